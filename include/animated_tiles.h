@@ -0,0 +1,69 @@
+#ifndef ANIMATED_TILES_H
+#define ANIMATED_TILES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ANIMATED_TILE_FLICKER_RATE 12.0f    // Torch flicker changes per second
+
+// Animated objects of one chunk, stored as parallel arrays so a tick is a
+// straight loop over the chunk's entries
+typedef struct AnimatedChunk {
+    int chunkX;
+    int chunkY;
+    uint16_t* tiles;                 // Chunk-local index, y * CACHE_CHUNK_SIZE + x
+    uint8_t* types;                  // ObjectType per entry
+    float* resonance;                // Value from the last tick
+    int count;
+    int capacity;
+} AnimatedChunk;
+
+// Sparse index of every animated object, bucketed by cache chunk so only
+// resident chunks need ticking. Buckets are found through an open-addressing
+// hash on chunk coordinates and are kept once created.
+typedef struct AnimatedTileIndex {
+    AnimatedChunk* chunks;
+    int chunkCount;
+    int chunkCapacity;
+    int* slots;                      // Hash table of bucket indices, -1 when empty
+    int slotMask;
+    int count;                       // Entries across all buckets
+} AnimatedTileIndex;
+
+// Objects whose resonance changes over time
+static inline bool IsObjectAnimated(ObjectType type) {
+    return type == OBJECT_FOUNTAIN || type == OBJECT_TORCH;
+}
+
+// Index management
+bool InitAnimatedTileIndex(AnimatedTileIndex* index);
+void FreeAnimatedTileIndex(AnimatedTileIndex* index);
+void ClearAnimatedTileIndex(AnimatedTileIndex* index);
+
+// Re-derives the index from packed tile planes laid out width x height
+bool RebuildAnimatedTileIndex(AnimatedTileIndex* index, const TileGrid* tiles, int width, int height);
+
+// Records the object now on a tile: animated objects are added or
+// updated, anything else removes the tile from the index
+bool SetAnimatedTile(AnimatedTileIndex* index, int tileX, int tileY, ObjectType type);
+
+// Bucket lookup, NULL when the chunk has never held an animated object
+AnimatedChunk* FindAnimatedChunk(const AnimatedTileIndex* index, int chunkX, int chunkY);
+
+// Recomputes every entry of one bucket for the given time. Values are a
+// pure function of tile and time, so chunks can be ticked in any order.
+void TickAnimatedChunk(AnimatedChunk* chunk, double time);
+
+// Last ticked value for a tile, 0 when it holds no animated object
+float GetAnimatedTileResonance(const AnimatedTileIndex* index, int tileX, int tileY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANIMATED_TILES_H
@@ -0,0 +1,69 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Library limits
+#define MAX_ANIMATION_CLIPS 64
+#define MAX_ANIMATION_FRAMES 512
+#define MAX_CLIP_FRAMES 64
+#define ANIMATION_CLIP_NAME_LENGTH 32
+#define ANIMATION_NO_CLIP -1
+
+// Sprite metadata loaded by GetAnimationLibrary
+#define ANIMATION_METADATA_PATH "resources/sprites/animations.txt"
+
+// One frame of a sprite sheet and how long it stays on screen
+typedef struct AnimationFrame {
+    Rectangle source;
+    float duration;
+} AnimationFrame;
+
+// Named run of frames inside the library's frame array
+typedef struct AnimationClip {
+    char name[ANIMATION_CLIP_NAME_LENGTH];
+    int firstFrame;
+    int frameCount;
+    float totalDuration;
+    bool loop;
+} AnimationClip;
+
+// Clip definitions shared by every animator. Entities only store a clip
+// index, so adding animated entities never duplicates frame data.
+typedef struct AnimationLibrary {
+    AnimationClip clips[MAX_ANIMATION_CLIPS];
+    int clipCount;
+    AnimationFrame frames[MAX_ANIMATION_FRAMES];
+    int frameCount;
+} AnimationLibrary;
+
+// Library management
+AnimationLibrary* CreateAnimationLibrary(void);
+void DestroyAnimationLibrary(AnimationLibrary* library);
+AnimationLibrary* GetAnimationLibrary(void);   // Loads ANIMATION_METADATA_PATH on first use
+void UnloadAnimationLibrary(void);
+
+// Clip registration. Returns the clip index or ANIMATION_NO_CLIP on failure.
+int AddAnimationClip(AnimationLibrary* library, const char* name, const AnimationFrame* frames, int frameCount, bool loop);
+int AddAnimationStrip(AnimationLibrary* library, const char* name, Rectangle firstFrame, int frameCount, float frameDuration, bool loop);
+
+// Clip lookup
+int FindAnimationClip(const AnimationLibrary* library, const char* name);
+const AnimationClip* GetAnimationClip(const AnimationLibrary* library, int clip);
+
+// Parses sprite metadata into the library. Lines are:
+//   clip NAME loop|once
+//   frame X Y WIDTH HEIGHT DURATION
+//   strip X Y WIDTH HEIGHT COUNT DURATION   (COUNT frames left to right)
+bool LoadAnimationClips(AnimationLibrary* library, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANIMATION_H
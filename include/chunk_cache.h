@@ -0,0 +1,50 @@
+#ifndef CHUNK_CACHE_H
+#define CHUNK_CACHE_H
+
+#include <stdbool.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHUNK_EVICT_CANDIDATES 4      // LRU-tail chunks a prefetch weighs for eviction
+
+// Cache management. Textures are owned by the caller: unload them before
+// FreeChunkCache (see UnloadChunkCache in map_system.h).
+bool InitChunkCache(ChunkCache* cache, int capacity);
+void FreeChunkCache(ChunkCache* cache);
+
+// Lookup without changing the eviction order, NULL when not cached
+CachedChunk* FindCachedChunk(const ChunkCache* cache, int chunkX, int chunkY);
+
+// Marks a chunk most recently used
+void TouchCachedChunk(ChunkCache* cache, CachedChunk* chunk);
+
+// Adds a chunk as most recently used and marks it dirty. When the cache is
+// full the least recently used chunk is evicted and its slot reused; the
+// slot keeps the evicted chunk's texture so it can be redrawn in place.
+CachedChunk* InsertCachedChunk(ChunkCache* cache, int chunkX, int chunkY);
+
+// Adds a chunk wanted soon but not this frame. Only chunks not used this
+// frame can make room: of the CHUNK_EVICT_CANDIDATES least recently used,
+// the one farthest from focus (in chunk coordinates) is evicted, provided
+// it is farther than the new chunk. NULL when nothing qualifies.
+CachedChunk* PrefetchCachedChunk(ChunkCache* cache, int chunkX, int chunkY, float focusX, float focusY);
+
+// Redraw tracking. Edits between two redraws accumulate as chunk-local
+// tile rectangles; touching rectangles are merged, and once the regions
+// cover half the chunk a full redraw is scheduled instead.
+void MarkChunkDirty(CachedChunk* chunk);
+void MarkChunkRegionDirty(CachedChunk* chunk, int minX, int minY, int maxX, int maxY);
+void ClearChunkDirty(CachedChunk* chunk);
+
+// Marks one map tile in whichever cached chunk holds it. Chunks that are
+// not cached are drawn in full when inserted, so they need nothing.
+void MarkCachedTileDirty(ChunkCache* cache, int tileX, int tileY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNK_CACHE_H
@@ -0,0 +1,64 @@
+#ifndef CHUNK_IO_H
+#define CHUNK_IO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_CHUNK_SIZE 32                 // Streamed chunk edge in tiles
+#define STREAM_CHUNK_TILES (STREAM_CHUNK_SIZE * STREAM_CHUNK_SIZE)
+#define CHUNK_IO_QUEUE_CAPACITY 256          // Pending loads and saves
+#define CHUNK_FILE_MAGIC 0x4B435753u         // "SWCK"
+#define CHUNK_FILE_VERSION 1
+
+// One streamed block of the world. Planes use the TileGrid byte encoding.
+typedef struct StreamChunk {
+    int chunkX;
+    int chunkY;
+    uint8_t types[STREAM_CHUNK_TILES];
+    uint8_t objects[STREAM_CHUNK_TILES];
+    bool dirty;                       // Modified since load, saved on eviction
+    uint32_t generation;              // Tag of the load request that filled it
+    struct StreamChunk* next;         // Completed-load list link
+} StreamChunk;
+
+// Fills a chunk that has no file yet. Runs on the I/O thread, so it must
+// only touch the chunk and its own context.
+typedef void (*ChunkGenerateFunc)(void* context, StreamChunk* chunk);
+
+// Opaque background loader/saver. Requests run in submission order on a
+// single thread, so a save always lands before a later load of that chunk.
+typedef struct ChunkIO ChunkIO;
+
+// A NULL directory keeps chunks in memory only: loads generate and saves
+// discard. Queued saves are written out before DestroyChunkIO returns.
+ChunkIO* CreateChunkIO(const char* directory, ChunkGenerateFunc generate, void* context);
+void DestroyChunkIO(ChunkIO* io);
+
+// Requests return false when the queue is full. A queued save takes
+// ownership of the chunk and frees it once written. A loaded chunk carries
+// the generation its load was queued with, so a caller can tell it from
+// the result of an older request for the same chunk.
+bool QueueChunkLoad(ChunkIO* io, int chunkX, int chunkY, uint32_t generation);
+bool QueueChunkSave(ChunkIO* io, StreamChunk* chunk);
+
+// Detaches every finished load as a list linked through next, NULL if none
+StreamChunk* PollLoadedChunks(ChunkIO* io);
+
+// Blocks until every queued request has run
+void FlushChunkIO(ChunkIO* io);
+
+// Synchronous chunk files, as used by the I/O thread
+void GetChunkFilePath(const char* directory, int chunkX, int chunkY, char* path, size_t size);
+bool ReadChunkFile(const char* directory, StreamChunk* chunk);
+bool WriteChunkFile(const char* directory, const StreamChunk* chunk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNK_IO_H
@@ -0,0 +1,64 @@
+#ifndef CHUNK_PREFETCH_H
+#define CHUNK_PREFETCH_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHUNK_PREFETCH_LOOKAHEAD 0.3f       // Seconds of camera motion predicted
+#define CHUNK_PREFETCH_SMOOTHING 0.25f      // Weight of the newest velocity sample
+#define CHUNK_PREFETCH_MAX_JUMP 4.0f        // Views moving more than this many times their size a frame are cuts
+#define CHUNK_PREFETCH_MAX_AHEAD 2.0f       // Prediction reaches at most this many view sizes away
+#define CHUNK_PREFETCH_QUEUE_SIZE 64
+
+// Chunk coordinate
+typedef struct ChunkCoord {
+    int x;
+    int y;
+} ChunkCoord;
+
+// Predicts where the camera is heading from its smoothed velocity and
+// lists the chunks it will reach that are not on screen yet, nearest to
+// the current view first. Counts how many chunks were ready when they
+// came into view.
+typedef struct ChunkPrefetcher {
+    Rectangle view;                  // View of the last update
+    Vector2 velocity;                // Smoothed view motion, pixels per second
+    Rectangle predictedView;         // view moved lookahead seconds along velocity
+    float lookahead;
+    bool hasView;
+
+    ChunkCoord queue[CHUNK_PREFETCH_QUEUE_SIZE];  // Chunks to prepare, highest priority first
+    int queueCount;
+
+    // Hit-rate metrics
+    int enteredChunks;               // Chunks that came into view
+    int readyChunks;                 // Of those, drawn complete on their first frame
+    int prefetchedChunks;            // Chunks prepared ahead of being visible
+} ChunkPrefetcher;
+
+// lookahead <= 0 uses CHUNK_PREFETCH_LOOKAHEAD
+void InitChunkPrefetcher(ChunkPrefetcher* prefetcher, float lookahead);
+
+// Feeds this frame's view (world space) and rebuilds the queue. A jump of
+// several view sizes, like a teleport, resets the velocity instead of
+// being taken as motion.
+void UpdateChunkPrefetcher(ChunkPrefetcher* prefetcher, Rectangle view, float deltaTime);
+
+// Centre of the predicted view, in pixels
+Vector2 GetChunkPrefetchFocus(const ChunkPrefetcher* prefetcher);
+
+// Metrics. The hit rate is 1 before any chunk has entered the view.
+void RecordChunkEntered(ChunkPrefetcher* prefetcher, bool ready);
+float GetChunkPrefetchHitRate(const ChunkPrefetcher* prefetcher);
+void ResetChunkPrefetchStats(ChunkPrefetcher* prefetcher);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNK_PREFETCH_H
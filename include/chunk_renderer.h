@@ -0,0 +1,126 @@
+#ifndef CHUNK_RENDERER_H
+#define CHUNK_RENDERER_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "map_types.h"
+#include "tile_mesh.h"
+#include "tile_lod.h"
+#include "job_system.h"
+#include "chunk_prefetch.h"
+
+// Forward declarations
+struct World;
+
+#define CHUNK_BUILD_SLOTS 8              // Chunk meshes building on workers at once
+#define CHUNK_UPLOADS_PER_FRAME 4        // Finished meshes sent to the GPU per frame
+#define CHUNK_PLACEHOLDER_COLOR (Color){ 46, 74, 40, 255 }
+#define CHUNK_LOD_CACHE_SIZE 24          // Group textures kept per reduced level
+#define CHUNK_LOD_BUILD_SLOTS 2          // Group images composed on workers at once
+#define CHUNK_LOD_UPLOADS_PER_FRAME 1    // Each upload is a full chunk-sized texture
+
+// A chunk mesh built on a worker. Tiles are copied in on the main thread,
+// so edits made while it builds cannot race with it; they leave the chunk
+// dirty for another build.
+typedef struct ChunkBuild {
+    uint8_t types[CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE];
+    uint8_t objects[CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE];
+    uint8_t resonance[CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE];
+    bool hasResonance;
+    uint32_t resonanceVersion;       // Field version the levels were copied at
+    int width;
+    int height;
+    TileAtlasLayout layout;
+    TileMeshData data;
+    JobCounter counter;
+    int slot;                        // Cache slot the mesh is for, -1 when idle
+    int chunkX;
+    int chunkY;
+} ChunkBuild;
+
+// A reduced image of a group of chunks, composed on a worker from copied
+// tiles the same way as a mesh build
+typedef struct ChunkLodBuild {
+    uint8_t types[TILE_LOD_MAX_TILES * TILE_LOD_MAX_TILES];
+    uint8_t objects[TILE_LOD_MAX_TILES * TILE_LOD_MAX_TILES];
+    int width;
+    int height;
+    Color* pixels;                   // CACHE_CHUNK_SIZE * TILE_SIZE pixels square
+    const TileLodAtlas* atlas;
+    JobCounter counter;
+    int level;
+    int slot;                        // Slot in the level's cache, -1 when idle
+    int groupX;
+    int groupY;
+} ChunkLodBuild;
+
+// Texture of one reduced-level cache slot. The texture is kept when the
+// slot is handed to another group and overwritten by its next upload.
+typedef struct ChunkLodSlot {
+    Texture2D texture;               // id 0 until first uploaded
+    int groupX;                      // Group the texture shows, valid when hasImage
+    int groupY;
+    bool hasImage;
+    bool isBuilding;
+} ChunkLodSlot;
+
+// GPU mesh of one cache slot
+typedef struct ChunkMeshSlot {
+    Mesh mesh;                       // vaoId 0 until uploaded
+    int chunkX;                      // Chunk the mesh shows, valid when hasMesh
+    int chunkY;
+    bool hasMesh;
+    bool isBuilding;                 // A ChunkBuild targets this slot
+    uint32_t resonanceVersion;       // Field version baked into the mesh
+    int shownFrame;                  // Last frame the slot's chunk was in view
+    int shownX;                      // Chunk shown that frame
+    int shownY;
+} ChunkMeshSlot;
+
+// Draws a world's tiles as one static quad mesh per chunk. Dirty chunks
+// are rebuilt on worker threads and only the upload happens on the main
+// thread, a few per frame; chunks still waiting draw a flat placeholder.
+// Each visible chunk is a single draw call through the resonance shader,
+// carrying the world's resonance field per vertex and rebuilt when the
+// field changes; the caller keeps the field current. Chunks are tracked by the same
+// hashed LRU cache as the chunk textures, so GPU memory stays bounded on
+// streamed worlds. Spare build slots go to the chunks the camera is about
+// to reach, so most arrive already meshed.
+//
+// Zoomed out, 2x2 or 4x4 groups of chunks are drawn as one texture each,
+// reduced on the CPU from a box-filtered copy of the tileset, so the view
+// stays a few dozen draws and the caches do not thrash. A view needing more
+// groups than CHUNK_LOD_CACHE_SIZE draws that many around its centre.
+typedef struct ChunkRenderer {
+    ChunkCache cache;                // Keys, LRU order and dirty state
+    ChunkMeshSlot* slots;            // Parallel to cache.chunks
+    ChunkBuild builds[CHUNK_BUILD_SLOTS];
+    Material material;
+    bool hasMaterial;                // Created on first draw, needs a GL context
+    int timeLocation;                // Resonance shader clock, -1 on the default shader
+    ChunkPrefetcher prefetch;        // Camera prediction and hit rate
+
+    // Reduced levels, indexed by level; level 0 is the meshes above
+    ChunkCache lodCaches[TILE_LOD_LEVELS];
+    ChunkLodSlot* lodSlots[TILE_LOD_LEVELS];
+    ChunkLodBuild lodBuilds[CHUNK_LOD_BUILD_SLOTS];
+    TileLodAtlas lodAtlas;
+    unsigned int lodTilesetId;       // Tileset the atlas was reduced from, 0 for none
+} ChunkRenderer;
+
+// Renderer management. Creation needs no GL context.
+ChunkRenderer* CreateChunkRenderer(int capacity);
+void DestroyChunkRenderer(ChunkRenderer* renderer);
+
+// Dirty tracking, driven by tile edits
+void MarkChunkMeshDirty(ChunkRenderer* renderer, int tileX, int tileY);
+void InvalidateChunkRenderer(ChunkRenderer* renderer);
+
+// Draws every chunk overlapping view (world space) inside the current 2D
+// mode. Uploads finished builds first, then starts builds for dirty
+// chunks in view, then for chunks on the camera's predicted path. The
+// zoom, and with it the level of detail, follows from the view's width
+// against the screen's.
+void DrawChunkRenderer(ChunkRenderer* renderer, const struct World* world, Texture2D tileset, Rectangle view);
+
+#endif // CHUNK_RENDERER_H
@@ -0,0 +1,93 @@
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COLLISION_WORD_BITS 64
+#define COLLISION_MAX_SLIDES 3      // Sweeps per move: the motion, then a slide along each axis
+
+// Outcome of sweeping a box through the grid
+typedef struct SweepResult {
+    float time;                     // Fraction of the motion before contact, 1 when clear
+    Vector2 position;               // Box top-left at that time
+    Vector2 normal;                 // Contact normal, zero when clear
+    Vector2 slide;                  // Unspent motion along the contact surface
+    bool hit;
+} SweepResult;
+
+// Grid management. A new grid has every in-bounds cell open.
+CollisionGrid* CreateCollisionGrid(int width, int height, int cellSize);
+void DestroyCollisionGrid(CollisionGrid* grid);
+void ClearCollisionGrid(CollisionGrid* grid);
+
+// Re-derives cells from packed tile planes laid out width x height
+void RebuildCollisionGrid(CollisionGrid* grid, const TileGrid* tiles);
+void UpdateCollisionCell(CollisionGrid* grid, int x, int y, TileType type, ObjectType object);
+
+// Single cell access. Cells outside the grid are blocked.
+static inline bool IsCellBlocked(const CollisionGrid* grid, int x, int y) {
+    if (x < 0 || x >= grid->width || y < 0 || y >= grid->height) return true;
+    return (grid->bits[(size_t)y * grid->stride + (x >> 6)] >> (x & 63)) & 1u;
+}
+
+static inline void SetCellBlocked(CollisionGrid* grid, int x, int y, bool blocked) {
+    if (x < 0 || x >= grid->width || y < 0 || y >= grid->height) return;
+    uint64_t* word = &grid->bits[(size_t)y * grid->stride + (x >> 6)];
+    uint64_t mask = (uint64_t)1 << (x & 63);
+    *word = blocked ? (*word | mask) : (*word & ~mask);
+}
+
+// 64 cells of row y starting at x; bit i is cell x + i. Any alignment works
+// and cells outside the grid read as blocked.
+uint64_t GetCollisionRow(const CollisionGrid* grid, int x, int y);
+
+// True when any cell of the inclusive tile rectangle is blocked
+bool IsCollisionAreaBlocked(const CollisionGrid* grid, int minX, int minY, int maxX, int maxY);
+
+// True when a world-space box overlaps a blocked cell. Touching edges do
+// not count as overlap.
+bool CheckCollisionGridRec(const CollisionGrid* grid, Rectangle bounds);
+
+// Sweeps a world-space box along motion, visiting the cells its leading
+// edges enter in time order (DDA). Only newly entered cells can stop it, so
+// a box that starts overlapping a blocked cell can still move out.
+SweepResult SweepCollisionBox(const CollisionGrid* grid, Rectangle box, Vector2 motion);
+
+// Sweeps and then slides along whatever was hit. Returns the final
+// top-left; hit reports whether any sweep made contact.
+Vector2 MoveCollisionBox(const CollisionGrid* grid, Rectangle box, Vector2 motion, bool* hit);
+
+// Batched queries, for callers that probe many points a frame. Points and
+// rays are world-space; cells outside the grid are blocked as usual.
+
+// Writes whether each point's cell is open and returns how many are
+int TestCollisionPoints(const CollisionGrid* grid, const Vector2* points, int count, bool* open);
+
+// Blocked cells overlapping a world-space box, row by row. Writes at most
+// maxCells and returns the total, so a short buffer can be detected.
+int FindBlockedCells(const CollisionGrid* grid, Rectangle bounds, CollisionCell* cells, int maxCells);
+
+// Casts rays from origins[i] along motions[i], stopping each at the first
+// blocked cell it passes through. A ray starting in a blocked cell hits at
+// time 0.
+void CastCollisionRays(const CollisionGrid* grid, const Vector2* origins, const Vector2* motions,
+                       int count, CollisionRayHit* hits);
+
+// The cell walk behind CastCollisionRays (DDA), over any per-cell test, for
+// callers whose cells are not in a bitmap
+typedef bool (*CellBlockedFunc)(const void* context, int x, int y);
+CollisionRayHit CastCellRay(Vector2 origin, Vector2 motion, float cellSize,
+                            CellBlockedFunc isBlocked, const void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COLLISION_GRID_H
@@ -0,0 +1,30 @@
+#ifndef ANIMATOR_H
+#define ANIMATOR_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "../entity_types.h"
+#include "../entity_pool.h"
+#include "../animation.h"
+
+// Advances every animator in a pool on one fixed timestep. Frame time is
+// accumulated once per update, so all entities step in lockstep no matter
+// how the render frame rate varies, and each pass writes the current
+// frame's source rect straight into the entity's render component.
+typedef struct AnimationSystem {
+    const AnimationLibrary* library;
+    float accumulator;                 // Unspent time, always below ANIMATION_FIXED_STEP
+} AnimationSystem;
+
+// System management
+AnimationSystem* CreateAnimationSystem(const AnimationLibrary* library);
+void DestroyAnimationSystem(AnimationSystem* system);
+
+// Returns the number of fixed steps taken this update
+int UpdateAnimationSystem(AnimationSystem* system, EntityPool* pool, float deltaTime);
+
+// Starts a clip from its first frame. Replaying the current clip keeps its progress.
+void PlayAnimation(Entity* entity, int clip);
+void StopAnimation(Entity* entity);
+
+#endif // ANIMATOR_H
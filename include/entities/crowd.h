@@ -0,0 +1,58 @@
+#ifndef CROWD_H
+#define CROWD_H
+
+#include <raylib.h>
+#include "../entity_types.h"
+#include "../entity_pool.h"
+#include "../spatial_grid.h"
+#include "../job_system.h"
+
+// Forward declarations
+struct World;
+
+// Crowd defaults
+#define CROWD_NEIGHBOR_RADIUS 64.0f
+#define CROWD_SEPARATION_RADIUS 36.0f
+#define CROWD_SEPARATION_WEIGHT 1.5f
+#define CROWD_ALIGNMENT_WEIGHT 0.3f
+#define CROWD_OBSTACLE_WEIGHT 2.0f
+#define CROWD_OBSTACLE_LOOKAHEAD 24.0f
+#define CROWD_MAX_SPEED NPC_SPEED
+#define CROWD_CELLS_PER_JOB 8
+
+// Steering tuning
+typedef struct CrowdSettings {
+    float neighborRadius;     // Alignment range, also the grid cell size
+    float separationRadius;   // Personal space
+    float separationWeight;
+    float alignmentWeight;
+    float obstacleWeight;
+    float obstacleLookahead;  // Probe distance along the preferred direction
+    float maxSpeed;
+} CrowdSettings;
+
+// Batched crowd steering stage. Agents are snapshotted into SoA arrays,
+// binned into a uniform grid and steered in parallel over grid cells.
+typedef struct CrowdSystem {
+    CrowdSettings settings;
+    SpatialGrid* grid;
+    Entity** agents;
+    Vector2* positions;
+    Vector2* velocities;      // Preferred velocity each agent asked for
+    Vector2* desired;         // Steering output
+    Vector2* probes;          // Obstacle probe point ahead of each agent
+    bool* probeOpen;          // Whether each probe landed on a walkable tile
+    int agentCount;
+    int agentCapacity;
+} CrowdSystem;
+
+// Crowd system management
+CrowdSettings GetDefaultCrowdSettings(void);
+CrowdSystem* CreateCrowdSystem(Rectangle worldBounds, const CrowdSettings* settings);
+void DestroyCrowdSystem(CrowdSystem* crowd);
+
+// Computes a desired velocity for every AI agent and writes it to its
+// PhysicsComponent. Results do not depend on the job system's worker count.
+void UpdateCrowdSteering(CrowdSystem* crowd, EntityPool* pool, const struct World* world, JobSystem* jobs);
+
+#endif // CROWD_H
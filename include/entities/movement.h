@@ -0,0 +1,36 @@
+#ifndef MOVEMENT_H
+#define MOVEMENT_H
+
+#include <raylib.h>
+#include "../entity_types.h"
+#include "../entity_pool.h"
+#include "../job_system.h"
+
+// Forward declarations
+struct World;
+
+#define MOVEMENT_ENTITIES_PER_JOB 32
+#define MOVEMENT_BLOCKED_PROGRESS 0.5f   // Below this share of the requested motion a mover counts as blocked
+
+// Batched tile-collision stage. Every entity with a transform and a
+// non-kinematic physics component sweeps its collider box along
+// moveVelocity through the world's collision bitmap, sliding along walls.
+// Time is consumed in whole MOVEMENT_FIXED_STEP steps and each entity only
+// reads the static grid and writes itself, so results do not depend on the
+// frame rate or on how the pass is split across workers.
+typedef struct MovementSystem {
+    float accumulator;                   // Unspent time, always below MOVEMENT_FIXED_STEP
+} MovementSystem;
+
+// System management
+MovementSystem* CreateMovementSystem(void);
+void DestroyMovementSystem(MovementSystem* system);
+
+// Returns the number of fixed steps taken this update
+int UpdateMovementSystem(MovementSystem* system, EntityPool* pool, const struct World* world,
+                         JobSystem* jobs, float deltaTime);
+
+// World-space box an entity collides with at a given position
+Rectangle GetMovementBox(Entity* entity, Vector2 position);
+
+#endif // MOVEMENT_H
@@ -60,6 +60,5 @@ void UpdateFleeState(Entity* npc, struct World* world, float deltaTime);
 float GetDistanceToPlayer(const Entity* npc, const struct World* world);
 bool IsPlayerVisible(const Entity* npc, const struct World* world);
 Vector2 GetRandomPatrolPoint(const Entity* npc, const struct World* world);
-void UpdateNPCAnimation(Entity* npc, float deltaTime);
 
 #endif // NPC_H
\ No newline at end of file
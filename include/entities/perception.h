@@ -0,0 +1,56 @@
+#ifndef PERCEPTION_H
+#define PERCEPTION_H
+
+#include <raylib.h>
+#include <stdint.h>
+#include "../entity_types.h"
+#include "../entity_pool.h"
+
+// Perception limits
+#define PERCEPTION_MAX_STIMULI 16
+#define PERCEPTION_LANES 4
+
+// Bits written to AIComponent.perception
+typedef enum PerceptionFlags {
+    PERCEPTION_NONE = 0,
+    PERCEPTION_PLAYER_DETECTED = 1u << 0,  // Player inside detectionRadius
+    PERCEPTION_PLAYER_IN_RANGE = 1u << 1,  // Player inside twice detectionRadius
+    PERCEPTION_STIMULUS_SHIFT = 8          // Stimulus i sets bit (8 + i)
+} PerceptionFlags;
+
+#define PERCEPTION_STIMULUS_BIT(index) (1u << (PERCEPTION_STIMULUS_SHIFT + (index)))
+
+// Transient point of interest, e.g. a noise, heard within its radius
+typedef struct PerceptionStimulus {
+    Vector2 position;
+    float radius;
+} PerceptionStimulus;
+
+// Batched distance tests for every AI agent. Positions and radii are kept
+// as SoA float arrays padded to PERCEPTION_LANES so the whole pass runs in
+// vector lanes and compares squared distances only.
+typedef struct PerceptionSystem {
+    Entity** agents;
+    float* positionsX;
+    float* positionsY;
+    float* detectionRadiiSq;
+    uint32_t* masks;
+    int agentCount;
+    int agentCapacity;                     // Always a multiple of PERCEPTION_LANES
+    PerceptionStimulus stimuli[PERCEPTION_MAX_STIMULI];
+    int stimulusCount;
+} PerceptionSystem;
+
+// Perception system management
+PerceptionSystem* CreatePerceptionSystem(void);
+void DestroyPerceptionSystem(PerceptionSystem* perception);
+
+// Stimuli are consumed by the next UpdatePerception. Returns the stimulus
+// index (see PERCEPTION_STIMULUS_BIT) or -1 when the frame is full.
+int AddPerceptionStimulus(PerceptionSystem* perception, Vector2 position, float radius);
+void ClearPerceptionStimuli(PerceptionSystem* perception);
+
+// Writes PerceptionFlags to the AIComponent of every active AI agent
+void UpdatePerception(PerceptionSystem* perception, EntityPool* pool, Vector2 playerPosition);
+
+#endif // PERCEPTION_H
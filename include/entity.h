@@ -35,6 +35,7 @@ RenderComponent* GetRenderComponent(Entity* entity);
 ColliderComponent* GetColliderComponent(Entity* entity);
 AIComponent* GetAIComponent(Entity* entity);
 PlayerControlComponent* GetPlayerControlComponent(Entity* entity);
+AnimatorComponent* GetAnimatorComponent(Entity* entity);
 
 // Component initialization functions
 void InitializeTransformComponent(TransformComponent* transform, Vector2 position);
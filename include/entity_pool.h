@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include "entity_types.h"
 #include "constants.h"
+#include "map_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,7 @@ extern "C" {
 
 // Forward declarations
 struct World;
+struct SpatialGrid;
 
 // Pool configuration
 #define POOL_MEMORY_ALIGNMENT 16
@@ -35,6 +37,13 @@ typedef struct EntityPool {
     size_t firstFree;             // Index of first free slot
     PoolStatus status;            // Current pool status
     struct World* world;          // Reference to parent world
+    uint32_t nextEntityId;        // Next id handed out by CreateEntity
+
+    // Draw index: entity slots binned by map chunk, rebuilt once a frame
+    struct SpatialGrid* drawGrid;
+    Vector2* drawPositions;       // Position snapshot the grid was built from
+    size_t drawCapacity;
+    size_t indexedCount;          // Slots covered by the grid, 0 when stale
 } EntityPool;
 
 // Core pool functions
@@ -43,6 +52,14 @@ void DestroyEntityPool(EntityPool* pool);
 void UpdateEntityPool(EntityPool* pool, struct World* world, float deltaTime);
 void DrawEntityPool(EntityPool* pool);
 
+// Bins every entity by the map chunk it stands in, for DrawEntityPoolInView.
+// Call once positions are final for the frame.
+bool IndexEntityPool(EntityPool* pool, Rectangle worldBounds);
+
+// Draws only entities in or next to the viewport's chunks, so off-screen
+// entities cost nothing. Falls back to DrawEntityPool without an index.
+void DrawEntityPoolInView(EntityPool* pool, const Viewport* viewport);
+
 // Entity management
 Entity* CreateEntity(EntityPool* pool, EntityType type, Vector2 position);
 void RemoveEntity(EntityPool* pool, Entity* entity);
@@ -4,6 +4,7 @@
 #include <raylib.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "constants.h"
 
 // Entity dimensions and constants
@@ -17,10 +18,15 @@
 #define NPC_SPEED 150.0f
 
 // Animation constants
-#define ANIMATION_FRAME_TIME 0.1f
-#define ANIMATION_FRAME_COUNT 4
+#define ANIMATION_FRAME_TIME 0.1f          // Default frame duration for sprite strips
+#define ANIMATION_FIXED_STEP (1.0f / 60.0f)
+#define ANIMATION_MAX_STEPS 8              // Catch-up steps allowed after a long frame
 #define ARRIVAL_THRESHOLD 5.0f
 
+// Movement constants
+#define MOVEMENT_FIXED_STEP (1.0f / 60.0f)
+#define MOVEMENT_MAX_STEPS 8               // Catch-up steps allowed after a long frame
+
 // State durations
 #define IDLE_DURATION 3.0f
 #define PATROL_DURATION 5.0f
@@ -50,7 +56,8 @@ typedef enum ComponentFlags {
     COMPONENT_RENDER = 1 << 2,
     COMPONENT_COLLIDER = 1 << 3,
     COMPONENT_AI = 1 << 4,
-    COMPONENT_PLAYER_CONTROL = 1 << 5
+    COMPONENT_PLAYER_CONTROL = 1 << 5,
+    COMPONENT_ANIMATOR = 1 << 6
 } ComponentFlags;
 
 // Component Registry for managing component arrays
@@ -96,9 +103,13 @@ typedef struct {
 typedef struct {
     Vector2 velocity;
     Vector2 acceleration;
+    Vector2 desiredVelocity;  // Crowd steering output
     float friction;
     float mass;
     bool isKinematic;
+    bool isSteered;           // desiredVelocity was written this frame
+    Vector2 moveVelocity;     // Velocity the movement pass sweeps through the tiles
+    bool isBlocked;           // The last movement pass was stopped by a tile
 } PhysicsComponent;
 
 typedef struct {
@@ -125,9 +136,9 @@ typedef struct {
     bool isAggressive;
     EntityState state;
     float stateTimer;
-    int animationFrame;
-    float animationTimer;
     float moveSpeed;
+    uint32_t perception;           // PerceptionFlags from the perception stage
+    int pathHandle;                // Route to targetPosition, see GetPathFollower
 } AIComponent;
 
 typedef struct {
@@ -136,6 +147,14 @@ typedef struct {
     bool isInteracting;
 } PlayerControlComponent;
 
+typedef struct {
+    int clip;                      // Index into the shared AnimationLibrary
+    int frame;                     // Frame within the clip
+    float frameTime;               // Time spent on the current frame
+    float speed;                   // Playback rate multiplier
+    bool playing;
+} AnimatorComponent;
+
 // Component data union
 typedef union {
     TransformComponent transform;
@@ -144,10 +163,12 @@ typedef union {
     ColliderComponent collider;
     AIComponent ai;
     PlayerControlComponent playerControl;
+    AnimatorComponent animator;
 } ComponentData;
 
 // Entity definition
 typedef struct Entity {
+    uint32_t id;                   // Stable for the entity's lifetime, never reused by its pool
     EntityType type;
     ComponentFlags components;
     EntityState state;
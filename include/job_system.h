@@ -0,0 +1,50 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_JOB_WORKERS 16
+#define JOB_QUEUE_CAPACITY 1024
+
+// Job entry points
+typedef void (*JobFunc)(void* context);
+typedef void (*JobRangeFunc)(void* context, int begin, int end);
+
+// Opaque worker pool
+typedef struct JobSystem JobSystem;
+
+// Tracks completion of a batch of submitted jobs
+typedef struct JobCounter {
+    volatile long pending;
+} JobCounter;
+
+// Job system management
+JobSystem* CreateJobSystem(int workerCount);  // workerCount <= 0 picks one per spare core
+void DestroyJobSystem(JobSystem* jobs);
+JobSystem* GetJobSystem(void);                // Shared pool, created on first use
+void UnloadJobSystem(void);
+int GetJobWorkerCount(const JobSystem* jobs);
+
+// Job submission. A NULL job system (or a full queue) runs the job inline.
+void SubmitJob(JobSystem* jobs, JobFunc func, void* context, JobCounter* counter);
+bool IsJobCounterDone(const JobCounter* counter);
+void WaitForJobs(JobSystem* jobs, JobCounter* counter);
+
+// Splits [0, count) into grainSize ranges and blocks until all have run.
+// Ranges never overlap, so writes indexed by the range are race-free.
+void ParallelFor(JobSystem* jobs, int count, int grainSize, JobRangeFunc func, void* context);
+
+// Atomics shared by systems that hand data between threads
+long JobAtomicAdd(volatile long* value, long amount);
+long JobAtomicLoad(const volatile long* value);
+void JobAtomicStore(volatile long* value, long newValue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,105 @@
+#ifndef MAP_FILE_H
+#define MAP_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAP_FILE_MAGIC 0x504D5753u      // "SWMP" in file byte order
+#define MAP_FILE_VERSION 1
+#define MAP_FILE_CHUNK_SIZE 32          // Tiles per side of one compressed record
+#define MAP_FILE_HEADER_SIZE 32
+#define MAP_PATCH_MAGIC 0x54505753u     // "SWPT" in file byte order
+#define MAP_PATCH_VERSION 2             // Logs before 2 carry no generation
+#define MAP_PATCH_HEADER_SIZE 20
+
+// Chunked map file. All integers are little-endian.
+//
+//   header        magic, version, chunk size, width, height, index offset,
+//                 string table offset, string count, generation
+//   chunk records the type plane then the object plane of one chunk, each
+//                 run-length encoded, then its custom property references
+//                 as (chunk-local tile, string id) pairs
+//   string table  length-prefixed custom property strings, one per
+//                 property set
+//   chunk index   (offset, size) of every record, row-major by chunk
+//
+// Chunks at the right and bottom edge are clipped to the map, so records
+// never hold tiles outside it.
+//
+// Saves between full rewrites append to a patch log beside the map file,
+// named by adding ".patch":
+//
+//   header        magic, version, chunk size, width, height, generation
+//   entries       chunk x, chunk y (u16 each), record size (u32), then a
+//                 chunk record whose custom properties are inline as
+//                 (chunk-local tile, length, bytes) instead of string ids
+//
+// Opening a map file replays its log, later entries winning. An entry cut
+// short by a crash ends the log there. Every full save stamps the file
+// with the next generation and a log with the generation it was started
+// against, so a log a crash left behind a newer file is never replayed.
+typedef struct MapFile MapFile;
+typedef struct MapPatch MapPatch;
+
+// Writes a width x height grid, replacing the file only once it is complete
+// and then deleting its patch log, which the new file already includes
+bool SaveMapFile(const char* path, const TileGrid* tiles, int width, int height);
+
+// Opening maps the file read-only and checks only the header, so it costs
+// the same for any map size; pages are read in as chunks are decoded and
+// are shared with other processes mapping the same file. NULL when the
+// file is missing, is not a map file or has an unknown version.
+MapFile* OpenMapFile(const char* path);
+void CloseMapFile(MapFile* file);
+
+int GetMapFileWidth(const MapFile* file);
+int GetMapFileHeight(const MapFile* file);
+int GetMapFileChunkCount(const MapFile* file);
+
+// Decodes one chunk into a grid of the file's dimensions, including its
+// custom properties. Not safe to call on one file from several threads.
+bool ReadMapFileChunk(MapFile* file, int chunkX, int chunkY, TileGrid* tiles);
+
+// Asks the OS to start reading a chunk's pages in the background, so a
+// later ReadMapFileChunk does not wait on the disk
+void PrefetchMapFileChunk(const MapFile* file, int chunkX, int chunkY);
+
+// Reads a whole map into a fresh grid
+bool LoadMapFile(const char* path, TileGrid* tiles, int* width, int* height);
+
+// Patch entries for a width x height map. Adding a chunk encodes it on the
+// spot, so the grid may change afterwards and the patch can be written
+// from another thread.
+MapPatch* CreateMapPatch(int width, int height);
+void DestroyMapPatch(MapPatch* patch);
+bool AddMapPatchChunk(MapPatch* patch, const TileGrid* tiles, int chunkX, int chunkY);
+int GetMapPatchChunkCount(const MapPatch* patch);
+
+// Appends a patch to the log of the map file at path, starting the log
+// when there is none or it is from an older generation of the file. Fails
+// without writing when the map file is missing, or the log belongs to a
+// map of another size or ends in a torn entry; a full save clears either.
+bool AppendMapFilePatch(const char* path, const MapPatch* patch);
+
+// Rewrites a map file with its patch log folded in
+bool CompactMapFile(const char* path);
+
+// Run-length coding used for the tile planes. A control byte below 128
+// starts control + 1 literal bytes; from 128 up it repeats the next byte
+// control - 126 times. Decode returns the bytes consumed, or 0 when the
+// input ends early or would overrun the output.
+size_t EncodeMapPlane(const uint8_t* data, size_t count, uint8_t* out);
+size_t DecodeMapPlane(const uint8_t* in, size_t inSize, uint8_t* out, size_t count);
+size_t GetMapPlaneBound(size_t count);      // Worst-case encoded size
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MAP_FILE_H
@@ -2,17 +2,39 @@
 #define MAP_SYSTEM_H
 
 #include "map_types.h"
+#include "animated_tiles.h"
+#include "job_system.h"
 #include <raylib.h>
 
 // Forward declarations
 struct World;
+struct MapPatch;
+
+#define MAP_SAVE_PATH_LENGTH 512
+
+// Saves after a full one append only the edited file chunks to the map
+// file's patch log, on a worker that now and then folds the log back in
+typedef struct MapSaveJob {
+    JobCounter counter;
+    struct MapPatch* patch;    // Being written, NULL when idle
+    char path[MAP_SAVE_PATH_LENGTH];
+    int patchedChunks;         // Entries in the log since it was last folded in
+    bool compact;              // Fold the log in after appending
+    bool appended;             // Results, read once the counter is done
+    bool compacted;
+    bool isQueued;             // Asked for again while running
+    bool needsFullSave;        // The file fell behind the map, rewrite it whole
+} MapSaveJob;
 
 // Map System structure
 typedef struct MapSystem {
     TileMap* currentMap;
     CollisionGrid* collisionGrid;
-    RenderLayer* layers;
-    int layerCount;
+    struct World* world;       // Gameplay grid that mirrors object edits
+    AnimatedTileIndex animatedTiles;      // Fountains and torches of the current map, by chunk
+    int chunkCacheSize;        // Chunk textures kept by each loaded map
+    char savePath[MAP_SAVE_PATH_LENGTH];  // File the map matches as of its last save, empty for none
+    MapSaveJob save;
 } MapSystem;
 
 // Map system management functions
@@ -20,18 +42,31 @@ MapSystem* CreateMapSystem(void);
 void DestroyMapSystem(MapSystem* mapSystem);
 bool LoadMap(MapSystem* mapSystem, const char* fileName);
 void UpdateMapState(MapSystem* mapSystem, float deltaTime);
-void RenderMapLayers(MapSystem* mapSystem);
 
 // Additional map system functions
 void UpdateMapSystem(struct World* world, float deltaTime);
 void DrawMapSystem(MapSystem* mapSystem);
 void AddMapObject(MapSystem* mapSystem, ObjectType type, Vector2 position);
 void RemoveMapObject(MapSystem* mapSystem, Vector2 position);
+void SetMapTileProperties(MapSystem* mapSystem, int tileX, int tileY, const char* properties);  // NULL clears them
 void UpdateMapObjects(MapSystem* mapSystem, float deltaTime);
-void SaveMapSystem(MapSystem* mapSystem, const char* filename);
+void SaveMapSystem(MapSystem* mapSystem, const char* filename);   // Only edited chunks when saving over the last file
+void FinishMapSave(MapSystem* mapSystem);                         // Blocks until saves on workers are written
 void LoadMapSystem(MapSystem* mapSystem, const char* filename);
+void LoadMapArea(MapSystem* mapSystem, Rectangle bounds);    // Decodes tiles a lazily loaded map has not reached yet
+Viewport GetCameraViewport(Camera2D camera);                // World area and chunk range on screen
+
+// Layer functions
+bool InitMapLayers(TileMap* map, int chunkCacheSize);
+void FreeMapLayers(TileMap* map);                             // Unloads every layer's chunk textures
+void SetMapLayerVisible(MapSystem* mapSystem, MapLayerType layer, bool visible);
+void SetMapLayerRefreshInterval(MapSystem* mapSystem, MapLayerType layer, float seconds);
+void MarkMapTileDirty(MapSystem* mapSystem, int tileX, int tileY);  // Redraws one tile on every layer and saves it next time
+void DrawMapOverhead(MapSystem* mapSystem);                   // Layers drawn after entities
 
 // Chunk management functions
 CachedChunk* GetChunk(ChunkCache* cache, Vector2 gridPos);
+void UnloadChunkCache(ChunkCache* cache);                     // Unloads textures and frees the cache
+bool SetChunkCacheSize(MapSystem* mapSystem, int capacity);  // Applies to the current and future maps
 
 #endif // MAP_SYSTEM_H 
\ No newline at end of file
@@ -3,10 +3,28 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "constants.h"
 
 #define CACHE_CHUNK_SIZE 16  // Size of each cached chunk in tiles
-#define MAX_CACHED_CHUNKS 64 // Maximum number of chunks to keep in cache
+#define DEFAULT_CHUNK_CACHE_SIZE 64 // Chunks kept when no cache size is configured
+#define CHUNK_MAX_DIRTY_RECTS 4     // Separate redraw regions per chunk before they are merged
+
+// Spreads chunk coordinates over a power-of-two slot table; shared by the
+// chunk cache, the animated tile index and the world stream
+static inline uint32_t HashChunkKey(int chunkX, int chunkY) {
+    uint32_t hash = (uint32_t)chunkX * 0x9E3779B1u ^ (uint32_t)chunkY * 0x85EBCA77u;
+    hash ^= hash >> 15;
+    hash *= 0x2C1B3C6Du;
+    return hash ^ (hash >> 12);
+}
+
+// Integer division rounding toward negative infinity, so tile -1 lands in
+// chunk -1 rather than chunk 0
+static inline int FloorDiv(int value, int divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
 
 // Forward declarations
 struct World;
@@ -25,7 +43,7 @@ typedef enum {
     OBJECT_COUNT
 } ObjectType;
 
-// Enhanced tile properties (lightweight TMX-like)
+// Properties shared by every tile of one TileType
 typedef struct {
     bool isWalkable;
     bool isDestructible;
@@ -33,47 +51,84 @@ typedef struct {
     float friction;
     float resonance;
     Color color;
-    const char* customProperties;  // JSON string for custom properties
 } TileProperties;
 
-// Basic tile structure
+// Tile value passed through the tile API. Grids do not store these;
+// see TileGrid for the packed layout.
 typedef struct {
     TileType type;
     ObjectType objectType;
-    TileProperties properties;
 } Tile;
 
-// Create a tile with default properties
+// Create a tile value
 static inline Tile CreateTile(TileType type, ObjectType objectType) {
     Tile tile = {
         .type = type,
-        .objectType = objectType,
-        .properties = {
-            .isWalkable = true,
-            .isDestructible = false,
-            .isInteractive = false,
-            .friction = 1.0f,
-            .resonance = 0.0f,
-            .color = WHITE,
-            .customProperties = NULL
-        }
+        .objectType = objectType
     };
     return tile;
 }
 
+// Rare per-tile data that does not belong in the shared property table
+typedef struct {
+    int index;                      // Tile index, y * width + x
+    uint16_t propertySet;           // Custom properties, an id in the grid's property store
+} TileOverride;
+
+// Flyweight tile storage. Types and objects are separate one-byte planes,
+// so a 1024x1024 map is 2 MB and a scan over one attribute touches only
+// that plane. Everything else comes from the per-type property table or
+// the sparse override list, whose tiles share interned property sets.
+typedef struct {
+    uint8_t* types;                 // TileType per tile
+    uint8_t* objects;               // ObjectType per tile
+    size_t count;
+    TileOverride* overrides;        // Sorted by index
+    int overrideCount;
+    int overrideCapacity;
+    struct PropertyStore* propertyStore;  // Created with the first override
+} TileGrid;
+
+// Objects that stop movement through their tile
+static inline bool IsObjectBlocking(ObjectType type) {
+    return type == OBJECT_TREE || type == OBJECT_FOUNTAIN ||
+           type == OBJECT_STATUE || type == OBJECT_ROCK;
+}
+
+// Inclusive tile rectangle in chunk-local coordinates
+typedef struct {
+    uint8_t minX;
+    uint8_t minY;
+    uint8_t maxX;
+    uint8_t maxY;
+} ChunkDirtyRect;
+
 // Cached chunk for rendering optimization
 typedef struct {
     RenderTexture2D texture;    // Pre-rendered chunk texture
     Rectangle bounds;           // World space bounds of this chunk
     bool isDirty;              // Whether chunk needs updating
-    int lastAccessTime;        // For cache eviction
+    ChunkDirtyRect dirtyRects[CHUNK_MAX_DIRTY_RECTS];  // Regions to redraw, disjoint and non-adjacent
+    int dirtyRectCount;
+    int lastAccessTime;        // Frame the chunk was last visible
     Vector2 gridPosition;      // Position in chunk grid
+    int chunkX;                // Integer cache key
+    int chunkY;
+    int lruPrev;               // Toward the most recently used chunk, -1 at the head
+    int lruNext;               // Toward the eviction candidate, -1 at the tail
 } CachedChunk;
 
-// Chunk cache manager
+// Chunk cache manager. Chunks are found through an open-addressing hash
+// keyed on integer chunk coordinates and ordered by an intrusive LRU
+// list, so lookup, touch and eviction are all constant time.
 typedef struct {
-    CachedChunk chunks[MAX_CACHED_CHUNKS];
+    CachedChunk* chunks;       // capacity slots, the first chunkCount in use
+    int capacity;
     int chunkCount;
+    int* slots;                // Hash table of chunk indices, -1 when empty
+    int slotMask;              // Table size minus one, the size is a power of two
+    int lruHead;               // Most recently used chunk
+    int lruTail;               // Next chunk to evict
     int frameCounter;          // For cache aging
 } ChunkCache;
 
@@ -84,30 +139,64 @@ typedef struct {
     Vector2 chunkMax;         // Max chunk coordinates visible
 } Viewport;
 
-// Map layer for rendering
+// Map layers in draw order. Entities are drawn between decoration and
+// overhead.
+typedef enum {
+    MAP_LAYER_GROUND,          // Tile types
+    MAP_LAYER_DECORATION,      // Objects standing on the ground
+    MAP_LAYER_OVERHEAD,        // Tree canopies reaching over the tile above
+    MAP_LAYER_COLLISION,       // Blocked cells, a debug overlay hidden by default
+    MAP_LAYER_COUNT
+} MapLayerType;
+
+// One layer of a map with its own chunk textures. Edits redraw only the
+// dirty regions of a layer; animated layers also redraw their animated
+// tiles every refreshInterval seconds. Chunks with nothing on the layer
+// stay cached without a texture.
 typedef struct {
-    Texture2D background;
-    Texture2D foreground;
-    Texture2D objects;
+    ChunkCache cache;
+    bool isVisible;
+    float refreshInterval;     // 0 for static layers
+    float refreshTimer;
 } RenderLayer;
 
-// Collision grid for efficient collision detection
-typedef struct {
+// Walkability bitmap, one bit per cell with 1 meaning blocked. Rows are
+// padded to whole 64-bit words and the padding reads as blocked.
+typedef struct CollisionGrid {
     int width;
     int height;
     int cellSize;
-    bool* cells;
+    int stride;                     // Words per row
+    uint64_t* bits;
 } CollisionGrid;
 
+// Tile coordinate of a cell
+typedef struct CollisionCell {
+    int x;
+    int y;
+} CollisionCell;
+
+// Outcome of casting a thin ray through the grid
+typedef struct CollisionRayHit {
+    float time;                     // Fraction of the ray before the blocked cell, 1 when clear
+    CollisionCell cell;             // The blocked cell, valid when hit
+    bool hit;
+} CollisionRayHit;
+
 // Enhanced map structure
 typedef struct {
-    Tile* tiles;
+    TileGrid tiles;
     int width;
     int height;
-    ChunkCache cache;
+    RenderLayer layers[MAP_LAYER_COUNT];  // Each with its own chunk cache
     Viewport viewport;
     bool enableCulling;
-    TileProperties* properties;  // Array of properties for the map
+    struct MapFile* source;         // Open until every file chunk is decoded
+    uint8_t* decodedChunks;         // One flag per file chunk, row-major
+    int pendingChunks;
+    int prefetchCursor;             // Next file chunk for background decoding
+    uint8_t* unsavedChunks;         // One flag per file chunk edited since the last save
+    int unsavedCount;
 } TileMap;
 
 // Map system structure is defined in map_system.h
@@ -0,0 +1,134 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Forward declarations
+struct World;
+
+// Abstract graph configuration
+#define HPA_CHUNK_SIZE CACHE_CHUNK_SIZE
+#define HPA_MAX_CHUNK_NODES (4 * HPA_CHUNK_SIZE)
+#define HPA_ENTRANCE_SPLIT 6        // Entrances this wide get a transition at each end
+#define HPA_NO_PATH UINT16_MAX
+#define HPA_PATH_WINDOW 4           // Abstract waypoints an NPC carries at once
+
+// Tile coordinate
+typedef struct HPAPoint {
+    int x;
+    int y;
+} HPAPoint;
+
+// One CACHE_CHUNK_SIZE square of the map. Nodes are transition tiles on the
+// chunk border; costs holds precomputed in-chunk path lengths between them.
+typedef struct HPAChunk {
+    int nodeCount;
+    HPAPoint nodes[HPA_MAX_CHUNK_NODES];
+    int8_t nodeAt[HPA_CHUNK_SIZE * HPA_CHUNK_SIZE];               // Local tile -> node, -1 if none
+    uint16_t costs[HPA_MAX_CHUNK_NODES * HPA_MAX_CHUNK_NODES];    // HPA_NO_PATH when disconnected
+} HPAChunk;
+
+typedef struct HPASearchEntry {
+    int priority;
+    int node;
+} HPASearchEntry;
+
+// Hierarchical pathfinding graph over a world's tile grid
+typedef struct HPAGraph {
+    int width;                      // Map size in tiles
+    int height;
+    int chunksX;
+    int chunksY;
+    HPAChunk* chunks;
+
+    // Abstract search scratch, one slot per node plus start and goal
+    int nodeSlots;
+    uint32_t* visitStamp;
+    uint32_t searchStamp;
+    int* gScore;
+    int* parent;
+    HPASearchEntry* open;
+    int openCount;
+    int openCapacity;
+    uint16_t goalCosts[HPA_MAX_CHUNK_NODES];
+
+    // Tile-level search scratch covering two chunks side by side
+    int* regionDist;
+    int* regionParent;
+    int* regionQueue;
+} HPAGraph;
+
+// Per-agent path state. Holds a short window of abstract waypoints and
+// the next refined tile step, so refinement happens lazily while walking.
+typedef struct PathFollower {
+    bool active;
+    HPAPoint goal;
+    HPAPoint waypoints[HPA_PATH_WINDOW];
+    int waypointCount;
+    int waypointIndex;
+    HPAPoint stepFrom;              // Tile the cached step was refined from
+    HPAPoint step;
+    bool hasStep;
+} PathFollower;
+
+#define PATH_FOLLOWER_NONE 0           // Handles are slot + 1, so zeroed components hold none
+#define PATH_FOLLOWER_IDLE_TICKS 600   // Slots unused this long go to new owners
+
+typedef struct PathFollowerSlot {
+    PathFollower follower;
+    uint32_t owner;                 // Entity id
+    uint64_t lastUsed;              // World tick of the last lookup
+} PathFollowerSlot;
+
+// Path state for the agents that path, kept out of the entity components
+// so entities that never path do not carry it. AI components hold a
+// handle; a slot left idle for PATH_FOLLOWER_IDLE_TICKS goes to the next
+// new owner, and its old owner then starts over with a fresh follower.
+typedef struct PathFollowerTable {
+    PathFollowerSlot* slots;
+    int count;
+    int capacity;
+} PathFollowerTable;
+
+// Graph management
+HPAGraph* CreateHPAGraph(const struct World* world);
+void DestroyHPAGraph(HPAGraph* graph);
+HPAGraph* GetWorldPathGraph(struct World* world);   // Built on first use
+
+// Repairs the chunk holding the tile, plus any neighbor sharing the edited border
+void RepairHPATile(HPAGraph* graph, const struct World* world, int x, int y);
+void RepairHPAChunk(HPAGraph* graph, const struct World* world, int chunkX, int chunkY);
+
+// Abstract query. Writes up to maxPoints waypoints after the start, ending
+// with the goal when it fits. Returns the count written or -1 if unreachable.
+int FindHPAPath(HPAGraph* graph, const struct World* world, HPAPoint start, HPAPoint goal,
+                HPAPoint* waypoints, int maxPoints);
+
+// Tile-level step from one tile towards a waypoint in the same or an adjacent chunk
+bool RefineHPAStep(HPAGraph* graph, const struct World* world, HPAPoint from, HPAPoint to, HPAPoint* step);
+
+// Follower table management
+PathFollowerTable* CreatePathFollowerTable(void);
+void DestroyPathFollowerTable(PathFollowerTable* table);
+PathFollowerTable* GetWorldPathFollowers(struct World* world);   // Built on first use
+
+// The owner's follower, taking a slot and updating the handle when the
+// handle is unset or its slot went to another owner. NULL when out of memory.
+PathFollower* GetPathFollower(PathFollowerTable* table, int* handle, uint32_t owner, uint64_t tick);
+
+// Path following (positions are in world space, targets are tile origins)
+bool SetPathGoal(PathFollower* path, HPAGraph* graph, const struct World* world, Vector2 position, Vector2 goal);
+bool GetPathTarget(PathFollower* path, HPAGraph* graph, const struct World* world, Vector2 position, Vector2* target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PATHFINDING_H
@@ -0,0 +1,92 @@
+#ifndef PROPERTY_STORE_H
+#define PROPERTY_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROPERTY_SET_NONE 0             // Id of no properties at all
+#define PROPERTY_MAX_SETS 65535         // Ids are 16-bit, 0 is taken
+#define PROPERTY_KEY_NONE -1
+
+typedef enum PropertyType {
+    PROPERTY_NULL,
+    PROPERTY_BOOL,
+    PROPERTY_NUMBER,
+    PROPERTY_STRING
+} PropertyType;
+
+// One typed value. Strings are interned and live as long as the store.
+typedef struct PropertyValue {
+    PropertyType type;
+    union {
+        bool boolean;
+        double number;
+        const char* string;
+    };
+} PropertyValue;
+
+typedef struct PropertyRecord {
+    int key;                         // Interned key id
+    PropertyValue value;
+} PropertyRecord;
+
+// A distinct set of key/value records, shared by every tile that has it
+typedef struct PropertySet {
+    int first;                       // Into the store's records, sorted by key name
+    int count;
+    const char* json;                // Canonical text: keys sorted, no spaces
+} PropertySet;
+
+// Interned custom properties. Each JSON object is parsed once into typed
+// records, and objects with the same keys and values, however they were
+// written, share one set with one 16-bit id. Keys are interned too, so a
+// lookup is an index into the set list and a short scan of its records
+// comparing ids. Sets live until the store is destroyed.
+//
+// Only flat objects are taken: values are strings, numbers, true, false
+// or null.
+typedef struct PropertyStore {
+    PropertySet* sets;               // Indexed by id, entry 0 unused
+    int setCount;
+    int setCapacity;
+    uint16_t* setTable;              // Open addressing over canonical text, 0 is empty
+    int setTableCapacity;
+
+    PropertyRecord* records;
+    int recordCount;
+    int recordCapacity;
+
+    char** strings;                  // Interned keys, string values and set text
+    int stringCount;
+    int stringCapacity;
+    int* stringTable;                // Open addressing, -1 is empty
+    int stringTableCapacity;
+} PropertyStore;
+
+// Store management
+PropertyStore* CreatePropertyStore(void);
+void DestroyPropertyStore(PropertyStore* store);
+
+// Id of the set a JSON object parses to, adding the set when new.
+// PROPERTY_SET_NONE when the text is not a flat object or ids ran out.
+uint16_t InternPropertySet(PropertyStore* store, const char* json);
+
+// NULL for PROPERTY_SET_NONE and unknown ids
+const PropertySet* GetPropertySet(const PropertyStore* store, uint16_t id);
+
+// Id of a key, PROPERTY_KEY_NONE when no set has it. Look keys up once
+// and keep the id; the per-tile lookup then never touches the name.
+int FindPropertyKey(const PropertyStore* store, const char* key);
+
+// Value of a key in a set, NULL when the set does not have it
+const PropertyValue* GetPropertyValue(const PropertyStore* store, uint16_t id, int key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROPERTY_STORE_H
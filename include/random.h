@@ -0,0 +1,49 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Default seed for worlds created without an explicit one
+#define WORLD_DEFAULT_SEED 0x5348414457ULL
+
+// Stream purposes. Entity streams combine a purpose with the entity id;
+// world generation streams use a purpose alone.
+typedef enum RandomPurpose {
+    RANDOM_PURPOSE_AI_IDLE = 1,
+    RANDOM_PURPOSE_AI_PATROL,
+    RANDOM_PURPOSE_AI_TRANSITION,
+    RANDOM_PURPOSE_SPAWN,
+    RANDOM_PURPOSE_GEN_ROOMS,
+    RANDOM_PURPOSE_GEN_GARDENS,
+    RANDOM_PURPOSE_TILE_ANIMATION
+} RandomPurpose;
+
+// Counter-based random stream. Every value is a pure function of
+// (key, counter), so a stream can be rebuilt anywhere from the same
+// inputs and no state is shared between threads.
+typedef struct RandomStream {
+    uint64_t key;
+    uint64_t counter;
+} RandomStream;
+
+// Stateless mixer
+uint64_t HashRandom(uint64_t seed, uint64_t stream, uint64_t counter);
+
+// Stream creation
+RandomStream CreateRandomStream(uint64_t seed, uint64_t stream, uint64_t tick);
+RandomStream CreateEntityRandomStream(uint64_t seed, uint32_t entityId, RandomPurpose purpose, uint64_t tick);
+
+// Draws
+uint32_t NextRandom(RandomStream* rng);
+float NextRandomFloat(RandomStream* rng);                 // [0, 1)
+int NextRandomInt(RandomStream* rng, int min, int max);   // [min, max], like GetRandomValue
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RANDOM_H
@@ -0,0 +1,57 @@
+#ifndef REGION_MAP_H
+#define REGION_MAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Forward declarations
+struct World;
+
+#define REGION_NONE UINT32_MAX
+
+// Connected regions of walkable tiles, four-connected like the path search.
+// Each tile carries a region id and ids that have been joined share a
+// union-find root, so "can A reach B" is two lookups and a compare.
+// Opening a tile joins the regions around it; blocking one relabels only
+// the side cut off, found by searching out from its neighbors together
+// and stopping once one side is left.
+typedef struct RegionMap {
+    int width;
+    int height;
+    uint32_t* labels;               // Region id per tile, REGION_NONE when blocked
+    uint32_t* parent;               // Union-find forest over region ids
+    uint32_t regionCount;           // Ids handed out since the last rebuild
+    uint32_t regionCapacity;
+
+    // Split search scratch
+    uint32_t* visit;                // Search stamp << 2 | front per tile
+    uint32_t stamp;
+    int* queue;
+    int queueCapacity;
+} RegionMap;
+
+// Map management. A new map has every tile blocked.
+RegionMap* CreateRegionMap(int width, int height);
+void DestroyRegionMap(RegionMap* regions);
+struct RegionMap* GetWorldRegions(struct World* world);   // Built on first use, NULL for streamed worlds
+
+// Relabels every tile from a collision bitmap of the same size
+void RebuildRegionMap(RegionMap* regions, const CollisionGrid* grid);
+
+// Applies one tile edit. No-op when walkability did not change.
+void UpdateRegionTile(RegionMap* regions, int x, int y, bool walkable);
+
+// Root region of a tile, REGION_NONE when blocked or out of bounds
+uint32_t GetTileRegion(RegionMap* regions, int x, int y);
+bool AreTilesConnected(RegionMap* regions, int ax, int ay, int bx, int by);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REGION_MAP_H
@@ -0,0 +1,81 @@
+#ifndef RESONANCE_FIELD_H
+#define RESONANCE_FIELD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Forward declarations
+struct World;
+
+#define RESONANCE_MAX_RADIUS 8      // Farthest any emitter reaches, in tiles
+
+// An object that radiates resonance, and light with it
+typedef struct ResonanceEmitter {
+    int x;
+    int y;
+    float strength;                  // Level on the emitter's own tile, 0 to 1
+    int radius;                      // Steps until the level reaches 0
+} ResonanceEmitter;
+
+// Field values of one cache chunk, ready to hand to the GPU
+typedef struct ResonanceChunk {
+    uint8_t values[CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE];  // Level per tile, 255 is 1
+    uint32_t version;                // Bumped on every recompute
+    bool isDirty;
+} ResonanceChunk;
+
+// Resonance spread from fountains and torches. Each emitter floods out
+// over walkable tiles, four-connected like the path search, fading
+// linearly with the steps taken; blocked tiles are reached but pass
+// nothing on. Overlapping emitters take the brightest. An edit only
+// marks the chunks its emitters reach, and those alone are recomputed.
+typedef struct ResonanceField {
+    int width;
+    int height;
+    int chunksX;
+    int chunksY;
+    ResonanceChunk* chunks;          // chunksX * chunksY, row-major
+    uint8_t* open;                   // Walkability per tile, as last seen
+    int* dirtyChunks;                // Indices of chunks awaiting recompute
+    int dirtyCount;
+
+    ResonanceEmitter* emitters;
+    int emitterCount;
+    int emitterCapacity;
+
+    // Flood scratch, one emitter's reach
+    int* distance;
+    int* queue;
+} ResonanceField;
+
+// Field management. A new field has no emitters and every tile open.
+ResonanceField* CreateResonanceField(int width, int height);
+void DestroyResonanceField(ResonanceField* field);
+struct ResonanceField* GetWorldResonance(struct World* world);   // Built on first use, NULL for streamed worlds
+
+// Takes emitters from the object plane and walkability from a collision
+// grid of the same size, then marks every chunk for recompute
+void RebuildResonanceField(ResonanceField* field, const TileGrid* tiles, const CollisionGrid* grid);
+
+// Applies one tile edit, marking only the chunks whose levels it can change
+void UpdateResonanceTile(ResonanceField* field, int x, int y, ObjectType object, bool walkable);
+
+// Recomputes marked chunks, returning how many there were
+int UpdateResonanceField(ResonanceField* field);
+
+// Level of a tile from 0 to 1, 0 outside the map
+float GetResonanceLevel(const ResonanceField* field, int x, int y);
+
+// Chunk values, NULL outside the map
+const ResonanceChunk* GetResonanceChunk(const ResonanceField* field, int chunkX, int chunkY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RESONANCE_FIELD_H
@@ -0,0 +1,42 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Uniform grid over a fixed world rectangle. Items are binned with a
+// counting sort each rebuild, so every cell's items sit contiguously in
+// cellItems[cellStart[c] .. cellStart[c + 1]) in ascending item order.
+typedef struct SpatialGrid {
+    Rectangle bounds;       // World-space area covered by the grid
+    float cellSize;
+    float invCellSize;
+    int columns;
+    int rows;
+    int* cellStart;         // columns * rows + 1 prefix offsets
+    int* cellCursor;        // Scatter scratch, one per cell
+    int* cellItems;         // Item indices grouped by cell
+    int* itemCells;         // Cell index of each item
+    int itemCount;
+    int itemCapacity;
+} SpatialGrid;
+
+// Grid management
+SpatialGrid* CreateSpatialGrid(Rectangle bounds, float cellSize);
+void DestroySpatialGrid(SpatialGrid* grid);
+bool BuildSpatialGrid(SpatialGrid* grid, const Vector2* positions, int count);
+
+// Cell lookup (positions outside the bounds clamp to the border cells)
+int GetSpatialGridCellX(const SpatialGrid* grid, float x);
+int GetSpatialGridCellY(const SpatialGrid* grid, float y);
+int GetSpatialGridCellCount(const SpatialGrid* grid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,63 @@
+#ifndef TILE_GRID_H
+#define TILE_GRID_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "map_types.h"
+#include "property_store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Grid management. Every tile starts as fill with no object.
+bool InitTileGrid(TileGrid* grid, size_t count, TileType fill);
+void FreeTileGrid(TileGrid* grid);
+void FillTileGrid(TileGrid* grid, TileType fill);
+
+// Shared per-type properties
+const TileProperties* GetTileProperties(TileType type);
+
+// Packed tile access, index is y * width + x and must be in range
+static inline TileType GetGridTileType(const TileGrid* grid, size_t index) {
+    return (TileType)grid->types[index];
+}
+
+static inline ObjectType GetGridObjectType(const TileGrid* grid, size_t index) {
+    return (ObjectType)grid->objects[index];
+}
+
+static inline Tile GetGridTile(const TileGrid* grid, size_t index) {
+    return CreateTile(GetGridTileType(grid, index), GetGridObjectType(grid, index));
+}
+
+static inline void SetGridTile(TileGrid* grid, size_t index, Tile tile) {
+    grid->types[index] = (uint8_t)tile.type;
+    grid->objects[index] = (uint8_t)tile.objectType;
+}
+
+// Sparse per-tile custom properties. The JSON object is parsed and interned
+// in the grid's property store, so tiles with the same properties share
+// one set; text that is not a flat object is refused. Passing NULL removes
+// the override. Get returns the set's canonical text.
+bool SetTileOverride(TileGrid* grid, int index, const char* customProperties);
+const char* GetTileOverride(const TileGrid* grid, int index);
+
+// The same by set id, PROPERTY_SET_NONE for none. Ids belong to the grid's
+// store and mean nothing in another grid.
+bool SetTilePropertySet(TileGrid* grid, int index, uint16_t propertySet);
+uint16_t GetTilePropertySet(const TileGrid* grid, int index);
+
+// One property of a tile, NULL when it has none by that key. Find the key
+// id once with FindPropertyKey(grid->propertyStore, name).
+const PropertyValue* GetTileProperty(const TileGrid* grid, int index, int key);
+
+// Position in grid->overrides of the first override at or after index, so
+// a range of tiles can walk just its own overrides
+int FindTileOverrideSlot(const TileGrid* grid, int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TILE_GRID_H
@@ -0,0 +1,49 @@
+#ifndef TILE_LOD_H
+#define TILE_LOD_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+#include "tile_mesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Level 0 is full detail. Level n draws a square of 2^n by 2^n chunks as
+// one texture the size of a single chunk, so each tile gets tileSize >> n
+// pixels.
+#define TILE_LOD_LEVELS 3
+#define TILE_LOD_MAX_TILES (CACHE_CHUNK_SIZE << (TILE_LOD_LEVELS - 1))  // Group edge in tiles at the coarsest level
+
+// The tileset's cells box-filtered down once per reduced level, in the
+// same ground-row, object-row order as the atlas
+typedef struct TileLodAtlas {
+    Color* cells[TILE_LOD_LEVELS];   // [0] unused, the tileset itself is level 0
+    int columns;
+    int tileSize;
+} TileLodAtlas;
+
+// Reduces an RGBA tileset laid out as layout describes. Colour is
+// averaged weighted by alpha, so transparent object pixels do not darken
+// the edges they blend into. False when out of memory or when the tile
+// size does not halve evenly down to the last level.
+bool BuildTileLodAtlas(TileLodAtlas* atlas, const Color* pixels, TileAtlasLayout layout);
+void FreeTileLodAtlas(TileLodAtlas* atlas);
+
+// Paints a width x height window of packed tile planes, rows stride bytes
+// apart, into an RGBA image of CACHE_CHUNK_SIZE * tileSize pixels square.
+// Objects are blended over their ground; empty and missing tiles are left
+// transparent.
+void ComposeTileLod(Color* pixels, const TileLodAtlas* atlas, int level, const uint8_t* types,
+                    const uint8_t* objects, int stride, int width, int height);
+
+// Coarsest level whose texels are no larger than a screen pixel
+int SelectTileLodLevel(float zoom);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TILE_LOD_H
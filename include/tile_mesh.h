@@ -0,0 +1,50 @@
+#ifndef TILE_MESH_H
+#define TILE_MESH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TILE_MESH_MAX_QUADS (CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE * 2)  // A ground and an object quad per tile
+
+// Where images sit in the tileset: ground tiles along the first row
+// indexed by TileType, objects along the second indexed by ObjectType
+typedef struct TileAtlasLayout {
+    int tileSize;
+    int textureWidth;
+    int textureHeight;
+} TileAtlasLayout;
+
+// CPU-side chunk geometry in the layout raylib's Mesh expects. Four
+// vertices and two triangles per quad, positions relative to the chunk.
+typedef struct TileMeshData {
+    float* vertices;                 // x, y, z per vertex, z is 0
+    float* texcoords;                // u, v per vertex
+    float* texcoords2;               // u is the tile's resonance from 0 to 1, v is 0
+    unsigned short* indices;         // 6 per quad
+    int quadCount;
+} TileMeshData;
+
+// Buffers sized for TILE_MESH_MAX_QUADS
+bool InitTileMeshData(TileMeshData* mesh);
+void FreeTileMeshData(TileMeshData* mesh);
+
+// Builds the quads of a width x height window of packed tile planes whose
+// rows are stride bytes apart. TILE_NONE ground and OBJECT_NONE objects
+// produce no quad. Returns the quad count, at most TILE_MESH_MAX_QUADS.
+int BuildTileMesh(TileMeshData* mesh, const uint8_t* types, const uint8_t* objects, int stride,
+                  int width, int height, TileAtlasLayout layout);
+
+// Fills the second texture coordinates of a built mesh from per-tile
+// levels (255 is 1) laid out like the tile planes, for resonance.vs
+void SetTileMeshResonance(TileMeshData* mesh, const uint8_t* levels, int stride, int tileSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TILE_MESH_H
@@ -3,6 +3,7 @@
 
 #include <raylib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "entity_types.h"
 #include "map_types.h"
 #include "constants.h"
@@ -12,6 +13,13 @@ struct EntityPool;
 struct ComponentRegistry;
 struct MapSystem;
 struct ResourceManager;
+struct CrowdSystem;
+struct PerceptionSystem;
+struct HPAGraph;
+struct AnimationSystem;
+struct MovementSystem;
+struct WorldStream;
+struct ChunkRenderer;
 
 #define MAX_SPAWN_POINTS 16
 
@@ -35,10 +43,23 @@ typedef struct World {
     struct TileProperties* tileProperties;
     Camera2D camera;
     WorldTextures textures;
-    Tile* tiles;
+    TileGrid tiles;                // Packed tile and object planes
+    CollisionGrid* collision;      // Blocked-cell bitmap of tiles, see RebuildWorldCollision
     struct ResourceManager* resourceManager;
     struct EntityPool* entityPool;
     struct MapSystem* mapSystem;
+    struct CrowdSystem* crowd;
+    struct PerceptionSystem* perception;
+    struct HPAGraph* pathGraph;      // Built lazily by GetWorldPathGraph
+    struct PathFollowerTable* paths; // NPC routes, built lazily by GetWorldPathFollowers
+    struct RegionMap* regions;       // Walkable regions, built lazily by GetWorldRegions
+    struct ResonanceField* resonance; // Resonance per chunk, built lazily by GetWorldResonance
+    struct AnimationSystem* animation;
+    struct MovementSystem* movement;
+    struct WorldStream* stream;    // Chunked tile store, NULL for fixed-size maps
+    struct ChunkRenderer* renderer; // Per-chunk tile meshes, rebuilt on tile edits
+    uint64_t seed;                 // Root of every deterministic random stream
+    uint64_t tick;                 // Simulation steps since creation
 } World;
 
 // World state structure
@@ -81,13 +102,27 @@ void LoadMapSystem(struct MapSystem* mapSystem, const char* filename);
 
 // Tile management
 void SetTile(World* world, int x, int y, TileType tileType);
+void OnTileChanged(World* world, int x, int y);
+bool RebuildWorldCollision(World* world);  // After bulk writes that bypass SetTile
 TileType GetTile(World* world, int x, int y);
 bool IsWalkable(const World* world, Vector2 position);
 bool IsWalkableGrid(const World* world, int x, int y);
 
+// Batched queries over world-space positions, one call per frame's worth
+// of probes. See TestCollisionPoints, FindBlockedCells and
+// CastCollisionRays; worlds without a collision grid fall back to tile
+// lookups, with rays walking the same cells.
+int AreWalkable(const World* world, const Vector2* positions, int count, bool* walkable);
+int FindBlockingTiles(const World* world, Rectangle area, CollisionCell* tiles, int maxTiles);
+void CastWorldRays(const World* world, const Vector2* origins, const Vector2* motions, int count, CollisionRayHit* hits);
+
+// Streams tiles from chunk files under directory instead of the fixed grid.
+// Tiles are then addressable at any coordinate near the camera or player.
+bool EnableWorldStreaming(World* world, const char* directory);
+
 // Spawn point management
 void AddSpawnPoint(World* world, Vector2 position);
-Vector2 GetRandomSpawnPoint(World* world);
+Vector2 GetRandomSpawnPoint(World* world, uint32_t spawnIndex);
 
 // Debug functions
 void DrawWorldDebug(World* world);
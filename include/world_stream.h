@@ -0,0 +1,69 @@
+#ifndef WORLD_STREAM_H
+#define WORLD_STREAM_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "chunk_io.h"
+#include "map_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_DEFAULT_RADIUS 2          // Chunks kept loaded around each focus point
+#define STREAM_UNLOAD_MARGIN 1           // Extra ring kept before eviction, stops thrashing at borders
+#define STREAM_DEFAULT_MAX_CHUNKS 128    // Resident plus in-flight loads
+#define STREAM_MAX_FOCUS 4
+
+// Table entry, keyed by chunk coordinates
+typedef struct StreamEntry {
+    int chunkX;
+    int chunkY;
+    StreamChunk* chunk;                  // NULL while the load is in flight
+    uint32_t generation;                 // Tag of the load it waits for
+} StreamEntry;
+
+// Sparse chunk table for an unbounded world. Only chunks near a focus
+// point stay resident; the rest live on disk.
+typedef struct WorldStream {
+    ChunkIO* io;
+    StreamEntry* entries;                // Dense, swap-removed
+    int entryCount;
+    int maxChunks;
+    int* slots;                          // Open-addressed index into entries
+    int slotMask;
+    int radius;
+    uint32_t nextGeneration;             // Tag for the next load, never reused
+} WorldStream;
+
+// Stream management. A NULL generate fills new chunks with grass.
+// Destroying saves every dirty chunk before the I/O thread exits.
+WorldStream* CreateWorldStream(const char* directory, int radius, int maxChunks,
+                               ChunkGenerateFunc generate, void* context);
+void DestroyWorldStream(WorldStream* stream);
+
+// Residency. Focus points are world positions in pixels (camera target,
+// player). Installs finished loads, evicts far chunks and queues new ones.
+void UpdateWorldStream(WorldStream* stream, const Vector2* focus, int focusCount);
+
+// Blocks until queued loads finish and installs them
+void FlushWorldStream(WorldStream* stream);
+
+// Queues a save of every dirty resident chunk
+void SaveWorldStream(WorldStream* stream);
+
+// Chunk access, NULL when the chunk is not resident
+StreamChunk* GetStreamChunk(const WorldStream* stream, int chunkX, int chunkY);
+int GetResidentChunkCount(const WorldStream* stream);
+
+// Tile access in world tile coordinates, which may be negative. Reads of
+// non-resident tiles return TILE_NONE; writes to them are dropped.
+bool IsStreamTileResident(const WorldStream* stream, int x, int y);
+Tile GetStreamTile(const WorldStream* stream, int x, int y);
+bool SetStreamTile(WorldStream* stream, int x, int y, Tile tile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORLD_STREAM_H
@@ -0,0 +1,228 @@
+#include "../../include/animated_tiles.h"
+#include "../../include/random.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ANIMATED_SLOT_EMPTY -1
+#define ANIMATED_INITIAL_SLOTS 64
+#define ANIMATED_TWO_PI 6.28318530718
+
+// Unit value in [0, 1) from the top 24 bits of a hash
+static float HashToUnit(uint64_t hash) {
+    return (float)(hash >> 40) * (1.0f / 16777216.0f);
+}
+
+bool InitAnimatedTileIndex(AnimatedTileIndex* index) {
+    if (!index) return false;
+
+    memset(index, 0, sizeof(AnimatedTileIndex));
+    index->slots = (int*)malloc(ANIMATED_INITIAL_SLOTS * sizeof(int));
+    if (!index->slots) return false;
+
+    for (int i = 0; i < ANIMATED_INITIAL_SLOTS; i++) index->slots[i] = ANIMATED_SLOT_EMPTY;
+    index->slotMask = ANIMATED_INITIAL_SLOTS - 1;
+    return true;
+}
+
+void FreeAnimatedTileIndex(AnimatedTileIndex* index) {
+    if (!index) return;
+
+    for (int i = 0; i < index->chunkCount; i++) {
+        AnimatedChunk* chunk = &index->chunks[i];
+        free(chunk->tiles);
+        free(chunk->types);
+        free(chunk->resonance);
+    }
+    free(index->chunks);
+    free(index->slots);
+    memset(index, 0, sizeof(AnimatedTileIndex));
+}
+
+void ClearAnimatedTileIndex(AnimatedTileIndex* index) {
+    if (!index) return;
+
+    // Buckets keep their storage for the next fill
+    for (int i = 0; i < index->chunkCount; i++) {
+        index->chunks[i].count = 0;
+    }
+    index->count = 0;
+}
+
+AnimatedChunk* FindAnimatedChunk(const AnimatedTileIndex* index, int chunkX, int chunkY) {
+    if (!index || !index->slots) return NULL;
+
+    int slot = (int)(HashChunkKey(chunkX, chunkY) & (uint32_t)index->slotMask);
+    while (index->slots[slot] != ANIMATED_SLOT_EMPTY) {
+        AnimatedChunk* chunk = &index->chunks[index->slots[slot]];
+        if (chunk->chunkX == chunkX && chunk->chunkY == chunkY) return chunk;
+        slot = (slot + 1) & index->slotMask;
+    }
+    return NULL;
+}
+
+static void InsertSlot(AnimatedTileIndex* index, int bucket) {
+    const AnimatedChunk* chunk = &index->chunks[bucket];
+    int slot = (int)(HashChunkKey(chunk->chunkX, chunk->chunkY) & (uint32_t)index->slotMask);
+    while (index->slots[slot] != ANIMATED_SLOT_EMPTY) {
+        slot = (slot + 1) & index->slotMask;
+    }
+    index->slots[slot] = bucket;
+}
+
+// Doubles the hash table, keeping it at most half full
+static bool GrowSlots(AnimatedTileIndex* index) {
+    int slotCount = (index->slotMask + 1) * 2;
+    int* slots = (int*)malloc((size_t)slotCount * sizeof(int));
+    if (!slots) return false;
+
+    free(index->slots);
+    index->slots = slots;
+    index->slotMask = slotCount - 1;
+    for (int i = 0; i < slotCount; i++) index->slots[i] = ANIMATED_SLOT_EMPTY;
+    for (int i = 0; i < index->chunkCount; i++) InsertSlot(index, i);
+    return true;
+}
+
+static AnimatedChunk* GetOrCreateAnimatedChunk(AnimatedTileIndex* index, int chunkX, int chunkY) {
+    AnimatedChunk* existing = FindAnimatedChunk(index, chunkX, chunkY);
+    if (existing) return existing;
+
+    if ((index->chunkCount + 1) * 2 > index->slotMask + 1 && !GrowSlots(index)) return NULL;
+
+    if (index->chunkCount == index->chunkCapacity) {
+        int capacity = index->chunkCapacity > 0 ? index->chunkCapacity * 2 : 16;
+        AnimatedChunk* chunks = (AnimatedChunk*)realloc(index->chunks, (size_t)capacity * sizeof(AnimatedChunk));
+        if (!chunks) return NULL;
+        index->chunks = chunks;
+        index->chunkCapacity = capacity;
+    }
+
+    AnimatedChunk* chunk = &index->chunks[index->chunkCount];
+    memset(chunk, 0, sizeof(AnimatedChunk));
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    InsertSlot(index, index->chunkCount++);
+    return chunk;
+}
+
+static bool ReserveAnimatedEntries(AnimatedChunk* chunk, int capacity) {
+    if (capacity <= chunk->capacity) return true;
+
+    uint16_t* tiles = (uint16_t*)realloc(chunk->tiles, (size_t)capacity * sizeof(uint16_t));
+    if (!tiles) return false;
+    chunk->tiles = tiles;
+
+    uint8_t* types = (uint8_t*)realloc(chunk->types, (size_t)capacity * sizeof(uint8_t));
+    if (!types) return false;
+    chunk->types = types;
+
+    float* resonance = (float*)realloc(chunk->resonance, (size_t)capacity * sizeof(float));
+    if (!resonance) return false;
+    chunk->resonance = resonance;
+
+    chunk->capacity = capacity;
+    return true;
+}
+
+static int FindAnimatedEntry(const AnimatedChunk* chunk, uint16_t tile) {
+    for (int i = 0; i < chunk->count; i++) {
+        if (chunk->tiles[i] == tile) return i;
+    }
+    return -1;
+}
+
+bool SetAnimatedTile(AnimatedTileIndex* index, int tileX, int tileY, ObjectType type) {
+    if (!index || !index->slots) return false;
+
+    int chunkX = FloorDiv(tileX, CACHE_CHUNK_SIZE);
+    int chunkY = FloorDiv(tileY, CACHE_CHUNK_SIZE);
+    uint16_t tile = (uint16_t)((tileY - chunkY * CACHE_CHUNK_SIZE) * CACHE_CHUNK_SIZE +
+                               (tileX - chunkX * CACHE_CHUNK_SIZE));
+
+    if (!IsObjectAnimated(type)) {
+        AnimatedChunk* chunk = FindAnimatedChunk(index, chunkX, chunkY);
+        int entry = chunk ? FindAnimatedEntry(chunk, tile) : -1;
+        if (entry < 0) return true;
+
+        // Swap-remove, order within a bucket does not matter
+        int last = --chunk->count;
+        chunk->tiles[entry] = chunk->tiles[last];
+        chunk->types[entry] = chunk->types[last];
+        chunk->resonance[entry] = chunk->resonance[last];
+        index->count--;
+        return true;
+    }
+
+    AnimatedChunk* chunk = GetOrCreateAnimatedChunk(index, chunkX, chunkY);
+    if (!chunk) return false;
+
+    int entry = FindAnimatedEntry(chunk, tile);
+    if (entry < 0) {
+        if (chunk->count == chunk->capacity &&
+            !ReserveAnimatedEntries(chunk, chunk->capacity > 0 ? chunk->capacity * 2 : 4)) {
+            return false;
+        }
+        entry = chunk->count++;
+        chunk->tiles[entry] = tile;
+        chunk->resonance[entry] = 0.0f;
+        index->count++;
+    }
+    chunk->types[entry] = (uint8_t)type;
+    return true;
+}
+
+bool RebuildAnimatedTileIndex(AnimatedTileIndex* index, const TileGrid* tiles, int width, int height) {
+    if (!index || !tiles || !tiles->objects) return false;
+    if (tiles->count < (size_t)width * (size_t)height) return false;
+
+    ClearAnimatedTileIndex(index);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* objects = &tiles->objects[(size_t)y * width];
+        for (int x = 0; x < width; x++) {
+            if (IsObjectAnimated((ObjectType)objects[x]) &&
+                !SetAnimatedTile(index, x, y, (ObjectType)objects[x])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void TickAnimatedChunk(AnimatedChunk* chunk, double time) {
+    if (!chunk) return;
+
+    // Shared per-tick terms, wrapped in double so long sessions keep precision
+    float angle = (float)fmod(time * 2.0, ANIMATED_TWO_PI);
+    uint64_t flickerFrame = (uint64_t)(time * ANIMATED_TILE_FLICKER_RATE);
+    int originX = chunk->chunkX * CACHE_CHUNK_SIZE;
+    int originY = chunk->chunkY * CACHE_CHUNK_SIZE;
+
+    for (int i = 0; i < chunk->count; i++) {
+        int tileX = originX + chunk->tiles[i] % CACHE_CHUNK_SIZE;
+        int tileY = originY + chunk->tiles[i] / CACHE_CHUNK_SIZE;
+        uint64_t key = (uint64_t)(uint32_t)tileX << 32 | (uint32_t)tileY;
+
+        if (chunk->types[i] == OBJECT_FOUNTAIN) {
+            // Each fountain keeps its own phase so they do not pulse in step
+            float phase = HashToUnit(HashRandom(key, RANDOM_PURPOSE_TILE_ANIMATION, 0)) * (float)ANIMATED_TWO_PI;
+            chunk->resonance[i] = sinf(angle + phase) * 0.5f + 0.5f;
+        } else {
+            // Torches hold a random level in [0.8, 1] for each flicker frame
+            float level = HashToUnit(HashRandom(key, RANDOM_PURPOSE_TILE_ANIMATION, flickerFrame + 1));
+            chunk->resonance[i] = 0.8f + 0.2f * level;
+        }
+    }
+}
+
+float GetAnimatedTileResonance(const AnimatedTileIndex* index, int tileX, int tileY) {
+    int chunkX = FloorDiv(tileX, CACHE_CHUNK_SIZE);
+    int chunkY = FloorDiv(tileY, CACHE_CHUNK_SIZE);
+    const AnimatedChunk* chunk = FindAnimatedChunk(index, chunkX, chunkY);
+    if (!chunk) return 0.0f;
+
+    uint16_t tile = (uint16_t)((tileY - chunkY * CACHE_CHUNK_SIZE) * CACHE_CHUNK_SIZE +
+                               (tileX - chunkX * CACHE_CHUNK_SIZE));
+    int entry = FindAnimatedEntry(chunk, tile);
+    return entry >= 0 ? chunk->resonance[entry] : 0.0f;
+}
@@ -0,0 +1,178 @@
+#include "../../include/animation.h"
+#include "../../include/entity_types.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <raylib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+END_EXTERNAL_WARNINGS
+
+#define ANIMATION_LINE_LENGTH 256
+
+static AnimationLibrary* g_animationLibrary = NULL;
+
+AnimationLibrary* CreateAnimationLibrary(void) {
+    return (AnimationLibrary*)calloc(1, sizeof(AnimationLibrary));
+}
+
+void DestroyAnimationLibrary(AnimationLibrary* library) {
+    free(library);
+}
+
+// Fallback clips matching the stock sprite sheets
+static void AddDefaultAnimationClips(AnimationLibrary* library) {
+    Rectangle firstFrame = { 0.0f, 0.0f, (float)NPC_WIDTH, (float)NPC_HEIGHT };
+    AddAnimationStrip(library, "npc_idle", firstFrame, 1, 1.0f, true);
+    AddAnimationStrip(library, "npc_walk", firstFrame, 4, ANIMATION_FRAME_TIME, true);
+}
+
+AnimationLibrary* GetAnimationLibrary(void) {
+    if (!g_animationLibrary) {
+        g_animationLibrary = CreateAnimationLibrary();
+        if (g_animationLibrary && !LoadAnimationClips(g_animationLibrary, ANIMATION_METADATA_PATH)) {
+            TraceLog(LOG_WARNING, "Using built-in animation clips, failed to load %s", ANIMATION_METADATA_PATH);
+            AddDefaultAnimationClips(g_animationLibrary);
+        }
+    }
+    return g_animationLibrary;
+}
+
+void UnloadAnimationLibrary(void) {
+    DestroyAnimationLibrary(g_animationLibrary);
+    g_animationLibrary = NULL;
+}
+
+int AddAnimationClip(AnimationLibrary* library, const char* name, const AnimationFrame* frames, int frameCount, bool loop) {
+    if (!library || !name || !frames || frameCount <= 0) return ANIMATION_NO_CLIP;
+    if (library->clipCount >= MAX_ANIMATION_CLIPS) return ANIMATION_NO_CLIP;
+    if (library->frameCount + frameCount > MAX_ANIMATION_FRAMES) return ANIMATION_NO_CLIP;
+    if (FindAnimationClip(library, name) != ANIMATION_NO_CLIP) return ANIMATION_NO_CLIP;
+
+    // Zero-length frames would stall the animator's catch-up loop
+    float totalDuration = 0.0f;
+    for (int i = 0; i < frameCount; i++) {
+        if (frames[i].duration <= 0.0f) return ANIMATION_NO_CLIP;
+        totalDuration += frames[i].duration;
+    }
+
+    int index = library->clipCount++;
+    AnimationClip* clip = &library->clips[index];
+    strncpy(clip->name, name, ANIMATION_CLIP_NAME_LENGTH - 1);
+    clip->name[ANIMATION_CLIP_NAME_LENGTH - 1] = '\0';
+    clip->firstFrame = library->frameCount;
+    clip->frameCount = frameCount;
+    clip->totalDuration = totalDuration;
+    clip->loop = loop;
+
+    memcpy(&library->frames[library->frameCount], frames, (size_t)frameCount * sizeof(AnimationFrame));
+    library->frameCount += frameCount;
+    return index;
+}
+
+int AddAnimationStrip(AnimationLibrary* library, const char* name, Rectangle firstFrame, int frameCount, float frameDuration, bool loop) {
+    if (frameCount <= 0 || frameCount > MAX_CLIP_FRAMES) return ANIMATION_NO_CLIP;
+
+    AnimationFrame frames[MAX_CLIP_FRAMES];
+    for (int i = 0; i < frameCount; i++) {
+        frames[i].source = firstFrame;
+        frames[i].source.x += (float)i * firstFrame.width;
+        frames[i].duration = frameDuration;
+    }
+    return AddAnimationClip(library, name, frames, frameCount, loop);
+}
+
+int FindAnimationClip(const AnimationLibrary* library, const char* name) {
+    if (!library || !name) return ANIMATION_NO_CLIP;
+
+    for (int i = 0; i < library->clipCount; i++) {
+        if (strncmp(library->clips[i].name, name, ANIMATION_CLIP_NAME_LENGTH) == 0) return i;
+    }
+    return ANIMATION_NO_CLIP;
+}
+
+const AnimationClip* GetAnimationClip(const AnimationLibrary* library, int clip) {
+    if (!library || clip < 0 || clip >= library->clipCount) return NULL;
+    return &library->clips[clip];
+}
+
+// Metadata parsing
+
+typedef struct PendingClip {
+    char name[ANIMATION_CLIP_NAME_LENGTH];
+    bool loop;
+    bool open;
+    AnimationFrame frames[MAX_CLIP_FRAMES];
+    int frameCount;
+} PendingClip;
+
+static bool FlushPendingClip(AnimationLibrary* library, PendingClip* pending) {
+    if (!pending->open) return true;
+
+    pending->open = false;
+    return AddAnimationClip(library, pending->name, pending->frames, pending->frameCount, pending->loop) != ANIMATION_NO_CLIP;
+}
+
+static bool AddPendingFrame(PendingClip* pending, Rectangle source, float duration) {
+    if (!pending->open || pending->frameCount >= MAX_CLIP_FRAMES) return false;
+
+    pending->frames[pending->frameCount++] = (AnimationFrame){ source, duration };
+    return true;
+}
+
+bool LoadAnimationClips(AnimationLibrary* library, const char* path) {
+    if (!library || !path) return false;
+
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    PendingClip pending = { 0 };
+    char line[ANIMATION_LINE_LENGTH];
+    int lineNumber = 0;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+
+        char keyword[16];
+        if (sscanf(line, "%15s", keyword) != 1 || keyword[0] == '#') continue;
+
+        if (strcmp(keyword, "clip") == 0) {
+            char name[ANIMATION_CLIP_NAME_LENGTH];
+            char mode[16] = "loop";
+            ok = FlushPendingClip(library, &pending) && sscanf(line, "%*s %31s %15s", name, mode) >= 1;
+            if (ok) {
+                memcpy(pending.name, name, sizeof(name));
+                pending.loop = strcmp(mode, "once") != 0;
+                pending.open = true;
+                pending.frameCount = 0;
+            }
+        } else if (strcmp(keyword, "frame") == 0) {
+            Rectangle source;
+            float duration;
+            ok = sscanf(line, "%*s %f %f %f %f %f", &source.x, &source.y, &source.width, &source.height, &duration) == 5 &&
+                 AddPendingFrame(&pending, source, duration);
+        } else if (strcmp(keyword, "strip") == 0) {
+            Rectangle source;
+            int count;
+            float duration;
+            ok = sscanf(line, "%*s %f %f %f %f %d %f", &source.x, &source.y, &source.width, &source.height, &count, &duration) == 6;
+            for (int i = 0; ok && i < count; i++) {
+                ok = AddPendingFrame(&pending, source, duration);
+                source.x += source.width;
+            }
+        } else {
+            ok = false;
+        }
+    }
+
+    if (ok) ok = FlushPendingClip(library, &pending);
+    if (!ok) TraceLog(LOG_WARNING, "Invalid animation metadata in %s at line %d", path, lineNumber);
+
+    fclose(file);
+    return ok;
+}
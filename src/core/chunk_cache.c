@@ -0,0 +1,334 @@
+#include "../../include/chunk_cache.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHUNK_SLOT_EMPTY -1
+
+static int HomeSlot(const ChunkCache* cache, const CachedChunk* chunk) {
+    return (int)(HashChunkKey(chunk->chunkX, chunk->chunkY) & (uint32_t)cache->slotMask);
+}
+
+bool InitChunkCache(ChunkCache* cache, int capacity) {
+    if (!cache) return false;
+    if (capacity <= 0) capacity = DEFAULT_CHUNK_CACHE_SIZE;
+
+    // Keep the table at most half full so probe runs stay short
+    int slotCount = 1;
+    while (slotCount < capacity * 2) slotCount <<= 1;
+
+    memset(cache, 0, sizeof(ChunkCache));
+    cache->chunks = (CachedChunk*)calloc((size_t)capacity, sizeof(CachedChunk));
+    cache->slots = (int*)malloc((size_t)slotCount * sizeof(int));
+    if (!cache->chunks || !cache->slots) {
+        FreeChunkCache(cache);
+        return false;
+    }
+
+    for (int i = 0; i < slotCount; i++) cache->slots[i] = CHUNK_SLOT_EMPTY;
+    cache->capacity = capacity;
+    cache->slotMask = slotCount - 1;
+    cache->lruHead = -1;
+    cache->lruTail = -1;
+    return true;
+}
+
+void FreeChunkCache(ChunkCache* cache) {
+    if (!cache) return;
+
+    free(cache->chunks);
+    free(cache->slots);
+    memset(cache, 0, sizeof(ChunkCache));
+    cache->lruHead = -1;
+    cache->lruTail = -1;
+}
+
+// Hash slot holding the chunk, or -1
+static int FindSlot(const ChunkCache* cache, int chunkX, int chunkY) {
+    if (!cache->slots) return -1;
+
+    int slot = (int)(HashChunkKey(chunkX, chunkY) & (uint32_t)cache->slotMask);
+    while (cache->slots[slot] != CHUNK_SLOT_EMPTY) {
+        const CachedChunk* chunk = &cache->chunks[cache->slots[slot]];
+        if (chunk->chunkX == chunkX && chunk->chunkY == chunkY) return slot;
+        slot = (slot + 1) & cache->slotMask;
+    }
+    return -1;
+}
+
+CachedChunk* FindCachedChunk(const ChunkCache* cache, int chunkX, int chunkY) {
+    if (!cache) return NULL;
+
+    int slot = FindSlot(cache, chunkX, chunkY);
+    return slot >= 0 ? &cache->chunks[cache->slots[slot]] : NULL;
+}
+
+// Backward-shift deletion keeps probe runs intact without tombstones
+static void RemoveSlot(ChunkCache* cache, int slot) {
+    int hole = slot;
+    int next = (slot + 1) & cache->slotMask;
+
+    while (cache->slots[next] != CHUNK_SLOT_EMPTY) {
+        int home = HomeSlot(cache, &cache->chunks[cache->slots[next]]);
+
+        // Move the entry back if the hole lies between its home and its slot
+        bool movable = (next > hole) ? (home <= hole || home > next)
+                                     : (home <= hole && home > next);
+        if (movable) {
+            cache->slots[hole] = cache->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & cache->slotMask;
+    }
+
+    cache->slots[hole] = CHUNK_SLOT_EMPTY;
+}
+
+static void UnlinkChunk(ChunkCache* cache, int index) {
+    CachedChunk* chunk = &cache->chunks[index];
+
+    if (chunk->lruPrev >= 0) {
+        cache->chunks[chunk->lruPrev].lruNext = chunk->lruNext;
+    } else {
+        cache->lruHead = chunk->lruNext;
+    }
+
+    if (chunk->lruNext >= 0) {
+        cache->chunks[chunk->lruNext].lruPrev = chunk->lruPrev;
+    } else {
+        cache->lruTail = chunk->lruPrev;
+    }
+
+    chunk->lruPrev = -1;
+    chunk->lruNext = -1;
+}
+
+static void LinkChunkAtHead(ChunkCache* cache, int index) {
+    CachedChunk* chunk = &cache->chunks[index];
+    chunk->lruPrev = -1;
+    chunk->lruNext = cache->lruHead;
+
+    if (cache->lruHead >= 0) {
+        cache->chunks[cache->lruHead].lruPrev = index;
+    } else {
+        cache->lruTail = index;
+    }
+    cache->lruHead = index;
+}
+
+void TouchCachedChunk(ChunkCache* cache, CachedChunk* chunk) {
+    if (!cache || !chunk) return;
+
+    int index = (int)(chunk - cache->chunks);
+    chunk->lastAccessTime = cache->frameCounter;
+    if (cache->lruHead == index) return;
+
+    UnlinkChunk(cache, index);
+    LinkChunkAtHead(cache, index);
+}
+
+// Drops a chunk from the table and the LRU list so its slot can be reused
+static void EvictChunk(ChunkCache* cache, int index) {
+    CachedChunk* evicted = &cache->chunks[index];
+    RemoveSlot(cache, FindSlot(cache, evicted->chunkX, evicted->chunkY));
+    UnlinkChunk(cache, index);
+}
+
+static CachedChunk* PlaceChunk(ChunkCache* cache, int index, int chunkX, int chunkY) {
+    CachedChunk* chunk = &cache->chunks[index];
+    chunk->chunkX = chunkX;
+    chunk->chunkY = chunkY;
+    chunk->gridPosition = (Vector2){ (float)chunkX, (float)chunkY };
+    chunk->bounds = (Rectangle){
+        (float)(chunkX * CACHE_CHUNK_SIZE * TILE_SIZE),
+        (float)(chunkY * CACHE_CHUNK_SIZE * TILE_SIZE),
+        (float)(CACHE_CHUNK_SIZE * TILE_SIZE),
+        (float)(CACHE_CHUNK_SIZE * TILE_SIZE)
+    };
+    MarkChunkDirty(chunk);
+    chunk->lastAccessTime = cache->frameCounter;
+
+    int slot = (int)(HashChunkKey(chunkX, chunkY) & (uint32_t)cache->slotMask);
+    while (cache->slots[slot] != CHUNK_SLOT_EMPTY) {
+        slot = (slot + 1) & cache->slotMask;
+    }
+    cache->slots[slot] = index;
+
+    LinkChunkAtHead(cache, index);
+    return chunk;
+}
+
+CachedChunk* InsertCachedChunk(ChunkCache* cache, int chunkX, int chunkY) {
+    if (!cache || !cache->chunks) return NULL;
+
+    CachedChunk* existing = FindCachedChunk(cache, chunkX, chunkY);
+    if (existing) {
+        TouchCachedChunk(cache, existing);
+        return existing;
+    }
+
+    int index;
+    if (cache->chunkCount < cache->capacity) {
+        index = cache->chunkCount++;
+    } else {
+        // Evict the least recently used chunk and reuse its slot
+        index = cache->lruTail;
+        EvictChunk(cache, index);
+    }
+
+    return PlaceChunk(cache, index, chunkX, chunkY);
+}
+
+static float GetChunkDistanceSq(int chunkX, int chunkY, float focusX, float focusY) {
+    float dx = (float)chunkX + 0.5f - focusX;
+    float dy = (float)chunkY + 0.5f - focusY;
+    return dx * dx + dy * dy;
+}
+
+CachedChunk* PrefetchCachedChunk(ChunkCache* cache, int chunkX, int chunkY, float focusX, float focusY) {
+    if (!cache || !cache->chunks) return NULL;
+
+    CachedChunk* existing = FindCachedChunk(cache, chunkX, chunkY);
+    if (existing) return existing;
+
+    if (cache->chunkCount < cache->capacity) {
+        return PlaceChunk(cache, cache->chunkCount++, chunkX, chunkY);
+    }
+
+    // Among the stalest few, give up the one farthest from where the view
+    // is heading, and only if it is farther than the chunk wanted
+    int victim = -1;
+    float victimDistance = GetChunkDistanceSq(chunkX, chunkY, focusX, focusY);
+    int index = cache->lruTail;
+    for (int i = 0; i < CHUNK_EVICT_CANDIDATES && index >= 0; i++) {
+        const CachedChunk* candidate = &cache->chunks[index];
+        if (candidate->lastAccessTime != cache->frameCounter) {
+            float distance = GetChunkDistanceSq(candidate->chunkX, candidate->chunkY, focusX, focusY);
+            if (distance > victimDistance) {
+                victim = index;
+                victimDistance = distance;
+            }
+        }
+        index = candidate->lruPrev;
+    }
+    if (victim < 0) return NULL;
+
+    EvictChunk(cache, victim);
+    return PlaceChunk(cache, victim, chunkX, chunkY);
+}
+
+// Dirty regions
+
+#define CHUNK_FULL_REDRAW_AREA (CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE / 2)
+
+static int GetDirtyRectArea(ChunkDirtyRect rect) {
+    return (rect.maxX - rect.minX + 1) * (rect.maxY - rect.minY + 1);
+}
+
+static ChunkDirtyRect UniteDirtyRects(ChunkDirtyRect a, ChunkDirtyRect b) {
+    return (ChunkDirtyRect){
+        a.minX < b.minX ? a.minX : b.minX,
+        a.minY < b.minY ? a.minY : b.minY,
+        a.maxX > b.maxX ? a.maxX : b.maxX,
+        a.maxY > b.maxY ? a.maxY : b.maxY
+    };
+}
+
+// Overlapping or sharing an edge, so the union adds no wasted tiles
+static bool DirtyRectsTouch(ChunkDirtyRect a, ChunkDirtyRect b) {
+    return a.minX <= b.maxX + 1 && b.minX <= a.maxX + 1 &&
+           a.minY <= b.maxY + 1 && b.minY <= a.maxY + 1;
+}
+
+static void RemoveDirtyRect(CachedChunk* chunk, int index) {
+    chunk->dirtyRects[index] = chunk->dirtyRects[--chunk->dirtyRectCount];
+}
+
+void MarkChunkDirty(CachedChunk* chunk) {
+    if (!chunk) return;
+
+    chunk->isDirty = true;
+    chunk->dirtyRects[0] = (ChunkDirtyRect){ 0, 0, CACHE_CHUNK_SIZE - 1, CACHE_CHUNK_SIZE - 1 };
+    chunk->dirtyRectCount = 1;
+}
+
+void MarkChunkRegionDirty(CachedChunk* chunk, int minX, int minY, int maxX, int maxY) {
+    if (!chunk) return;
+
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX >= CACHE_CHUNK_SIZE) maxX = CACHE_CHUNK_SIZE - 1;
+    if (maxY >= CACHE_CHUNK_SIZE) maxY = CACHE_CHUNK_SIZE - 1;
+    if (maxX < minX || maxY < minY) return;
+
+    // A dirty chunk without regions predates region tracking: redraw it all
+    if (chunk->isDirty && chunk->dirtyRectCount == 0) {
+        MarkChunkDirty(chunk);
+        return;
+    }
+
+    ChunkDirtyRect rect = { (uint8_t)minX, (uint8_t)minY, (uint8_t)maxX, (uint8_t)maxY };
+
+    for (;;) {
+        // Absorb every region the new one touches, repeating as it grows
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (int i = 0; i < chunk->dirtyRectCount; i++) {
+                if (DirtyRectsTouch(rect, chunk->dirtyRects[i])) {
+                    rect = UniteDirtyRects(rect, chunk->dirtyRects[i]);
+                    RemoveDirtyRect(chunk, i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        if (chunk->dirtyRectCount < CHUNK_MAX_DIRTY_RECTS) break;
+
+        // Out of room: fold the new region into the one it grows least
+        int best = 0;
+        int bestGrowth = INT32_MAX;
+        for (int i = 0; i < chunk->dirtyRectCount; i++) {
+            ChunkDirtyRect other = chunk->dirtyRects[i];
+            int growth = GetDirtyRectArea(UniteDirtyRects(rect, other)) -
+                         GetDirtyRectArea(rect) - GetDirtyRectArea(other);
+            if (growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        rect = UniteDirtyRects(rect, chunk->dirtyRects[best]);
+        RemoveDirtyRect(chunk, best);
+    }
+
+    chunk->dirtyRects[chunk->dirtyRectCount++] = rect;
+    chunk->isDirty = true;
+
+    // Past half the chunk one clear beats several scissored passes
+    int area = 0;
+    for (int i = 0; i < chunk->dirtyRectCount; i++) {
+        area += GetDirtyRectArea(chunk->dirtyRects[i]);
+    }
+    if (area >= CHUNK_FULL_REDRAW_AREA) MarkChunkDirty(chunk);
+}
+
+void ClearChunkDirty(CachedChunk* chunk) {
+    if (!chunk) return;
+
+    chunk->isDirty = false;
+    chunk->dirtyRectCount = 0;
+}
+
+void MarkCachedTileDirty(ChunkCache* cache, int tileX, int tileY) {
+    if (!cache) return;
+
+    // Floor division so negative tiles land in the chunk left of or above
+    int chunkX = FloorDiv(tileX, CACHE_CHUNK_SIZE);
+    int chunkY = FloorDiv(tileY, CACHE_CHUNK_SIZE);
+    CachedChunk* chunk = FindCachedChunk(cache, chunkX, chunkY);
+    if (!chunk) return;
+
+    int localX = tileX - chunkX * CACHE_CHUNK_SIZE;
+    int localY = tileY - chunkY * CACHE_CHUNK_SIZE;
+    MarkChunkRegionDirty(chunk, localX, localY, localX, localY);
+}
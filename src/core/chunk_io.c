@@ -0,0 +1,329 @@
+// Chunk I/O - one background thread that reads, generates and writes
+// streamed chunks. Kept free of raylib includes for the same reason as
+// the job system: the platform headers collide with raylib symbols.
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../include/chunk_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <direct.h>
+typedef SRWLOCK IOLock;
+typedef CONDITION_VARIABLE IOCond;
+typedef HANDLE IOThread;
+#else
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+typedef pthread_mutex_t IOLock;
+typedef pthread_cond_t IOCond;
+typedef pthread_t IOThread;
+#endif
+
+#define CHUNK_PATH_LENGTH 512
+
+typedef enum {
+    CHUNK_REQUEST_LOAD,
+    CHUNK_REQUEST_SAVE
+} ChunkRequestType;
+
+typedef struct ChunkRequest {
+    ChunkRequestType type;
+    int chunkX;
+    int chunkY;
+    StreamChunk* chunk;               // Save payload, owned by the request
+    uint32_t generation;              // Load tag, copied to the loaded chunk
+} ChunkRequest;
+
+struct ChunkIO {
+    char directory[CHUNK_PATH_LENGTH];
+    bool persistent;
+    ChunkGenerateFunc generate;
+    void* context;
+
+    IOThread thread;
+    bool threadRunning;
+    ChunkRequest queue[CHUNK_IO_QUEUE_CAPACITY];
+    int head;
+    int count;
+    bool busy;                        // The thread is running a popped request
+    bool shuttingDown;
+    StreamChunk* completed;
+    IOLock lock;
+    IOCond workAvailable;
+    IOCond workFinished;
+};
+
+// Platform wrappers
+#ifdef _WIN32
+static void InitLock(IOLock* lock) { InitializeSRWLock(lock); }
+static void DestroyLock(IOLock* lock) { (void)lock; }
+static void Lock(IOLock* lock) { AcquireSRWLockExclusive(lock); }
+static void Unlock(IOLock* lock) { ReleaseSRWLockExclusive(lock); }
+static void InitCond(IOCond* cond) { InitializeConditionVariable(cond); }
+static void DestroyCond(IOCond* cond) { (void)cond; }
+static void WaitCond(IOCond* cond, IOLock* lock) { SleepConditionVariableSRW(cond, lock, INFINITE, 0); }
+static void SignalCond(IOCond* cond) { WakeConditionVariable(cond); }
+static void BroadcastCond(IOCond* cond) { WakeAllConditionVariable(cond); }
+static void MakeDirectory(const char* path) { _mkdir(path); }
+#else
+static void InitLock(IOLock* lock) { pthread_mutex_init(lock, NULL); }
+static void DestroyLock(IOLock* lock) { pthread_mutex_destroy(lock); }
+static void Lock(IOLock* lock) { pthread_mutex_lock(lock); }
+static void Unlock(IOLock* lock) { pthread_mutex_unlock(lock); }
+static void InitCond(IOCond* cond) { pthread_cond_init(cond, NULL); }
+static void DestroyCond(IOCond* cond) { pthread_cond_destroy(cond); }
+static void WaitCond(IOCond* cond, IOLock* lock) { pthread_cond_wait(cond, lock); }
+static void SignalCond(IOCond* cond) { pthread_cond_signal(cond); }
+static void BroadcastCond(IOCond* cond) { pthread_cond_broadcast(cond); }
+static void MakeDirectory(const char* path) { mkdir(path, 0755); }
+#endif
+
+// Chunk files
+void GetChunkFilePath(const char* directory, int chunkX, int chunkY, char* path, size_t size) {
+    snprintf(path, size, "%s/chunk_%d_%d.bin", directory, chunkX, chunkY);
+}
+
+bool ReadChunkFile(const char* directory, StreamChunk* chunk) {
+    if (!directory || !chunk) return false;
+
+    char path[CHUNK_PATH_LENGTH];
+    GetChunkFilePath(directory, chunk->chunkX, chunk->chunkY, path, sizeof(path));
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t size = 0;
+    int32_t chunkX = 0;
+    int32_t chunkY = 0;
+    bool valid = fread(&magic, sizeof(magic), 1, file) == 1 &&
+                 fread(&version, sizeof(version), 1, file) == 1 &&
+                 fread(&size, sizeof(size), 1, file) == 1 &&
+                 fread(&chunkX, sizeof(chunkX), 1, file) == 1 &&
+                 fread(&chunkY, sizeof(chunkY), 1, file) == 1 &&
+                 magic == CHUNK_FILE_MAGIC && version == CHUNK_FILE_VERSION &&
+                 size == STREAM_CHUNK_SIZE && chunkX == chunk->chunkX && chunkY == chunk->chunkY &&
+                 fread(chunk->types, 1, STREAM_CHUNK_TILES, file) == STREAM_CHUNK_TILES &&
+                 fread(chunk->objects, 1, STREAM_CHUNK_TILES, file) == STREAM_CHUNK_TILES;
+
+    fclose(file);
+    return valid;
+}
+
+bool WriteChunkFile(const char* directory, const StreamChunk* chunk) {
+    if (!directory || !chunk) return false;
+
+    char path[CHUNK_PATH_LENGTH];
+    char tempPath[CHUNK_PATH_LENGTH + 4];
+    GetChunkFilePath(directory, chunk->chunkX, chunk->chunkY, path, sizeof(path));
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    // Write beside the old file and swap, so a crash never leaves half a chunk
+    FILE* file = fopen(tempPath, "wb");
+    if (!file) return false;
+
+    uint32_t magic = CHUNK_FILE_MAGIC;
+    uint16_t version = CHUNK_FILE_VERSION;
+    uint16_t size = STREAM_CHUNK_SIZE;
+    int32_t chunkX = chunk->chunkX;
+    int32_t chunkY = chunk->chunkY;
+    bool written = fwrite(&magic, sizeof(magic), 1, file) == 1 &&
+                   fwrite(&version, sizeof(version), 1, file) == 1 &&
+                   fwrite(&size, sizeof(size), 1, file) == 1 &&
+                   fwrite(&chunkX, sizeof(chunkX), 1, file) == 1 &&
+                   fwrite(&chunkY, sizeof(chunkY), 1, file) == 1 &&
+                   fwrite(chunk->types, 1, STREAM_CHUNK_TILES, file) == STREAM_CHUNK_TILES &&
+                   fwrite(chunk->objects, 1, STREAM_CHUNK_TILES, file) == STREAM_CHUNK_TILES;
+
+    if (fclose(file) != 0) written = false;
+    if (!written) {
+        remove(tempPath);
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(path);
+#endif
+    return rename(tempPath, path) == 0;
+}
+
+// I/O thread
+static void RunLoad(ChunkIO* io, const ChunkRequest* request) {
+    StreamChunk* chunk = (StreamChunk*)calloc(1, sizeof(StreamChunk));
+    if (!chunk) return;
+
+    chunk->chunkX = request->chunkX;
+    chunk->chunkY = request->chunkY;
+    chunk->generation = request->generation;
+    if (!io->persistent || !ReadChunkFile(io->directory, chunk)) {
+        memset(chunk->types, 0, sizeof(chunk->types));
+        memset(chunk->objects, 0, sizeof(chunk->objects));
+        if (io->generate) io->generate(io->context, chunk);
+    }
+
+    Lock(&io->lock);
+    chunk->next = io->completed;
+    io->completed = chunk;
+    Unlock(&io->lock);
+}
+
+static void RunSave(ChunkIO* io, StreamChunk* chunk) {
+    if (io->persistent) WriteChunkFile(io->directory, chunk);
+    free(chunk);
+}
+
+static void IOLoop(ChunkIO* io) {
+    Lock(&io->lock);
+    for (;;) {
+        while (io->count == 0 && !io->shuttingDown) {
+            WaitCond(&io->workAvailable, &io->lock);
+        }
+        if (io->count == 0) break;
+
+        ChunkRequest request = io->queue[io->head];
+        io->head = (io->head + 1) % CHUNK_IO_QUEUE_CAPACITY;
+        io->count--;
+        io->busy = true;
+        bool skipLoad = io->shuttingDown;
+        Unlock(&io->lock);
+
+        // Saves always finish; loads are pointless once shutdown starts
+        if (request.type == CHUNK_REQUEST_SAVE) {
+            RunSave(io, request.chunk);
+        } else if (!skipLoad) {
+            RunLoad(io, &request);
+        }
+
+        Lock(&io->lock);
+        io->busy = false;
+        if (io->count == 0) BroadcastCond(&io->workFinished);
+    }
+    Unlock(&io->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI IOEntry(LPVOID param) {
+    IOLoop((ChunkIO*)param);
+    return 0;
+}
+#else
+static void* IOEntry(void* param) {
+    IOLoop((ChunkIO*)param);
+    return NULL;
+}
+#endif
+
+// Chunk I/O management
+ChunkIO* CreateChunkIO(const char* directory, ChunkGenerateFunc generate, void* context) {
+    ChunkIO* io = (ChunkIO*)calloc(1, sizeof(ChunkIO));
+    if (!io) return NULL;
+
+    if (directory) {
+        snprintf(io->directory, sizeof(io->directory), "%s", directory);
+        io->persistent = true;
+        MakeDirectory(io->directory);
+    }
+    io->generate = generate;
+    io->context = context;
+
+    InitLock(&io->lock);
+    InitCond(&io->workAvailable);
+    InitCond(&io->workFinished);
+
+#ifdef _WIN32
+    io->thread = CreateThread(NULL, 0, IOEntry, io, 0, NULL);
+    io->threadRunning = io->thread != NULL;
+#else
+    io->threadRunning = pthread_create(&io->thread, NULL, IOEntry, io) == 0;
+#endif
+
+    if (!io->threadRunning) {
+        DestroyCond(&io->workFinished);
+        DestroyCond(&io->workAvailable);
+        DestroyLock(&io->lock);
+        free(io);
+        return NULL;
+    }
+
+    return io;
+}
+
+void DestroyChunkIO(ChunkIO* io) {
+    if (!io) return;
+
+    Lock(&io->lock);
+    io->shuttingDown = true;
+    BroadcastCond(&io->workAvailable);
+    Unlock(&io->lock);
+
+#ifdef _WIN32
+    WaitForSingleObject(io->thread, INFINITE);
+    CloseHandle(io->thread);
+#else
+    pthread_join(io->thread, NULL);
+#endif
+
+    while (io->completed) {
+        StreamChunk* next = io->completed->next;
+        free(io->completed);
+        io->completed = next;
+    }
+
+    DestroyCond(&io->workFinished);
+    DestroyCond(&io->workAvailable);
+    DestroyLock(&io->lock);
+    free(io);
+}
+
+static bool PushRequest(ChunkIO* io, ChunkRequest request) {
+    Lock(&io->lock);
+    if (io->count >= CHUNK_IO_QUEUE_CAPACITY) {
+        Unlock(&io->lock);
+        return false;
+    }
+
+    io->queue[(io->head + io->count) % CHUNK_IO_QUEUE_CAPACITY] = request;
+    io->count++;
+    SignalCond(&io->workAvailable);
+    Unlock(&io->lock);
+    return true;
+}
+
+bool QueueChunkLoad(ChunkIO* io, int chunkX, int chunkY, uint32_t generation) {
+    if (!io) return false;
+    return PushRequest(io, (ChunkRequest){ CHUNK_REQUEST_LOAD, chunkX, chunkY, NULL, generation });
+}
+
+bool QueueChunkSave(ChunkIO* io, StreamChunk* chunk) {
+    if (!io || !chunk) return false;
+    return PushRequest(io, (ChunkRequest){ CHUNK_REQUEST_SAVE, chunk->chunkX, chunk->chunkY, chunk, 0 });
+}
+
+StreamChunk* PollLoadedChunks(ChunkIO* io) {
+    if (!io) return NULL;
+
+    Lock(&io->lock);
+    StreamChunk* loaded = io->completed;
+    io->completed = NULL;
+    Unlock(&io->lock);
+    return loaded;
+}
+
+void FlushChunkIO(ChunkIO* io) {
+    if (!io) return;
+
+    Lock(&io->lock);
+    while (io->count > 0 || io->busy) {
+        WaitCond(&io->workFinished, &io->lock);
+    }
+    Unlock(&io->lock);
+}
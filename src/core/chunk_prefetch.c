@@ -0,0 +1,122 @@
+#include "../../include/chunk_prefetch.h"
+#include <math.h>
+#include <string.h>
+
+#define CHUNK_PIXELS ((float)(CACHE_CHUNK_SIZE * TILE_SIZE))
+
+void InitChunkPrefetcher(ChunkPrefetcher* prefetcher, float lookahead) {
+    if (!prefetcher) return;
+
+    memset(prefetcher, 0, sizeof(ChunkPrefetcher));
+    prefetcher->lookahead = lookahead > 0.0f ? lookahead : CHUNK_PREFETCH_LOOKAHEAD;
+}
+
+// Distance from a chunk's centre to the nearest point of a view
+static float GetChunkViewDistance(int chunkX, int chunkY, Rectangle view) {
+    float centerX = ((float)chunkX + 0.5f) * CHUNK_PIXELS;
+    float centerY = ((float)chunkY + 0.5f) * CHUNK_PIXELS;
+    float dx = fmaxf(fmaxf(view.x - centerX, centerX - (view.x + view.width)), 0.0f);
+    float dy = fmaxf(fmaxf(view.y - centerY, centerY - (view.y + view.height)), 0.0f);
+    return sqrtf(dx * dx + dy * dy);
+}
+
+// Keeps the queue sorted by distance, dropping the farthest when full
+static void QueueChunk(ChunkPrefetcher* prefetcher, float* distances, int chunkX, int chunkY, float distance) {
+    int count = prefetcher->queueCount;
+    if (count == CHUNK_PREFETCH_QUEUE_SIZE && distance >= distances[count - 1]) return;
+
+    int at = count < CHUNK_PREFETCH_QUEUE_SIZE ? count : count - 1;
+    while (at > 0 && distances[at - 1] > distance) {
+        prefetcher->queue[at] = prefetcher->queue[at - 1];
+        distances[at] = distances[at - 1];
+        at--;
+    }
+    prefetcher->queue[at] = (ChunkCoord){ chunkX, chunkY };
+    distances[at] = distance;
+    if (count < CHUNK_PREFETCH_QUEUE_SIZE) prefetcher->queueCount++;
+}
+
+// Chunks between the view and the predicted view that are not visible yet
+static void BuildPrefetchQueue(ChunkPrefetcher* prefetcher) {
+    prefetcher->queueCount = 0;
+
+    Rectangle view = prefetcher->view;
+    Rectangle ahead = prefetcher->predictedView;
+    if (ahead.x == view.x && ahead.y == view.y) return;
+
+    float left = fminf(view.x, ahead.x);
+    float top = fminf(view.y, ahead.y);
+    float right = fmaxf(view.x + view.width, ahead.x + ahead.width);
+    float bottom = fmaxf(view.y + view.height, ahead.y + ahead.height);
+
+    int viewMinX = (int)floorf(view.x / CHUNK_PIXELS);
+    int viewMinY = (int)floorf(view.y / CHUNK_PIXELS);
+    int viewMaxX = (int)floorf((view.x + view.width) / CHUNK_PIXELS);
+    int viewMaxY = (int)floorf((view.y + view.height) / CHUNK_PIXELS);
+
+    float distances[CHUNK_PREFETCH_QUEUE_SIZE];
+    for (int y = (int)floorf(top / CHUNK_PIXELS); y <= (int)floorf(bottom / CHUNK_PIXELS); y++) {
+        for (int x = (int)floorf(left / CHUNK_PIXELS); x <= (int)floorf(right / CHUNK_PIXELS); x++) {
+            if (x >= viewMinX && x <= viewMaxX && y >= viewMinY && y <= viewMaxY) continue;
+            QueueChunk(prefetcher, distances, x, y, GetChunkViewDistance(x, y, view));
+        }
+    }
+}
+
+void UpdateChunkPrefetcher(ChunkPrefetcher* prefetcher, Rectangle view, float deltaTime) {
+    if (!prefetcher) return;
+
+    if (prefetcher->hasView && deltaTime > 0.0f) {
+        float dx = view.x - prefetcher->view.x;
+        float dy = view.y - prefetcher->view.y;
+        bool isCut = fabsf(dx) > view.width * CHUNK_PREFETCH_MAX_JUMP ||
+                     fabsf(dy) > view.height * CHUNK_PREFETCH_MAX_JUMP;
+
+        if (isCut) {
+            prefetcher->velocity = (Vector2){ 0.0f, 0.0f };
+        } else {
+            // Smoothed so a single jittery frame does not swing the prediction
+            prefetcher->velocity.x += (dx / deltaTime - prefetcher->velocity.x) * CHUNK_PREFETCH_SMOOTHING;
+            prefetcher->velocity.y += (dy / deltaTime - prefetcher->velocity.y) * CHUNK_PREFETCH_SMOOTHING;
+        }
+    }
+
+    prefetcher->view = view;
+    prefetcher->hasView = true;
+    float limitX = view.width * CHUNK_PREFETCH_MAX_AHEAD;
+    float limitY = view.height * CHUNK_PREFETCH_MAX_AHEAD;
+    prefetcher->predictedView = (Rectangle){
+        view.x + fminf(fmaxf(prefetcher->velocity.x * prefetcher->lookahead, -limitX), limitX),
+        view.y + fminf(fmaxf(prefetcher->velocity.y * prefetcher->lookahead, -limitY), limitY),
+        view.width,
+        view.height
+    };
+    BuildPrefetchQueue(prefetcher);
+}
+
+Vector2 GetChunkPrefetchFocus(const ChunkPrefetcher* prefetcher) {
+    if (!prefetcher) return (Vector2){ 0.0f, 0.0f };
+
+    Rectangle ahead = prefetcher->predictedView;
+    return (Vector2){ ahead.x + ahead.width * 0.5f, ahead.y + ahead.height * 0.5f };
+}
+
+void RecordChunkEntered(ChunkPrefetcher* prefetcher, bool ready) {
+    if (!prefetcher) return;
+
+    prefetcher->enteredChunks++;
+    if (ready) prefetcher->readyChunks++;
+}
+
+float GetChunkPrefetchHitRate(const ChunkPrefetcher* prefetcher) {
+    if (!prefetcher || prefetcher->enteredChunks == 0) return 1.0f;
+    return (float)prefetcher->readyChunks / (float)prefetcher->enteredChunks;
+}
+
+void ResetChunkPrefetchStats(ChunkPrefetcher* prefetcher) {
+    if (!prefetcher) return;
+
+    prefetcher->enteredChunks = 0;
+    prefetcher->readyChunks = 0;
+    prefetcher->prefetchedChunks = 0;
+}
@@ -0,0 +1,606 @@
+#include "../../include/chunk_renderer.h"
+#include "../../include/chunk_cache.h"
+#include "../../include/world.h"
+#include "../../include/world_stream.h"
+#include "../../include/resonance_field.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <math.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <stdlib.h>
+#include <string.h>
+
+END_EXTERNAL_WARNINGS
+
+#define CHUNK_PIXELS ((float)(CACHE_CHUNK_SIZE * TILE_SIZE))
+#define CHUNK_SHADER_VS "resources/shaders/resonance.vs"
+#define CHUNK_SHADER_FS "resources/shaders/resonance.fs"
+#define CHUNK_RESONANCE_STRENGTH 0.6f
+#define CHUNK_RESONANCE_FAR -1.0e6f     // Wave centre no tile is near, so vertices stay put
+
+ChunkRenderer* CreateChunkRenderer(int capacity) {
+    ChunkRenderer* renderer = (ChunkRenderer*)calloc(1, sizeof(ChunkRenderer));
+    if (!renderer) return NULL;
+
+    if (!InitChunkCache(&renderer->cache, capacity)) {
+        DestroyChunkRenderer(renderer);
+        return NULL;
+    }
+
+    for (int i = 0; i < CHUNK_BUILD_SLOTS; i++) {
+        renderer->builds[i].slot = -1;
+        if (!InitTileMeshData(&renderer->builds[i].data)) {
+            DestroyChunkRenderer(renderer);
+            return NULL;
+        }
+    }
+
+    renderer->slots = (ChunkMeshSlot*)calloc((size_t)renderer->cache.capacity, sizeof(ChunkMeshSlot));
+    if (!renderer->slots) {
+        DestroyChunkRenderer(renderer);
+        return NULL;
+    }
+    for (int i = 0; i < renderer->cache.capacity; i++) {
+        renderer->slots[i].shownFrame = -2;
+    }
+
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        if (!InitChunkCache(&renderer->lodCaches[level], CHUNK_LOD_CACHE_SIZE)) {
+            DestroyChunkRenderer(renderer);
+            return NULL;
+        }
+        renderer->lodSlots[level] = (ChunkLodSlot*)calloc((size_t)renderer->lodCaches[level].capacity,
+                                                          sizeof(ChunkLodSlot));
+        if (!renderer->lodSlots[level]) {
+            DestroyChunkRenderer(renderer);
+            return NULL;
+        }
+    }
+
+    for (int i = 0; i < CHUNK_LOD_BUILD_SLOTS; i++) {
+        renderer->lodBuilds[i].slot = -1;
+        renderer->lodBuilds[i].pixels = (Color*)malloc((size_t)CHUNK_PIXELS * (size_t)CHUNK_PIXELS * sizeof(Color));
+        if (!renderer->lodBuilds[i].pixels) {
+            DestroyChunkRenderer(renderer);
+            return NULL;
+        }
+    }
+
+    InitChunkPrefetcher(&renderer->prefetch, CHUNK_PREFETCH_LOOKAHEAD);
+    return renderer;
+}
+
+static void ReleaseChunkMesh(ChunkMeshSlot* slot) {
+    // UnloadMesh frees the CPU arrays as well as the GPU buffers
+    if (slot->mesh.vaoId > 0 || slot->mesh.vertices) UnloadMesh(slot->mesh);
+    memset(&slot->mesh, 0, sizeof(Mesh));
+    slot->hasMesh = false;
+}
+
+void DestroyChunkRenderer(ChunkRenderer* renderer) {
+    if (!renderer) return;
+
+    // Workers may still be writing into the build buffers
+    for (int i = 0; i < CHUNK_BUILD_SLOTS; i++) {
+        WaitForJobs(NULL, &renderer->builds[i].counter);
+        FreeTileMeshData(&renderer->builds[i].data);
+    }
+
+    for (int i = 0; i < CHUNK_LOD_BUILD_SLOTS; i++) {
+        WaitForJobs(NULL, &renderer->lodBuilds[i].counter);
+        free(renderer->lodBuilds[i].pixels);
+    }
+
+    if (renderer->slots) {
+        for (int i = 0; i < renderer->cache.chunkCount; i++) {
+            ReleaseChunkMesh(&renderer->slots[i]);
+        }
+        free(renderer->slots);
+    }
+
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        if (renderer->lodSlots[level]) {
+            for (int i = 0; i < renderer->lodCaches[level].chunkCount; i++) {
+                if (renderer->lodSlots[level][i].texture.id > 0) UnloadTexture(renderer->lodSlots[level][i].texture);
+            }
+            free(renderer->lodSlots[level]);
+        }
+        FreeChunkCache(&renderer->lodCaches[level]);
+    }
+    FreeTileLodAtlas(&renderer->lodAtlas);
+
+    // The tileset belongs to the caller, so only the shader and map array are freed
+    if (renderer->hasMaterial) {
+        if (renderer->material.shader.id != rlGetShaderIdDefault()) UnloadShader(renderer->material.shader);
+        RL_FREE(renderer->material.maps);
+    }
+
+    FreeChunkCache(&renderer->cache);
+    free(renderer);
+}
+
+void MarkChunkMeshDirty(ChunkRenderer* renderer, int tileX, int tileY) {
+    if (!renderer) return;
+    MarkCachedTileDirty(&renderer->cache, tileX, tileY);
+
+    // Group images are recomposed whole, so the group is simply dirty
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        int groupTiles = CACHE_CHUNK_SIZE << level;
+        CachedChunk* group = FindCachedChunk(&renderer->lodCaches[level],
+                                             FloorDiv(tileX, groupTiles), FloorDiv(tileY, groupTiles));
+        if (group) MarkChunkDirty(group);
+    }
+}
+
+void InvalidateChunkRenderer(ChunkRenderer* renderer) {
+    if (!renderer) return;
+
+    for (int i = 0; i < renderer->cache.chunkCount; i++) {
+        MarkChunkDirty(&renderer->cache.chunks[i]);
+    }
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        for (int i = 0; i < renderer->lodCaches[level].chunkCount; i++) {
+            MarkChunkDirty(&renderer->lodCaches[level].chunks[i]);
+        }
+    }
+}
+
+// Copies a size x size square of tiles into packed planes size bytes
+// wide, setting how much of it the map covers. False while a streamed
+// chunk in it is still loading, so the caller stays dirty and retries
+// next frame.
+static bool CopyWorldTiles(const World* world, int startX, int startY, int size,
+                           uint8_t* types, uint8_t* objects, int* width, int* height) {
+    if (world->stream) {
+        // Stream chunks are a whole number of cache chunks, so checking
+        // one tile per cache chunk covers the square
+        for (int y = 0; y < size; y += CACHE_CHUNK_SIZE) {
+            for (int x = 0; x < size; x += CACHE_CHUNK_SIZE) {
+                if (!IsStreamTileResident(world->stream, startX + x, startY + y)) return false;
+            }
+        }
+
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                Tile tile = GetStreamTile(world->stream, startX + x, startY + y);
+                types[y * size + x] = (uint8_t)tile.type;
+                objects[y * size + x] = (uint8_t)tile.objectType;
+            }
+        }
+        *width = size;
+        *height = size;
+        return true;
+    }
+
+    // Squares past the map edge come out empty
+    int copyWidth = world->width - startX < size ? world->width - startX : size;
+    int copyHeight = world->height - startY < size ? world->height - startY : size;
+    if (!world->tiles.types || startX < 0 || startY < 0 || copyWidth <= 0 || copyHeight <= 0) {
+        *width = 0;
+        *height = 0;
+        return true;
+    }
+
+    for (int y = 0; y < copyHeight; y++) {
+        size_t offset = (size_t)(startY + y) * world->width + startX;
+        memcpy(&types[y * size], &world->tiles.types[offset], (size_t)copyWidth);
+        memcpy(&objects[y * size], &world->tiles.objects[offset], (size_t)copyWidth);
+    }
+    *width = copyWidth;
+    *height = copyHeight;
+    return true;
+}
+
+static bool CopyChunkTiles(const World* world, int chunkX, int chunkY, ChunkBuild* build) {
+    return CopyWorldTiles(world, chunkX * CACHE_CHUNK_SIZE, chunkY * CACHE_CHUNK_SIZE, CACHE_CHUNK_SIZE,
+                          build->types, build->objects, &build->width, &build->height);
+}
+
+// Copies built geometry into a fresh GPU mesh
+static void UploadChunkMesh(ChunkMeshSlot* slot, const TileMeshData* data) {
+    ReleaseChunkMesh(slot);
+    slot->hasMesh = true;
+    if (data->quadCount == 0) return;
+
+    Mesh* mesh = &slot->mesh;
+    size_t vertexBytes = (size_t)data->quadCount * 4 * 3 * sizeof(float);
+    size_t texcoordBytes = (size_t)data->quadCount * 4 * 2 * sizeof(float);
+    size_t indexBytes = (size_t)data->quadCount * 6 * sizeof(unsigned short);
+
+    mesh->vertices = (float*)RL_MALLOC(vertexBytes);
+    mesh->texcoords = (float*)RL_MALLOC(texcoordBytes);
+    mesh->texcoords2 = (float*)RL_MALLOC(texcoordBytes);
+    mesh->indices = (unsigned short*)RL_MALLOC(indexBytes);
+    if (!mesh->vertices || !mesh->texcoords || !mesh->texcoords2 || !mesh->indices) {
+        RL_FREE(mesh->vertices);
+        RL_FREE(mesh->texcoords);
+        RL_FREE(mesh->texcoords2);
+        RL_FREE(mesh->indices);
+        memset(mesh, 0, sizeof(Mesh));
+        return;
+    }
+
+    memcpy(mesh->vertices, data->vertices, vertexBytes);
+    memcpy(mesh->texcoords, data->texcoords, texcoordBytes);
+    memcpy(mesh->texcoords2, data->texcoords2, texcoordBytes);
+    memcpy(mesh->indices, data->indices, indexBytes);
+    mesh->vertexCount = data->quadCount * 4;
+    mesh->triangleCount = data->quadCount * 2;
+    UploadMesh(mesh, false);
+}
+
+// Runs on a worker and touches nothing but the build
+static void BuildChunkJob(void* context) {
+    ChunkBuild* build = (ChunkBuild*)context;
+    BuildTileMesh(&build->data, build->types, build->objects, CACHE_CHUNK_SIZE,
+                  build->width, build->height, build->layout);
+    if (build->hasResonance) {
+        SetTileMeshResonance(&build->data, build->resonance, CACHE_CHUNK_SIZE, build->layout.tileSize);
+    }
+}
+
+// Uploads finished builds, at most CHUNK_UPLOADS_PER_FRAME. A build whose
+// slot was handed to another chunk meanwhile is dropped; the new chunk was
+// inserted dirty and builds on its own.
+static void CollectChunkBuilds(ChunkRenderer* renderer) {
+    int uploads = 0;
+    for (int i = 0; i < CHUNK_BUILD_SLOTS && uploads < CHUNK_UPLOADS_PER_FRAME; i++) {
+        ChunkBuild* build = &renderer->builds[i];
+        if (build->slot < 0 || !IsJobCounterDone(&build->counter)) continue;
+
+        ChunkMeshSlot* slot = &renderer->slots[build->slot];
+        const CachedChunk* chunk = &renderer->cache.chunks[build->slot];
+        if (chunk->chunkX == build->chunkX && chunk->chunkY == build->chunkY) {
+            UploadChunkMesh(slot, &build->data);
+            slot->resonanceVersion = build->resonanceVersion;
+            slot->chunkX = build->chunkX;
+            slot->chunkY = build->chunkY;
+            uploads++;
+        }
+        slot->isBuilding = false;
+        build->slot = -1;
+    }
+}
+
+// Hands a dirty chunk to a worker. Its dirty state is cleared now, since
+// the tiles were copied; edits from here on mark it for another build.
+static void StartChunkBuild(ChunkRenderer* renderer, const World* world, CachedChunk* chunk, TileAtlasLayout layout) {
+    ChunkBuild* build = NULL;
+    for (int i = 0; i < CHUNK_BUILD_SLOTS && !build; i++) {
+        if (renderer->builds[i].slot < 0) build = &renderer->builds[i];
+    }
+    if (!build || !CopyChunkTiles(world, chunk->chunkX, chunk->chunkY, build)) return;
+
+    int slotIndex = (int)(chunk - renderer->cache.chunks);
+    build->slot = slotIndex;
+    build->chunkX = chunk->chunkX;
+    build->chunkY = chunk->chunkY;
+    build->layout = layout;
+
+    // The field is recomputed on the main thread, so its levels are
+    // copied along with the tiles
+    const ResonanceChunk* field = GetResonanceChunk(world->resonance, chunk->chunkX, chunk->chunkY);
+    build->hasResonance = field != NULL;
+    build->resonanceVersion = field ? field->version : 0;
+    if (field) memcpy(build->resonance, field->values, sizeof(build->resonance));
+
+    renderer->slots[slotIndex].isBuilding = true;
+    ClearChunkDirty(chunk);
+
+    SubmitJob(GetJobSystem(), BuildChunkJob, build, &build->counter);
+}
+
+// Reduced levels
+
+// Runs on a worker and touches nothing but the build
+static void BuildChunkLodJob(void* context) {
+    ChunkLodBuild* build = (ChunkLodBuild*)context;
+    int size = CACHE_CHUNK_SIZE << build->level;
+    ComposeTileLod(build->pixels, build->atlas, build->level, build->types, build->objects, size,
+                   build->width, build->height);
+}
+
+static void CollectChunkLodBuilds(ChunkRenderer* renderer) {
+    int uploads = 0;
+    for (int i = 0; i < CHUNK_LOD_BUILD_SLOTS && uploads < CHUNK_LOD_UPLOADS_PER_FRAME; i++) {
+        ChunkLodBuild* build = &renderer->lodBuilds[i];
+        if (build->slot < 0 || !IsJobCounterDone(&build->counter)) continue;
+
+        ChunkLodSlot* slot = &renderer->lodSlots[build->level][build->slot];
+        const CachedChunk* group = &renderer->lodCaches[build->level].chunks[build->slot];
+        if (group->chunkX == build->groupX && group->chunkY == build->groupY) {
+            if (slot->texture.id == 0) {
+                Image image = {
+                    build->pixels, (int)CHUNK_PIXELS, (int)CHUNK_PIXELS, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+                };
+                slot->texture = LoadTextureFromImage(image);
+                SetTextureFilter(slot->texture, TEXTURE_FILTER_BILINEAR);
+            } else {
+                UpdateTexture(slot->texture, build->pixels);
+            }
+            slot->hasImage = slot->texture.id > 0;
+            slot->groupX = build->groupX;
+            slot->groupY = build->groupY;
+            uploads++;
+        }
+        slot->isBuilding = false;
+        build->slot = -1;
+    }
+}
+
+static void StartChunkLodBuild(ChunkRenderer* renderer, const World* world, int level, CachedChunk* group) {
+    ChunkLodBuild* build = NULL;
+    for (int i = 0; i < CHUNK_LOD_BUILD_SLOTS && !build; i++) {
+        if (renderer->lodBuilds[i].slot < 0) build = &renderer->lodBuilds[i];
+    }
+
+    int size = CACHE_CHUNK_SIZE << level;
+    if (!build || !CopyWorldTiles(world, group->chunkX * size, group->chunkY * size, size,
+                                  build->types, build->objects, &build->width, &build->height)) {
+        return;
+    }
+
+    int slotIndex = (int)(group - renderer->lodCaches[level].chunks);
+    build->slot = slotIndex;
+    build->level = level;
+    build->groupX = group->chunkX;
+    build->groupY = group->chunkY;
+    build->atlas = &renderer->lodAtlas;
+    renderer->lodSlots[level][slotIndex].isBuilding = true;
+    ClearChunkDirty(group);
+
+    SubmitJob(GetJobSystem(), BuildChunkLodJob, build, &build->counter);
+}
+
+// Reduces the tileset on the CPU the first time it is seen. Builds in
+// flight read the old atlas, so they finish first; every group image is
+// then recomposed.
+static bool PrepareChunkLodAtlas(ChunkRenderer* renderer, Texture2D tileset) {
+    if (renderer->lodTilesetId == tileset.id) return renderer->lodAtlas.columns > 0;
+
+    for (int i = 0; i < CHUNK_LOD_BUILD_SLOTS; i++) {
+        ChunkLodBuild* build = &renderer->lodBuilds[i];
+        WaitForJobs(NULL, &build->counter);
+        if (build->slot >= 0) renderer->lodSlots[build->level][build->slot].isBuilding = false;
+        build->slot = -1;
+    }
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        for (int i = 0; i < renderer->lodCaches[level].chunkCount; i++) {
+            MarkChunkDirty(&renderer->lodCaches[level].chunks[i]);
+            renderer->lodSlots[level][i].hasImage = false;
+        }
+    }
+
+    FreeTileLodAtlas(&renderer->lodAtlas);
+    renderer->lodTilesetId = tileset.id;
+
+    Image image = LoadImageFromTexture(tileset);
+    if (!image.data) return false;
+
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    TileAtlasLayout layout = { TILE_SIZE, image.width, image.height };
+    bool built = BuildTileLodAtlas(&renderer->lodAtlas, (const Color*)image.data, layout);
+    UnloadImage(image);
+    return built;
+}
+
+// Shrinks a group range to at most capacity groups, keeping the ones
+// nearest the view's centre, and fills the view with the placeholder so
+// the dropped border does not show stale pixels
+static void FitChunkLodRange(Rectangle view, float groupPixels, int capacity,
+                             int* minX, int* maxX, int* minY, int* maxY) {
+    int columns = *maxX - *minX + 1;
+    int rows = *maxY - *minY + 1;
+    if (columns <= 0 || rows <= 0 || columns * rows <= capacity) return;
+
+    DrawRectangleRec(view, CHUNK_PLACEHOLDER_COLOR);
+    while (columns * rows > capacity) {
+        if (columns >= rows) columns--;
+        else rows--;
+    }
+
+    int centerX = (int)floorf((view.x + view.width * 0.5f) / groupPixels);
+    int centerY = (int)floorf((view.y + view.height * 0.5f) / groupPixels);
+    int x = centerX - (columns - 1) / 2;
+    int y = centerY - (rows - 1) / 2;
+    if (x > *maxX - columns + 1) x = *maxX - columns + 1;
+    if (y > *maxY - rows + 1) y = *maxY - rows + 1;
+    if (x < *minX) x = *minX;
+    if (y < *minY) y = *minY;
+
+    *minX = x;
+    *maxX = x + columns - 1;
+    *minY = y;
+    *maxY = y + rows - 1;
+}
+
+// Draws the view as groups of 2^level chunks, one texture each
+static void DrawChunkLods(ChunkRenderer* renderer, const World* world, Rectangle view, int level) {
+    ChunkCache* cache = &renderer->lodCaches[level];
+    int groupTiles = CACHE_CHUNK_SIZE << level;
+    float groupPixels = (float)(groupTiles * TILE_SIZE);
+    int minX = (int)floorf(view.x / groupPixels);
+    int minY = (int)floorf(view.y / groupPixels);
+    int maxX = (int)floorf((view.x + view.width) / groupPixels);
+    int maxY = (int)floorf((view.y + view.height) / groupPixels);
+
+    if (!world->stream) {
+        int lastX = (world->width - 1) / groupTiles;
+        int lastY = (world->height - 1) / groupTiles;
+        if (minX < 0) minX = 0;
+        if (minY < 0) minY = 0;
+        if (maxX > lastX) maxX = lastX;
+        if (maxY > lastY) maxY = lastY;
+    }
+
+    // Every group drawn must fit in the cache at once, or late inserts
+    // evict the frame's earlier groups and none ever keeps an image. Past
+    // that zoom only the groups around the centre are drawn.
+    FitChunkLodRange(view, groupPixels, cache->capacity, &minX, &maxX, &minY, &maxY);
+
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            CachedChunk* group = InsertCachedChunk(cache, x, y);
+            if (!group) continue;
+
+            ChunkLodSlot* slot = &renderer->lodSlots[level][group - cache->chunks];
+            if (group->isDirty && !slot->isBuilding) StartChunkLodBuild(renderer, world, level, group);
+
+            Rectangle dest = { (float)x * groupPixels, (float)y * groupPixels, groupPixels, groupPixels };
+            if (!slot->hasImage || slot->groupX != x || slot->groupY != y) {
+                DrawRectangleRec(dest, CHUNK_PLACEHOLDER_COLOR);
+                continue;
+            }
+
+            Rectangle source = { 0.0f, 0.0f, (float)slot->texture.width, (float)slot->texture.height };
+            DrawTexturePro(slot->texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+    }
+    cache->frameCounter++;
+}
+
+// Spends build slots left over after the visible chunks on the queue from
+// the prefetcher, nearest first. Prefetched chunks never push out chunks
+// drawn this frame.
+static void PrefetchChunkBuilds(ChunkRenderer* renderer, const World* world, TileAtlasLayout layout) {
+    Vector2 focus = GetChunkPrefetchFocus(&renderer->prefetch);
+    float focusX = focus.x / CHUNK_PIXELS;
+    float focusY = focus.y / CHUNK_PIXELS;
+    int lastX = (world->width - 1) / CACHE_CHUNK_SIZE;
+    int lastY = (world->height - 1) / CACHE_CHUNK_SIZE;
+
+    for (int i = 0; i < renderer->prefetch.queueCount; i++) {
+        int freeBuilds = 0;
+        for (int b = 0; b < CHUNK_BUILD_SLOTS; b++) {
+            if (renderer->builds[b].slot < 0) freeBuilds++;
+        }
+        if (freeBuilds == 0) return;
+
+        ChunkCoord coord = renderer->prefetch.queue[i];
+        if (!world->stream && (coord.x < 0 || coord.y < 0 || coord.x > lastX || coord.y > lastY)) continue;
+
+        CachedChunk* chunk = PrefetchCachedChunk(&renderer->cache, coord.x, coord.y, focusX, focusY);
+        if (!chunk) continue;
+
+        ChunkMeshSlot* slot = &renderer->slots[chunk - renderer->cache.chunks];
+        if (!chunk->isDirty || slot->isBuilding) continue;
+
+        StartChunkBuild(renderer, world, chunk, layout);
+        if (slot->isBuilding) renderer->prefetch.prefetchedChunks++;
+    }
+}
+
+// The baked field only shows through resonance.vs/fs. The shader's own
+// travelling wave is kept out of reach, so the field alone lights tiles.
+// Without the shader, chunks still draw, unlit, with the default one.
+static void LoadChunkMaterial(ChunkRenderer* renderer) {
+    renderer->material = LoadMaterialDefault();
+    renderer->hasMaterial = true;
+    renderer->timeLocation = -1;
+
+    Shader shader = LoadShader(CHUNK_SHADER_VS, CHUNK_SHADER_FS);
+    if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_WARNING, "Chunk renderer: resonance shader unavailable, drawing without it");
+        return;
+    }
+
+    float strength = CHUNK_RESONANCE_STRENGTH;
+    float zero = 0.0f;
+    Vector2 center = { CHUNK_RESONANCE_FAR, CHUNK_RESONANCE_FAR };
+    Vector4 color = ColorNormalize(GOLD);
+    SetShaderValue(shader, GetShaderLocation(shader, "resonanceStrength"), &strength, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "resonanceCenter"), &center, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, GetShaderLocation(shader, "resonanceFrequency"), &zero, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "resonancePhase"), &zero, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "psycheLevel"), &zero, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "resonanceColor"), &color, SHADER_UNIFORM_VEC4);
+
+    renderer->material.shader = shader;
+    renderer->timeLocation = GetShaderLocation(shader, "time");
+}
+
+void DrawChunkRenderer(ChunkRenderer* renderer, const World* world, Texture2D tileset, Rectangle view) {
+    if (!renderer || !world || tileset.id == 0) return;
+
+    if (!renderer->hasMaterial) LoadChunkMaterial(renderer);
+    renderer->material.maps[MATERIAL_MAP_DIFFUSE].texture = tileset;
+    if (renderer->timeLocation >= 0) {
+        float time = (float)GetTime();
+        SetShaderValue(renderer->material.shader, renderer->timeLocation, &time, SHADER_UNIFORM_FLOAT);
+    }
+
+    TileAtlasLayout layout = { TILE_SIZE, tileset.width, tileset.height };
+    int minX = (int)floorf(view.x / CHUNK_PIXELS);
+    int minY = (int)floorf(view.y / CHUNK_PIXELS);
+    int maxX = (int)floorf((view.x + view.width) / CHUNK_PIXELS);
+    int maxY = (int)floorf((view.y + view.height) / CHUNK_PIXELS);
+
+    // Fixed maps have nothing outside their bounds
+    if (!world->stream) {
+        int lastX = (world->width - 1) / CACHE_CHUNK_SIZE;
+        int lastY = (world->height - 1) / CACHE_CHUNK_SIZE;
+        if (minX < 0) minX = 0;
+        if (minY < 0) minY = 0;
+        if (maxX > lastX) maxX = lastX;
+        if (maxY > lastY) maxY = lastY;
+    }
+
+    CollectChunkBuilds(renderer);
+    CollectChunkLodBuilds(renderer);
+    UpdateChunkPrefetcher(&renderer->prefetch, view, GetFrameTime());
+
+    // Zoomed out far enough, draw reduced groups instead of chunk meshes
+    int level = view.width > 0.0f ? SelectTileLodLevel((float)GetScreenWidth() / view.width) : 0;
+    if (level > 0 && PrepareChunkLodAtlas(renderer, tileset)) {
+        DrawChunkLods(renderer, world, view, level);
+        renderer->cache.frameCounter++;
+        return;
+    }
+
+    // Meshes bypass the batch, so flush what was queued before them
+    rlDrawRenderBatchActive();
+
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            // Inserting touches cached chunks and evicts the stalest when full
+            CachedChunk* chunk = InsertCachedChunk(&renderer->cache, x, y);
+            if (!chunk) continue;
+
+            ChunkMeshSlot* slot = &renderer->slots[chunk - renderer->cache.chunks];
+            bool hasOwnMesh = slot->hasMesh && slot->chunkX == x && slot->chunkY == y;
+
+            // A chunk that just came into view counts as a hit if its mesh
+            // was ready for it
+            bool wasShown = slot->shownFrame == renderer->cache.frameCounter - 1 &&
+                            slot->shownX == x && slot->shownY == y;
+            if (!wasShown) RecordChunkEntered(&renderer->prefetch, hasOwnMesh);
+            slot->shownFrame = renderer->cache.frameCounter;
+            slot->shownX = x;
+            slot->shownY = y;
+
+            // Resonance changes bake into the mesh like tile edits
+            const ResonanceChunk* field = GetResonanceChunk(world->resonance, x, y);
+            if (hasOwnMesh && field && field->version != slot->resonanceVersion) MarkChunkDirty(chunk);
+
+            if (chunk->isDirty && !slot->isBuilding) StartChunkBuild(renderer, world, chunk, layout);
+
+            // A slot reused from an evicted chunk must not show its tiles;
+            // a chunk being rebuilt after an edit keeps its old mesh
+            if (!hasOwnMesh) {
+                if (slot->hasMesh) ReleaseChunkMesh(slot);
+                DrawRectangleRec(chunk->bounds, CHUNK_PLACEHOLDER_COLOR);
+                continue;
+            }
+            if (slot->mesh.vertexCount == 0) continue;
+
+            DrawMesh(slot->mesh, renderer->material, MatrixTranslate(chunk->bounds.x, chunk->bounds.y, 0.0f));
+        }
+    }
+
+    PrefetchChunkBuilds(renderer, world, layout);
+    renderer->cache.frameCounter++;
+}
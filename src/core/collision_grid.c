@@ -0,0 +1,411 @@
+#include "../../include/collision_grid.h"
+#include "../../include/tile_grid.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISION_USE_SSE 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+END_EXTERNAL_WARNINGS
+
+#define COLLISION_ALL_BLOCKED (~(uint64_t)0)
+
+static bool IsBlocking(TileType type, ObjectType object) {
+    return !GetTileProperties(type)->isWalkable || IsObjectBlocking(object);
+}
+
+// Bits past the last column of each row, which must stay blocked
+static uint64_t GetPaddingMask(const CollisionGrid* grid) {
+    int used = grid->width & 63;
+    return used == 0 ? 0 : COLLISION_ALL_BLOCKED << used;
+}
+
+CollisionGrid* CreateCollisionGrid(int width, int height, int cellSize) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    CollisionGrid* grid = (CollisionGrid*)calloc(1, sizeof(CollisionGrid));
+    if (!grid) return NULL;
+
+    grid->width = width;
+    grid->height = height;
+    grid->cellSize = cellSize > 0 ? cellSize : TILE_SIZE;
+    grid->stride = (width + COLLISION_WORD_BITS - 1) / COLLISION_WORD_BITS;
+    grid->bits = (uint64_t*)malloc((size_t)grid->stride * (size_t)height * sizeof(uint64_t));
+    if (!grid->bits) {
+        free(grid);
+        return NULL;
+    }
+
+    ClearCollisionGrid(grid);
+    return grid;
+}
+
+void DestroyCollisionGrid(CollisionGrid* grid) {
+    if (!grid) return;
+
+    free(grid->bits);
+    free(grid);
+}
+
+void ClearCollisionGrid(CollisionGrid* grid) {
+    if (!grid || !grid->bits) return;
+
+    memset(grid->bits, 0, (size_t)grid->stride * (size_t)grid->height * sizeof(uint64_t));
+
+    uint64_t padding = GetPaddingMask(grid);
+    if (padding == 0) return;
+    for (int y = 0; y < grid->height; y++) {
+        grid->bits[(size_t)y * grid->stride + grid->stride - 1] |= padding;
+    }
+}
+
+void RebuildCollisionGrid(CollisionGrid* grid, const TileGrid* tiles) {
+    if (!grid || !tiles || !tiles->types) return;
+    if (tiles->count < (size_t)grid->width * (size_t)grid->height) return;
+
+    uint64_t padding = GetPaddingMask(grid);
+
+    // Build each word in a register instead of setting bits one at a time
+    for (int y = 0; y < grid->height; y++) {
+        const uint8_t* types = &tiles->types[(size_t)y * grid->width];
+        const uint8_t* objects = &tiles->objects[(size_t)y * grid->width];
+        uint64_t* row = &grid->bits[(size_t)y * grid->stride];
+
+        for (int word = 0; word < grid->stride; word++) {
+            int first = word * COLLISION_WORD_BITS;
+            int last = first + COLLISION_WORD_BITS < grid->width ? first + COLLISION_WORD_BITS : grid->width;
+
+            uint64_t bits = word == grid->stride - 1 ? padding : 0;
+            for (int x = first; x < last; x++) {
+                if (IsBlocking((TileType)types[x], (ObjectType)objects[x])) {
+                    bits |= (uint64_t)1 << (x - first);
+                }
+            }
+            row[word] = bits;
+        }
+    }
+}
+
+void UpdateCollisionCell(CollisionGrid* grid, int x, int y, TileType type, ObjectType object) {
+    if (!grid) return;
+    SetCellBlocked(grid, x, y, IsBlocking(type, object));
+}
+
+// Word of a row, with words outside the grid fully blocked
+static uint64_t GetRowWord(const CollisionGrid* grid, const uint64_t* row, int word) {
+    if (word < 0 || word >= grid->stride) return COLLISION_ALL_BLOCKED;
+    return row[word];
+}
+
+uint64_t GetCollisionRow(const CollisionGrid* grid, int x, int y) {
+    if (!grid || y < 0 || y >= grid->height) return COLLISION_ALL_BLOCKED;
+
+    const uint64_t* row = &grid->bits[(size_t)y * grid->stride];
+    int word = x >= 0 ? x / COLLISION_WORD_BITS : -((-x + COLLISION_WORD_BITS - 1) / COLLISION_WORD_BITS);
+    int shift = x - word * COLLISION_WORD_BITS;
+
+    uint64_t bits = GetRowWord(grid, row, word) >> shift;
+    if (shift != 0) {
+        bits |= GetRowWord(grid, row, word + 1) << (COLLISION_WORD_BITS - shift);
+    }
+    return bits;
+}
+
+bool IsCollisionAreaBlocked(const CollisionGrid* grid, int minX, int minY, int maxX, int maxY) {
+    if (!grid) return true;
+    if (maxX < minX || maxY < minY) return false;
+
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x += COLLISION_WORD_BITS) {
+            int span = maxX - x + 1;
+            uint64_t mask = span >= COLLISION_WORD_BITS ? COLLISION_ALL_BLOCKED
+                                                        : ((uint64_t)1 << span) - 1;
+            if (GetCollisionRow(grid, x, y) & mask) return true;
+        }
+    }
+    return false;
+}
+
+bool CheckCollisionGridRec(const CollisionGrid* grid, Rectangle bounds) {
+    if (!grid || bounds.width <= 0.0f || bounds.height <= 0.0f) return false;
+
+    float cellSize = (float)grid->cellSize;
+    int minX = (int)floorf(bounds.x / cellSize);
+    int minY = (int)floorf(bounds.y / cellSize);
+    int maxX = (int)ceilf((bounds.x + bounds.width) / cellSize) - 1;
+    int maxY = (int)ceilf((bounds.y + bounds.height) / cellSize) - 1;
+    return IsCollisionAreaBlocked(grid, minX, minY, maxX, maxY);
+}
+
+// Swept movement
+
+#define SWEEP_EPSILON 1e-3f   // Pixels of slack so touching edges never count as overlap
+
+// First and last cell covered by [low, high) along one axis
+static void GetCellSpan(float low, float high, float cellSize, int* first, int* last) {
+    *first = (int)floorf((low + SWEEP_EPSILON) / cellSize);
+    *last = (int)ceilf((high - SWEEP_EPSILON) / cellSize) - 1;
+}
+
+// Traversal state for one axis
+typedef struct SweepAxis {
+    int step;                 // -1, 0 or 1
+    int next;                 // Cell the leading edge enters next
+    float time;               // When it gets there, as a fraction of the motion
+    float delta;              // Time to cross one more cell
+} SweepAxis;
+
+static SweepAxis InitSweepAxis(float position, float size, float motion, float cellSize) {
+    SweepAxis axis = { 0, 0, INFINITY, INFINITY };
+    if (motion == 0.0f) return axis;
+
+    int first, last;
+    GetCellSpan(position, position + size, cellSize, &first, &last);
+    axis.step = motion > 0.0f ? 1 : -1;
+    axis.next = motion > 0.0f ? last + 1 : first - 1;
+
+    float boundary = (float)(motion > 0.0f ? axis.next : axis.next + 1) * cellSize;
+    float edge = motion > 0.0f ? position + size : position;
+    axis.time = fmaxf((boundary - edge) / motion, 0.0f);
+    axis.delta = cellSize / fabsf(motion);
+    return axis;
+}
+
+// Cells covered across an axis at some time, widened to every cell that
+// axis has already entered so exact corner ties cannot slip through
+static void GetCoveredSpan(const SweepAxis* axis, float low, float high, float cellSize, int* first, int* last) {
+    GetCellSpan(low, high, cellSize, first, last);
+    if (axis->step > 0 && axis->next - 1 > *last) *last = axis->next - 1;
+    if (axis->step < 0 && axis->next + 1 < *first) *first = axis->next + 1;
+}
+
+SweepResult SweepCollisionBox(const CollisionGrid* grid, Rectangle box, Vector2 motion) {
+    SweepResult result = { 1.0f, { box.x + motion.x, box.y + motion.y }, { 0.0f, 0.0f }, { 0.0f, 0.0f }, false };
+    if (!grid || (motion.x == 0.0f && motion.y == 0.0f)) return result;
+
+    float cellSize = (float)grid->cellSize;
+    SweepAxis axisX = InitSweepAxis(box.x, box.width, motion.x, cellSize);
+    SweepAxis axisY = InitSweepAxis(box.y, box.height, motion.y, cellSize);
+
+    for (;;) {
+        bool alongX = axisX.time <= axisY.time;
+        float time = alongX ? axisX.time : axisY.time;
+        if (time >= 1.0f) return result;
+
+        if (alongX) {
+            // Entering a column: test it across the rows the box spans now
+            float top = box.y + motion.y * time;
+            int first, last;
+            GetCoveredSpan(&axisY, top, top + box.height, cellSize, &first, &last);
+            if (IsCollisionAreaBlocked(grid, axisX.next, first, axisX.next, last)) {
+                result.time = time;
+                result.normal = (Vector2){ (float)-axisX.step, 0.0f };
+                result.position = (Vector2){
+                    axisX.step > 0 ? axisX.next * cellSize - box.width : (axisX.next + 1) * cellSize,
+                    top
+                };
+                break;
+            }
+            axisX.next += axisX.step;
+            axisX.time += axisX.delta;
+        } else {
+            // Entering a row: one masked row read per 64 columns
+            float left = box.x + motion.x * time;
+            int first, last;
+            GetCoveredSpan(&axisX, left, left + box.width, cellSize, &first, &last);
+            if (IsCollisionAreaBlocked(grid, first, axisY.next, last, axisY.next)) {
+                result.time = time;
+                result.normal = (Vector2){ 0.0f, (float)-axisY.step };
+                result.position = (Vector2){
+                    left,
+                    axisY.step > 0 ? axisY.next * cellSize - box.height : (axisY.next + 1) * cellSize
+                };
+                break;
+            }
+            axisY.next += axisY.step;
+            axisY.time += axisY.delta;
+        }
+    }
+
+    // Keep the motion along the surface, drop the part into it
+    float remaining = 1.0f - result.time;
+    result.hit = true;
+    result.slide = result.normal.x != 0.0f ? (Vector2){ 0.0f, motion.y * remaining }
+                                           : (Vector2){ motion.x * remaining, 0.0f };
+    return result;
+}
+
+Vector2 MoveCollisionBox(const CollisionGrid* grid, Rectangle box, Vector2 motion, bool* hit) {
+    bool contact = false;
+
+    for (int i = 0; i < COLLISION_MAX_SLIDES; i++) {
+        if (motion.x == 0.0f && motion.y == 0.0f) break;
+
+        SweepResult sweep = SweepCollisionBox(grid, box, motion);
+        box.x = sweep.position.x;
+        box.y = sweep.position.y;
+        if (!sweep.hit) break;
+
+        contact = true;
+        motion = sweep.slide;
+    }
+
+    if (hit) *hit = contact;
+    return (Vector2){ box.x, box.y };
+}
+
+// Batched queries
+
+#define COLLISION_POINT_LANES 4
+
+static int CountTrailingZeros(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+#ifdef COLLISION_USE_SSE
+// floor() of four floats. Truncation rounds negatives up, so subtract one
+// wherever it did; the compare mask is -1 in exactly those lanes. Values
+// out of int range come out as INT_MIN or INT_MAX, which are off the grid.
+static __m128i FloorToInt(__m128 value) {
+    __m128i truncated = _mm_cvttps_epi32(value);
+    __m128 roundedUp = _mm_cmplt_ps(value, _mm_cvtepi32_ps(truncated));
+    return _mm_add_epi32(truncated, _mm_castps_si128(roundedUp));
+}
+#endif
+
+int TestCollisionPoints(const CollisionGrid* grid, const Vector2* points, int count, bool* open) {
+    if (!points || !open || count <= 0) return 0;
+    if (!grid) {
+        memset(open, 0, (size_t)count * sizeof(bool));
+        return 0;
+    }
+
+    float cellSize = (float)grid->cellSize;
+    int openCount = 0;
+    int i = 0;
+
+#ifdef COLLISION_USE_SSE
+    // Four points per pass: deinterleave x and y, then divide and floor
+    // together. Only the bit lookups stay scalar.
+    const __m128 size = _mm_set1_ps(cellSize);
+    int cellX[COLLISION_POINT_LANES];
+    int cellY[COLLISION_POINT_LANES];
+    for (; i + COLLISION_POINT_LANES <= count; i += COLLISION_POINT_LANES) {
+        __m128 low = _mm_loadu_ps(&points[i].x);
+        __m128 high = _mm_loadu_ps(&points[i + 2].x);
+        __m128 x = _mm_div_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)), size);
+        __m128 y = _mm_div_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)), size);
+        _mm_storeu_si128((__m128i*)cellX, FloorToInt(x));
+        _mm_storeu_si128((__m128i*)cellY, FloorToInt(y));
+
+        for (int lane = 0; lane < COLLISION_POINT_LANES; lane++) {
+            open[i + lane] = !IsCellBlocked(grid, cellX[lane], cellY[lane]);
+            openCount += open[i + lane];
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        open[i] = !IsCellBlocked(grid, (int)floorf(points[i].x / cellSize), (int)floorf(points[i].y / cellSize));
+        openCount += open[i];
+    }
+    return openCount;
+}
+
+int FindBlockedCells(const CollisionGrid* grid, Rectangle bounds, CollisionCell* cells, int maxCells) {
+    if (!grid || bounds.width <= 0.0f || bounds.height <= 0.0f) return 0;
+    if (!cells) maxCells = 0;
+
+    float cellSize = (float)grid->cellSize;
+    int minX = (int)floorf(bounds.x / cellSize);
+    int minY = (int)floorf(bounds.y / cellSize);
+    int maxX = (int)ceilf((bounds.x + bounds.width) / cellSize) - 1;
+    int maxY = (int)ceilf((bounds.y + bounds.height) / cellSize) - 1;
+
+    // One row read per 64 cells, then one step per set bit
+    int total = 0;
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x += COLLISION_WORD_BITS) {
+            int span = maxX - x + 1;
+            uint64_t mask = span >= COLLISION_WORD_BITS ? COLLISION_ALL_BLOCKED
+                                                        : ((uint64_t)1 << span) - 1;
+            uint64_t bits = GetCollisionRow(grid, x, y) & mask;
+            while (bits) {
+                if (total < maxCells) {
+                    cells[total] = (CollisionCell){ x + CountTrailingZeros(bits), y };
+                }
+                total++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    return total;
+}
+
+CollisionRayHit CastCellRay(Vector2 origin, Vector2 motion, float cellSize,
+                            CellBlockedFunc isBlocked, const void* context) {
+    CollisionRayHit result = { 1.0f, { 0, 0 }, false };
+    int x = (int)floorf(origin.x / cellSize);
+    int y = (int)floorf(origin.y / cellSize);
+
+    int stepX = motion.x > 0.0f ? 1 : (motion.x < 0.0f ? -1 : 0);
+    int stepY = motion.y > 0.0f ? 1 : (motion.y < 0.0f ? -1 : 0);
+    float nextX = stepX == 0 ? INFINITY : ((float)(stepX > 0 ? x + 1 : x) * cellSize - origin.x) / motion.x;
+    float nextY = stepY == 0 ? INFINITY : ((float)(stepY > 0 ? y + 1 : y) * cellSize - origin.y) / motion.y;
+    float deltaX = stepX == 0 ? INFINITY : cellSize / fabsf(motion.x);
+    float deltaY = stepY == 0 ? INFINITY : cellSize / fabsf(motion.y);
+
+    float time = 0.0f;
+    while (!isBlocked(context, x, y)) {
+        time = fminf(nextX, nextY);
+        if (time >= 1.0f) return result;
+
+        if (nextX <= nextY) {
+            x += stepX;
+            nextX += deltaX;
+        } else {
+            y += stepY;
+            nextY += deltaY;
+        }
+    }
+
+    result.time = time;
+    result.cell = (CollisionCell){ x, y };
+    result.hit = true;
+    return result;
+}
+
+static bool IsGridCellBlocked(const void* context, int x, int y) {
+    return IsCellBlocked((const CollisionGrid*)context, x, y);
+}
+
+void CastCollisionRays(const CollisionGrid* grid, const Vector2* origins, const Vector2* motions,
+                       int count, CollisionRayHit* hits) {
+    if (!origins || !motions || !hits) return;
+
+    for (int i = 0; i < count; i++) {
+        if (!grid) {
+            hits[i] = (CollisionRayHit){ 0.0f, { 0, 0 }, true };
+            continue;
+        }
+        hits[i] = CastCellRay(origins[i], motions[i], (float)grid->cellSize, IsGridCellBlocked, grid);
+    }
+}
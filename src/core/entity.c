@@ -59,6 +59,7 @@ Entity* CreateEntity(EntityPool* pool, EntityType type) {
     }
     
     Entity* entity = &pool->entities[pool->count++];
+    entity->id = ++pool->nextEntityId;
     entity->type = type;
     entity->components = COMPONENT_NONE;
     entity->active = true;
@@ -9,6 +9,8 @@ END_EXTERNAL_WARNINGS
 #include "../../include/world.h"
 #include "../../include/map_types.h"
 #include "../../include/resource_manager.h"
+#include "../../include/random.h"
+#include "../../include/chunk_renderer.h"
 #include <stdlib.h>
 
 // Internal helper functions
@@ -148,28 +150,18 @@ void GenerateEstateMap(EstateMap* map) {
 void DrawEstateMap(const EstateMap* map) {
     if (!map || !map->world) return;
     
-    // Draw tiles
-    for (int y = 0; y < ESTATE_HEIGHT; y++) {
-        for (int x = 0; x < ESTATE_WIDTH; x++) {
-            // Calculate screen position
-            Vector2 position = { x * TILE_SIZE, y * TILE_SIZE };
-            
-            // Get tile and object types
-            TileType tileType = GetTile(map->world, x, y);
-            ObjectType objectType = GetMapObjectAt(map->world, x, y);
-            
-            // Draw tile
-            Rectangle tileSource = { tileType * TILE_SIZE, 0, TILE_SIZE, TILE_SIZE };
-            Rectangle tileDest = { position.x, position.y, TILE_SIZE, TILE_SIZE };
-            DrawTexturePro(map->tileset, tileSource, tileDest, (Vector2){0, 0}, 0.0f, WHITE);
-            
-            // Draw object if present
-            if (objectType != OBJECT_NONE) {
-                Rectangle objectSource = { objectType * TILE_SIZE, TILE_SIZE, TILE_SIZE, TILE_SIZE };
-                DrawTexturePro(map->tileset, objectSource, tileDest, (Vector2){0, 0}, 0.0f, WHITE);
-            }
-        }
-    }
+    // One prebuilt mesh per visible chunk instead of a draw call per tile
+    const World* world = map->world;
+    Camera2D camera = world->camera;
+    Rectangle view = {
+        camera.target.x - camera.offset.x / camera.zoom,
+        camera.target.y - camera.offset.y / camera.zoom,
+        GetScreenWidth() / camera.zoom,
+        GetScreenHeight() / camera.zoom
+    };
+
+    // Meshes bake the resonance field as UpdateWorld last left it
+    DrawChunkRenderer(world->renderer, world, map->tileset, view);
 }
 
 // Internal helper functions
@@ -188,6 +180,7 @@ static void CreateGardens(World* world, int centerX, int centerY, int courtyardS
     };
     
     // Create each garden
+    RandomStream rng = CreateRandomStream(world->seed, RANDOM_PURPOSE_GEN_GARDENS, 0);
     for (int i = 0; i < 4; i++) {
         int gx = (int)gardenPositions[i].x;
         int gy = (int)gardenPositions[i].y;
@@ -199,9 +192,9 @@ static void CreateGardens(World* world, int centerX, int centerY, int courtyardS
                     SetTile(world, x, y, TILE_GRASS);
                     
                     // Add random decorative objects
-                    if (rand() % 100 < 30) {
+                    if (NextRandomInt(&rng, 0, 99) < 30) {
                         ObjectType objects[] = {OBJECT_TREE, OBJECT_BUSH, OBJECT_FLOWER};
-                        SetMapObjectAt(world, x, y, objects[rand() % 3]);
+                        SetMapObjectAt(world, x, y, objects[NextRandomInt(&rng, 0, 2)]);
                     }
                 }
             }
@@ -0,0 +1,306 @@
+// Job system - small fixed worker pool with a shared FIFO queue.
+// Kept free of raylib includes so the platform headers do not collide
+// with raylib symbols (Rectangle, CloseWindow, ...).
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../include/job_system.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef SRWLOCK JobLock;
+typedef CONDITION_VARIABLE JobCond;
+typedef HANDLE JobThread;
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_mutex_t JobLock;
+typedef pthread_cond_t JobCond;
+typedef pthread_t JobThread;
+#endif
+
+typedef struct Job {
+    JobFunc func;
+    void* context;
+    JobCounter* counter;
+} Job;
+
+struct JobSystem {
+    JobThread threads[MAX_JOB_WORKERS];
+    int workerCount;
+    Job queue[JOB_QUEUE_CAPACITY];
+    int head;
+    int count;
+    bool shuttingDown;
+    JobLock lock;
+    JobCond workAvailable;
+    JobCond workFinished;
+};
+
+static JobSystem* g_jobSystem = NULL;
+
+// Platform wrappers
+#ifdef _WIN32
+static void InitLock(JobLock* lock) { InitializeSRWLock(lock); }
+static void DestroyLock(JobLock* lock) { (void)lock; }
+static void Lock(JobLock* lock) { AcquireSRWLockExclusive(lock); }
+static void Unlock(JobLock* lock) { ReleaseSRWLockExclusive(lock); }
+static void InitCond(JobCond* cond) { InitializeConditionVariable(cond); }
+static void DestroyCond(JobCond* cond) { (void)cond; }
+static void WaitCond(JobCond* cond, JobLock* lock) { SleepConditionVariableSRW(cond, lock, INFINITE, 0); }
+static void SignalCond(JobCond* cond) { WakeConditionVariable(cond); }
+static void BroadcastCond(JobCond* cond) { WakeAllConditionVariable(cond); }
+
+static int GetCoreCount(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+long JobAtomicAdd(volatile long* value, long amount) {
+    return InterlockedExchangeAdd(value, amount) + amount;
+}
+
+long JobAtomicLoad(const volatile long* value) {
+    return InterlockedCompareExchange((volatile long*)value, 0, 0);
+}
+
+void JobAtomicStore(volatile long* value, long newValue) {
+    InterlockedExchange(value, newValue);
+}
+#else
+static void InitLock(JobLock* lock) { pthread_mutex_init(lock, NULL); }
+static void DestroyLock(JobLock* lock) { pthread_mutex_destroy(lock); }
+static void Lock(JobLock* lock) { pthread_mutex_lock(lock); }
+static void Unlock(JobLock* lock) { pthread_mutex_unlock(lock); }
+static void InitCond(JobCond* cond) { pthread_cond_init(cond, NULL); }
+static void DestroyCond(JobCond* cond) { pthread_cond_destroy(cond); }
+static void WaitCond(JobCond* cond, JobLock* lock) { pthread_cond_wait(cond, lock); }
+static void SignalCond(JobCond* cond) { pthread_cond_signal(cond); }
+static void BroadcastCond(JobCond* cond) { pthread_cond_broadcast(cond); }
+
+static int GetCoreCount(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+
+long JobAtomicAdd(volatile long* value, long amount) {
+    return __atomic_add_fetch(value, amount, __ATOMIC_ACQ_REL);
+}
+
+long JobAtomicLoad(const volatile long* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+void JobAtomicStore(volatile long* value, long newValue) {
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+#endif
+
+// Pops the oldest job. Caller must hold the lock.
+static bool PopJob(JobSystem* jobs, Job* job) {
+    if (jobs->count == 0) return false;
+    *job = jobs->queue[jobs->head];
+    jobs->head = (jobs->head + 1) % JOB_QUEUE_CAPACITY;
+    jobs->count--;
+    return true;
+}
+
+static void RunJob(JobSystem* jobs, const Job* job) {
+    job->func(job->context);
+    if (job->counter && JobAtomicAdd(&job->counter->pending, -1) == 0) {
+        Lock(&jobs->lock);
+        BroadcastCond(&jobs->workFinished);
+        Unlock(&jobs->lock);
+    }
+}
+
+static void WorkerLoop(JobSystem* jobs) {
+    for (;;) {
+        Job job;
+        Lock(&jobs->lock);
+        while (jobs->count == 0 && !jobs->shuttingDown) {
+            WaitCond(&jobs->workAvailable, &jobs->lock);
+        }
+        if (!PopJob(jobs, &job)) {
+            Unlock(&jobs->lock);
+            return;
+        }
+        Unlock(&jobs->lock);
+        RunJob(jobs, &job);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI WorkerEntry(LPVOID param) {
+    WorkerLoop((JobSystem*)param);
+    return 0;
+}
+#else
+static void* WorkerEntry(void* param) {
+    WorkerLoop((JobSystem*)param);
+    return NULL;
+}
+#endif
+
+JobSystem* CreateJobSystem(int workerCount) {
+    if (workerCount <= 0) {
+        workerCount = GetCoreCount() - 1;
+    }
+    if (workerCount > MAX_JOB_WORKERS) workerCount = MAX_JOB_WORKERS;
+    if (workerCount < 0) workerCount = 0;
+
+    JobSystem* jobs = (JobSystem*)calloc(1, sizeof(JobSystem));
+    if (!jobs) return NULL;
+
+    InitLock(&jobs->lock);
+    InitCond(&jobs->workAvailable);
+    InitCond(&jobs->workFinished);
+
+    for (int i = 0; i < workerCount; i++) {
+#ifdef _WIN32
+        jobs->threads[i] = CreateThread(NULL, 0, WorkerEntry, jobs, 0, NULL);
+        if (!jobs->threads[i]) break;
+#else
+        if (pthread_create(&jobs->threads[i], NULL, WorkerEntry, jobs) != 0) break;
+#endif
+        jobs->workerCount++;
+    }
+
+    return jobs;
+}
+
+void DestroyJobSystem(JobSystem* jobs) {
+    if (!jobs) return;
+
+    Lock(&jobs->lock);
+    jobs->shuttingDown = true;
+    BroadcastCond(&jobs->workAvailable);
+    Unlock(&jobs->lock);
+
+    for (int i = 0; i < jobs->workerCount; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(jobs->threads[i], INFINITE);
+        CloseHandle(jobs->threads[i]);
+#else
+        pthread_join(jobs->threads[i], NULL);
+#endif
+    }
+
+    DestroyCond(&jobs->workFinished);
+    DestroyCond(&jobs->workAvailable);
+    DestroyLock(&jobs->lock);
+    free(jobs);
+}
+
+JobSystem* GetJobSystem(void) {
+    if (!g_jobSystem) {
+        g_jobSystem = CreateJobSystem(0);
+    }
+    return g_jobSystem;
+}
+
+void UnloadJobSystem(void) {
+    DestroyJobSystem(g_jobSystem);
+    g_jobSystem = NULL;
+}
+
+int GetJobWorkerCount(const JobSystem* jobs) {
+    return jobs ? jobs->workerCount : 0;
+}
+
+void SubmitJob(JobSystem* jobs, JobFunc func, void* context, JobCounter* counter) {
+    if (!func) return;
+
+    Job job = { func, context, counter };
+    if (counter) JobAtomicAdd(&counter->pending, 1);
+
+    if (jobs && jobs->workerCount > 0) {
+        Lock(&jobs->lock);
+        if (jobs->count < JOB_QUEUE_CAPACITY) {
+            jobs->queue[(jobs->head + jobs->count) % JOB_QUEUE_CAPACITY] = job;
+            jobs->count++;
+            SignalCond(&jobs->workAvailable);
+            Unlock(&jobs->lock);
+            return;
+        }
+        Unlock(&jobs->lock);
+    }
+
+    // No workers or queue full - run on the calling thread
+    func(context);
+    if (counter) JobAtomicAdd(&counter->pending, -1);
+}
+
+bool IsJobCounterDone(const JobCounter* counter) {
+    return !counter || JobAtomicLoad(&counter->pending) <= 0;
+}
+
+void WaitForJobs(JobSystem* jobs, JobCounter* counter) {
+    if (!counter) return;
+    if (!jobs) {
+        while (!IsJobCounterDone(counter)) {}
+        return;
+    }
+
+    // Help drain the queue instead of idling while the batch finishes
+    for (;;) {
+        Job job;
+        Lock(&jobs->lock);
+        while (!IsJobCounterDone(counter) && jobs->count == 0) {
+            WaitCond(&jobs->workFinished, &jobs->lock);
+        }
+        if (IsJobCounterDone(counter)) {
+            Unlock(&jobs->lock);
+            return;
+        }
+        bool popped = PopJob(jobs, &job);
+        Unlock(&jobs->lock);
+        if (popped) RunJob(jobs, &job);
+    }
+}
+
+typedef struct RangeJob {
+    JobRangeFunc func;
+    void* context;
+    int begin;
+    int end;
+} RangeJob;
+
+static void RunRangeJob(void* param) {
+    RangeJob* range = (RangeJob*)param;
+    range->func(range->context, range->begin, range->end);
+}
+
+void ParallelFor(JobSystem* jobs, int count, int grainSize, JobRangeFunc func, void* context) {
+    if (!func || count <= 0) return;
+    if (grainSize <= 0) grainSize = 1;
+
+    int rangeCount = (count + grainSize - 1) / grainSize;
+    if (!jobs || jobs->workerCount == 0 || rangeCount == 1) {
+        func(context, 0, count);
+        return;
+    }
+
+    RangeJob* ranges = (RangeJob*)malloc((size_t)rangeCount * sizeof(RangeJob));
+    if (!ranges) {
+        func(context, 0, count);
+        return;
+    }
+
+    JobCounter counter = {0};
+    for (int i = 0; i < rangeCount; i++) {
+        ranges[i].func = func;
+        ranges[i].context = context;
+        ranges[i].begin = i * grainSize;
+        ranges[i].end = ranges[i].begin + grainSize < count ? ranges[i].begin + grainSize : count;
+        SubmitJob(jobs, RunRangeJob, &ranges[i], &counter);
+    }
+
+    WaitForJobs(jobs, &counter);
+    free(ranges);
+}
@@ -14,132 +14,221 @@ END_EXTERNAL_WARNINGS
 #include "../../include/world.h"
 #include "../../include/map_types.h"
 #include "../../include/map_system.h"
+#include "../../include/chunk_cache.h"
 #include "../../include/resource_manager.h"
+#include "../../include/pathfinding.h"
+#include "../../include/tile_grid.h"
+#include "../../include/world_stream.h"
+#include "../../include/collision_grid.h"
+#include "../../include/region_map.h"
+#include "../../include/resonance_field.h"
+#include "../../include/chunk_renderer.h"
 
 // Internal functions
-static void* SafeAlloc(size_t size) {
-    void* ptr = calloc(1, size);
-    if (!ptr) {
-        TraceLog(LOG_ERROR, "Memory allocation failed");
-        exit(1);
-    }
-    return ptr;
-}
-
-static bool IsInBounds(int x, int y) {
-    return x >= 0 && x < ESTATE_WIDTH && y >= 0 && y < ESTATE_HEIGHT;
+static bool IsInBounds(const World* world, int x, int y) {
+    return world->tiles.types && x >= 0 && x < world->width && y >= 0 && y < world->height;
 }
 
-static int GetIndex(int x, int y) {
-    return y * ESTATE_WIDTH + x;
+static int GetIndex(const World* world, int x, int y) {
+    return y * world->width + x;
 }
 
 // Map tile and object access functions
 void SetTile(World* world, int x, int y, TileType type) {
-    if (!world || !IsInBounds(x, y)) return;
-    world->tiles[GetIndex(x, y)].type = type;
+    if (!world) return;
+    if (world->stream) {
+        Tile tile = GetStreamTile(world->stream, x, y);
+        tile.type = type;
+        if (SetStreamTile(world->stream, x, y, tile)) OnTileChanged(world, x, y);
+        return;
+    }
+    if (!IsInBounds(world, x, y)) return;
+    world->tiles.types[GetIndex(world, x, y)] = (uint8_t)type;
+    OnTileChanged(world, x, y);
 }
 
 void SetMapObjectAt(World* world, int x, int y, ObjectType type) {
-    if (!world || !IsInBounds(x, y)) return;
-    world->tiles[GetIndex(x, y)].objectType = type;
+    if (!world) return;
+    if (world->stream) {
+        Tile tile = GetStreamTile(world->stream, x, y);
+        tile.objectType = type;
+        if (SetStreamTile(world->stream, x, y, tile)) OnTileChanged(world, x, y);
+        return;
+    }
+    if (!IsInBounds(world, x, y)) return;
+    world->tiles.objects[GetIndex(world, x, y)] = (uint8_t)type;
+    OnTileChanged(world, x, y);
 }
 
 TileType GetTile(const World* world, int x, int y) {
-    if (!world || !IsInBounds(x, y)) return TILE_NONE;
-    return world->tiles[GetIndex(x, y)].type;
+    if (!world) return TILE_NONE;
+    if (world->stream) return GetStreamTile(world->stream, x, y).type;
+    if (!IsInBounds(world, x, y)) return TILE_NONE;
+    return GetGridTileType(&world->tiles, GetIndex(world, x, y));
 }
 
 ObjectType GetMapObjectAt(const World* world, int x, int y) {
-    if (!world || !IsInBounds(x, y)) return OBJECT_NONE;
-    return world->tiles[GetIndex(x, y)].objectType;
+    if (!world) return OBJECT_NONE;
+    if (world->stream) return GetStreamTile(world->stream, x, y).objectType;
+    if (!IsInBounds(world, x, y)) return OBJECT_NONE;
+    return GetGridObjectType(&world->tiles, GetIndex(world, x, y));
+}
+
+// Keeps derived navigation data in step with the tile grid
+void OnTileChanged(World* world, int x, int y) {
+    if (!world) return;
+
+    if (world->collision && IsInBounds(world, x, y)) {
+        int index = GetIndex(world, x, y);
+        UpdateCollisionCell(world->collision, x, y,
+                            GetGridTileType(&world->tiles, index), GetGridObjectType(&world->tiles, index));
+        UpdateRegionTile(world->regions, x, y, !IsCellBlocked(world->collision, x, y));
+        UpdateResonanceTile(world->resonance, x, y, GetGridObjectType(&world->tiles, index),
+                            !IsCellBlocked(world->collision, x, y));
+    }
+
+    if (world->pathGraph) {
+        RepairHPATile(world->pathGraph, world, x, y);
+    }
+
+    MarkChunkMeshDirty(world->renderer, x, y);
 }
 
 // Helper functions
 bool IsWalkableGrid(const World* world, int x, int y) {
-    if (!world || !IsInBounds(x, y)) return false;
-    TileType type = world->tiles[GetIndex(x, y)].type;
-    return type != TILE_WALL && type != TILE_WATER;
+    if (!world) return false;
+    if (world->stream) {
+        // Unloaded tiles block so nothing walks off the resident area
+        if (!IsStreamTileResident(world->stream, x, y)) return false;
+        Tile tile = GetStreamTile(world->stream, x, y);
+        return GetTileProperties(tile.type)->isWalkable && !IsObjectBlocking(tile.objectType);
+    }
+    if (!IsInBounds(world, x, y)) return false;
+    if (world->collision) return !IsCellBlocked(world->collision, x, y);
+    int index = GetIndex(world, x, y);
+    return GetTileProperties(GetGridTileType(&world->tiles, index))->isWalkable &&
+           !IsObjectBlocking(GetGridObjectType(&world->tiles, index));
+}
+
+bool RebuildWorldCollision(World* world) {
+    if (!world || !world->tiles.types) return false;
+
+    // Replace a grid left over from a map of another size
+    if (world->collision &&
+        (world->collision->width != world->width || world->collision->height != world->height)) {
+        DestroyCollisionGrid(world->collision);
+        world->collision = NULL;
+    }
+
+    if (!world->collision) {
+        world->collision = CreateCollisionGrid(world->width, world->height, TILE_SIZE);
+        if (!world->collision) return false;
+    }
+
+    RebuildCollisionGrid(world->collision, &world->tiles);
+    RebuildRegionMap(world->regions, world->collision);
+    RebuildResonanceField(world->resonance, &world->tiles, world->collision);
+    return true;
 }
 
 bool IsWalkable(const World* world, Vector2 position) {
     if (!world) return false;
     
     // Convert world coordinates to grid coordinates
-    int gridX = (int)(position.x / TILE_SIZE);
-    int gridY = (int)(position.y / TILE_SIZE);
+    int gridX = (int)floorf(position.x / TILE_SIZE);
+    int gridY = (int)floorf(position.y / TILE_SIZE);
     
     return IsWalkableGrid(world, gridX, gridY);
 }
 
+// Batched queries
+int AreWalkable(const World* world, const Vector2* positions, int count, bool* walkable) {
+    if (!world || !positions || !walkable || count <= 0) return 0;
+    if (world->collision && !world->stream) {
+        return TestCollisionPoints(world->collision, positions, count, walkable);
+    }
+
+    int walkableCount = 0;
+    for (int i = 0; i < count; i++) {
+        walkable[i] = IsWalkable(world, positions[i]);
+        walkableCount += walkable[i];
+    }
+    return walkableCount;
+}
+
+int FindBlockingTiles(const World* world, Rectangle area, CollisionCell* tiles, int maxTiles) {
+    if (!world || area.width <= 0.0f || area.height <= 0.0f) return 0;
+    if (world->collision && !world->stream) {
+        return FindBlockedCells(world->collision, area, tiles, maxTiles);
+    }
+    if (!tiles) maxTiles = 0;
+
+    int minX = (int)floorf(area.x / TILE_SIZE);
+    int minY = (int)floorf(area.y / TILE_SIZE);
+    int maxX = (int)ceilf((area.x + area.width) / TILE_SIZE) - 1;
+    int maxY = (int)ceilf((area.y + area.height) / TILE_SIZE) - 1;
+
+    int total = 0;
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            if (IsWalkableGrid(world, x, y)) continue;
+            if (total < maxTiles) tiles[total] = (CollisionCell){ x, y };
+            total++;
+        }
+    }
+    return total;
+}
+
+static bool IsWorldCellBlocked(const void* context, int x, int y) {
+    return !IsWalkableGrid((const World*)context, x, y);
+}
+
+void CastWorldRays(const World* world, const Vector2* origins, const Vector2* motions, int count, CollisionRayHit* hits) {
+    if (!world || !origins || !motions || !hits) return;
+    if (world->collision && !world->stream) {
+        CastCollisionRays(world->collision, origins, motions, count, hits);
+        return;
+    }
+
+    // Same cell walk, testing each cell through the tiles or stream
+    for (int i = 0; i < count; i++) {
+        hits[i] = CastCellRay(origins[i], motions[i], (float)TILE_SIZE, IsWorldCellBlocked, world);
+    }
+}
+
 // Core map functions
 bool InitMap(World* world) {
     if (!world) return false;
     
-    // Initialize map tiles
-    world->tiles = (Tile*)SafeAlloc(ESTATE_WIDTH * ESTATE_HEIGHT * sizeof(Tile));
-    if (!world->tiles) return false;
-    
-    // Set default tiles
-    for (int y = 0; y < ESTATE_HEIGHT; y++) {
-        for (int x = 0; x < ESTATE_WIDTH; x++) {
-            SetTile(world, x, y, TILE_GRASS);
-            SetMapObjectAt(world, x, y, OBJECT_NONE);
-            
-            // Initialize tile properties
-            int index = GetIndex(x, y);
-            world->tiles[index].properties = (TileProperties){
-                .isWalkable = true,
-                .isDestructible = false,
-                .isInteractive = false,
-                .friction = 1.0f,
-                .resonance = 0.0f,
-                .color = GREEN,
-                .customProperties = NULL
-            };
-        }
+    // Initialize map tiles to grass; per-type data comes from the shared table
+    if (!InitTileGrid(&world->tiles, (size_t)(world->width * world->height), TILE_GRASS)) {
+        TraceLog(LOG_ERROR, "Memory allocation failed");
+        return false;
     }
     
-    return true;
+    InvalidateChunkRenderer(world->renderer);
+    return RebuildWorldCollision(world);
 }
 
 void UnloadMap(World* world) {
-    if (!world || !world->tiles) return;
-    
-    // Free any custom properties
-    for (int i = 0; i < ESTATE_WIDTH * ESTATE_HEIGHT; i++) {
-        if (world->tiles[i].properties.customProperties) {
-            free((void*)world->tiles[i].properties.customProperties);
-        }
-    }
+    if (!world || !world->tiles.types) return;
     
-    free(world->tiles);
-    world->tiles = NULL;
+    // Frees the planes, the overrides and their property store in one go
+    FreeTileGrid(&world->tiles);
+    DestroyCollisionGrid(world->collision);
+    world->collision = NULL;
 }
 
 // Helper function to set custom properties for a tile
 void SetTileCustomProperties(World* world, int x, int y, const char* properties) {
-    if (!world || !IsInBounds(x, y)) return;
-    
-    int index = GetIndex(x, y);
-    Tile* tile = &world->tiles[index];
+    if (!world || !IsInBounds(world, x, y)) return;
     
-    // Free existing custom properties if any
-    if (tile->properties.customProperties) {
-        free((void*)tile->properties.customProperties);
-    }
-    
-    // Set new custom properties
-    char* key = _strdup(properties);
-    tile->properties.customProperties = key;
+    int index = GetIndex(world, x, y);
     
-    // Mark chunk as dirty
-    int chunkX = x / CACHE_CHUNK_SIZE;
-    int chunkY = y / CACHE_CHUNK_SIZE;
-    Vector2 gridPos = {(float)chunkX, (float)chunkY};
+    // Parsed once and shared with every tile of the same properties;
+    // stored sparsely, most tiles never have any
+    if (!SetTileOverride(&world->tiles, index, properties)) return;
     
-    CachedChunk* chunk = GetChunk(&world->mapSystem->currentMap->cache, gridPos);
-    if (chunk) {
-        chunk->isDirty = true;
-    }
+    // The map's own grid is the one saved; this also redraws the tile
+    SetMapTileProperties(world->mapSystem, x, y, properties);
 }
\ No newline at end of file
@@ -15,14 +15,17 @@ TileType GetTile(const World* world, int x, int y);
 void SetTile(World* world, int x, int y, TileType type);
 ObjectType GetMapObjectAt(const World* world, int x, int y);
 void SetMapObjectAt(World* world, int x, int y, ObjectType type);
+void SetTileCustomProperties(World* world, int x, int y, const char* properties);  // JSON, NULL clears them
 
 // Helper functions
 bool IsWalkable(const World* world, Vector2 position);
 bool IsWalkableGrid(const World* world, int x, int y);
+int AreWalkable(const World* world, const Vector2* positions, int count, bool* walkable);
+int FindBlockingTiles(const World* world, Rectangle area, CollisionCell* tiles, int maxTiles);
+void CastWorldRays(const World* world, const Vector2* origins, const Vector2* motions, int count, CollisionRayHit* hits);
 
 // Internal functions - not exposed in header
-static bool IsInBounds(int x, int y);
-static int GetIndex(int x, int y);
-static void* SafeAlloc(size_t size);
+static bool IsInBounds(const World* world, int x, int y);
+static int GetIndex(const World* world, int x, int y);
 
 #endif // MAP_H 
\ No newline at end of file
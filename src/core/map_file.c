@@ -0,0 +1,883 @@
+// Map files - chunked, run-length encoded tile planes. Readers map the
+// file instead of reading it, so opening costs the same for any map size
+// and processes running the same map share its pages. Kept free of raylib
+// includes because the platform headers collide with raylib symbols.
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../include/map_file.h"
+#include "../../include/tile_grid.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define MAP_PLANE_MAX_LITERAL 128
+#define MAP_PLANE_MAX_RUN 129
+#define MAP_FILE_CHUNK_TILES (MAP_FILE_CHUNK_SIZE * MAP_FILE_CHUNK_SIZE)
+#define MAP_FILE_MAX_SIDE 65536          // Keeps tile indices inside an int
+#define MAP_FILE_PATH_LENGTH 512
+#define MAP_PATCH_ENTRY_HEADER 8          // Chunk x, chunk y, record size
+
+struct MapFile {
+    const uint8_t* data;              // The whole file, mapped read-only
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+    int width;
+    int height;
+    int chunksX;
+    int chunksY;
+    uint32_t indexOffset;
+    uint32_t stringTableOffset;
+    uint32_t stringCount;
+    uint32_t generation;              // Full saves so far, matched by the log
+    uint32_t* stringOffsets;          // Built on the first custom property read
+    char* scratch;                    // Terminated copy of one string
+    size_t scratchCapacity;
+    uint16_t* stringSets;             // Property set each string became, per id
+    const struct PropertyStore* stringSetStore;  // Store those sets are in
+    uint8_t* patch;                   // Patch log read at open, NULL without one
+    uint32_t* patchEntries;           // Latest log entry per chunk, 0 for none
+};
+
+struct MapPatch {
+    int width;
+    int height;
+    int chunkCount;
+    uint8_t* data;                    // Encoded log entries
+    size_t size;
+    size_t capacity;
+    bool failed;
+};
+
+// Little-endian encoding
+
+static void StoreU16(uint8_t* at, uint16_t value) {
+    at[0] = (uint8_t)value;
+    at[1] = (uint8_t)(value >> 8);
+}
+
+static void StoreU32(uint8_t* at, uint32_t value) {
+    at[0] = (uint8_t)value;
+    at[1] = (uint8_t)(value >> 8);
+    at[2] = (uint8_t)(value >> 16);
+    at[3] = (uint8_t)(value >> 24);
+}
+
+static uint16_t LoadU16(const uint8_t* at) {
+    return (uint16_t)(at[0] | at[1] << 8);
+}
+
+static uint32_t LoadU32(const uint8_t* at) {
+    return (uint32_t)at[0] | (uint32_t)at[1] << 8 | (uint32_t)at[2] << 16 | (uint32_t)at[3] << 24;
+}
+
+// Plane coding
+
+size_t GetMapPlaneBound(size_t count) {
+    return count + (count + MAP_PLANE_MAX_LITERAL - 1) / MAP_PLANE_MAX_LITERAL;
+}
+
+size_t EncodeMapPlane(const uint8_t* data, size_t count, uint8_t* out) {
+    size_t written = 0;
+    size_t i = 0;
+
+    while (i < count) {
+        size_t run = 1;
+        while (i + run < count && run < MAP_PLANE_MAX_RUN && data[i + run] == data[i]) run++;
+
+        if (run >= 2) {
+            out[written++] = (uint8_t)(run + 126);
+            out[written++] = data[i];
+            i += run;
+            continue;
+        }
+
+        // Literals stop where the next run begins
+        size_t start = i;
+        while (i < count && i - start < MAP_PLANE_MAX_LITERAL) {
+            if (i + 1 < count && data[i + 1] == data[i]) break;
+            i++;
+        }
+        out[written++] = (uint8_t)(i - start - 1);
+        memcpy(&out[written], &data[start], i - start);
+        written += i - start;
+    }
+    return written;
+}
+
+size_t DecodeMapPlane(const uint8_t* in, size_t inSize, uint8_t* out, size_t count) {
+    size_t read = 0;
+    size_t written = 0;
+
+    while (written < count) {
+        if (read >= inSize) return 0;
+
+        uint8_t control = in[read++];
+        if (control < 128) {
+            size_t length = (size_t)control + 1;
+            if (read + length > inSize || written + length > count) return 0;
+            memcpy(&out[written], &in[read], length);
+            read += length;
+            written += length;
+        } else {
+            size_t length = (size_t)control - 126;
+            if (read >= inSize || written + length > count) return 0;
+            memset(&out[written], in[read++], length);
+            written += length;
+        }
+    }
+    return read;
+}
+
+// Growable output buffer. Allocation failure sticks, so writers can check once.
+typedef struct ByteBuffer {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} ByteBuffer;
+
+static uint8_t* ReserveBytes(ByteBuffer* buffer, size_t count) {
+    if (buffer->failed) return NULL;
+
+    if (buffer->size + count > buffer->capacity) {
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity : 4096;
+        while (capacity < buffer->size + count) capacity *= 2;
+
+        uint8_t* data = (uint8_t*)realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            return NULL;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    return &buffer->data[buffer->size];
+}
+
+static void PutU16(ByteBuffer* buffer, uint16_t value) {
+    uint8_t* at = ReserveBytes(buffer, 2);
+    if (!at) return;
+    StoreU16(at, value);
+    buffer->size += 2;
+}
+
+static void PutU32(ByteBuffer* buffer, uint32_t value) {
+    uint8_t* at = ReserveBytes(buffer, 4);
+    if (!at) return;
+    StoreU32(at, value);
+    buffer->size += 4;
+}
+
+static void PutPlane(ByteBuffer* buffer, const uint8_t* data, size_t count) {
+    uint8_t* at = ReserveBytes(buffer, GetMapPlaneBound(count));
+    if (!at) return;
+    buffer->size += EncodeMapPlane(data, count, at);
+}
+
+// Tile window of one chunk, clipped to the map
+static void GetChunkExtent(int width, int height, int chunkX, int chunkY,
+                           int* startX, int* startY, int* chunkWidth, int* chunkHeight) {
+    *startX = chunkX * MAP_FILE_CHUNK_SIZE;
+    *startY = chunkY * MAP_FILE_CHUNK_SIZE;
+    *chunkWidth = width - *startX < MAP_FILE_CHUNK_SIZE ? width - *startX : MAP_FILE_CHUNK_SIZE;
+    *chunkHeight = height - *startY < MAP_FILE_CHUNK_SIZE ? height - *startY : MAP_FILE_CHUNK_SIZE;
+}
+
+static bool GetPatchPath(const char* path, char* patchPath, size_t size) {
+    return snprintf(patchPath, size, "%s.patch", path) < (int)size;
+}
+
+// Reads the generation from the header of the map file at path
+static bool ReadMapFileGeneration(const char* path, uint32_t* generation) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t header[MAP_FILE_HEADER_SIZE];
+    bool read = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+                LoadU32(&header[0]) == MAP_FILE_MAGIC && LoadU16(&header[4]) == MAP_FILE_VERSION;
+    fclose(file);
+    if (read) *generation = LoadU32(&header[28]);
+    return read;
+}
+
+// Property set text written to a file, each set once
+typedef struct StringTable {
+    const char** strings;             // In file string id order
+    uint32_t* ids;                    // File string id per property set id, UINT32_MAX until added
+    uint32_t count;
+} StringTable;
+
+// File string id of a property set, adding its text when new. Sets are
+// already deduplicated, so the set id is the key.
+static uint32_t InternString(StringTable* table, const PropertySet* set, uint16_t id) {
+    if (table->ids[id] == UINT32_MAX) {
+        table->strings[table->count] = set->json;
+        table->ids[id] = table->count++;
+    }
+    return table->ids[id];
+}
+
+// With no string table the properties are written inline, as patch
+// entries hold them
+static void PutChunkRecord(ByteBuffer* buffer, const TileGrid* tiles, int width, int height,
+                           int chunkX, int chunkY, StringTable* strings) {
+    int startX, startY, chunkWidth, chunkHeight;
+    GetChunkExtent(width, height, chunkX, chunkY, &startX, &startY, &chunkWidth, &chunkHeight);
+
+    uint8_t types[MAP_FILE_CHUNK_TILES];
+    uint8_t objects[MAP_FILE_CHUNK_TILES];
+    for (int y = 0; y < chunkHeight; y++) {
+        size_t row = (size_t)(startY + y) * width + startX;
+        memcpy(&types[y * chunkWidth], &tiles->types[row], (size_t)chunkWidth);
+        memcpy(&objects[y * chunkWidth], &tiles->objects[row], (size_t)chunkWidth);
+    }
+
+    size_t count = (size_t)chunkWidth * chunkHeight;
+    PutPlane(buffer, types, count);
+    PutPlane(buffer, objects, count);
+
+    // Overrides are sorted by map index, so each chunk row's overrides are
+    // one run found by binary search rather than a scan of the whole list
+    size_t countAt = buffer->size;
+    uint16_t overrideCount = 0;
+    PutU16(buffer, 0);
+    for (int y = 0; y < chunkHeight && tiles->overrideCount > 0; y++) {
+        int rowStart = (startY + y) * width + startX;
+        for (int i = FindTileOverrideSlot(tiles, rowStart);
+             i < tiles->overrideCount && tiles->overrides[i].index < rowStart + chunkWidth; i++) {
+            const TileOverride* entry = &tiles->overrides[i];
+            const PropertySet* set = GetPropertySet(tiles->propertyStore, entry->propertySet);
+            if (!set) continue;
+
+            PutU16(buffer, (uint16_t)(y * chunkWidth + entry->index - rowStart));
+            if (strings) {
+                PutU32(buffer, InternString(strings, set, entry->propertySet));
+            } else {
+                size_t length = strlen(set->json);
+                PutU32(buffer, (uint32_t)length);
+                uint8_t* at = ReserveBytes(buffer, length);
+                if (!at) return;
+                memcpy(at, set->json, length);
+                buffer->size += length;
+            }
+            overrideCount++;
+        }
+    }
+    if (!buffer->failed) StoreU16(&buffer->data[countAt], overrideCount);
+}
+
+static bool WriteFileReplacing(const char* path, const uint8_t* data, size_t size) {
+    char tempPath[MAP_FILE_PATH_LENGTH];
+    if (snprintf(tempPath, sizeof(tempPath), "%s.tmp", path) >= (int)sizeof(tempPath)) return false;
+
+    FILE* file = fopen(tempPath, "wb");
+    if (!file) return false;
+
+    bool written = fwrite(data, 1, size, file) == size;
+    if (fclose(file) != 0) written = false;
+    if (!written) {
+        remove(tempPath);
+        return false;
+    }
+
+#ifdef _WIN32
+    remove(path);
+#endif
+    return rename(tempPath, path) == 0;
+}
+
+bool SaveMapFile(const char* path, const TileGrid* tiles, int width, int height) {
+    if (!path || !tiles || !tiles->types || width <= 0 || height <= 0) return false;
+    if (width > MAP_FILE_MAX_SIDE || height > MAP_FILE_MAX_SIDE) return false;
+    if (tiles->count < (size_t)width * (size_t)height) return false;
+
+    int chunksX = (width + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    int chunksY = (height + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    size_t chunkCount = (size_t)chunksX * chunksY;
+
+    // Each property set becomes one string, however many tiles share it
+    size_t setCount = tiles->propertyStore ? (size_t)tiles->propertyStore->setCount : 1;
+    uint32_t* index = (uint32_t*)malloc(chunkCount * 2 * sizeof(uint32_t));
+    StringTable strings = { (const char**)malloc(setCount * sizeof(char*)),
+                            (uint32_t*)malloc(setCount * sizeof(uint32_t)), 0 };
+    if (!index || !strings.strings || !strings.ids) {
+        free(index);
+        free(strings.strings);
+        free(strings.ids);
+        return false;
+    }
+    memset(strings.ids, 0xFF, setCount * sizeof(uint32_t));
+
+    // The log beside the old file is stale once this one replaces it
+    uint32_t generation = 0;
+    ReadMapFileGeneration(path, &generation);
+
+    ByteBuffer buffer = { 0 };
+    if (ReserveBytes(&buffer, MAP_FILE_HEADER_SIZE)) {
+        memset(buffer.data, 0, MAP_FILE_HEADER_SIZE);
+        buffer.size = MAP_FILE_HEADER_SIZE;
+    }
+
+    for (int chunkY = 0; chunkY < chunksY; chunkY++) {
+        for (int chunkX = 0; chunkX < chunksX; chunkX++) {
+            size_t chunk = (size_t)chunkY * chunksX + chunkX;
+            size_t offset = buffer.size;
+            PutChunkRecord(&buffer, tiles, width, height, chunkX, chunkY, &strings);
+            index[chunk * 2] = (uint32_t)offset;
+            index[chunk * 2 + 1] = (uint32_t)(buffer.size - offset);
+        }
+    }
+
+    size_t stringTableOffset = buffer.size;
+    for (uint32_t i = 0; i < strings.count; i++) {
+        size_t length = strlen(strings.strings[i]);
+        PutU32(&buffer, (uint32_t)length);
+        uint8_t* at = ReserveBytes(&buffer, length);
+        if (!at) break;
+        memcpy(at, strings.strings[i], length);
+        buffer.size += length;
+    }
+
+    size_t indexOffset = buffer.size;
+    for (size_t i = 0; i < chunkCount * 2; i++) {
+        PutU32(&buffer, index[i]);
+    }
+
+    // Offsets are 32-bit, which bounds a file at 4 GB
+    bool saved = !buffer.failed && buffer.size <= UINT32_MAX;
+    if (saved) {
+        uint8_t* header = buffer.data;
+        StoreU32(&header[0], MAP_FILE_MAGIC);
+        StoreU16(&header[4], MAP_FILE_VERSION);
+        StoreU16(&header[6], MAP_FILE_CHUNK_SIZE);
+        StoreU32(&header[8], (uint32_t)width);
+        StoreU32(&header[12], (uint32_t)height);
+        StoreU32(&header[16], (uint32_t)indexOffset);
+        StoreU32(&header[20], (uint32_t)stringTableOffset);
+        StoreU32(&header[24], strings.count);
+        StoreU32(&header[28], generation + 1);
+        saved = WriteFileReplacing(path, buffer.data, buffer.size);
+    }
+
+    // A crash before this leaves a log of the old generation, which is
+    // then neither replayed nor appended to
+    char patchPath[MAP_FILE_PATH_LENGTH];
+    if (saved && GetPatchPath(path, patchPath, sizeof(patchPath))) remove(patchPath);
+
+    free(buffer.data);
+    free(index);
+    free(strings.strings);
+    free(strings.ids);
+    return saved;
+}
+
+// Reading
+
+static bool MapWholeFile(MapFile* map, const char* path) {
+#ifdef _WIN32
+    map->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (map->file == INVALID_HANDLE_VALUE) {
+        map->file = NULL;
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(map->file, &size) || size.QuadPart < MAP_FILE_HEADER_SIZE || size.QuadPart > UINT32_MAX) {
+        return false;
+    }
+
+    map->mapping = CreateFileMappingA(map->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!map->mapping) return false;
+
+    map->data = (const uint8_t*)MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+    map->size = (size_t)size.QuadPart;
+    return map->data != NULL;
+#else
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) return false;
+
+    // The mapping keeps the file alive, the descriptor is not needed after
+    struct stat info;
+    bool mapped = false;
+    if (fstat(descriptor, &info) == 0 && info.st_size >= MAP_FILE_HEADER_SIZE && info.st_size <= UINT32_MAX) {
+        void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+        if (data != MAP_FAILED) {
+            map->data = (const uint8_t*)data;
+            map->size = (size_t)info.st_size;
+            mapped = true;
+        }
+    }
+    close(descriptor);
+    return mapped;
+#endif
+}
+
+static bool IsPatchHeaderFor(const uint8_t* header, int width, int height, uint32_t generation) {
+    return LoadU32(&header[0]) == MAP_PATCH_MAGIC && LoadU16(&header[4]) == MAP_PATCH_VERSION &&
+           LoadU16(&header[6]) == MAP_FILE_CHUNK_SIZE &&
+           LoadU32(&header[8]) == (uint32_t)width && LoadU32(&header[12]) == (uint32_t)height &&
+           LoadU32(&header[16]) == generation;
+}
+
+// Reads the patch log whole, it stays small between compactions. A log
+// that is missing, unreadable, for another map size or for an older
+// generation of the file is left out.
+static void ReadPatchLog(MapFile* map, const char* path) {
+    char patchPath[MAP_FILE_PATH_LENGTH];
+    if (!GetPatchPath(path, patchPath, sizeof(patchPath))) return;
+
+    FILE* file = fopen(patchPath, "rb");
+    if (!file) return;
+
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) size = ftell(file);
+    if (size < MAP_PATCH_HEADER_SIZE || (uint64_t)size > UINT32_MAX || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return;
+    }
+
+    uint8_t* data = (uint8_t*)malloc((size_t)size);
+    bool read = data && fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!read || !IsPatchHeaderFor(data, map->width, map->height, map->generation)) {
+        free(data);
+        return;
+    }
+
+    map->patchEntries = (uint32_t*)calloc((size_t)map->chunksX * map->chunksY, sizeof(uint32_t));
+    if (!map->patchEntries) {
+        free(data);
+        return;
+    }
+    map->patch = data;
+
+    // Later entries for a chunk replace earlier ones; the log ends at the
+    // first entry that is cut short or outside the map
+    size_t position = MAP_PATCH_HEADER_SIZE;
+    while (position + MAP_PATCH_ENTRY_HEADER <= (size_t)size) {
+        int chunkX = LoadU16(&data[position]);
+        int chunkY = LoadU16(&data[position + 2]);
+        uint32_t recordSize = LoadU32(&data[position + 4]);
+        if (chunkX >= map->chunksX || chunkY >= map->chunksY ||
+            recordSize > (size_t)size - position - MAP_PATCH_ENTRY_HEADER) {
+            break;
+        }
+
+        map->patchEntries[(size_t)chunkY * map->chunksX + chunkX] = (uint32_t)position;
+        position += MAP_PATCH_ENTRY_HEADER + recordSize;
+    }
+}
+
+MapFile* OpenMapFile(const char* path) {
+    if (!path) return NULL;
+
+    MapFile* map = (MapFile*)calloc(1, sizeof(MapFile));
+    if (!map) return NULL;
+
+    if (!MapWholeFile(map, path)) {
+        CloseMapFile(map);
+        return NULL;
+    }
+
+    const uint8_t* header = map->data;
+    if (LoadU32(&header[0]) != MAP_FILE_MAGIC || LoadU16(&header[4]) != MAP_FILE_VERSION ||
+        LoadU16(&header[6]) != MAP_FILE_CHUNK_SIZE) {
+        CloseMapFile(map);
+        return NULL;
+    }
+
+    uint32_t width = LoadU32(&header[8]);
+    uint32_t height = LoadU32(&header[12]);
+    if (width == 0 || height == 0 || width > MAP_FILE_MAX_SIDE || height > MAP_FILE_MAX_SIDE) {
+        CloseMapFile(map);
+        return NULL;
+    }
+
+    map->width = (int)width;
+    map->height = (int)height;
+    map->chunksX = (map->width + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    map->chunksY = (map->height + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    map->indexOffset = LoadU32(&header[16]);
+    map->stringTableOffset = LoadU32(&header[20]);
+    map->stringCount = LoadU32(&header[24]);
+    map->generation = LoadU32(&header[28]);
+
+    // Records are checked as they are read, so opening only checks the layout
+    uint64_t indexSize = (uint64_t)map->chunksX * map->chunksY * 2 * sizeof(uint32_t);
+    if ((uint64_t)map->indexOffset + indexSize > map->size ||
+        map->stringTableOffset < MAP_FILE_HEADER_SIZE || map->stringTableOffset > map->indexOffset ||
+        (uint64_t)map->stringCount * 4 > map->indexOffset - map->stringTableOffset) {
+        CloseMapFile(map);
+        return NULL;
+    }
+
+    ReadPatchLog(map, path);
+    return map;
+}
+
+void CloseMapFile(MapFile* map) {
+    if (!map) return;
+
+#ifdef _WIN32
+    if (map->data) UnmapViewOfFile(map->data);
+    if (map->mapping) CloseHandle(map->mapping);
+    if (map->file) CloseHandle(map->file);
+#else
+    if (map->data) munmap((void*)map->data, map->size);
+#endif
+    free(map->stringOffsets);
+    free(map->stringSets);
+    free(map->scratch);
+    free(map->patch);
+    free(map->patchEntries);
+    free(map);
+}
+
+// Locates every string once; the table is walked only when a chunk first
+// needs a custom property
+static bool IndexStrings(MapFile* map) {
+    if (map->stringOffsets || map->stringCount == 0) return true;
+
+    uint32_t* offsets = (uint32_t*)malloc(map->stringCount * sizeof(uint32_t));
+    if (!offsets) return false;
+
+    uint64_t position = map->stringTableOffset;
+    for (uint32_t i = 0; i < map->stringCount; i++) {
+        if (position + 4 > map->indexOffset) {
+            free(offsets);
+            return false;
+        }
+        offsets[i] = (uint32_t)position;
+        position += 4 + (uint64_t)LoadU32(&map->data[position]);
+    }
+    if (position > map->indexOffset) {
+        free(offsets);
+        return false;
+    }
+
+    map->stringOffsets = offsets;
+    return true;
+}
+
+// Terminated copy of some bytes, valid until the next call
+static const char* CopyMapFileString(MapFile* map, const uint8_t* bytes, uint32_t length) {
+    if ((size_t)length + 1 > map->scratchCapacity) {
+        char* scratch = (char*)realloc(map->scratch, (size_t)length + 1);
+        if (!scratch) return NULL;
+        map->scratch = scratch;
+        map->scratchCapacity = (size_t)length + 1;
+    }
+    memcpy(map->scratch, bytes, length);
+    map->scratch[length] = '\0';
+    return map->scratch;
+}
+
+// Gives a tile the property set of a file string. Each string is parsed
+// the first time a tile uses it; later tiles reuse its set once the text
+// is confirmed, in case the grid's store is not the one remembered.
+static bool SetTileFileString(MapFile* map, TileGrid* tiles, int tile, uint32_t id) {
+    if (id >= map->stringCount || !IndexStrings(map)) return false;
+
+    if (!map->stringSets) {
+        map->stringSets = (uint16_t*)calloc(map->stringCount, sizeof(uint16_t));
+        if (!map->stringSets) return false;
+    }
+    if (map->stringSetStore != tiles->propertyStore) {
+        memset(map->stringSets, 0, map->stringCount * sizeof(uint16_t));
+        map->stringSetStore = tiles->propertyStore;
+    }
+
+    const uint8_t* at = &map->data[map->stringOffsets[id]];
+    uint32_t length = LoadU32(at);
+    const PropertySet* set = GetPropertySet(tiles->propertyStore, map->stringSets[id]);
+    if (set && strlen(set->json) == length && memcmp(set->json, at + 4, length) == 0) {
+        return SetTilePropertySet(tiles, tile, map->stringSets[id]);
+    }
+
+    const char* properties = CopyMapFileString(map, at + 4, length);
+    if (!properties || !SetTileOverride(tiles, tile, properties)) return false;
+
+    // The first override creates the store
+    map->stringSetStore = tiles->propertyStore;
+    map->stringSets[id] = GetTilePropertySet(tiles, tile);
+    return true;
+}
+
+// Latest patch log record of a chunk, NULL when the log has none
+static const uint8_t* GetPatchRecord(const MapFile* map, int chunkX, int chunkY, uint32_t* size) {
+    if (!map->patchEntries) return NULL;
+
+    uint32_t offset = map->patchEntries[(size_t)chunkY * map->chunksX + chunkX];
+    if (offset == 0) return NULL;
+    *size = LoadU32(&map->patch[offset + 4]);
+    return &map->patch[offset + MAP_PATCH_ENTRY_HEADER];
+}
+
+// Record of one chunk in the file, NULL when the index points outside it
+static const uint8_t* GetChunkRecord(const MapFile* map, int chunkX, int chunkY, uint32_t* size) {
+    const uint8_t* entry = &map->data[map->indexOffset + ((size_t)chunkY * map->chunksX + chunkX) * 8];
+    uint32_t offset = LoadU32(entry);
+    *size = LoadU32(entry + 4);
+    if (offset < MAP_FILE_HEADER_SIZE || (uint64_t)offset + *size > map->stringTableOffset) return NULL;
+    return &map->data[offset];
+}
+
+int GetMapFileWidth(const MapFile* map) {
+    return map ? map->width : 0;
+}
+
+int GetMapFileHeight(const MapFile* map) {
+    return map ? map->height : 0;
+}
+
+int GetMapFileChunkCount(const MapFile* map) {
+    return map ? map->chunksX * map->chunksY : 0;
+}
+
+bool ReadMapFileChunk(MapFile* map, int chunkX, int chunkY, TileGrid* tiles) {
+    if (!map || !tiles || !tiles->types) return false;
+    if (chunkX < 0 || chunkX >= map->chunksX || chunkY < 0 || chunkY >= map->chunksY) return false;
+    if (tiles->count < (size_t)map->width * (size_t)map->height) return false;
+
+    uint32_t size;
+    const uint8_t* record = GetPatchRecord(map, chunkX, chunkY, &size);
+    bool isPatched = record != NULL;
+    if (!isPatched) record = GetChunkRecord(map, chunkX, chunkY, &size);
+    if (!record) return false;
+
+    int startX, startY, chunkWidth, chunkHeight;
+    GetChunkExtent(map->width, map->height, chunkX, chunkY, &startX, &startY, &chunkWidth, &chunkHeight);
+    size_t count = (size_t)chunkWidth * chunkHeight;
+
+    uint8_t types[MAP_FILE_CHUNK_TILES];
+    uint8_t objects[MAP_FILE_CHUNK_TILES];
+    size_t typeBytes = DecodeMapPlane(record, size, types, count);
+    if (typeBytes == 0) return false;
+    size_t objectBytes = DecodeMapPlane(&record[typeBytes], size - typeBytes, objects, count);
+    if (objectBytes == 0 || typeBytes + objectBytes + 2 > size) return false;
+
+    uint16_t overrideCount = LoadU16(&record[typeBytes + objectBytes]);
+    if (typeBytes + objectBytes + 2 + (size_t)overrideCount * 6 > size) return false;
+
+    for (int y = 0; y < chunkHeight; y++) {
+        size_t row = (size_t)(startY + y) * map->width + startX;
+        memcpy(&tiles->types[row], &types[y * chunkWidth], (size_t)chunkWidth);
+        memcpy(&tiles->objects[row], &objects[y * chunkWidth], (size_t)chunkWidth);
+    }
+
+    // Drop properties left from whatever the grid held here before
+    if (tiles->overrideCount > 0) {
+        for (int y = 0; y < chunkHeight; y++) {
+            for (int x = 0; x < chunkWidth; x++) {
+                int tile = (startY + y) * map->width + startX + x;
+                if (GetTileOverride(tiles, tile)) SetTileOverride(tiles, tile, NULL);
+            }
+        }
+    }
+
+    // Patched records carry their strings inline after each reference
+    size_t position = typeBytes + objectBytes + 2;
+    for (uint16_t i = 0; i < overrideCount; i++) {
+        if (position + 6 > size) return false;
+        uint16_t local = LoadU16(&record[position]);
+        uint32_t value = LoadU32(&record[position + 2]);
+        position += 6;
+
+        if (local >= count) return false;
+        int tile = (startY + local / chunkWidth) * map->width + startX + local % chunkWidth;
+
+        if (!isPatched) {
+            if (!SetTileFileString(map, tiles, tile, value)) return false;
+            continue;
+        }
+        if (value > size - position) return false;
+        const char* properties = CopyMapFileString(map, &record[position], value);
+        position += value;
+        if (!properties || !SetTileOverride(tiles, tile, properties)) return false;
+    }
+    return true;
+}
+
+void PrefetchMapFileChunk(const MapFile* map, int chunkX, int chunkY) {
+    if (!map || chunkX < 0 || chunkX >= map->chunksX || chunkY < 0 || chunkY >= map->chunksY) return;
+
+    // Patched chunks are already in memory
+    uint32_t size;
+    if (GetPatchRecord(map, chunkX, chunkY, &size)) return;
+    const uint8_t* record = GetChunkRecord(map, chunkX, chunkY, &size);
+    if (!record || size == 0) return;
+
+#ifdef _WIN32
+    // Windows reads mapped pages ahead on its own; nothing portable to hint
+    (void)record;
+#else
+    // The advice range has to start on a page boundary
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)record & ~(pageSize - 1);
+    posix_madvise((void*)start, (uintptr_t)record + size - start, POSIX_MADV_WILLNEED);
+#endif
+}
+
+bool LoadMapFile(const char* path, TileGrid* tiles, int* width, int* height) {
+    if (!tiles) return false;
+
+    MapFile* map = OpenMapFile(path);
+    if (!map) return false;
+
+    bool loaded = InitTileGrid(tiles, (size_t)map->width * (size_t)map->height, TILE_NONE);
+    for (int chunkY = 0; loaded && chunkY < map->chunksY; chunkY++) {
+        for (int chunkX = 0; loaded && chunkX < map->chunksX; chunkX++) {
+            loaded = ReadMapFileChunk(map, chunkX, chunkY, tiles);
+        }
+    }
+
+    if (loaded) {
+        if (width) *width = map->width;
+        if (height) *height = map->height;
+    } else {
+        FreeTileGrid(tiles);
+    }
+    CloseMapFile(map);
+    return loaded;
+}
+
+// Patches
+
+MapPatch* CreateMapPatch(int width, int height) {
+    if (width <= 0 || height <= 0 || width > MAP_FILE_MAX_SIDE || height > MAP_FILE_MAX_SIDE) return NULL;
+
+    MapPatch* patch = (MapPatch*)calloc(1, sizeof(MapPatch));
+    if (!patch) return NULL;
+
+    patch->width = width;
+    patch->height = height;
+    return patch;
+}
+
+void DestroyMapPatch(MapPatch* patch) {
+    if (!patch) return;
+
+    free(patch->data);
+    free(patch);
+}
+
+bool AddMapPatchChunk(MapPatch* patch, const TileGrid* tiles, int chunkX, int chunkY) {
+    if (!patch || !tiles || !tiles->types || patch->failed) return false;
+    if (tiles->count < (size_t)patch->width * (size_t)patch->height) return false;
+
+    int chunksX = (patch->width + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    int chunksY = (patch->height + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    if (chunkX < 0 || chunkX >= chunksX || chunkY < 0 || chunkY >= chunksY) return false;
+
+    // Entries go straight into the patch's own buffer
+    ByteBuffer buffer = { patch->data, patch->size, patch->capacity, false };
+    size_t start = buffer.size;
+    PutU16(&buffer, (uint16_t)chunkX);
+    PutU16(&buffer, (uint16_t)chunkY);
+    PutU32(&buffer, 0);
+    PutChunkRecord(&buffer, tiles, patch->width, patch->height, chunkX, chunkY, NULL);
+
+    patch->data = buffer.data;
+    patch->capacity = buffer.capacity;
+    if (buffer.failed) {
+        patch->failed = true;
+        return false;
+    }
+
+    StoreU32(&buffer.data[start + 4], (uint32_t)(buffer.size - start - MAP_PATCH_ENTRY_HEADER));
+    patch->size = buffer.size;
+    patch->chunkCount++;
+    return true;
+}
+
+int GetMapPatchChunkCount(const MapPatch* patch) {
+    return patch ? patch->chunkCount : 0;
+}
+
+// Checks that an existing log can take more entries: same map size and
+// generation, and no torn entry at its end. Only entry headers are read.
+// A log of another generation is stale and may be started over.
+static bool IsPatchLogAppendable(FILE* file, int width, int height, uint32_t generation, bool* stale) {
+    uint8_t header[MAP_PATCH_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header)) return false;
+    *stale = LoadU32(&header[0]) == MAP_PATCH_MAGIC &&
+             (LoadU16(&header[4]) != MAP_PATCH_VERSION || LoadU32(&header[16]) != generation);
+    if (!IsPatchHeaderFor(header, width, height, generation)) return false;
+    if (fseek(file, 0, SEEK_END) != 0) return false;
+    long size = ftell(file);
+
+    long position = MAP_PATCH_HEADER_SIZE;
+    while (position < size) {
+        uint8_t entry[MAP_PATCH_ENTRY_HEADER];
+        if (fseek(file, position, SEEK_SET) != 0 || fread(entry, 1, sizeof(entry), file) != sizeof(entry)) {
+            return false;
+        }
+        position += MAP_PATCH_ENTRY_HEADER + (long)LoadU32(&entry[4]);
+    }
+    return position == size;
+}
+
+bool AppendMapFilePatch(const char* path, const MapPatch* patch) {
+    if (!path || !patch || patch->failed) return false;
+
+    char patchPath[MAP_FILE_PATH_LENGTH];
+    if (!GetPatchPath(path, patchPath, sizeof(patchPath))) return false;
+    if (patch->chunkCount == 0) return true;
+
+    uint32_t generation;
+    if (!ReadMapFileGeneration(path, &generation)) return false;
+
+    bool stale = false;
+    FILE* existing = fopen(patchPath, "rb");
+    if (existing) {
+        bool appendable = IsPatchLogAppendable(existing, patch->width, patch->height, generation, &stale);
+        fclose(existing);
+        if (!appendable && !stale) return false;
+    }
+
+    bool startLog = !existing || stale;
+    FILE* file = fopen(patchPath, startLog ? "wb" : "ab");
+    if (!file) return false;
+
+    bool written = true;
+    if (startLog) {
+        uint8_t header[MAP_PATCH_HEADER_SIZE];
+        StoreU32(&header[0], MAP_PATCH_MAGIC);
+        StoreU16(&header[4], MAP_PATCH_VERSION);
+        StoreU16(&header[6], MAP_FILE_CHUNK_SIZE);
+        StoreU32(&header[8], (uint32_t)patch->width);
+        StoreU32(&header[12], (uint32_t)patch->height);
+        StoreU32(&header[16], generation);
+        written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    }
+    written = written && fwrite(patch->data, 1, patch->size, file) == patch->size;
+    if (fclose(file) != 0) written = false;
+    return written;
+}
+
+bool CompactMapFile(const char* path) {
+    TileGrid tiles;
+    int width = 0;
+    int height = 0;
+    if (!LoadMapFile(path, &tiles, &width, &height)) return false;
+
+    bool compacted = SaveMapFile(path, &tiles, width, height);
+    FreeTileGrid(&tiles);
+    return compacted;
+}
@@ -13,6 +13,11 @@ END_EXTERNAL_WARNINGS
 #include <stdlib.h>
 #include <string.h>
 #include "../include/world.h"
+#include "../../include/estate_map.h"
+#include "../../include/tile_grid.h"
+#include "../../include/chunk_cache.h"
+#include "../../include/collision_grid.h"
+#include "../../include/map_file.h"
 
 // Add size type safety
 #define SAFE_SIZE_T(x) ((x) > SIZE_MAX ? SIZE_MAX : (x))
@@ -21,161 +26,503 @@ END_EXTERNAL_WARNINGS
 // Macro for unused parameters
 #define UNUSED(x) (void)(x)
 
+// Lazy map loading
+#define MAP_DECODE_CHUNKS_PER_UPDATE 4   // Off-screen file chunks decoded each update
+#define MAP_PREFETCH_AHEAD 8             // File chunks hinted to the OS ahead of decoding
+
 // Function declarations
-static void RenderMapLayers(MapSystem* mapSystem);
 static void UpdateMapSystem(World* world, float deltaTime);
+static void CollectMapSave(MapSystem* mapSystem, bool wait);
 
 // Helper functions for chunk management
 CachedChunk* GetChunk(ChunkCache* cache, Vector2 gridPos) {
+    return FindCachedChunk(cache, (int)gridPos.x, (int)gridPos.y);
+}
+
+void UnloadChunkCache(ChunkCache* cache) {
+    if (!cache) return;
+    
     for (int i = 0; i < cache->chunkCount; i++) {
-        if (cache->chunks[i].gridPosition.x == gridPos.x &&
-            cache->chunks[i].gridPosition.y == gridPos.y) {
-            cache->chunks[i].lastAccessTime = cache->frameCounter;
-            return &cache->chunks[i];
+        if (cache->chunks[i].texture.id > 0) {
+            UnloadRenderTexture(cache->chunks[i].texture);
         }
     }
-    return NULL;
+    FreeChunkCache(cache);
 }
 
-static void UpdateChunkTexture(MapSystem* mapSystem, CachedChunk* chunk) {
-    if (!chunk->isDirty) return;
+bool SetChunkCacheSize(MapSystem* mapSystem, int capacity) {
+    if (!mapSystem || capacity <= 0) return false;
+    
+    mapSystem->chunkCacheSize = capacity;
+    if (!mapSystem->currentMap) return true;
+    
+    // Cached textures are redrawn on demand, so resizing just starts over
+    bool resized = true;
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        ChunkCache* cache = &mapSystem->currentMap->layers[i].cache;
+        UnloadChunkCache(cache);
+        resized = InitChunkCache(cache, capacity) && resized;
+    }
+    return resized;
+}
 
-    BeginTextureMode(chunk->texture);
-    ClearBackground(BLANK);
+// Layers
 
-    // Calculate chunk bounds in tile coordinates
-    int startX = (int)chunk->gridPosition.x * CACHE_CHUNK_SIZE;
-    int startY = (int)chunk->gridPosition.y * CACHE_CHUNK_SIZE;
-    int endX = startX + CACHE_CHUNK_SIZE;
-    int endY = startY + CACHE_CHUNK_SIZE;
+bool InitMapLayers(TileMap* map, int chunkCacheSize) {
+    if (!map) return false;
+    
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        RenderLayer* layer = &map->layers[i];
+        memset(layer, 0, sizeof(RenderLayer));
+        if (!InitChunkCache(&layer->cache, chunkCacheSize)) {
+            FreeMapLayers(map);
+            return false;
+        }
+        layer->isVisible = i != MAP_LAYER_COLLISION;
+    }
+    
+    // Torches and fountains change between edits
+    map->layers[MAP_LAYER_DECORATION].refreshInterval = 1.0f / ANIMATED_TILE_FLICKER_RATE;
+    return true;
+}
+
+void FreeMapLayers(TileMap* map) {
+    if (!map) return;
+    
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        UnloadChunkCache(&map->layers[i].cache);
+    }
+}
+
+void SetMapLayerVisible(MapSystem* mapSystem, MapLayerType layer, bool visible) {
+    if (!mapSystem || !mapSystem->currentMap || layer < 0 || layer >= MAP_LAYER_COUNT) return;
+    
+    // Hidden layers keep collecting dirty regions and catch up when shown
+    mapSystem->currentMap->layers[layer].isVisible = visible;
+}
+
+void SetMapLayerRefreshInterval(MapSystem* mapSystem, MapLayerType layer, float seconds) {
+    if (!mapSystem || !mapSystem->currentMap || layer < 0 || layer >= MAP_LAYER_COUNT) return;
+    
+    RenderLayer* renderLayer = &mapSystem->currentMap->layers[layer];
+    renderLayer->refreshInterval = seconds > 0.0f ? seconds : 0.0f;
+    renderLayer->refreshTimer = 0.0f;
+}
 
-    // Render tiles within chunk
+void MarkMapTileDirty(MapSystem* mapSystem, int tileX, int tileY) {
+    if (!mapSystem || !mapSystem->currentMap) return;
+    
+    TileMap* map = mapSystem->currentMap;
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        MarkCachedTileDirty(&map->layers[i].cache, tileX, tileY);
+    }
+    
+    // A canopy hangs over the tile above its tree
+    MarkCachedTileDirty(&map->layers[MAP_LAYER_OVERHEAD].cache, tileX, tileY - 1);
+    
+    // The next save writes the tile's file chunk
+    if (map->unsavedChunks && tileX >= 0 && tileX < map->width && tileY >= 0 && tileY < map->height) {
+        int chunksX = (map->width + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+        uint8_t* unsaved = &map->unsavedChunks[(tileY / MAP_FILE_CHUNK_SIZE) * chunksX + tileX / MAP_FILE_CHUNK_SIZE];
+        if (!*unsaved) {
+            *unsaved = 1;
+            map->unsavedCount++;
+        }
+    }
+}
+
+// Marks every cached chunk over an inclusive tile rectangle on all layers
+static void MarkMapRegionDirty(TileMap* map, int minX, int minY, int maxX, int maxY) {
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        int top = i == MAP_LAYER_OVERHEAD ? minY - 1 : minY;
+        int minChunkY = FloorDiv(top, CACHE_CHUNK_SIZE);
+        for (int y = minChunkY; y <= maxY / CACHE_CHUNK_SIZE; y++) {
+            for (int x = minX / CACHE_CHUNK_SIZE; x <= maxX / CACHE_CHUNK_SIZE; x++) {
+                CachedChunk* cached = FindCachedChunk(&map->layers[i].cache, x, y);
+                if (cached) MarkChunkDirty(cached);
+            }
+        }
+    }
+}
+
+// Lazy map loading. A loaded map file stays mapped while any of its chunks
+// is undecoded; tiles under the view are decoded on demand and the rest a
+// few chunks per update, so loading does not scale with the map.
+static void CloseMapSource(TileMap* map) {
+    CloseMapFile(map->source);
+    free(map->decodedChunks);
+    map->source = NULL;
+    map->decodedChunks = NULL;
+    map->pendingChunks = 0;
+    map->prefetchCursor = 0;
+}
+
+static int GetMapFileChunksX(const TileMap* map) {
+    return (map->width + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+}
+
+// Decodes one file chunk and brings the collision bitmap, animated tile
+// index and cached textures over it up to date
+static void DecodeMapChunk(MapSystem* mapSystem, int chunkX, int chunkY) {
+    TileMap* map = mapSystem->currentMap;
+    int chunk = chunkY * GetMapFileChunksX(map) + chunkX;
+    if (map->decodedChunks[chunk]) return;
+
+    map->decodedChunks[chunk] = 1;
+    map->pendingChunks--;
+
+    // A damaged record leaves its tiles empty rather than stopping the game
+    if (!ReadMapFileChunk(map->source, chunkX, chunkY, &map->tiles)) {
+        TraceLog(LOG_WARNING, "Failed to decode map chunk %d, %d", chunkX, chunkY);
+    }
+
+    int startX = chunkX * MAP_FILE_CHUNK_SIZE;
+    int startY = chunkY * MAP_FILE_CHUNK_SIZE;
+    int endX = startX + MAP_FILE_CHUNK_SIZE < map->width ? startX + MAP_FILE_CHUNK_SIZE : map->width;
+    int endY = startY + MAP_FILE_CHUNK_SIZE < map->height ? startY + MAP_FILE_CHUNK_SIZE : map->height;
     for (int y = startY; y < endY; y++) {
         for (int x = startX; x < endX; x++) {
+            int index = y * map->width + x;
+            ObjectType object = GetGridObjectType(&map->tiles, index);
+            if (mapSystem->collisionGrid) {
+                UpdateCollisionCell(mapSystem->collisionGrid, x, y, GetGridTileType(&map->tiles, index), object);
+            }
+            if (IsObjectAnimated(object)) {
+                SetAnimatedTile(&mapSystem->animatedTiles, x, y, object);
+            }
+        }
+    }
+
+    MarkMapRegionDirty(map, startX, startY, endX - 1, endY - 1);
+
+    if (map->pendingChunks == 0) CloseMapSource(map);
+}
+
+// Decodes every file chunk overlapping an inclusive tile rectangle
+static void DecodeMapTiles(MapSystem* mapSystem, int minX, int minY, int maxX, int maxY) {
+    TileMap* map = mapSystem->currentMap;
+    if (!map || !map->source) return;
+
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX >= map->width) maxX = map->width - 1;
+    if (maxY >= map->height) maxY = map->height - 1;
+    if (minX > maxX || minY > maxY) return;
+
+    for (int y = minY / MAP_FILE_CHUNK_SIZE; y <= maxY / MAP_FILE_CHUNK_SIZE && map->source; y++) {
+        for (int x = minX / MAP_FILE_CHUNK_SIZE; x <= maxX / MAP_FILE_CHUNK_SIZE && map->source; x++) {
+            DecodeMapChunk(mapSystem, x, y);
+        }
+    }
+}
+
+// Hints the undecoded file chunks in an inclusive chunk rectangle
+static void PrefetchMapChunks(const TileMap* map, int minX, int minY, int maxX, int maxY) {
+    if (!map->source) return;
+
+    int chunksX = GetMapFileChunksX(map);
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            if (x < 0 || x >= chunksX || y < 0 || y * MAP_FILE_CHUNK_SIZE >= map->height) continue;
+            if (!map->decodedChunks[y * chunksX + x]) PrefetchMapFileChunk(map->source, x, y);
+        }
+    }
+}
+
+// Decodes a few chunks away from the view, hinting the ones after them
+static void DecodeMapBackground(MapSystem* mapSystem) {
+    TileMap* map = mapSystem->currentMap;
+    int chunksX = GetMapFileChunksX(map);
+    int decoded = 0;
+
+    while (map->source && decoded < MAP_DECODE_CHUNKS_PER_UPDATE) {
+        int chunk = map->prefetchCursor++;
+        if (map->decodedChunks[chunk]) continue;
+
+        int ahead = chunk + MAP_PREFETCH_AHEAD;
+        PrefetchMapChunks(map, ahead % chunksX, ahead / chunksX, ahead % chunksX, ahead / chunksX);
+        DecodeMapChunk(mapSystem, chunk % chunksX, chunk / chunksX);
+        decoded++;
+    }
+}
+
+void LoadMapArea(MapSystem* mapSystem, Rectangle bounds) {
+    if (!mapSystem || !mapSystem->currentMap) return;
+
+    DecodeMapTiles(mapSystem, (int)floorf(bounds.x / TILE_SIZE), (int)floorf(bounds.y / TILE_SIZE),
+                   (int)floorf((bounds.x + bounds.width) / TILE_SIZE),
+                   (int)floorf((bounds.y + bounds.height) / TILE_SIZE));
+}
+
+// Draws one tile of a layer at dest
+static void DrawLayerTile(MapSystem* mapSystem, MapLayerType layer, int x, int y, Rectangle dest) {
+    const TileMap* map = mapSystem->currentMap;
+    int index = y * map->width + x;
+    
+    switch (layer) {
+        case MAP_LAYER_GROUND:
+            DrawRectangleRec(dest, GetTileProperties(GetGridTileType(&map->tiles, index))->color);
+            break;
+            
+        case MAP_LAYER_DECORATION: {
+            ObjectType object = GetGridObjectType(&map->tiles, index);
+            if (object == OBJECT_NONE) break;
+            
+            // Fountains and torches pulse with their own resonance
+            Color objColor = DARKGREEN;
+            if (IsObjectAnimated(object)) {
+                objColor = ColorBrightness(objColor, GetAnimatedTileResonance(&mapSystem->animatedTiles, x, y) * 0.5f);
+            }
+            float objSize = TILE_SIZE * 0.6f;
+            Vector2 objPos = {
+                dest.x + (TILE_SIZE - objSize) / 2,
+                dest.y + (TILE_SIZE - objSize) / 2
+            };
+            DrawRectangleV(objPos, (Vector2){objSize, objSize}, objColor);
+            break;
+        }
+            
+        case MAP_LAYER_OVERHEAD:
+            // Canopy of a tree on the tile below, covering whoever walks behind it
+            if (y + 1 < map->height && GetGridObjectType(&map->tiles, index + map->width) == OBJECT_TREE) {
+                Rectangle canopy = { dest.x + TILE_SIZE * 0.1f, dest.y + TILE_SIZE * 0.5f,
+                                     TILE_SIZE * 0.8f, TILE_SIZE * 0.5f };
+                DrawRectangleRec(canopy, Fade(DARKGREEN, 0.85f));
+            }
+            break;
+            
+        case MAP_LAYER_COLLISION:
+            if (mapSystem->collisionGrid && IsCellBlocked(mapSystem->collisionGrid, x, y)) {
+                DrawRectangleRec(dest, Fade(RED, 0.35f));
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// Draws the tiles of one chunk-local rectangle into the bound chunk texture
+static void DrawChunkTiles(MapSystem* mapSystem, MapLayerType layer, const CachedChunk* chunk, ChunkDirtyRect rect) {
+    int startX = (int)chunk->gridPosition.x * CACHE_CHUNK_SIZE;
+    int startY = (int)chunk->gridPosition.y * CACHE_CHUNK_SIZE;
+
+    for (int y = startY + rect.minY; y <= startY + rect.maxY; y++) {
+        for (int x = startX + rect.minX; x <= startX + rect.maxX; x++) {
             if (x >= 0 && x < mapSystem->currentMap->width &&
                 y >= 0 && y < mapSystem->currentMap->height) {
                 
-                int index = y * mapSystem->currentMap->width + x;
-                Tile* tile = &mapSystem->currentMap->tiles[index];
-                
-                // Draw tile
                 Rectangle destRect = {
                     (float)((x - startX) * TILE_SIZE),
                     (float)((y - startY) * TILE_SIZE),
                     (float)TILE_SIZE,
                     (float)TILE_SIZE
                 };
-                
-                DrawRectangleRec(destRect, tile->properties.color);
-                
-                // Draw objects if present
-                if (tile->objectType != OBJECT_NONE) {
-                    Color objColor = DARKGREEN;
-                    float objSize = TILE_SIZE * 0.6f;
-                    Vector2 objPos = {
-                        destRect.x + (TILE_SIZE - objSize) / 2,
-                        destRect.y + (TILE_SIZE - objSize) / 2
-                    };
-                    DrawRectangleV(objPos, (Vector2){objSize, objSize}, objColor);
-                }
+                DrawLayerTile(mapSystem, layer, x, y, destRect);
+            }
+        }
+    }
+}
+
+static bool IsFullChunkRect(ChunkDirtyRect rect) {
+    return rect.minX == 0 && rect.minY == 0 &&
+           rect.maxX == CACHE_CHUNK_SIZE - 1 && rect.maxY == CACHE_CHUNK_SIZE - 1;
+}
+
+// Whether any tile of a chunk draws on the layer. Ground always does.
+static bool HasLayerContent(MapSystem* mapSystem, MapLayerType layer, const CachedChunk* chunk) {
+    if (layer == MAP_LAYER_GROUND) return true;
+
+    const TileMap* map = mapSystem->currentMap;
+    int startX = chunk->chunkX * CACHE_CHUNK_SIZE;
+    int startY = chunk->chunkY * CACHE_CHUNK_SIZE;
+    for (int y = startY; y < startY + CACHE_CHUNK_SIZE && y < map->height; y++) {
+        for (int x = startX; x < startX + CACHE_CHUNK_SIZE && x < map->width; x++) {
+            if (x < 0 || y < 0) continue;
+            int index = y * map->width + x;
+            switch (layer) {
+                case MAP_LAYER_DECORATION:
+                    if (GetGridObjectType(&map->tiles, index) != OBJECT_NONE) return true;
+                    break;
+                case MAP_LAYER_OVERHEAD:
+                    if (y + 1 < map->height && GetGridObjectType(&map->tiles, index + map->width) == OBJECT_TREE) return true;
+                    break;
+                case MAP_LAYER_COLLISION:
+                    if (mapSystem->collisionGrid && IsCellBlocked(mapSystem->collisionGrid, x, y)) return true;
+                    break;
+                default:
+                    return true;
             }
         }
     }
+    return false;
+}
+
+static void UpdateChunkTexture(MapSystem* mapSystem, MapLayerType layer, CachedChunk* chunk) {
+    if (!chunk->isDirty) return;
+
+    // Chunks with nothing on the layer hold no texture, so the mostly empty
+    // overhead and collision layers cost next to no video memory
+    bool isFull = chunk->dirtyRectCount == 0 || IsFullChunkRect(chunk->dirtyRects[0]);
+    if (isFull || chunk->texture.id == 0) {
+        if (!HasLayerContent(mapSystem, layer, chunk)) {
+            if (chunk->texture.id > 0) UnloadRenderTexture(chunk->texture);
+            chunk->texture = (RenderTexture2D){ 0 };
+            ClearChunkDirty(chunk);
+            return;
+        }
+        if (chunk->texture.id == 0) {
+            chunk->texture = LoadRenderTexture(CACHE_CHUNK_SIZE * TILE_SIZE, CACHE_CHUNK_SIZE * TILE_SIZE);
+            isFull = true;
+        }
+    }
+
+    BeginTextureMode(chunk->texture);
+
+    if (isFull) {
+        ClearBackground(BLANK);
+        DrawChunkTiles(mapSystem, layer, chunk, (ChunkDirtyRect){ 0, 0, CACHE_CHUNK_SIZE - 1, CACHE_CHUNK_SIZE - 1 });
+    } else {
+        // Scissor each region so the clear only wipes the tiles being redrawn
+        for (int i = 0; i < chunk->dirtyRectCount; i++) {
+            ChunkDirtyRect rect = chunk->dirtyRects[i];
+            BeginScissorMode(rect.minX * TILE_SIZE, rect.minY * TILE_SIZE,
+                             (rect.maxX - rect.minX + 1) * TILE_SIZE,
+                             (rect.maxY - rect.minY + 1) * TILE_SIZE);
+            ClearBackground(BLANK);
+            DrawChunkTiles(mapSystem, layer, chunk, rect);
+            EndScissorMode();
+        }
+    }
     
     EndTextureMode();
-    chunk->isDirty = false;
+    ClearChunkDirty(chunk);
 }
 
-static void CreateChunk(MapSystem* mapSystem, Vector2 gridPos) {
-    ChunkCache* cache = &mapSystem->currentMap->cache;
+static void CreateChunk(MapSystem* mapSystem, MapLayerType layer, int chunkX, int chunkY) {
+    ChunkCache* cache = &mapSystem->currentMap->layers[layer].cache;
     
-    // Evict oldest chunk if cache is full
-    if (cache->chunkCount >= MAX_CACHED_CHUNKS) {
-        int oldestIdx = 0;
-        int oldestTime = cache->chunks[0].lastAccessTime;
-        
-        for (int i = 1; i < cache->chunkCount; i++) {
-            if (cache->chunks[i].lastAccessTime < oldestTime) {
-                oldestTime = cache->chunks[i].lastAccessTime;
-                oldestIdx = i;
-            }
-        }
-        
-        UnloadRenderTexture(cache->chunks[oldestIdx].texture);
-        cache->chunks[oldestIdx] = cache->chunks[cache->chunkCount - 1];
-        cache->chunkCount--;
-    }
-    
-    // Create new chunk
-    CachedChunk chunk = {0};
-    chunk.gridPosition = gridPos;
-    chunk.texture = LoadRenderTexture(CACHE_CHUNK_SIZE * TILE_SIZE, 
-                                    CACHE_CHUNK_SIZE * TILE_SIZE);
-    chunk.bounds = (Rectangle){
-        gridPos.x * CACHE_CHUNK_SIZE * TILE_SIZE,
-        gridPos.y * CACHE_CHUNK_SIZE * TILE_SIZE,
-        CACHE_CHUNK_SIZE * TILE_SIZE,
-        CACHE_CHUNK_SIZE * TILE_SIZE
+    // Evicts the least recently used chunk when the cache is full
+    CachedChunk* chunk = InsertCachedChunk(cache, chunkX, chunkY);
+    if (!chunk) return;
+    
+    // Evicted slots keep their texture, every chunk texture is the same
+    // size; the redraw creates or drops it as the chunk's content needs
+    UpdateChunkTexture(mapSystem, layer, chunk);
+}
+
+// Queues a redraw of just the animated tiles of one layer chunk
+static void MarkAnimatedTilesDirty(MapSystem* mapSystem, CachedChunk* chunk) {
+    AnimatedChunk* animated = FindAnimatedChunk(&mapSystem->animatedTiles, chunk->chunkX, chunk->chunkY);
+    if (!animated) return;
+    
+    for (int i = 0; i < animated->count; i++) {
+        int x = animated->tiles[i] % CACHE_CHUNK_SIZE;
+        int y = animated->tiles[i] / CACHE_CHUNK_SIZE;
+        MarkChunkRegionDirty(chunk, x, y, x, y);
+    }
+}
+
+Viewport GetCameraViewport(Camera2D camera) {
+    Viewport viewport;
+    viewport.bounds = (Rectangle){
+        camera.target.x - GetScreenWidth() / (2.0f * camera.zoom),
+        camera.target.y - GetScreenHeight() / (2.0f * camera.zoom),
+        GetScreenWidth() / camera.zoom,
+        GetScreenHeight() / camera.zoom
     };
-    chunk.isDirty = true;
-    chunk.lastAccessTime = cache->frameCounter;
     
-    cache->chunks[cache->chunkCount++] = chunk;
-    UpdateChunkTexture(mapSystem, &cache->chunks[cache->chunkCount - 1]);
+    viewport.chunkMin.x = floorf(viewport.bounds.x / (CACHE_CHUNK_SIZE * TILE_SIZE));
+    viewport.chunkMin.y = floorf(viewport.bounds.y / (CACHE_CHUNK_SIZE * TILE_SIZE));
+    viewport.chunkMax.x = ceilf((viewport.bounds.x + viewport.bounds.width) / 
+                                (CACHE_CHUNK_SIZE * TILE_SIZE));
+    viewport.chunkMax.y = ceilf((viewport.bounds.y + viewport.bounds.height) / 
+                                (CACHE_CHUNK_SIZE * TILE_SIZE));
+    return viewport;
 }
 
 static void UpdateMapSystem(World* world, float deltaTime) {
-    UNUSED(deltaTime);
     if (!world || !world->mapSystem || !world->mapSystem->currentMap) return;
     
     MapSystem* mapSystem = world->mapSystem;
     TileMap* map = mapSystem->currentMap;
     
-    // Update viewport bounds based on camera
-    Camera2D camera = world->camera;
-    map->viewport.bounds = (Rectangle){
-        camera.target.x - GetScreenWidth() / (2.0f * camera.zoom),
-        camera.target.y - GetScreenHeight() / (2.0f * camera.zoom),
-        GetScreenWidth() / camera.zoom,
-        GetScreenHeight() / camera.zoom
-    };
+    // Start a save asked for while the last one was still writing
+    CollectMapSave(mapSystem, false);
+    if (mapSystem->save.isQueued && !mapSystem->save.patch) {
+        mapSystem->save.isQueued = false;
+        SaveMapSystem(mapSystem, mapSystem->savePath);
+    }
     
-    // Calculate visible chunks
-    map->viewport.chunkMin.x = floorf(map->viewport.bounds.x / (CACHE_CHUNK_SIZE * TILE_SIZE));
-    map->viewport.chunkMin.y = floorf(map->viewport.bounds.y / (CACHE_CHUNK_SIZE * TILE_SIZE));
-    map->viewport.chunkMax.x = ceilf((map->viewport.bounds.x + map->viewport.bounds.width) / 
-                                   (CACHE_CHUNK_SIZE * TILE_SIZE));
-    map->viewport.chunkMax.y = ceilf((map->viewport.bounds.y + map->viewport.bounds.height) / 
-                                   (CACHE_CHUNK_SIZE * TILE_SIZE));
+    // Update viewport bounds and visible chunks based on camera
+    map->viewport = GetCameraViewport(world->camera);
     
     // Update or create visible chunks
-    for (float y = map->viewport.chunkMin.y; y <= map->viewport.chunkMax.y; y++) {
-        for (float x = map->viewport.chunkMin.x; x <= map->viewport.chunkMax.x; x++) {
-            Vector2 gridPos = {x, y};
-            CachedChunk* chunk = GetChunk(&map->cache, gridPos);
-            
-            if (!chunk) {
-                CreateChunk(mapSystem, gridPos);
-            } else if (chunk->isDirty) {
-                UpdateChunkTexture(mapSystem, chunk);
+    int minX = (int)map->viewport.chunkMin.x;
+    int minY = (int)map->viewport.chunkMin.y;
+    int maxX = (int)map->viewport.chunkMax.x;
+    int maxY = (int)map->viewport.chunkMax.y;
+    
+    // Tiles under the view first, then a ring around it and a few off-screen
+    // chunks so a lazily loaded map fills in without stalling a frame
+    if (map->source) {
+        DecodeMapTiles(mapSystem, minX * CACHE_CHUNK_SIZE, minY * CACHE_CHUNK_SIZE,
+                       (maxX + 1) * CACHE_CHUNK_SIZE - 1, (maxY + 1) * CACHE_CHUNK_SIZE - 1);
+        PrefetchMapChunks(map, minX * CACHE_CHUNK_SIZE / MAP_FILE_CHUNK_SIZE - 1,
+                          minY * CACHE_CHUNK_SIZE / MAP_FILE_CHUNK_SIZE - 1,
+                          maxX * CACHE_CHUNK_SIZE / MAP_FILE_CHUNK_SIZE + 1,
+                          maxY * CACHE_CHUNK_SIZE / MAP_FILE_CHUNK_SIZE + 1);
+        DecodeMapBackground(mapSystem);
+    }
+    
+    // Each layer keeps its own chunks, so a hidden or static layer costs
+    // nothing while another one animates
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        RenderLayer* layer = &map->layers[i];
+        if (!layer->isVisible) continue;
+        
+        bool refresh = false;
+        if (layer->refreshInterval > 0.0f) {
+            layer->refreshTimer += deltaTime;
+            if (layer->refreshTimer >= layer->refreshInterval) {
+                layer->refreshTimer = fmodf(layer->refreshTimer, layer->refreshInterval);
+                refresh = true;
+            }
+        }
+        
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                CachedChunk* chunk = FindCachedChunk(&layer->cache, x, y);
+                
+                if (!chunk) {
+                    CreateChunk(mapSystem, (MapLayerType)i, x, y);
+                    continue;
+                }
+                
+                TouchCachedChunk(&layer->cache, chunk);
+                if (refresh) {
+                    MarkAnimatedTilesDirty(mapSystem, chunk);
+                }
+                if (chunk->isDirty) {
+                    UpdateChunkTexture(mapSystem, (MapLayerType)i, chunk);
+                }
             }
         }
+        
+        // Increment frame counter
+        layer->cache.frameCounter++;
     }
-    
-    // Increment frame counter
-    map->cache.frameCounter++;
 }
 
-static void RenderMapLayers(MapSystem* mapSystem) {
-    if (!mapSystem || !mapSystem->currentMap) return;
-    
-    TileMap* map = mapSystem->currentMap;
+static void DrawMapLayer(const TileMap* map, MapLayerType type) {
+    const RenderLayer* layer = &map->layers[type];
+    if (!layer->isVisible) return;
     
     // Only render chunks within viewport
-    for (int i = 0; i < map->cache.chunkCount; i++) {
-        CachedChunk* chunk = &map->cache.chunks[i];
+    for (int i = 0; i < layer->cache.chunkCount; i++) {
+        const CachedChunk* chunk = &layer->cache.chunks[i];
         
-        if (CheckCollisionRecs(chunk->bounds, map->viewport.bounds)) {
+        if (chunk->texture.id > 0 && CheckCollisionRecs(chunk->bounds, map->viewport.bounds)) {
             DrawTextureRec(chunk->texture.texture,
                           (Rectangle){0, 0, chunk->texture.texture.width, -chunk->texture.texture.height},
                           (Vector2){chunk->bounds.x, chunk->bounds.y},
@@ -185,8 +532,27 @@ static void RenderMapLayers(MapSystem* mapSystem) {
 }
 
 void DrawMapSystem(MapSystem* mapSystem) {
-    if (!mapSystem) return;
-    RenderMapLayers(mapSystem);
+    if (!mapSystem || !mapSystem->currentMap) return;
+    
+    DrawMapLayer(mapSystem->currentMap, MAP_LAYER_GROUND);
+    DrawMapLayer(mapSystem->currentMap, MAP_LAYER_DECORATION);
+}
+
+void DrawMapOverhead(MapSystem* mapSystem) {
+    if (!mapSystem || !mapSystem->currentMap) return;
+    
+    DrawMapLayer(mapSystem->currentMap, MAP_LAYER_OVERHEAD);
+    DrawMapLayer(mapSystem->currentMap, MAP_LAYER_COLLISION);
+}
+
+// Keeps the collision bitmap in step with one edited tile
+static void SyncCollisionCell(MapSystem* mapSystem, int tileX, int tileY) {
+    if (!mapSystem->collisionGrid) return;
+
+    const TileMap* map = mapSystem->currentMap;
+    int index = tileY * map->width + tileX;
+    UpdateCollisionCell(mapSystem->collisionGrid, tileX, tileY,
+                        GetGridTileType(&map->tiles, index), GetGridObjectType(&map->tiles, index));
 }
 
 void AddMapObject(MapSystem* mapSystem, ObjectType type, Vector2 position) {
@@ -202,18 +568,21 @@ void AddMapObject(MapSystem* mapSystem, ObjectType type, Vector2 position) {
         return;
     }
     
+    // Decode first, or the file chunk would later overwrite the edit
+    DecodeMapTiles(mapSystem, tileX, tileY, tileX, tileY);
+    
     // Add object to tile
     int index = tileY * mapSystem->currentMap->width + tileX;
-    mapSystem->currentMap->tiles[index].objectType = type;
+    mapSystem->currentMap->tiles.objects[index] = (uint8_t)type;
+    SyncCollisionCell(mapSystem, tileX, tileY);
+    SetAnimatedTile(&mapSystem->animatedTiles, tileX, tileY, type);
     
-    // Mark affected chunk as dirty
-    Vector2 chunkPos = {
-        floorf(tileX / (float)CACHE_CHUNK_SIZE),
-        floorf(tileY / (float)CACHE_CHUNK_SIZE)
-    };
-    CachedChunk* chunk = GetChunk(&mapSystem->currentMap->cache, chunkPos);
-    if (chunk) {
-        chunk->isDirty = true;
+    // Redraw just this tile, coalesced with other edits until the next update
+    MarkMapTileDirty(mapSystem, tileX, tileY);
+    
+    // Mirror into the gameplay grid so navigation sees the object
+    if (mapSystem->world) {
+        SetMapObjectAt(mapSystem->world, tileX, tileY, type);
     }
 }
 
@@ -230,105 +599,289 @@ void RemoveMapObject(MapSystem* mapSystem, Vector2 position) {
         return;
     }
     
+    // Decode first, or the file chunk would later overwrite the edit
+    DecodeMapTiles(mapSystem, tileX, tileY, tileX, tileY);
+    
     // Remove object from tile
     int index = tileY * mapSystem->currentMap->width + tileX;
-    mapSystem->currentMap->tiles[index].objectType = OBJECT_NONE;
+    mapSystem->currentMap->tiles.objects[index] = OBJECT_NONE;
+    SyncCollisionCell(mapSystem, tileX, tileY);
+    SetAnimatedTile(&mapSystem->animatedTiles, tileX, tileY, OBJECT_NONE);
     
-    // Mark affected chunk as dirty
-    Vector2 chunkPos = {
-        floorf(tileX / (float)CACHE_CHUNK_SIZE),
-        floorf(tileY / (float)CACHE_CHUNK_SIZE)
-    };
-    CachedChunk* chunk = GetChunk(&mapSystem->currentMap->cache, chunkPos);
-    if (chunk) {
-        chunk->isDirty = true;
+    // Redraw just this tile, coalesced with other edits until the next update
+    MarkMapTileDirty(mapSystem, tileX, tileY);
+    
+    // Mirror into the gameplay grid so navigation sees the object
+    if (mapSystem->world) {
+        SetMapObjectAt(mapSystem->world, tileX, tileY, OBJECT_NONE);
     }
 }
 
+void SetMapTileProperties(MapSystem* mapSystem, int tileX, int tileY, const char* properties) {
+    if (!mapSystem || !mapSystem->currentMap) return;
+
+    if (tileX < 0 || tileX >= mapSystem->currentMap->width ||
+        tileY < 0 || tileY >= mapSystem->currentMap->height) {
+        return;
+    }
+
+    // Decode first, or the file chunk would later overwrite the edit
+    DecodeMapTiles(mapSystem, tileX, tileY, tileX, tileY);
+
+    // Saves encode this grid, not the world's
+    int index = tileY * mapSystem->currentMap->width + tileX;
+    if (!SetTileOverride(&mapSystem->currentMap->tiles, index, properties)) return;
+    MarkMapTileDirty(mapSystem, tileX, tileY);
+}
+
 void UpdateMapObjects(MapSystem* mapSystem, float deltaTime) {
+    UNUSED(deltaTime);
     if (!mapSystem || !mapSystem->currentMap) return;
+    double time = GetTime();
     
-    // Update object animations or states if needed
-    for (int y = 0; y < mapSystem->currentMap->height; y++) {
-        for (int x = 0; x < mapSystem->currentMap->width; x++) {
-            int index = y * mapSystem->currentMap->width + x;
-            Tile* tile = &mapSystem->currentMap->tiles[index];
-            
-            // Update object based on type
-            switch (tile->objectType) {
-                case OBJECT_FOUNTAIN:
-                    // Update fountain animation
-                    tile->properties.resonance = sinf(GetTime() * 2.0f) * 0.5f + 0.5f;
-                    break;
-                    
-                case OBJECT_TORCH:
-                    // Update torch flicker
-                    tile->properties.resonance = GetRandomValue(80, 100) / 100.0f;
-                    break;
-                    
-                default:
-                    break;
-            }
+    // Per-tile state only for chunks resident in the render cache, so the
+    // cost follows the view rather than the map or the object count
+    ChunkCache* cache = &mapSystem->currentMap->layers[MAP_LAYER_DECORATION].cache;
+    for (int i = 0; i < cache->chunkCount; i++) {
+        AnimatedChunk* animated = FindAnimatedChunk(&mapSystem->animatedTiles,
+                                                    cache->chunks[i].chunkX, cache->chunks[i].chunkY);
+        if (animated && animated->count > 0) {
+            TickAnimatedChunk(animated, time);
         }
     }
 }
 
+// Incremental saves. Once the map matches a file, saving over it encodes
+// the file chunks edited since and hands them to a worker that appends
+// them to the file's patch log, so the main thread's cost follows the
+// edits rather than the map.
+static void RunMapSaveJob(void* context) {
+    MapSaveJob* job = (MapSaveJob*)context;
+    job->appended = AppendMapFilePatch(job->path, job->patch);
+    job->compacted = job->appended && job->compact && CompactMapFile(job->path);
+}
+
+// Takes the results of a save that has finished. A failed append leaves
+// the file behind the map, so the next save rewrites it whole.
+static void CollectMapSave(MapSystem* mapSystem, bool wait) {
+    MapSaveJob* job = &mapSystem->save;
+    if (!job->patch) return;
+    
+    if (wait) {
+        WaitForJobs(NULL, &job->counter);
+    } else if (!IsJobCounterDone(&job->counter)) {
+        return;
+    }
+    
+    if (!job->appended) {
+        TraceLog(LOG_WARNING, "Failed to append to map file %s", job->path);
+        job->needsFullSave = true;
+    }
+    if (job->compacted) job->patchedChunks = 0;
+    DestroyMapPatch(job->patch);
+    job->patch = NULL;
+}
+
+// Starts tracking edits against a file the map now matches, or stops
+// tracking with a NULL filename
+static void TrackMapSave(MapSystem* mapSystem, const char* filename) {
+    TileMap* map = mapSystem->currentMap;
+    free(map->unsavedChunks);
+    map->unsavedChunks = NULL;
+    map->unsavedCount = 0;
+    mapSystem->save.patchedChunks = 0;
+    mapSystem->save.needsFullSave = false;
+    
+    size_t length = filename ? strlen(filename) : 0;
+    if (length == 0 || length >= MAP_SAVE_PATH_LENGTH) {
+        mapSystem->savePath[0] = '\0';
+        return;
+    }
+    
+    int chunksX = GetMapFileChunksX(map);
+    int chunksY = (map->height + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE;
+    map->unsavedChunks = (uint8_t*)calloc((size_t)chunksX * chunksY, 1);
+    if (filename != mapSystem->savePath) memcpy(mapSystem->savePath, filename, length + 1);
+    if (!map->unsavedChunks) mapSystem->savePath[0] = '\0';
+}
+
+static void SaveMapChanges(MapSystem* mapSystem) {
+    MapSaveJob* job = &mapSystem->save;
+    TileMap* map = mapSystem->currentMap;
+    
+    // Only one save writes at a time; this one follows when it is done
+    if (job->patch) {
+        job->isQueued = true;
+        return;
+    }
+    if (map->unsavedCount == 0) return;
+    
+    job->patch = CreateMapPatch(map->width, map->height);
+    if (!job->patch) {
+        TraceLog(LOG_WARNING, "Failed to save map file %s", mapSystem->savePath);
+        return;
+    }
+    
+    int chunksX = GetMapFileChunksX(map);
+    int chunkCount = chunksX * ((map->height + MAP_FILE_CHUNK_SIZE - 1) / MAP_FILE_CHUNK_SIZE);
+    for (int i = 0; i < chunkCount && map->unsavedCount > 0; i++) {
+        if (!map->unsavedChunks[i]) continue;
+        
+        // Edits decode their own tile, but the rest of the chunk may not
+        // be decoded yet
+        int x = i % chunksX;
+        int y = i / chunksX;
+        DecodeMapTiles(mapSystem, x * MAP_FILE_CHUNK_SIZE, y * MAP_FILE_CHUNK_SIZE,
+                       x * MAP_FILE_CHUNK_SIZE, y * MAP_FILE_CHUNK_SIZE);
+        AddMapPatchChunk(job->patch, &map->tiles, x, y);
+        map->unsavedChunks[i] = 0;
+        map->unsavedCount--;
+    }
+    
+    // Fold the log in once replaying it would cost as much as the file.
+    // Not while the file is still mapped, Windows cannot replace it then.
+    job->patchedChunks += GetMapPatchChunkCount(job->patch);
+    job->compact = job->patchedChunks >= chunkCount && !map->source;
+    memcpy(job->path, mapSystem->savePath, sizeof(job->path));
+    SubmitJob(GetJobSystem(), RunMapSaveJob, job, &job->counter);
+}
+
+void FinishMapSave(MapSystem* mapSystem) {
+    if (!mapSystem) return;
+    
+    CollectMapSave(mapSystem, true);
+    if (mapSystem->save.isQueued && mapSystem->currentMap) {
+        mapSystem->save.isQueued = false;
+        SaveMapSystem(mapSystem, mapSystem->savePath);
+        CollectMapSave(mapSystem, true);
+    }
+    mapSystem->save.isQueued = false;
+}
+
 void SaveMapSystem(MapSystem* mapSystem, const char* filename) {
     if (!mapSystem || !mapSystem->currentMap || !filename) return;
     
-    FILE* file = fopen(filename, "wb");
-    if (!file) return;
-    
-    // Save map dimensions
-    fwrite(&mapSystem->currentMap->width, sizeof(int), 1, file);
-    fwrite(&mapSystem->currentMap->height, sizeof(int), 1, file);
+    TileMap* map = mapSystem->currentMap;
+    CollectMapSave(mapSystem, false);
+    if (map->unsavedChunks && !mapSystem->save.needsFullSave && strcmp(filename, mapSystem->savePath) == 0) {
+        SaveMapChanges(mapSystem);
+        return;
+    }
     
-    // Save tiles
-    size_t tileCount = mapSystem->currentMap->width * mapSystem->currentMap->height;
-    fwrite(mapSystem->currentMap->tiles, sizeof(Tile), tileCount, file);
+    // A full save replaces whatever is still being appended
+    CollectMapSave(mapSystem, true);
+    mapSystem->save.isQueued = false;
     
-    // Save tile properties
-    fwrite(mapSystem->currentMap->properties, sizeof(TileProperties), TILE_COUNT, file);
+    // Saving needs every tile, which also releases the source file before
+    // it may be replaced
+    DecodeMapTiles(mapSystem, 0, 0, map->width - 1, map->height - 1);
+    if (!SaveMapFile(filename, &map->tiles, map->width, map->height)) {
+        TraceLog(LOG_WARNING, "Failed to save map file %s", filename);
+        return;
+    }
+    TrackMapSave(mapSystem, filename);
+}
+
+// Maps saved before the chunked format: int width, int height, then the
+// raw type and object planes
+static bool LoadLegacyMapFile(const char* filename, TileGrid* tiles, int* width, int* height) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return false;
+    
+    bool loaded = fread(width, sizeof(int), 1, file) == 1 &&
+                  fread(height, sizeof(int), 1, file) == 1 &&
+                  *width > 0 && *height > 0;
+    
+    size_t tileCount = loaded ? (size_t)*width * (size_t)*height : 0;
+    loaded = loaded && InitTileGrid(tiles, tileCount, TILE_NONE);
+    if (loaded) {
+        loaded = fread(tiles->types, sizeof(uint8_t), tileCount, file) == tileCount &&
+                 fread(tiles->objects, sizeof(uint8_t), tileCount, file) == tileCount;
+        if (!loaded) FreeTileGrid(tiles);
+    }
     
     fclose(file);
+    return loaded;
 }
 
 void LoadMapSystem(MapSystem* mapSystem, const char* filename) {
     if (!mapSystem || !filename) return;
     
-    FILE* file = fopen(filename, "rb");
-    if (!file) return;
+    // The file may be the one a worker is still writing
+    FinishMapSave(mapSystem);
+    
+    // Map files are mapped and decoded as chunks are needed; legacy files
+    // are read whole. Either way a bad file leaves the current map alone.
+    TileGrid tiles = { 0 };
+    int width = 0;
+    int height = 0;
+    MapFile* source = OpenMapFile(filename);
+    uint8_t* decodedChunks = NULL;
+    if (source) {
+        width = GetMapFileWidth(source);
+        height = GetMapFileHeight(source);
+        decodedChunks = (uint8_t*)calloc((size_t)GetMapFileChunkCount(source), 1);
+        if (!decodedChunks || !InitTileGrid(&tiles, (size_t)width * (size_t)height, TILE_NONE)) {
+            free(decodedChunks);
+            CloseMapFile(source);
+            return;
+        }
+    } else if (!LoadLegacyMapFile(filename, &tiles, &width, &height)) {
+        return;
+    }
     
     // Create new map if needed
     if (!mapSystem->currentMap) {
-        mapSystem->currentMap = (TileMap*)malloc(sizeof(TileMap));
-        if (!mapSystem->currentMap) {
-            fclose(file);
+        mapSystem->currentMap = (TileMap*)calloc(1, sizeof(TileMap));
+        if (!mapSystem->currentMap ||
+            !InitMapLayers(mapSystem->currentMap, mapSystem->chunkCacheSize)) {
+            free(mapSystem->currentMap);
+            mapSystem->currentMap = NULL;
+            FreeTileGrid(&tiles);
+            free(decodedChunks);
+            CloseMapFile(source);
             return;
         }
     }
     
-    // Load map dimensions
-    fread(&mapSystem->currentMap->width, sizeof(int), 1, file);
-    fread(&mapSystem->currentMap->height, sizeof(int), 1, file);
-    
-    // Allocate and load tiles
-    size_t tileCount = mapSystem->currentMap->width * mapSystem->currentMap->height;
-    mapSystem->currentMap->tiles = (Tile*)realloc(mapSystem->currentMap->tiles, tileCount * sizeof(Tile));
-    if (mapSystem->currentMap->tiles) {
-        fread(mapSystem->currentMap->tiles, sizeof(Tile), tileCount, file);
+    TileMap* map = mapSystem->currentMap;
+    CloseMapSource(map);
+    FreeTileGrid(&map->tiles);
+    map->tiles = tiles;
+    map->width = width;
+    map->height = height;
+    
+    // Resize the collision bitmap if the map size changed
+    CollisionGrid* grid = mapSystem->collisionGrid;
+    if (grid && (grid->width != map->width || grid->height != map->height)) {
+        DestroyCollisionGrid(grid);
+        grid = NULL;
     }
-    
-    // Allocate and load tile properties
-    mapSystem->currentMap->properties = (TileProperties*)realloc(mapSystem->currentMap->properties, TILE_COUNT * sizeof(TileProperties));
-    if (mapSystem->currentMap->properties) {
-        fread(mapSystem->currentMap->properties, sizeof(TileProperties), TILE_COUNT, file);
+    if (!grid) {
+        grid = CreateCollisionGrid(map->width, map->height, TILE_SIZE);
+    }
+    mapSystem->collisionGrid = grid;
+    
+    // Later saves patch a chunked file; a legacy one is rewritten first
+    TrackMapSave(mapSystem, source ? filename : NULL);
+    
+    if (source) {
+        // Chunks fill the bitmap and animated index in as they are decoded
+        map->source = source;
+        map->decodedChunks = decodedChunks;
+        map->pendingChunks = GetMapFileChunkCount(source);
+        ClearCollisionGrid(grid);
+        ClearAnimatedTileIndex(&mapSystem->animatedTiles);
+        DecodeMapBackground(mapSystem);
+    } else {
+        RebuildCollisionGrid(grid, &map->tiles);
+        RebuildAnimatedTileIndex(&mapSystem->animatedTiles, &map->tiles, map->width, map->height);
     }
-    
-    fclose(file);
     
     // Mark all chunks as dirty to force redraw
-    for (int i = 0; i < mapSystem->currentMap->cache.chunkCount; i++) {
-        mapSystem->currentMap->cache.chunks[i].isDirty = true;
+    for (int i = 0; i < MAP_LAYER_COUNT; i++) {
+        for (int j = 0; j < map->layers[i].cache.chunkCount; j++) {
+            MarkChunkDirty(&map->layers[i].cache.chunks[j]);
+        }
     }
-} 
\ No newline at end of file
+}
@@ -0,0 +1,633 @@
+#include "../../include/pathfinding.h"
+#include "../../include/world.h"
+#include "../../include/collision_grid.h"
+#include "../../include/region_map.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Neighbor order: east, south, west, north
+static const int kDirX[4] = { 1, 0, -1, 0 };
+static const int kDirY[4] = { 0, 1, 0, -1 };
+
+static bool SamePoint(HPAPoint a, HPAPoint b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+static int GetChunkIndex(const HPAGraph* graph, int chunkX, int chunkY) {
+    return chunkY * graph->chunksX + chunkX;
+}
+
+static int GetChunkIndexOfTile(const HPAGraph* graph, HPAPoint tile) {
+    return GetChunkIndex(graph, tile.x / HPA_CHUNK_SIZE, tile.y / HPA_CHUNK_SIZE);
+}
+
+static bool IsTileInGraph(const HPAGraph* graph, int x, int y) {
+    return x >= 0 && x < graph->width && y >= 0 && y < graph->height;
+}
+
+static void GetChunkRect(const HPAGraph* graph, int chunkX, int chunkY, int* x, int* y, int* width, int* height) {
+    *x = chunkX * HPA_CHUNK_SIZE;
+    *y = chunkY * HPA_CHUNK_SIZE;
+    *width = graph->width - *x < HPA_CHUNK_SIZE ? graph->width - *x : HPA_CHUNK_SIZE;
+    *height = graph->height - *y < HPA_CHUNK_SIZE ? graph->height - *y : HPA_CHUNK_SIZE;
+}
+
+// Regions never span more than two chunks along either axis
+#define HPA_REGION_MAX_ROWS (2 * HPA_CHUNK_SIZE)
+
+static HPAPoint GetTileOf(Vector2 position) {
+    return (HPAPoint){ (int)floorf(position.x / TILE_SIZE), (int)floorf(position.y / TILE_SIZE) };
+}
+
+// Tile-level search
+
+// Breadth-first search confined to a rectangle. Fills regionDist (-1 when
+// unreached) and regionParent; stops early once stop is reached.
+static void SearchRegion(HPAGraph* graph, const World* world, int rx, int ry, int rw, int rh,
+                         HPAPoint start, HPAPoint stop) {
+    int cellCount = rw * rh;
+    for (int i = 0; i < cellCount; i++) {
+        graph->regionDist[i] = -1;
+    }
+
+    int startIndex = (start.y - ry) * rw + (start.x - rx);
+    int stopIndex = (stop.x >= rx && stop.x < rx + rw && stop.y >= ry && stop.y < ry + rh)
+                  ? (stop.y - ry) * rw + (stop.x - rx) : -1;
+
+    // With a collision bitmap each region row is one word of open cells,
+    // so a neighbour check is a shift and a mask
+    uint64_t openRows[HPA_REGION_MAX_ROWS];
+    bool useRows = world->collision && rw <= COLLISION_WORD_BITS && rh <= HPA_REGION_MAX_ROWS;
+    if (useRows) {
+        uint64_t rowMask = rw == COLLISION_WORD_BITS ? ~(uint64_t)0 : ((uint64_t)1 << rw) - 1;
+        for (int y = 0; y < rh; y++) {
+            openRows[y] = ~GetCollisionRow(world->collision, rx, ry + y) & rowMask;
+        }
+    }
+
+    int head = 0;
+    int tail = 0;
+    graph->regionDist[startIndex] = 0;
+    graph->regionParent[startIndex] = -1;
+    graph->regionQueue[tail++] = startIndex;
+
+    while (head < tail) {
+        int current = graph->regionQueue[head++];
+        if (current == stopIndex) break;
+
+        int cx = current % rw;
+        int cy = current / rw;
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + kDirX[d];
+            int ny = cy + kDirY[d];
+            if (nx < 0 || nx >= rw || ny < 0 || ny >= rh) continue;
+
+            int next = ny * rw + nx;
+            if (graph->regionDist[next] >= 0) continue;
+            bool open = useRows ? ((openRows[ny] >> nx) & 1u) != 0 : IsWalkableGrid(world, rx + nx, ry + ny);
+            if (!open) continue;
+
+            graph->regionDist[next] = graph->regionDist[current] + 1;
+            graph->regionParent[next] = current;
+            graph->regionQueue[tail++] = next;
+        }
+    }
+}
+
+static void SearchChunk(HPAGraph* graph, const World* world, int chunkIndex, HPAPoint start, HPAPoint stop) {
+    int rx, ry, rw, rh;
+    GetChunkRect(graph, chunkIndex % graph->chunksX, chunkIndex / graph->chunksX, &rx, &ry, &rw, &rh);
+    SearchRegion(graph, world, rx, ry, rw, rh, start, stop);
+}
+
+static int GetRegionDistance(const HPAGraph* graph, int chunkIndex, HPAPoint tile) {
+    int rx, ry, rw, rh;
+    GetChunkRect(graph, chunkIndex % graph->chunksX, chunkIndex / graph->chunksX, &rx, &ry, &rw, &rh);
+    return graph->regionDist[(tile.y - ry) * rw + (tile.x - rx)];
+}
+
+// Abstract graph construction
+
+// Transition tiles on one border of a chunk. The scan only depends on the
+// shared border, so both neighbors derive matching pairs independently.
+static int GetBorderTransitions(const HPAGraph* graph, const World* world, int chunkX, int chunkY, int dir,
+                                HPAPoint* transitions) {
+    int neighborX = chunkX + kDirX[dir];
+    int neighborY = chunkY + kDirY[dir];
+    if (neighborX < 0 || neighborX >= graph->chunksX || neighborY < 0 || neighborY >= graph->chunksY) return 0;
+
+    int rx, ry, rw, rh;
+    GetChunkRect(graph, chunkX, chunkY, &rx, &ry, &rw, &rh);
+
+    bool alongX = kDirY[dir] != 0;
+    int fixed = dir == 0 ? rx + rw - 1 : dir == 2 ? rx : dir == 1 ? ry + rh - 1 : ry;
+    int begin = alongX ? rx : ry;
+    int end = alongX ? rx + rw : ry + rh;
+
+    int count = 0;
+    int runStart = -1;
+    for (int i = begin; i <= end; i++) {
+        bool open = false;
+        if (i < end) {
+            int x = alongX ? i : fixed;
+            int y = alongX ? fixed : i;
+            open = IsWalkableGrid(world, x, y) && IsWalkableGrid(world, x + kDirX[dir], y + kDirY[dir]);
+        }
+
+        if (open && runStart < 0) {
+            runStart = i;
+        } else if (!open && runStart >= 0) {
+            int length = i - runStart;
+            if (length < HPA_ENTRANCE_SPLIT) {
+                int mid = runStart + length / 2;
+                transitions[count++] = alongX ? (HPAPoint){ mid, fixed } : (HPAPoint){ fixed, mid };
+            } else {
+                transitions[count++] = alongX ? (HPAPoint){ runStart, fixed } : (HPAPoint){ fixed, runStart };
+                transitions[count++] = alongX ? (HPAPoint){ i - 1, fixed } : (HPAPoint){ fixed, i - 1 };
+            }
+            runStart = -1;
+        }
+    }
+
+    return count;
+}
+
+void RepairHPAChunk(HPAGraph* graph, const World* world, int chunkX, int chunkY) {
+    if (!graph || !world) return;
+    if (chunkX < 0 || chunkX >= graph->chunksX || chunkY < 0 || chunkY >= graph->chunksY) return;
+
+    int chunkIndex = GetChunkIndex(graph, chunkX, chunkY);
+    HPAChunk* chunk = &graph->chunks[chunkIndex];
+    int originX = chunkX * HPA_CHUNK_SIZE;
+    int originY = chunkY * HPA_CHUNK_SIZE;
+
+    // Collect transition tiles from all four borders
+    chunk->nodeCount = 0;
+    memset(chunk->nodeAt, -1, sizeof(chunk->nodeAt));
+
+    HPAPoint transitions[HPA_CHUNK_SIZE];
+    for (int dir = 0; dir < 4; dir++) {
+        int count = GetBorderTransitions(graph, world, chunkX, chunkY, dir, transitions);
+        for (int i = 0; i < count; i++) {
+            int local = (transitions[i].y - originY) * HPA_CHUNK_SIZE + (transitions[i].x - originX);
+            if (chunk->nodeAt[local] >= 0 || chunk->nodeCount >= HPA_MAX_CHUNK_NODES) continue;
+
+            chunk->nodeAt[local] = (int8_t)chunk->nodeCount;
+            chunk->nodes[chunk->nodeCount++] = transitions[i];
+        }
+    }
+
+    // Precompute intra-chunk costs between every pair of transitions
+    HPAPoint none = { -1, -1 };
+    for (int i = 0; i < chunk->nodeCount; i++) {
+        SearchChunk(graph, world, chunkIndex, chunk->nodes[i], none);
+        for (int j = 0; j < chunk->nodeCount; j++) {
+            int dist = GetRegionDistance(graph, chunkIndex, chunk->nodes[j]);
+            chunk->costs[i * HPA_MAX_CHUNK_NODES + j] = dist < 0 ? HPA_NO_PATH : (uint16_t)dist;
+        }
+    }
+}
+
+void RepairHPATile(HPAGraph* graph, const World* world, int x, int y) {
+    if (!graph || !IsTileInGraph(graph, x, y)) return;
+
+    int chunkX = x / HPA_CHUNK_SIZE;
+    int chunkY = y / HPA_CHUNK_SIZE;
+    int localX = x - chunkX * HPA_CHUNK_SIZE;
+    int localY = y - chunkY * HPA_CHUNK_SIZE;
+
+    RepairHPAChunk(graph, world, chunkX, chunkY);
+
+    // Border edits change the transitions the neighbor sees as well
+    if (localX == 0) RepairHPAChunk(graph, world, chunkX - 1, chunkY);
+    if (localX == HPA_CHUNK_SIZE - 1) RepairHPAChunk(graph, world, chunkX + 1, chunkY);
+    if (localY == 0) RepairHPAChunk(graph, world, chunkX, chunkY - 1);
+    if (localY == HPA_CHUNK_SIZE - 1) RepairHPAChunk(graph, world, chunkX, chunkY + 1);
+}
+
+HPAGraph* CreateHPAGraph(const World* world) {
+    if (!world || !world->tiles.types || world->width <= 0 || world->height <= 0) return NULL;
+
+    HPAGraph* graph = (HPAGraph*)calloc(1, sizeof(HPAGraph));
+    if (!graph) return NULL;
+
+    graph->width = world->width;
+    graph->height = world->height;
+    graph->chunksX = (world->width + HPA_CHUNK_SIZE - 1) / HPA_CHUNK_SIZE;
+    graph->chunksY = (world->height + HPA_CHUNK_SIZE - 1) / HPA_CHUNK_SIZE;
+
+    int chunkCount = graph->chunksX * graph->chunksY;
+    graph->nodeSlots = chunkCount * HPA_MAX_CHUNK_NODES + 2;
+    int regionCells = 2 * HPA_CHUNK_SIZE * HPA_CHUNK_SIZE;
+
+    graph->chunks = (HPAChunk*)calloc((size_t)chunkCount, sizeof(HPAChunk));
+    graph->visitStamp = (uint32_t*)calloc((size_t)graph->nodeSlots, sizeof(uint32_t));
+    graph->gScore = (int*)malloc((size_t)graph->nodeSlots * sizeof(int));
+    graph->parent = (int*)malloc((size_t)graph->nodeSlots * sizeof(int));
+    graph->regionDist = (int*)malloc((size_t)regionCells * sizeof(int));
+    graph->regionParent = (int*)malloc((size_t)regionCells * sizeof(int));
+    graph->regionQueue = (int*)malloc((size_t)regionCells * sizeof(int));
+
+    if (!graph->chunks || !graph->visitStamp || !graph->gScore || !graph->parent ||
+        !graph->regionDist || !graph->regionParent || !graph->regionQueue) {
+        DestroyHPAGraph(graph);
+        return NULL;
+    }
+
+    for (int y = 0; y < graph->chunksY; y++) {
+        for (int x = 0; x < graph->chunksX; x++) {
+            RepairHPAChunk(graph, world, x, y);
+        }
+    }
+
+    return graph;
+}
+
+void DestroyHPAGraph(HPAGraph* graph) {
+    if (!graph) return;
+
+    free(graph->chunks);
+    free(graph->visitStamp);
+    free(graph->gScore);
+    free(graph->parent);
+    free(graph->open);
+    free(graph->regionDist);
+    free(graph->regionParent);
+    free(graph->regionQueue);
+    free(graph);
+}
+
+HPAGraph* GetWorldPathGraph(World* world) {
+    if (!world) return NULL;
+
+    // Rebuild if the tile grid was replaced with one of a different size
+    if (world->pathGraph &&
+        (world->pathGraph->width != world->width || world->pathGraph->height != world->height)) {
+        DestroyHPAGraph(world->pathGraph);
+        world->pathGraph = NULL;
+    }
+
+    if (!world->pathGraph) {
+        world->pathGraph = CreateHPAGraph(world);
+    }
+
+    // Regions come with the graph so searches can reject enclosed goals
+    GetWorldRegions(world);
+    return world->pathGraph;
+}
+
+// Abstract search
+
+static bool PushOpen(HPAGraph* graph, int priority, int node) {
+    if (graph->openCount >= graph->openCapacity) {
+        int newCapacity = graph->openCapacity > 0 ? graph->openCapacity * 2 : 256;
+        HPASearchEntry* open = (HPASearchEntry*)realloc(graph->open, (size_t)newCapacity * sizeof(HPASearchEntry));
+        if (!open) return false;
+        graph->open = open;
+        graph->openCapacity = newCapacity;
+    }
+
+    // Sift up, ties broken by node id so results are stable
+    int i = graph->openCount++;
+    HPASearchEntry entry = { priority, node };
+    while (i > 0) {
+        int up = (i - 1) / 2;
+        HPASearchEntry parent = graph->open[up];
+        if (parent.priority < entry.priority ||
+            (parent.priority == entry.priority && parent.node <= entry.node)) break;
+        graph->open[i] = parent;
+        i = up;
+    }
+    graph->open[i] = entry;
+    return true;
+}
+
+static HPASearchEntry PopOpen(HPAGraph* graph) {
+    HPASearchEntry top = graph->open[0];
+    HPASearchEntry last = graph->open[--graph->openCount];
+
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= graph->openCount) break;
+        if (child + 1 < graph->openCount) {
+            HPASearchEntry a = graph->open[child];
+            HPASearchEntry b = graph->open[child + 1];
+            if (b.priority < a.priority || (b.priority == a.priority && b.node < a.node)) child++;
+        }
+        HPASearchEntry c = graph->open[child];
+        if (last.priority < c.priority || (last.priority == c.priority && last.node <= c.node)) break;
+        graph->open[i] = c;
+        i = child;
+    }
+    if (graph->openCount > 0) graph->open[i] = last;
+    return top;
+}
+
+static HPAPoint GetNodeTile(const HPAGraph* graph, int node, HPAPoint start, HPAPoint goal) {
+    if (node == graph->nodeSlots - 2) return start;
+    if (node == graph->nodeSlots - 1) return goal;
+    return graph->chunks[node / HPA_MAX_CHUNK_NODES].nodes[node % HPA_MAX_CHUNK_NODES];
+}
+
+static int GetHeuristic(HPAPoint tile, HPAPoint goal) {
+    return abs(tile.x - goal.x) + abs(tile.y - goal.y);
+}
+
+static void RelaxNode(HPAGraph* graph, int node, int from, int cost, HPAPoint tile, HPAPoint goal) {
+    if (graph->visitStamp[node] == graph->searchStamp && cost >= graph->gScore[node]) return;
+
+    graph->visitStamp[node] = graph->searchStamp;
+    graph->gScore[node] = cost;
+    graph->parent[node] = from;
+    PushOpen(graph, cost + GetHeuristic(tile, goal), node);
+}
+
+int FindHPAPath(HPAGraph* graph, const World* world, HPAPoint start, HPAPoint goal,
+                HPAPoint* waypoints, int maxPoints) {
+    if (!graph || !world || !waypoints || maxPoints <= 0) return -1;
+    if (!IsTileInGraph(graph, start.x, start.y) || !IsTileInGraph(graph, goal.x, goal.y)) return -1;
+    if (!IsWalkableGrid(world, goal.x, goal.y)) return -1;
+
+    // Goals in another region would search every tile reachable from the
+    // start before giving up. Starts off the walkable grid are left to the
+    // search, which can still step off them.
+    if (world->regions && GetTileRegion(world->regions, start.x, start.y) != REGION_NONE &&
+        !AreTilesConnected(world->regions, start.x, start.y, goal.x, goal.y)) {
+        return -1;
+    }
+
+    if (SamePoint(start, goal)) {
+        waypoints[0] = goal;
+        return 1;
+    }
+
+    int startChunk = GetChunkIndexOfTile(graph, start);
+    int goalChunk = GetChunkIndexOfTile(graph, goal);
+
+    // Short queries never leave the chunk
+    if (startChunk == goalChunk) {
+        SearchChunk(graph, world, startChunk, start, goal);
+        if (GetRegionDistance(graph, startChunk, goal) >= 0) {
+            waypoints[0] = goal;
+            return 1;
+        }
+    }
+
+    // Connect the goal to its chunk's transitions
+    const HPAChunk* goalNodes = &graph->chunks[goalChunk];
+    SearchChunk(graph, world, goalChunk, goal, (HPAPoint){ -1, -1 });
+    for (int i = 0; i < goalNodes->nodeCount; i++) {
+        int dist = GetRegionDistance(graph, goalChunk, goalNodes->nodes[i]);
+        graph->goalCosts[i] = dist < 0 ? HPA_NO_PATH : (uint16_t)dist;
+    }
+
+    int startNode = graph->nodeSlots - 2;
+    int goalNode = graph->nodeSlots - 1;
+
+    if (++graph->searchStamp == 0) {
+        memset(graph->visitStamp, 0, (size_t)graph->nodeSlots * sizeof(uint32_t));
+        graph->searchStamp = 1;
+    }
+    graph->openCount = 0;
+
+    graph->visitStamp[startNode] = graph->searchStamp;
+    graph->gScore[startNode] = 0;
+    graph->parent[startNode] = -1;
+    PushOpen(graph, GetHeuristic(start, goal), startNode);
+
+    bool found = false;
+    while (graph->openCount > 0) {
+        HPASearchEntry entry = PopOpen(graph);
+        int node = entry.node;
+        HPAPoint tile = GetNodeTile(graph, node, start, goal);
+        int cost = graph->gScore[node];
+
+        // Skip stale heap entries
+        if (entry.priority > cost + GetHeuristic(tile, goal)) continue;
+
+        if (node == goalNode) {
+            found = true;
+            break;
+        }
+
+        if (node == startNode) {
+            const HPAChunk* chunk = &graph->chunks[startChunk];
+            SearchChunk(graph, world, startChunk, start, (HPAPoint){ -1, -1 });
+            for (int j = 0; j < chunk->nodeCount; j++) {
+                int dist = GetRegionDistance(graph, startChunk, chunk->nodes[j]);
+                if (dist < 0) continue;
+                RelaxNode(graph, startChunk * HPA_MAX_CHUNK_NODES + j, node, dist, chunk->nodes[j], goal);
+            }
+            continue;
+        }
+
+        int chunkIndex = node / HPA_MAX_CHUNK_NODES;
+        int local = node % HPA_MAX_CHUNK_NODES;
+        const HPAChunk* chunk = &graph->chunks[chunkIndex];
+
+        // Intra-chunk edges
+        for (int j = 0; j < chunk->nodeCount; j++) {
+            uint16_t edge = chunk->costs[local * HPA_MAX_CHUNK_NODES + j];
+            if (j == local || edge == HPA_NO_PATH) continue;
+            RelaxNode(graph, chunkIndex * HPA_MAX_CHUNK_NODES + j, node, cost + edge, chunk->nodes[j], goal);
+        }
+
+        // Inter-chunk edges to the paired transition across the border
+        for (int d = 0; d < 4; d++) {
+            HPAPoint across = { tile.x + kDirX[d], tile.y + kDirY[d] };
+            if (!IsTileInGraph(graph, across.x, across.y)) continue;
+
+            int acrossChunk = GetChunkIndexOfTile(graph, across);
+            if (acrossChunk == chunkIndex) continue;
+
+            const HPAChunk* other = &graph->chunks[acrossChunk];
+            int localX = across.x % HPA_CHUNK_SIZE;
+            int localY = across.y % HPA_CHUNK_SIZE;
+            int otherNode = other->nodeAt[localY * HPA_CHUNK_SIZE + localX];
+            if (otherNode < 0) continue;
+
+            RelaxNode(graph, acrossChunk * HPA_MAX_CHUNK_NODES + otherNode, node, cost + 1, across, goal);
+        }
+
+        // Final hop to the goal
+        if (chunkIndex == goalChunk && graph->goalCosts[local] != HPA_NO_PATH) {
+            RelaxNode(graph, goalNode, node, cost + graph->goalCosts[local], goal, goal);
+        }
+    }
+
+    if (!found) return -1;
+
+    // Count the chain, then keep the waypoints nearest the start
+    int length = 0;
+    for (int node = goalNode; node != startNode; node = graph->parent[node]) {
+        length++;
+    }
+
+    int written = length < maxPoints ? length : maxPoints;
+    int position = length - 1;
+    for (int node = goalNode; node != startNode; node = graph->parent[node], position--) {
+        if (position < written) {
+            waypoints[position] = GetNodeTile(graph, node, start, goal);
+        }
+    }
+
+    return written;
+}
+
+bool RefineHPAStep(HPAGraph* graph, const World* world, HPAPoint from, HPAPoint to, HPAPoint* step) {
+    if (!graph || !world || !step) return false;
+    if (!IsTileInGraph(graph, from.x, from.y) || !IsTileInGraph(graph, to.x, to.y)) return false;
+
+    if (SamePoint(from, to)) {
+        *step = to;
+        return true;
+    }
+
+    int fromChunkX = from.x / HPA_CHUNK_SIZE;
+    int fromChunkY = from.y / HPA_CHUNK_SIZE;
+    int toChunkX = to.x / HPA_CHUNK_SIZE;
+    int toChunkY = to.y / HPA_CHUNK_SIZE;
+    if (abs(fromChunkX - toChunkX) + abs(fromChunkY - toChunkY) > 1) return false;
+
+    // Search the union of the two chunks
+    int ax, ay, aw, ah, bx, by, bw, bh;
+    GetChunkRect(graph, fromChunkX, fromChunkY, &ax, &ay, &aw, &ah);
+    GetChunkRect(graph, toChunkX, toChunkY, &bx, &by, &bw, &bh);
+    int rx = ax < bx ? ax : bx;
+    int ry = ay < by ? ay : by;
+    int rw = (ax + aw > bx + bw ? ax + aw : bx + bw) - rx;
+    int rh = (ay + ah > by + bh ? ay + ah : by + bh) - ry;
+
+    SearchRegion(graph, world, rx, ry, rw, rh, from, to);
+
+    int target = (to.y - ry) * rw + (to.x - rx);
+    if (graph->regionDist[target] < 0) return false;
+
+    // Walk back to the tile right after the start
+    int fromIndex = (from.y - ry) * rw + (from.x - rx);
+    int current = target;
+    while (graph->regionParent[current] != fromIndex) {
+        current = graph->regionParent[current];
+    }
+
+    *step = (HPAPoint){ rx + current % rw, ry + current / rw };
+    return true;
+}
+
+// Path following
+
+static bool ReplanPath(PathFollower* path, HPAGraph* graph, const World* world, HPAPoint from) {
+    int count = FindHPAPath(graph, world, from, path->goal, path->waypoints, HPA_PATH_WINDOW);
+
+    path->waypointCount = count > 0 ? count : 0;
+    path->waypointIndex = 0;
+    path->hasStep = false;
+
+    // The start tile can itself be a transition
+    while (path->waypointIndex < path->waypointCount &&
+           SamePoint(path->waypoints[path->waypointIndex], from)) {
+        path->waypointIndex++;
+    }
+
+    path->active = path->waypointIndex < path->waypointCount;
+    return path->active;
+}
+
+bool SetPathGoal(PathFollower* path, HPAGraph* graph, const World* world, Vector2 position, Vector2 goal) {
+    if (!path) return false;
+
+    memset(path, 0, sizeof(PathFollower));
+    path->goal = GetTileOf(goal);
+    return ReplanPath(path, graph, world, GetTileOf(position));
+}
+
+bool GetPathTarget(PathFollower* path, HPAGraph* graph, const World* world, Vector2 position, Vector2* target) {
+    if (!path || !path->active || !target) return false;
+
+    HPAPoint tile = GetTileOf(position);
+
+    // Consume reached waypoints, refilling the window from the abstract graph
+    while (path->waypointIndex < path->waypointCount &&
+           SamePoint(tile, path->waypoints[path->waypointIndex])) {
+        path->waypointIndex++;
+        path->hasStep = false;
+    }
+
+    if (path->waypointIndex >= path->waypointCount) {
+        if (SamePoint(tile, path->goal)) {
+            path->active = false;
+            return false;
+        }
+        if (!ReplanPath(path, graph, world, tile)) return false;
+    }
+
+    // Refine only the next tile step, and only when the tile changes
+    if (!path->hasStep || !SamePoint(path->stepFrom, tile)) {
+        if (!RefineHPAStep(graph, world, tile, path->waypoints[path->waypointIndex], &path->step)) {
+            // Pushed off the planned route, plan again from here
+            if (!ReplanPath(path, graph, world, tile)) return false;
+            if (!RefineHPAStep(graph, world, tile, path->waypoints[path->waypointIndex], &path->step)) {
+                path->active = false;
+                return false;
+            }
+        }
+        path->stepFrom = tile;
+        path->hasStep = true;
+    }
+
+    *target = (Vector2){ (float)(path->step.x * TILE_SIZE), (float)(path->step.y * TILE_SIZE) };
+    return true;
+}
+
+// Follower table
+
+PathFollowerTable* CreatePathFollowerTable(void) {
+    return (PathFollowerTable*)calloc(1, sizeof(PathFollowerTable));
+}
+
+void DestroyPathFollowerTable(PathFollowerTable* table) {
+    if (!table) return;
+    free(table->slots);
+    free(table);
+}
+
+PathFollowerTable* GetWorldPathFollowers(World* world) {
+    if (!world) return NULL;
+    if (!world->paths) world->paths = CreatePathFollowerTable();
+    return world->paths;
+}
+
+// A slot idle long enough to hand over, or a new one at the end
+static int TakePathFollowerSlot(PathFollowerTable* table, uint64_t tick) {
+    for (int i = 0; i < table->count; i++) {
+        if (tick >= table->slots[i].lastUsed + PATH_FOLLOWER_IDLE_TICKS) return i;
+    }
+
+    if (table->count >= table->capacity) {
+        int newCapacity = table->capacity > 0 ? table->capacity * 2 : 32;
+        PathFollowerSlot* slots = (PathFollowerSlot*)realloc(table->slots, (size_t)newCapacity * sizeof(PathFollowerSlot));
+        if (!slots) return -1;
+        table->slots = slots;
+        table->capacity = newCapacity;
+    }
+    return table->count++;
+}
+
+PathFollower* GetPathFollower(PathFollowerTable* table, int* handle, uint32_t owner, uint64_t tick) {
+    if (!table || !handle) return NULL;
+
+    int slot = *handle - 1;
+    if (slot < 0 || slot >= table->count || table->slots[slot].owner != owner) {
+        slot = TakePathFollowerSlot(table, tick);
+        if (slot < 0) return NULL;
+
+        memset(&table->slots[slot].follower, 0, sizeof(PathFollower));
+        table->slots[slot].owner = owner;
+        *handle = slot + 1;
+    }
+
+    table->slots[slot].lastUsed = tick;
+    return &table->slots[slot].follower;
+}
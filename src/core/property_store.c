@@ -0,0 +1,539 @@
+#include "../../include/property_store.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROPERTY_INITIAL_CAPACITY 16
+#define PROPERTY_NUMBER_LENGTH 32
+
+// One key/value pair as parsed, before interning
+typedef struct ParsedProperty {
+    char* key;
+    PropertyValue value;
+    char* string;                    // Owned until interned
+    int order;                       // Position in the text, later duplicates win
+} ParsedProperty;
+
+typedef struct ParsedObject {
+    ParsedProperty* properties;
+    int count;
+    int capacity;
+} ParsedObject;
+
+// Growable text, as the canonical form is built
+typedef struct TextBuffer {
+    char* data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} TextBuffer;
+
+static uint32_t HashText(const char* text) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* at = (const unsigned char*)text; *at; at++) {
+        hash = (hash ^ *at) * 16777619u;
+    }
+    return hash;
+}
+
+static bool GrowArray(void** data, int* capacity, int needed, size_t elementSize) {
+    if (needed <= *capacity) return true;
+
+    int newCapacity = *capacity > 0 ? *capacity * 2 : PROPERTY_INITIAL_CAPACITY;
+    while (newCapacity < needed) newCapacity *= 2;
+    void* grown = realloc(*data, (size_t)newCapacity * elementSize);
+    if (!grown) return false;
+
+    *data = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+// Store management
+
+PropertyStore* CreatePropertyStore(void) {
+    PropertyStore* store = (PropertyStore*)calloc(1, sizeof(PropertyStore));
+    if (!store) return NULL;
+
+    // Id 0 stays unused so PROPERTY_SET_NONE never names a set
+    if (!GrowArray((void**)&store->sets, &store->setCapacity, 1, sizeof(PropertySet))) {
+        free(store);
+        return NULL;
+    }
+    store->sets[0] = (PropertySet){ 0, 0, NULL };
+    store->setCount = 1;
+    return store;
+}
+
+void DestroyPropertyStore(PropertyStore* store) {
+    if (!store) return;
+
+    for (int i = 0; i < store->stringCount; i++) {
+        free(store->strings[i]);
+    }
+    free(store->strings);
+    free(store->stringTable);
+    free(store->sets);
+    free(store->setTable);
+    free(store->records);
+    free(store);
+}
+
+// String interning
+
+static int FindString(const PropertyStore* store, const char* text, uint32_t hash) {
+    if (store->stringTableCapacity == 0) return -1;
+
+    int mask = store->stringTableCapacity - 1;
+    for (int slot = (int)(hash & (uint32_t)mask);; slot = (slot + 1) & mask) {
+        int id = store->stringTable[slot];
+        if (id < 0 || strcmp(store->strings[id], text) == 0) return id;
+    }
+}
+
+static void PlaceString(PropertyStore* store, int id) {
+    int mask = store->stringTableCapacity - 1;
+    int slot = (int)(HashText(store->strings[id]) & (uint32_t)mask);
+    while (store->stringTable[slot] >= 0) slot = (slot + 1) & mask;
+    store->stringTable[slot] = id;
+}
+
+// Kept at most half full so probes stay short
+static bool GrowStringTable(PropertyStore* store) {
+    if ((store->stringCount + 1) * 2 <= store->stringTableCapacity) return true;
+
+    int capacity = store->stringTableCapacity > 0 ? store->stringTableCapacity * 2 : PROPERTY_INITIAL_CAPACITY * 2;
+    int* table = (int*)malloc((size_t)capacity * sizeof(int));
+    if (!table) return false;
+
+    free(store->stringTable);
+    store->stringTable = table;
+    store->stringTableCapacity = capacity;
+    for (int i = 0; i < capacity; i++) table[i] = -1;
+    for (int i = 0; i < store->stringCount; i++) PlaceString(store, i);
+    return true;
+}
+
+// Id of a string, copying it in when new; -1 when out of memory
+static int InternString(PropertyStore* store, const char* text) {
+    int id = FindString(store, text, HashText(text));
+    if (id >= 0) return id;
+
+    if (!GrowStringTable(store) ||
+        !GrowArray((void**)&store->strings, &store->stringCapacity, store->stringCount + 1, sizeof(char*))) {
+        return -1;
+    }
+
+    size_t length = strlen(text) + 1;
+    char* copy = (char*)malloc(length);
+    if (!copy) return -1;
+    memcpy(copy, text, length);
+
+    id = store->stringCount++;
+    store->strings[id] = copy;
+    PlaceString(store, id);
+    return id;
+}
+
+// Parsing
+
+static const char* SkipSpace(const char* at) {
+    while (*at == ' ' || *at == '\t' || *at == '\n' || *at == '\r') at++;
+    return at;
+}
+
+static int ParseHexDigits(const char* at) {
+    int value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = at[i];
+        int digit = c >= '0' && c <= '9' ? c - '0' :
+                    c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                    c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digit < 0) return -1;
+        value = value * 16 + digit;
+    }
+    return value;
+}
+
+static size_t PutUtf8(char* out, unsigned int code) {
+    if (code < 0x80) {
+        out[0] = (char)code;
+        return 1;
+    }
+    if (code < 0x800) {
+        out[0] = (char)(0xC0 | code >> 6);
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000) {
+        out[0] = (char)(0xE0 | code >> 12);
+        out[1] = (char)(0x80 | (code >> 6 & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | code >> 18);
+    out[1] = (char)(0x80 | (code >> 12 & 0x3F));
+    out[2] = (char)(0x80 | (code >> 6 & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+// Decodes the escape after a backslash onto the end of text, returning
+// where the escape ends or NULL when it is malformed
+static const char* ParseEscape(const char* at, char* text, size_t* length) {
+    char escape = *at++;
+    switch (escape) {
+        case '"': case '\\': case '/': text[(*length)++] = escape; return at;
+        case 'b': text[(*length)++] = '\b'; return at;
+        case 'f': text[(*length)++] = '\f'; return at;
+        case 'n': text[(*length)++] = '\n'; return at;
+        case 'r': text[(*length)++] = '\r'; return at;
+        case 't': text[(*length)++] = '\t'; return at;
+        case 'u': break;
+        default: return NULL;
+    }
+
+    // \uXXXX, with surrogate pairs joined into one code point
+    int code = ParseHexDigits(at);
+    if (code < 0) return NULL;
+    at += 4;
+    if (code >= 0xD800 && code < 0xDC00) {
+        int low = at[0] == '\\' && at[1] == 'u' ? ParseHexDigits(at + 2) : -1;
+        if (low < 0xDC00 || low >= 0xE000) return NULL;
+        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        at += 6;
+    } else if (code >= 0xDC00 && code < 0xE000) {
+        return NULL;
+    }
+    *length += PutUtf8(&text[*length], (unsigned int)code);
+    return at;
+}
+
+// Decodes a quoted string starting at the opening quote. Escapes never
+// decode longer than they are written, so the text length bounds the copy.
+static const char* ParseString(const char* at, char** out) {
+    if (*at != '"') return NULL;
+    at++;
+
+    const char* end = at;
+    while (*end && *end != '"') end += (*end == '\\' && end[1]) ? 2 : 1;
+    if (*end != '"') return NULL;
+
+    char* text = (char*)malloc((size_t)(end - at) + 1);
+    if (!text) return NULL;
+
+    size_t length = 0;
+    bool valid = true;
+    while (valid && *at != '"') {
+        unsigned char c = (unsigned char)*at++;
+        if (c < 0x20) {
+            valid = false;
+        } else if (c != '\\') {
+            text[length++] = (char)c;
+        } else {
+            at = ParseEscape(at, text, &length);
+            valid = at != NULL;
+        }
+    }
+
+    // Embedded nulls would cut the string short once interned
+    if (!valid || memchr(text, '\0', length)) {
+        free(text);
+        return NULL;
+    }
+    text[length] = '\0';
+    *out = text;
+    return at + 1;
+}
+
+// JSON number grammar, checked before strtod so it takes nothing looser
+static const char* ParseNumber(const char* at, double* out) {
+    const char* start = at;
+    if (*at == '-') at++;
+    if (*at == '0') {
+        at++;
+    } else if (*at >= '1' && *at <= '9') {
+        while (*at >= '0' && *at <= '9') at++;
+    } else {
+        return NULL;
+    }
+    if (*at == '.') {
+        at++;
+        if (*at < '0' || *at > '9') return NULL;
+        while (*at >= '0' && *at <= '9') at++;
+    }
+    if (*at == 'e' || *at == 'E') {
+        at++;
+        if (*at == '+' || *at == '-') at++;
+        if (*at < '0' || *at > '9') return NULL;
+        while (*at >= '0' && *at <= '9') at++;
+    }
+
+    *out = strtod(start, NULL);
+    return isfinite(*out) ? at : NULL;
+}
+
+static const char* ParseValue(const char* at, ParsedProperty* property) {
+    if (*at == '"') {
+        at = ParseString(at, &property->string);
+        property->value.type = PROPERTY_STRING;
+        return at;
+    }
+    if (strncmp(at, "true", 4) == 0 || strncmp(at, "false", 5) == 0) {
+        property->value.type = PROPERTY_BOOL;
+        property->value.boolean = *at == 't';
+        return at + (*at == 't' ? 4 : 5);
+    }
+    if (strncmp(at, "null", 4) == 0) {
+        property->value.type = PROPERTY_NULL;
+        return at + 4;
+    }
+    property->value.type = PROPERTY_NUMBER;
+    return ParseNumber(at, &property->value.number);
+}
+
+static void FreeParsedObject(ParsedObject* object) {
+    for (int i = 0; i < object->count; i++) {
+        free(object->properties[i].key);
+        free(object->properties[i].string);
+    }
+    free(object->properties);
+}
+
+static bool ParseObject(const char* json, ParsedObject* object) {
+    memset(object, 0, sizeof(ParsedObject));
+
+    const char* at = SkipSpace(json);
+    if (*at++ != '{') return false;
+    at = SkipSpace(at);
+
+    if (*at != '}') {
+        for (;;) {
+            if (!GrowArray((void**)&object->properties, &object->capacity, object->count + 1,
+                           sizeof(ParsedProperty))) {
+                return false;
+            }
+            ParsedProperty* property = &object->properties[object->count];
+            memset(property, 0, sizeof(ParsedProperty));
+            property->order = object->count++;
+
+            at = ParseString(at, &property->key);
+            if (!at) return false;
+            at = SkipSpace(at);
+            if (*at++ != ':') return false;
+            at = ParseValue(SkipSpace(at), property);
+            if (!at) return false;
+
+            at = SkipSpace(at);
+            if (*at == '}') break;
+            if (*at++ != ',') return false;
+            at = SkipSpace(at);
+        }
+    }
+    return *SkipSpace(at + 1) == '\0';
+}
+
+static int CompareParsed(const void* a, const void* b) {
+    const ParsedProperty* left = (const ParsedProperty*)a;
+    const ParsedProperty* right = (const ParsedProperty*)b;
+    int order = strcmp(left->key, right->key);
+    return order != 0 ? order : left->order - right->order;
+}
+
+// Canonical text
+
+static void PutText(TextBuffer* buffer, const char* text, size_t length) {
+    if (buffer->failed) return;
+
+    if (buffer->length + length + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity : 64;
+        while (capacity < buffer->length + length + 1) capacity *= 2;
+        char* data = (char*)realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(&buffer->data[buffer->length], text, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void PutQuoted(TextBuffer* buffer, const char* text) {
+    PutText(buffer, "\"", 1);
+    for (const unsigned char* at = (const unsigned char*)text; *at; at++) {
+        char escape[8];
+        if (*at == '"' || *at == '\\') {
+            escape[0] = '\\';
+            escape[1] = (char)*at;
+            PutText(buffer, escape, 2);
+        } else if (*at < 0x20) {
+            snprintf(escape, sizeof(escape), "\\u%04x", *at);
+            PutText(buffer, escape, 6);
+        } else {
+            PutText(buffer, (const char*)at, 1);
+        }
+    }
+    PutText(buffer, "\"", 1);
+}
+
+// Shortest of the two forms that reads back exactly
+static void PutNumber(TextBuffer* buffer, double number) {
+    char text[PROPERTY_NUMBER_LENGTH];
+    snprintf(text, sizeof(text), "%.15g", number);
+    if (strtod(text, NULL) != number) snprintf(text, sizeof(text), "%.17g", number);
+    PutText(buffer, text, strlen(text));
+}
+
+// Sorts by key, drops all but the last of any repeated key, and writes
+// the object back out compactly
+static void PutCanonical(TextBuffer* buffer, ParsedObject* object) {
+    if (object->count > 1) {
+        qsort(object->properties, (size_t)object->count, sizeof(ParsedProperty), CompareParsed);
+    }
+
+    int kept = 0;
+    for (int i = 0; i < object->count; i++) {
+        if (i + 1 < object->count && strcmp(object->properties[i].key, object->properties[i + 1].key) == 0) {
+            free(object->properties[i].key);
+            free(object->properties[i].string);
+            continue;
+        }
+        object->properties[kept++] = object->properties[i];
+    }
+    object->count = kept;
+
+    PutText(buffer, "{", 1);
+    for (int i = 0; i < object->count; i++) {
+        const ParsedProperty* property = &object->properties[i];
+        if (i > 0) PutText(buffer, ",", 1);
+        PutQuoted(buffer, property->key);
+        PutText(buffer, ":", 1);
+
+        switch (property->value.type) {
+            case PROPERTY_STRING: PutQuoted(buffer, property->string); break;
+            case PROPERTY_NUMBER: PutNumber(buffer, property->value.number); break;
+            case PROPERTY_BOOL: PutText(buffer, property->value.boolean ? "true" : "false",
+                                        property->value.boolean ? 4 : 5); break;
+            default: PutText(buffer, "null", 4); break;
+        }
+    }
+    PutText(buffer, "}", 1);
+}
+
+// Set interning
+
+static int FindSet(const PropertyStore* store, const char* json, uint32_t hash) {
+    if (store->setTableCapacity == 0) return PROPERTY_SET_NONE;
+
+    int mask = store->setTableCapacity - 1;
+    for (int slot = (int)(hash & (uint32_t)mask);; slot = (slot + 1) & mask) {
+        uint16_t id = store->setTable[slot];
+        if (id == PROPERTY_SET_NONE || strcmp(store->sets[id].json, json) == 0) return id;
+    }
+}
+
+static bool GrowSetTable(PropertyStore* store) {
+    if (store->setCount * 2 <= store->setTableCapacity) return true;
+
+    int capacity = store->setTableCapacity > 0 ? store->setTableCapacity * 2 : PROPERTY_INITIAL_CAPACITY * 2;
+    uint16_t* table = (uint16_t*)calloc((size_t)capacity, sizeof(uint16_t));
+    if (!table) return false;
+
+    free(store->setTable);
+    store->setTable = table;
+    store->setTableCapacity = capacity;
+    for (int id = 1; id < store->setCount; id++) {
+        int slot = (int)(HashText(store->sets[id].json) & (uint32_t)(capacity - 1));
+        while (table[slot] != PROPERTY_SET_NONE) slot = (slot + 1) & (capacity - 1);
+        table[slot] = (uint16_t)id;
+    }
+    return true;
+}
+
+// Interns the parsed properties as a new set with the given canonical text
+static uint16_t AddSet(PropertyStore* store, const ParsedObject* object, const char* json) {
+    if (store->setCount > PROPERTY_MAX_SETS || !GrowSetTable(store) ||
+        !GrowArray((void**)&store->sets, &store->setCapacity, store->setCount + 1, sizeof(PropertySet)) ||
+        !GrowArray((void**)&store->records, &store->recordCapacity, store->recordCount + object->count,
+                   sizeof(PropertyRecord))) {
+        return PROPERTY_SET_NONE;
+    }
+
+    int text = InternString(store, json);
+    if (text < 0) return PROPERTY_SET_NONE;
+
+    PropertySet set = { store->recordCount, object->count, store->strings[text] };
+    for (int i = 0; i < object->count; i++) {
+        const ParsedProperty* property = &object->properties[i];
+        PropertyRecord record = { InternString(store, property->key), property->value };
+        if (record.key < 0) return PROPERTY_SET_NONE;
+
+        if (property->value.type == PROPERTY_STRING) {
+            int value = InternString(store, property->string);
+            if (value < 0) return PROPERTY_SET_NONE;
+            record.value.string = store->strings[value];
+        }
+        store->records[set.first + i] = record;
+    }
+    store->recordCount += set.count;
+
+    uint16_t id = (uint16_t)store->setCount++;
+    store->sets[id] = set;
+    int mask = store->setTableCapacity - 1;
+    int slot = (int)(HashText(json) & (uint32_t)mask);
+    while (store->setTable[slot] != PROPERTY_SET_NONE) slot = (slot + 1) & mask;
+    store->setTable[slot] = id;
+    return id;
+}
+
+uint16_t InternPropertySet(PropertyStore* store, const char* json) {
+    if (!store || !json) return PROPERTY_SET_NONE;
+
+    ParsedObject object;
+    if (!ParseObject(json, &object)) {
+        FreeParsedObject(&object);
+        return PROPERTY_SET_NONE;
+    }
+
+    TextBuffer canonical = { 0 };
+    PutCanonical(&canonical, &object);
+
+    uint16_t id = PROPERTY_SET_NONE;
+    if (!canonical.failed) {
+        id = (uint16_t)FindSet(store, canonical.data, HashText(canonical.data));
+        if (id == PROPERTY_SET_NONE) id = AddSet(store, &object, canonical.data);
+    }
+
+    free(canonical.data);
+    FreeParsedObject(&object);
+    return id;
+}
+
+// Queries
+
+const PropertySet* GetPropertySet(const PropertyStore* store, uint16_t id) {
+    if (!store || id == PROPERTY_SET_NONE || id >= store->setCount) return NULL;
+    return &store->sets[id];
+}
+
+int FindPropertyKey(const PropertyStore* store, const char* key) {
+    if (!store || !key) return PROPERTY_KEY_NONE;
+
+    int id = FindString(store, key, HashText(key));
+    return id >= 0 ? id : PROPERTY_KEY_NONE;
+}
+
+const PropertyValue* GetPropertyValue(const PropertyStore* store, uint16_t id, int key) {
+    const PropertySet* set = GetPropertySet(store, id);
+    if (!set || key < 0) return NULL;
+
+    const PropertyRecord* records = &store->records[set->first];
+    for (int i = 0; i < set->count; i++) {
+        if (records[i].key == key) return &records[i].value;
+    }
+    return NULL;
+}
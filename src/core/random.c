@@ -0,0 +1,47 @@
+#include "../../include/random.h"
+
+// SplitMix64 finalizer
+static uint64_t MixRandom(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t HashRandom(uint64_t seed, uint64_t stream, uint64_t counter) {
+    return MixRandom(MixRandom(seed ^ MixRandom(stream)) ^ counter);
+}
+
+RandomStream CreateRandomStream(uint64_t seed, uint64_t stream, uint64_t tick) {
+    RandomStream rng = {
+        .key = HashRandom(seed, stream, tick),
+        .counter = 0
+    };
+    return rng;
+}
+
+RandomStream CreateEntityRandomStream(uint64_t seed, uint32_t entityId, RandomPurpose purpose, uint64_t tick) {
+    uint64_t stream = ((uint64_t)purpose << 32) | (uint64_t)entityId;
+    return CreateRandomStream(seed, stream, tick);
+}
+
+uint32_t NextRandom(RandomStream* rng) {
+    return (uint32_t)(MixRandom(rng->key ^ rng->counter++) >> 32);
+}
+
+float NextRandomFloat(RandomStream* rng) {
+    // Top 24 bits map exactly onto the float mantissa
+    return (float)(NextRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+int NextRandomInt(RandomStream* rng, int min, int max) {
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+
+    uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    // Multiply-shift keeps the bias below 2^-32 without a division
+    return (int)((int64_t)min + (int64_t)(((uint64_t)NextRandom(rng) * range) >> 32));
+}
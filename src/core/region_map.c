@@ -0,0 +1,320 @@
+#include "../../include/region_map.h"
+#include "../../include/collision_grid.h"
+#include "../../include/world.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REGION_INITIAL_CAPACITY 64
+#define REGION_MAX_FRONTS 4
+#define REGION_FRONT_BITS 2
+#define REGION_FRONT_MASK ((1u << REGION_FRONT_BITS) - 1)
+#define REGION_MAX_STAMP (UINT32_MAX >> REGION_FRONT_BITS)
+
+// Neighbor order: east, south, west, north
+static const int kDirX[4] = { 1, 0, -1, 0 };
+static const int kDirY[4] = { 0, 1, 0, -1 };
+
+// Union-find over region ids
+
+static uint32_t FindRegionRoot(RegionMap* regions, uint32_t id) {
+    while (regions->parent[id] != id) {
+        // Path halving keeps later lookups short
+        regions->parent[id] = regions->parent[regions->parent[id]];
+        id = regions->parent[id];
+    }
+    return id;
+}
+
+// Joins two regions, returning the surviving root
+static uint32_t JoinRegions(RegionMap* regions, uint32_t a, uint32_t b) {
+    a = FindRegionRoot(regions, a);
+    b = FindRegionRoot(regions, b);
+    if (a == b) return a;
+
+    // The older id survives, so big settled regions keep their label
+    if (b < a) {
+        uint32_t swap = a;
+        a = b;
+        b = swap;
+    }
+    regions->parent[b] = a;
+    return a;
+}
+
+// REGION_NONE on allocation failure, which leaves tiles unlabelled and
+// so never rejects a query
+static uint32_t NewRegion(RegionMap* regions) {
+    if (regions->regionCount == regions->regionCapacity) {
+        if (regions->regionCapacity >= REGION_NONE / 2) return REGION_NONE;
+
+        uint32_t capacity = regions->regionCapacity > 0 ? regions->regionCapacity * 2 : REGION_INITIAL_CAPACITY;
+        uint32_t* parent = (uint32_t*)realloc(regions->parent, (size_t)capacity * sizeof(uint32_t));
+        if (!parent) return REGION_NONE;
+
+        regions->parent = parent;
+        regions->regionCapacity = capacity;
+    }
+
+    uint32_t id = regions->regionCount++;
+    regions->parent[id] = id;
+    return id;
+}
+
+static bool IsTileOpen(const RegionMap* regions, int x, int y) {
+    return x >= 0 && x < regions->width && y >= 0 && y < regions->height &&
+           regions->labels[y * regions->width + x] != REGION_NONE;
+}
+
+// Region map management
+
+RegionMap* CreateRegionMap(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    RegionMap* regions = (RegionMap*)calloc(1, sizeof(RegionMap));
+    if (!regions) return NULL;
+
+    size_t count = (size_t)width * (size_t)height;
+    regions->width = width;
+    regions->height = height;
+    regions->labels = (uint32_t*)malloc(count * sizeof(uint32_t));
+    regions->visit = (uint32_t*)calloc(count, sizeof(uint32_t));
+    if (!regions->labels || !regions->visit) {
+        DestroyRegionMap(regions);
+        return NULL;
+    }
+
+    memset(regions->labels, 0xFF, count * sizeof(uint32_t));
+    return regions;
+}
+
+void DestroyRegionMap(RegionMap* regions) {
+    if (!regions) return;
+
+    free(regions->labels);
+    free(regions->parent);
+    free(regions->visit);
+    free(regions->queue);
+    free(regions);
+}
+
+RegionMap* GetWorldRegions(World* world) {
+    if (!world || world->stream || !world->collision) return NULL;
+
+    // Rebuild if the tile grid was replaced with one of a different size
+    if (world->regions &&
+        (world->regions->width != world->width || world->regions->height != world->height)) {
+        DestroyRegionMap(world->regions);
+        world->regions = NULL;
+    }
+
+    if (!world->regions) {
+        world->regions = CreateRegionMap(world->width, world->height);
+        RebuildRegionMap(world->regions, world->collision);
+    }
+
+    return world->regions;
+}
+
+// Labels every tile in one scan, joining each tile with its west and north
+// neighbors. Without a grid the current labels say which tiles are open,
+// which compacts the ids left behind by splits.
+static void LabelAllTiles(RegionMap* regions, const CollisionGrid* grid) {
+    int width = regions->width;
+    regions->regionCount = 0;
+
+    for (int y = 0; y < regions->height; y++) {
+        for (int x = 0; x < width; x++) {
+            int index = y * width + x;
+            bool open = grid ? !IsCellBlocked(grid, x, y) : regions->labels[index] != REGION_NONE;
+            if (!open) {
+                regions->labels[index] = REGION_NONE;
+                continue;
+            }
+
+            uint32_t west = x > 0 ? regions->labels[index - 1] : REGION_NONE;
+            uint32_t north = y > 0 ? regions->labels[index - width] : REGION_NONE;
+            if (west != REGION_NONE && north != REGION_NONE) {
+                regions->labels[index] = JoinRegions(regions, west, north);
+            } else if (west != REGION_NONE || north != REGION_NONE) {
+                regions->labels[index] = west != REGION_NONE ? west : north;
+            } else {
+                regions->labels[index] = NewRegion(regions);
+            }
+        }
+    }
+
+    // Point every tile straight at its root
+    size_t count = (size_t)width * (size_t)regions->height;
+    for (size_t i = 0; i < count; i++) {
+        if (regions->labels[i] != REGION_NONE) {
+            regions->labels[i] = FindRegionRoot(regions, regions->labels[i]);
+        }
+    }
+}
+
+void RebuildRegionMap(RegionMap* regions, const CollisionGrid* grid) {
+    if (!regions || !grid || grid->width != regions->width || grid->height != regions->height) return;
+    LabelAllTiles(regions, grid);
+}
+
+// Edits
+
+static void OpenRegionTile(RegionMap* regions, int x, int y) {
+    uint32_t region = REGION_NONE;
+    for (int dir = 0; dir < 4; dir++) {
+        int nx = x + kDirX[dir];
+        int ny = y + kDirY[dir];
+        if (!IsTileOpen(regions, nx, ny)) continue;
+
+        uint32_t neighbor = regions->labels[ny * regions->width + nx];
+        region = region == REGION_NONE ? FindRegionRoot(regions, neighbor) : JoinRegions(regions, region, neighbor);
+    }
+
+    regions->labels[y * regions->width + x] = region != REGION_NONE ? region : NewRegion(regions);
+}
+
+static int FindFront(const int* owner, int front) {
+    while (owner[front] != front) front = owner[front];
+    return front;
+}
+
+static bool PushSearchTile(RegionMap* regions, int* tail, int tile) {
+    if (*tail == regions->queueCapacity) {
+        int capacity = regions->queueCapacity > 0 ? regions->queueCapacity * 2 : 256;
+        int* queue = (int*)realloc(regions->queue, (size_t)capacity * sizeof(int));
+        if (!queue) return false;
+
+        regions->queue = queue;
+        regions->queueCapacity = capacity;
+    }
+    regions->queue[(*tail)++] = tile;
+    return true;
+}
+
+// Breadth-first search out from every front at once. Fronts that meet are
+// merged; the search stops once a single front is still expanding. Every
+// other front ran dry on its own, so it is a piece cut off from the rest
+// and gets a fresh region, while the big side keeps its labels untouched.
+static void SplitRegion(RegionMap* regions, const int* starts, int frontCount) {
+    if (++regions->stamp > REGION_MAX_STAMP) {
+        memset(regions->visit, 0, (size_t)regions->width * (size_t)regions->height * sizeof(uint32_t));
+        regions->stamp = 1;
+    }
+    uint32_t mark = regions->stamp << REGION_FRONT_BITS;
+
+    int owner[REGION_MAX_FRONTS];
+    int pending[REGION_MAX_FRONTS];
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < frontCount; i++) {
+        owner[i] = i;
+        pending[i] = 1;
+        regions->visit[starts[i]] = mark | (uint32_t)i;
+        if (!PushSearchTile(regions, &tail, starts[i])) return;
+    }
+
+    int active = frontCount;
+    while (head < tail && active > 1) {
+        int tile = regions->queue[head++];
+        int front = FindFront(owner, (int)(regions->visit[tile] & REGION_FRONT_MASK));
+        int x = tile % regions->width;
+        int y = tile / regions->width;
+
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + kDirX[dir];
+            int ny = y + kDirY[dir];
+            if (!IsTileOpen(regions, nx, ny)) continue;
+
+            int next = ny * regions->width + nx;
+            if ((regions->visit[next] & ~REGION_FRONT_MASK) == mark) {
+                int other = FindFront(owner, (int)(regions->visit[next] & REGION_FRONT_MASK));
+                if (other != front) {
+                    owner[other] = front;
+                    pending[front] += pending[other];
+                    active--;
+                }
+                continue;
+            }
+
+            // Out of memory: stop without splitting, which only costs
+            // queries a wasted search
+            regions->visit[next] = mark | (uint32_t)front;
+            if (!PushSearchTile(regions, &tail, next)) return;
+            pending[front]++;
+        }
+
+        if (--pending[front] == 0) active--;
+    }
+
+    for (int i = 0; i < frontCount; i++) {
+        if (owner[i] != i || pending[i] > 0) continue;
+
+        uint32_t region = NewRegion(regions);
+        for (int j = 0; j < tail; j++) {
+            int tile = regions->queue[j];
+            if (FindFront(owner, (int)(regions->visit[tile] & REGION_FRONT_MASK)) == i) {
+                regions->labels[tile] = region;
+            }
+        }
+    }
+}
+
+static void BlockRegionTile(RegionMap* regions, int x, int y) {
+    regions->labels[y * regions->width + x] = REGION_NONE;
+
+    // Neighbors that still touch through the diagonal between them stay
+    // connected whatever happens further out, so they share a front
+    bool open[4];
+    int link[4];
+    for (int dir = 0; dir < 4; dir++) {
+        open[dir] = IsTileOpen(regions, x + kDirX[dir], y + kDirY[dir]);
+        link[dir] = dir;
+    }
+    for (int dir = 0; dir < 4; dir++) {
+        int next = (dir + 1) % 4;
+        if (open[dir] && open[next] &&
+            IsTileOpen(regions, x + kDirX[dir] + kDirX[next], y + kDirY[dir] + kDirY[next])) {
+            link[FindFront(link, dir)] = FindFront(link, next);
+        }
+    }
+
+    int starts[REGION_MAX_FRONTS];
+    int frontCount = 0;
+    for (int dir = 0; dir < 4; dir++) {
+        if (open[dir] && FindFront(link, dir) == dir) {
+            starts[frontCount++] = (y + kDirY[dir]) * regions->width + x + kDirX[dir];
+        }
+    }
+
+    if (frontCount > 1) SplitRegion(regions, starts, frontCount);
+}
+
+void UpdateRegionTile(RegionMap* regions, int x, int y, bool walkable) {
+    if (!regions || x < 0 || x >= regions->width || y < 0 || y >= regions->height) return;
+
+    bool open = regions->labels[y * regions->width + x] != REGION_NONE;
+    if (open == walkable) return;
+
+    // Splits only ever add ids; once there are more than tiles start over
+    if ((uint64_t)regions->regionCount > (uint64_t)regions->width * (uint64_t)regions->height) {
+        LabelAllTiles(regions, NULL);
+    }
+
+    if (walkable) {
+        OpenRegionTile(regions, x, y);
+    } else {
+        BlockRegionTile(regions, x, y);
+    }
+}
+
+// Queries
+
+uint32_t GetTileRegion(RegionMap* regions, int x, int y) {
+    if (!regions || !IsTileOpen(regions, x, y)) return REGION_NONE;
+    return FindRegionRoot(regions, regions->labels[y * regions->width + x]);
+}
+
+bool AreTilesConnected(RegionMap* regions, int ax, int ay, int bx, int by) {
+    uint32_t a = GetTileRegion(regions, ax, ay);
+    return a != REGION_NONE && a == GetTileRegion(regions, bx, by);
+}
@@ -0,0 +1,286 @@
+#include "../../include/resonance_field.h"
+#include "../../include/collision_grid.h"
+#include "../../include/world.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RESONANCE_INITIAL_EMITTERS 16
+#define RESONANCE_WINDOW (2 * RESONANCE_MAX_RADIUS + 1)
+
+// Neighbor order: east, south, west, north
+static const int kDirX[4] = { 1, 0, -1, 0 };
+static const int kDirY[4] = { 0, 1, 0, -1 };
+
+// What each object radiates; radius 0 for objects that do not
+typedef struct ResonanceEmission {
+    float strength;
+    int radius;
+} ResonanceEmission;
+
+static const ResonanceEmission g_emissions[OBJECT_COUNT] = {
+    [OBJECT_FOUNTAIN] = { 1.0f, 6 },
+    [OBJECT_TORCH]    = { 0.8f, 5 }
+};
+
+static ResonanceEmission GetObjectEmission(ObjectType object) {
+    if ((int)object < 0 || object >= OBJECT_COUNT) return (ResonanceEmission){ 0.0f, 0 };
+    return g_emissions[object];
+}
+
+// Field management
+
+ResonanceField* CreateResonanceField(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    ResonanceField* field = (ResonanceField*)calloc(1, sizeof(ResonanceField));
+    if (!field) return NULL;
+
+    size_t count = (size_t)width * (size_t)height;
+    field->width = width;
+    field->height = height;
+    field->chunksX = (width + CACHE_CHUNK_SIZE - 1) / CACHE_CHUNK_SIZE;
+    field->chunksY = (height + CACHE_CHUNK_SIZE - 1) / CACHE_CHUNK_SIZE;
+    size_t chunkCount = (size_t)field->chunksX * (size_t)field->chunksY;
+    field->chunks = (ResonanceChunk*)calloc(chunkCount, sizeof(ResonanceChunk));
+    field->dirtyChunks = (int*)malloc(chunkCount * sizeof(int));
+    field->open = (uint8_t*)malloc(count);
+    field->distance = (int*)malloc(RESONANCE_WINDOW * RESONANCE_WINDOW * sizeof(int));
+    field->queue = (int*)malloc(RESONANCE_WINDOW * RESONANCE_WINDOW * sizeof(int));
+    if (!field->chunks || !field->dirtyChunks || !field->open || !field->distance || !field->queue) {
+        DestroyResonanceField(field);
+        return NULL;
+    }
+
+    memset(field->open, 1, count);
+    return field;
+}
+
+void DestroyResonanceField(ResonanceField* field) {
+    if (!field) return;
+
+    free(field->chunks);
+    free(field->dirtyChunks);
+    free(field->open);
+    free(field->emitters);
+    free(field->distance);
+    free(field->queue);
+    free(field);
+}
+
+ResonanceField* GetWorldResonance(World* world) {
+    if (!world || world->stream || !world->collision) return NULL;
+
+    // Rebuild if the tile grid was replaced with one of a different size
+    if (world->resonance &&
+        (world->resonance->width != world->width || world->resonance->height != world->height)) {
+        DestroyResonanceField(world->resonance);
+        world->resonance = NULL;
+    }
+
+    if (!world->resonance) {
+        world->resonance = CreateResonanceField(world->width, world->height);
+        RebuildResonanceField(world->resonance, &world->tiles, world->collision);
+    }
+
+    return world->resonance;
+}
+
+// Dirty tracking
+
+static void MarkResonanceChunk(ResonanceField* field, int index) {
+    ResonanceChunk* chunk = &field->chunks[index];
+    if (chunk->isDirty) return;
+
+    chunk->isDirty = true;
+    field->dirtyChunks[field->dirtyCount++] = index;
+}
+
+// Marks every chunk an emitter's reach overlaps, or with mark false
+// reports whether any of them is already marked
+static bool VisitEmitterChunks(ResonanceField* field, const ResonanceEmitter* emitter, bool mark) {
+    int minX = (emitter->x - emitter->radius) / CACHE_CHUNK_SIZE;
+    int minY = (emitter->y - emitter->radius) / CACHE_CHUNK_SIZE;
+    int maxX = (emitter->x + emitter->radius) / CACHE_CHUNK_SIZE;
+    int maxY = (emitter->y + emitter->radius) / CACHE_CHUNK_SIZE;
+    if (emitter->x - emitter->radius < 0) minX = 0;
+    if (emitter->y - emitter->radius < 0) minY = 0;
+    if (maxX >= field->chunksX) maxX = field->chunksX - 1;
+    if (maxY >= field->chunksY) maxY = field->chunksY - 1;
+
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            int index = y * field->chunksX + x;
+            if (mark) {
+                MarkResonanceChunk(field, index);
+            } else if (field->chunks[index].isDirty) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Emitters
+
+static int FindEmitter(const ResonanceField* field, int x, int y) {
+    for (int i = 0; i < field->emitterCount; i++) {
+        if (field->emitters[i].x == x && field->emitters[i].y == y) return i;
+    }
+    return -1;
+}
+
+static bool AddEmitter(ResonanceField* field, ResonanceEmitter emitter) {
+    if (field->emitterCount == field->emitterCapacity) {
+        int capacity = field->emitterCapacity > 0 ? field->emitterCapacity * 2 : RESONANCE_INITIAL_EMITTERS;
+        ResonanceEmitter* emitters = (ResonanceEmitter*)realloc(field->emitters, (size_t)capacity * sizeof(ResonanceEmitter));
+        if (!emitters) return false;
+
+        field->emitters = emitters;
+        field->emitterCapacity = capacity;
+    }
+    field->emitters[field->emitterCount++] = emitter;
+    return true;
+}
+
+void RebuildResonanceField(ResonanceField* field, const TileGrid* tiles, const CollisionGrid* grid) {
+    if (!field || !tiles || !tiles->objects) return;
+    if (tiles->count < (size_t)field->width * (size_t)field->height) return;
+    if (grid && (grid->width != field->width || grid->height != field->height)) return;
+
+    field->emitterCount = 0;
+    for (int y = 0; y < field->height; y++) {
+        for (int x = 0; x < field->width; x++) {
+            size_t index = (size_t)y * field->width + x;
+            field->open[index] = grid ? !IsCellBlocked(grid, x, y) : 1;
+
+            ResonanceEmission emission = GetObjectEmission((ObjectType)tiles->objects[index]);
+            if (emission.radius > 0) {
+                AddEmitter(field, (ResonanceEmitter){ x, y, emission.strength, emission.radius });
+            }
+        }
+    }
+
+    for (int i = 0; i < field->chunksX * field->chunksY; i++) {
+        MarkResonanceChunk(field, i);
+    }
+}
+
+// Edits
+
+void UpdateResonanceTile(ResonanceField* field, int x, int y, ObjectType object, bool walkable) {
+    if (!field || x < 0 || x >= field->width || y < 0 || y >= field->height) return;
+
+    ResonanceEmission emission = GetObjectEmission(object);
+    int existing = FindEmitter(field, x, y);
+    bool isSame = existing >= 0 && field->emitters[existing].radius == emission.radius &&
+                  field->emitters[existing].strength == emission.strength;
+
+    if (existing >= 0 && !isSame) {
+        VisitEmitterChunks(field, &field->emitters[existing], true);
+        field->emitters[existing] = field->emitters[--field->emitterCount];
+    }
+    if (emission.radius > 0 && !isSame) {
+        ResonanceEmitter emitter = { x, y, emission.strength, emission.radius };
+        if (AddEmitter(field, emitter)) VisitEmitterChunks(field, &emitter, true);
+    }
+
+    // A wall going up or coming down reroutes every flood that reaches it
+    uint8_t* open = &field->open[(size_t)y * field->width + x];
+    if (*open == (uint8_t)walkable) return;
+
+    *open = (uint8_t)walkable;
+    for (int i = 0; i < field->emitterCount; i++) {
+        const ResonanceEmitter* emitter = &field->emitters[i];
+        if (abs(emitter->x - x) + abs(emitter->y - y) <= emitter->radius) {
+            VisitEmitterChunks(field, emitter, true);
+        }
+    }
+}
+
+// Recompute
+
+static void WriteResonance(ResonanceField* field, int x, int y, uint8_t value) {
+    ResonanceChunk* chunk = &field->chunks[(y / CACHE_CHUNK_SIZE) * field->chunksX + x / CACHE_CHUNK_SIZE];
+    if (!chunk->isDirty) return;
+
+    uint8_t* slot = &chunk->values[(y % CACHE_CHUNK_SIZE) * CACHE_CHUNK_SIZE + x % CACHE_CHUNK_SIZE];
+    if (value > *slot) *slot = value;
+}
+
+// Breadth-first flood from one emitter over a window just big enough for
+// its reach, writing into dirty chunks only
+static void FloodEmitter(ResonanceField* field, const ResonanceEmitter* emitter) {
+    int radius = emitter->radius < RESONANCE_MAX_RADIUS ? emitter->radius : RESONANCE_MAX_RADIUS;
+    int side = 2 * radius + 1;
+    int originX = emitter->x - radius;
+    int originY = emitter->y - radius;
+    for (int i = 0; i < side * side; i++) field->distance[i] = -1;
+
+    int head = 0;
+    int tail = 0;
+    int start = radius * side + radius;
+    field->distance[start] = 0;
+    field->queue[tail++] = start;
+
+    while (head < tail) {
+        int local = field->queue[head++];
+        int steps = field->distance[local];
+        int x = originX + local % side;
+        int y = originY + local / side;
+
+        float level = emitter->strength * (float)(radius - steps) / (float)radius;
+        WriteResonance(field, x, y, (uint8_t)(level * 255.0f + 0.5f));
+
+        // Blocked tiles are lit but pass nothing on; the emitter's own tile
+        // always does, since fountains block
+        if (steps + 1 >= radius) continue;
+        if (steps > 0 && !field->open[(size_t)y * field->width + x]) continue;
+
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + kDirX[dir];
+            int ny = y + kDirY[dir];
+            if (nx < 0 || nx >= field->width || ny < 0 || ny >= field->height) continue;
+
+            int next = (ny - originY) * side + (nx - originX);
+            if (field->distance[next] >= 0) continue;
+
+            field->distance[next] = steps + 1;
+            field->queue[tail++] = next;
+        }
+    }
+}
+
+int UpdateResonanceField(ResonanceField* field) {
+    if (!field || field->dirtyCount == 0) return 0;
+
+    for (int i = 0; i < field->dirtyCount; i++) {
+        memset(field->chunks[field->dirtyChunks[i]].values, 0, sizeof(field->chunks[0].values));
+    }
+
+    for (int i = 0; i < field->emitterCount; i++) {
+        if (VisitEmitterChunks(field, &field->emitters[i], false)) FloodEmitter(field, &field->emitters[i]);
+    }
+
+    int count = field->dirtyCount;
+    for (int i = 0; i < count; i++) {
+        ResonanceChunk* chunk = &field->chunks[field->dirtyChunks[i]];
+        chunk->isDirty = false;
+        chunk->version++;
+    }
+    field->dirtyCount = 0;
+    return count;
+}
+
+// Queries
+
+float GetResonanceLevel(const ResonanceField* field, int x, int y) {
+    if (!field || x < 0 || x >= field->width || y < 0 || y >= field->height) return 0.0f;
+
+    const ResonanceChunk* chunk = &field->chunks[(y / CACHE_CHUNK_SIZE) * field->chunksX + x / CACHE_CHUNK_SIZE];
+    return chunk->values[(y % CACHE_CHUNK_SIZE) * CACHE_CHUNK_SIZE + x % CACHE_CHUNK_SIZE] / 255.0f;
+}
+
+const ResonanceChunk* GetResonanceChunk(const ResonanceField* field, int chunkX, int chunkY) {
+    if (!field || chunkX < 0 || chunkX >= field->chunksX || chunkY < 0 || chunkY >= field->chunksY) return NULL;
+    return &field->chunks[chunkY * field->chunksX + chunkX];
+}
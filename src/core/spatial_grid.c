@@ -0,0 +1,99 @@
+#include "../../include/spatial_grid.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+SpatialGrid* CreateSpatialGrid(Rectangle bounds, float cellSize) {
+    if (cellSize <= 0.0f || bounds.width <= 0.0f || bounds.height <= 0.0f) return NULL;
+
+    SpatialGrid* grid = (SpatialGrid*)calloc(1, sizeof(SpatialGrid));
+    if (!grid) return NULL;
+
+    grid->bounds = bounds;
+    grid->cellSize = cellSize;
+    grid->invCellSize = 1.0f / cellSize;
+    grid->columns = (int)ceilf(bounds.width / cellSize);
+    grid->rows = (int)ceilf(bounds.height / cellSize);
+
+    grid->cellStart = (int*)calloc((size_t)(grid->columns * grid->rows + 1), sizeof(int));
+    grid->cellCursor = (int*)calloc((size_t)(grid->columns * grid->rows), sizeof(int));
+    if (!grid->cellStart || !grid->cellCursor) {
+        DestroySpatialGrid(grid);
+        return NULL;
+    }
+
+    return grid;
+}
+
+void DestroySpatialGrid(SpatialGrid* grid) {
+    if (!grid) return;
+
+    free(grid->cellStart);
+    free(grid->cellCursor);
+    free(grid->cellItems);
+    free(grid->itemCells);
+    free(grid);
+}
+
+int GetSpatialGridCellX(const SpatialGrid* grid, float x) {
+    int cell = (int)floorf((x - grid->bounds.x) * grid->invCellSize);
+    if (cell < 0) return 0;
+    if (cell >= grid->columns) return grid->columns - 1;
+    return cell;
+}
+
+int GetSpatialGridCellY(const SpatialGrid* grid, float y) {
+    int cell = (int)floorf((y - grid->bounds.y) * grid->invCellSize);
+    if (cell < 0) return 0;
+    if (cell >= grid->rows) return grid->rows - 1;
+    return cell;
+}
+
+int GetSpatialGridCellCount(const SpatialGrid* grid) {
+    return grid ? grid->columns * grid->rows : 0;
+}
+
+bool BuildSpatialGrid(SpatialGrid* grid, const Vector2* positions, int count) {
+    if (!grid || (count > 0 && !positions)) return false;
+
+    // Grow item storage
+    if (count > grid->itemCapacity) {
+        int newCapacity = grid->itemCapacity > 0 ? grid->itemCapacity : 64;
+        while (newCapacity < count) newCapacity *= 2;
+
+        int* newItems = (int*)realloc(grid->cellItems, (size_t)newCapacity * sizeof(int));
+        if (!newItems) return false;
+        grid->cellItems = newItems;
+
+        int* newCells = (int*)realloc(grid->itemCells, (size_t)newCapacity * sizeof(int));
+        if (!newCells) return false;
+        grid->itemCells = newCells;
+
+        grid->itemCapacity = newCapacity;
+    }
+
+    int cellCount = grid->columns * grid->rows;
+    memset(grid->cellStart, 0, (size_t)(cellCount + 1) * sizeof(int));
+
+    // Histogram
+    for (int i = 0; i < count; i++) {
+        int cell = GetSpatialGridCellY(grid, positions[i].y) * grid->columns +
+                   GetSpatialGridCellX(grid, positions[i].x);
+        grid->itemCells[i] = cell;
+        grid->cellStart[cell + 1]++;
+    }
+
+    // Prefix sum
+    for (int c = 0; c < cellCount; c++) {
+        grid->cellStart[c + 1] += grid->cellStart[c];
+    }
+
+    // Scatter in item order so each cell stays sorted by index
+    memcpy(grid->cellCursor, grid->cellStart, (size_t)cellCount * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        grid->cellItems[grid->cellCursor[grid->itemCells[i]]++] = i;
+    }
+
+    grid->itemCount = count;
+    return true;
+}
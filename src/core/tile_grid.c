@@ -0,0 +1,156 @@
+#include "../../include/tile_grid.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <raylib.h>
+#include <stdlib.h>
+#include <string.h>
+
+END_EXTERNAL_WARNINGS
+
+#define TILE_OVERRIDE_INITIAL_CAPACITY 16
+
+// Shared tile property table, one entry per TileType. Colors are spelled
+// out because raylib's color macros are not constant expressions in C.
+static const TileProperties g_tileProperties[TILE_COUNT] = {
+    [TILE_NONE]     = { .isWalkable = true,  .friction = 1.0f, .color = { 0, 0, 0, 0 } },
+    [TILE_EMPTY]    = { .isWalkable = true,  .friction = 1.0f, .color = { 255, 255, 255, 255 } },
+    [TILE_FLOOR]    = { .isWalkable = true,  .friction = 1.0f, .color = { 200, 200, 200, 255 } },
+    [TILE_WALL]     = { .isWalkable = false, .friction = 1.0f, .color = { 80, 80, 80, 255 } },
+    [TILE_DOOR]     = { .isWalkable = true,  .isInteractive = true, .friction = 1.0f, .color = { 127, 106, 79, 255 } },
+    [TILE_GRASS]    = { .isWalkable = true,  .friction = 1.0f, .color = { 0, 228, 48, 255 } },
+    [TILE_PATH]     = { .isWalkable = true,  .friction = 1.0f, .color = { 211, 176, 131, 255 } },
+    [TILE_WATER]    = { .isWalkable = false, .friction = 0.5f, .color = { 0, 121, 241, 255 } },
+    [TILE_COLUMN]   = { .isWalkable = true,  .friction = 1.0f, .color = { 130, 130, 130, 255 } },
+    [TILE_TREE]     = { .isWalkable = true,  .friction = 1.0f, .color = { 0, 117, 44, 255 } },
+    [TILE_BUSH]     = { .isWalkable = true,  .friction = 1.0f, .color = { 0, 158, 47, 255 } },
+    [TILE_FLOWER]   = { .isWalkable = true,  .friction = 1.0f, .color = { 255, 109, 194, 255 } },
+    [TILE_FOUNTAIN] = { .isWalkable = true,  .friction = 1.0f, .color = { 102, 191, 255, 255 } },
+    [TILE_STATUE]   = { .isWalkable = true,  .friction = 1.0f, .color = { 130, 130, 130, 255 } }
+};
+
+bool InitTileGrid(TileGrid* grid, size_t count, TileType fill) {
+    if (!grid || count == 0) return false;
+
+    // Zeroed planes are already TILE_NONE and OBJECT_NONE, and large calloc
+    // blocks are not touched until first written
+    memset(grid, 0, sizeof(TileGrid));
+    grid->types = (uint8_t*)calloc(count, 1);
+    grid->objects = (uint8_t*)calloc(count, 1);
+    if (!grid->types || !grid->objects) {
+        FreeTileGrid(grid);
+        return false;
+    }
+
+    grid->count = count;
+    if (fill != TILE_NONE) FillTileGrid(grid, fill);
+    return true;
+}
+
+void FreeTileGrid(TileGrid* grid) {
+    if (!grid) return;
+
+    // Overrides hold only ids, so nothing is freed per tile
+    DestroyPropertyStore(grid->propertyStore);
+    free(grid->overrides);
+    free(grid->types);
+    free(grid->objects);
+    memset(grid, 0, sizeof(TileGrid));
+}
+
+void FillTileGrid(TileGrid* grid, TileType fill) {
+    if (!grid || !grid->types) return;
+
+    memset(grid->types, (int)fill, grid->count);
+    memset(grid->objects, OBJECT_NONE, grid->count);
+}
+
+const TileProperties* GetTileProperties(TileType type) {
+    if ((int)type < 0 || type >= TILE_COUNT) type = TILE_NONE;
+    return &g_tileProperties[type];
+}
+
+int FindTileOverrideSlot(const TileGrid* grid, int index) {
+    int low = 0;
+    int high = grid->overrideCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (grid->overrides[mid].index < index) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool SetTilePropertySet(TileGrid* grid, int index, uint16_t propertySet) {
+    if (!grid || index < 0 || (size_t)index >= grid->count) return false;
+    if (propertySet != PROPERTY_SET_NONE && !GetPropertySet(grid->propertyStore, propertySet)) return false;
+
+    int slot = FindTileOverrideSlot(grid, index);
+    bool exists = slot < grid->overrideCount && grid->overrides[slot].index == index;
+
+    // Removal
+    if (propertySet == PROPERTY_SET_NONE) {
+        if (!exists) return true;
+        memmove(&grid->overrides[slot], &grid->overrides[slot + 1],
+                (size_t)(grid->overrideCount - slot - 1) * sizeof(TileOverride));
+        grid->overrideCount--;
+        return true;
+    }
+
+    if (exists) {
+        grid->overrides[slot].propertySet = propertySet;
+        return true;
+    }
+
+    if (grid->overrideCount >= grid->overrideCapacity) {
+        int newCapacity = grid->overrideCapacity > 0 ? grid->overrideCapacity * 2 : TILE_OVERRIDE_INITIAL_CAPACITY;
+        TileOverride* overrides = (TileOverride*)realloc(grid->overrides, (size_t)newCapacity * sizeof(TileOverride));
+        if (!overrides) return false;
+        grid->overrides = overrides;
+        grid->overrideCapacity = newCapacity;
+    }
+
+    memmove(&grid->overrides[slot + 1], &grid->overrides[slot],
+            (size_t)(grid->overrideCount - slot) * sizeof(TileOverride));
+    grid->overrides[slot] = (TileOverride){ index, propertySet };
+    grid->overrideCount++;
+    return true;
+}
+
+uint16_t GetTilePropertySet(const TileGrid* grid, int index) {
+    if (!grid || grid->overrideCount == 0) return PROPERTY_SET_NONE;
+
+    int slot = FindTileOverrideSlot(grid, index);
+    if (slot < grid->overrideCount && grid->overrides[slot].index == index) {
+        return grid->overrides[slot].propertySet;
+    }
+    return PROPERTY_SET_NONE;
+}
+
+bool SetTileOverride(TileGrid* grid, int index, const char* customProperties) {
+    if (!grid || index < 0 || (size_t)index >= grid->count) return false;
+    if (!customProperties) return SetTilePropertySet(grid, index, PROPERTY_SET_NONE);
+
+    if (!grid->propertyStore) {
+        grid->propertyStore = CreatePropertyStore();
+        if (!grid->propertyStore) return false;
+    }
+
+    uint16_t propertySet = InternPropertySet(grid->propertyStore, customProperties);
+    return propertySet != PROPERTY_SET_NONE && SetTilePropertySet(grid, index, propertySet);
+}
+
+const char* GetTileOverride(const TileGrid* grid, int index) {
+    const PropertySet* set = grid ? GetPropertySet(grid->propertyStore, GetTilePropertySet(grid, index)) : NULL;
+    return set ? set->json : NULL;
+}
+
+const PropertyValue* GetTileProperty(const TileGrid* grid, int index, int key) {
+    if (!grid) return NULL;
+    return GetPropertyValue(grid->propertyStore, GetTilePropertySet(grid, index), key);
+}
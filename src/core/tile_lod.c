@@ -0,0 +1,140 @@
+#include "../../include/tile_lod.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TILE_LOD_ROWS 2              // Ground row and object row
+
+bool BuildTileLodAtlas(TileLodAtlas* atlas, const Color* pixels, TileAtlasLayout layout) {
+    if (!atlas) return false;
+
+    memset(atlas, 0, sizeof(TileLodAtlas));
+    int tileSize = layout.tileSize;
+    int lastScale = 1 << (TILE_LOD_LEVELS - 1);
+    if (!pixels || tileSize < lastScale || tileSize % lastScale != 0 ||
+        layout.textureWidth < tileSize || layout.textureHeight < tileSize * TILE_LOD_ROWS) {
+        return false;
+    }
+
+    atlas->columns = layout.textureWidth / tileSize;
+    atlas->tileSize = tileSize;
+
+    for (int level = 1; level < TILE_LOD_LEVELS; level++) {
+        int scale = 1 << level;
+        int cellSize = tileSize / scale;
+        size_t cellPixels = (size_t)cellSize * (size_t)cellSize;
+        Color* cells = (Color*)malloc((size_t)atlas->columns * TILE_LOD_ROWS * cellPixels * sizeof(Color));
+        if (!cells) {
+            FreeTileLodAtlas(atlas);
+            return false;
+        }
+        atlas->cells[level] = cells;
+
+        for (int row = 0; row < TILE_LOD_ROWS; row++) {
+            for (int column = 0; column < atlas->columns; column++) {
+                Color* cell = &cells[((size_t)row * atlas->columns + column) * cellPixels];
+
+                for (int y = 0; y < cellSize; y++) {
+                    for (int x = 0; x < cellSize; x++) {
+                        // Box filter, colour weighted by alpha
+                        unsigned int r = 0, g = 0, b = 0, a = 0;
+                        for (int sy = 0; sy < scale; sy++) {
+                            int pixelY = row * tileSize + y * scale + sy;
+                            const Color* source = &pixels[(size_t)pixelY * layout.textureWidth +
+                                                          column * tileSize + x * scale];
+                            for (int sx = 0; sx < scale; sx++) {
+                                r += (unsigned int)source[sx].r * source[sx].a;
+                                g += (unsigned int)source[sx].g * source[sx].a;
+                                b += (unsigned int)source[sx].b * source[sx].a;
+                                a += source[sx].a;
+                            }
+                        }
+
+                        Color reduced = { 0, 0, 0, 0 };
+                        if (a > 0) {
+                            reduced.r = (unsigned char)(r / a);
+                            reduced.g = (unsigned char)(g / a);
+                            reduced.b = (unsigned char)(b / a);
+                            reduced.a = (unsigned char)(a / (unsigned int)(scale * scale));
+                        }
+                        cell[y * cellSize + x] = reduced;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void FreeTileLodAtlas(TileLodAtlas* atlas) {
+    if (!atlas) return;
+
+    for (int level = 0; level < TILE_LOD_LEVELS; level++) {
+        free(atlas->cells[level]);
+    }
+    memset(atlas, 0, sizeof(TileLodAtlas));
+}
+
+// Source-over blend of a reduced object pixel onto its ground
+static Color BlendTileLodPixel(Color under, Color over) {
+    if (over.a == 255 || under.a == 0) return over;
+    if (over.a == 0) return under;
+
+    unsigned int inverse = 255u - over.a;
+    unsigned int alpha = over.a * 255u + under.a * inverse;
+    Color blended;
+    blended.r = (unsigned char)((over.r * over.a * 255u + under.r * under.a * inverse) / alpha);
+    blended.g = (unsigned char)((over.g * over.a * 255u + under.g * under.a * inverse) / alpha);
+    blended.b = (unsigned char)((over.b * over.a * 255u + under.b * under.a * inverse) / alpha);
+    blended.a = (unsigned char)(alpha / 255u);
+    return blended;
+}
+
+void ComposeTileLod(Color* pixels, const TileLodAtlas* atlas, int level, const uint8_t* types,
+                    const uint8_t* objects, int stride, int width, int height) {
+    if (!pixels || !atlas || level <= 0 || level >= TILE_LOD_LEVELS || !atlas->cells[level]) return;
+
+    int cellSize = atlas->tileSize >> level;
+    int tiles = CACHE_CHUNK_SIZE << level;
+    int imageSize = tiles * cellSize;
+    size_t cellPixels = (size_t)cellSize * (size_t)cellSize;
+    const Color* groundCells = atlas->cells[level];
+    const Color* objectCells = &groundCells[(size_t)atlas->columns * cellPixels];
+
+    memset(pixels, 0, (size_t)imageSize * (size_t)imageSize * sizeof(Color));
+    if (!types || !objects) return;
+    if (width > tiles) width = tiles;
+    if (height > tiles) height = tiles;
+
+    for (int tileY = 0; tileY < height; tileY++) {
+        for (int tileX = 0; tileX < width; tileX++) {
+            uint8_t type = types[(size_t)tileY * stride + tileX];
+            uint8_t object = objects[(size_t)tileY * stride + tileX];
+            Color* target = &pixels[(size_t)tileY * cellSize * imageSize + (size_t)tileX * cellSize];
+
+            if (type != TILE_NONE && type < atlas->columns) {
+                const Color* cell = &groundCells[type * cellPixels];
+                for (int y = 0; y < cellSize; y++) {
+                    memcpy(&target[(size_t)y * imageSize], &cell[y * cellSize], (size_t)cellSize * sizeof(Color));
+                }
+            }
+
+            if (object != OBJECT_NONE && object < atlas->columns) {
+                const Color* cell = &objectCells[object * cellPixels];
+                for (int y = 0; y < cellSize; y++) {
+                    Color* line = &target[(size_t)y * imageSize];
+                    for (int x = 0; x < cellSize; x++) {
+                        line[x] = BlendTileLodPixel(line[x], cell[y * cellSize + x]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int SelectTileLodLevel(float zoom) {
+    int level = 0;
+    while (level + 1 < TILE_LOD_LEVELS && zoom > 0.0f && zoom * (float)(2 << level) <= 1.0f) {
+        level++;
+    }
+    return level;
+}
@@ -0,0 +1,108 @@
+#include "../../include/tile_mesh.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool InitTileMeshData(TileMeshData* mesh) {
+    if (!mesh) return false;
+
+    memset(mesh, 0, sizeof(TileMeshData));
+    mesh->vertices = (float*)malloc(TILE_MESH_MAX_QUADS * 4 * 3 * sizeof(float));
+    mesh->texcoords = (float*)malloc(TILE_MESH_MAX_QUADS * 4 * 2 * sizeof(float));
+    mesh->texcoords2 = (float*)malloc(TILE_MESH_MAX_QUADS * 4 * 2 * sizeof(float));
+    mesh->indices = (unsigned short*)malloc(TILE_MESH_MAX_QUADS * 6 * sizeof(unsigned short));
+    if (!mesh->vertices || !mesh->texcoords || !mesh->texcoords2 || !mesh->indices) {
+        FreeTileMeshData(mesh);
+        return false;
+    }
+    return true;
+}
+
+void FreeTileMeshData(TileMeshData* mesh) {
+    if (!mesh) return;
+
+    free(mesh->vertices);
+    free(mesh->texcoords);
+    free(mesh->texcoords2);
+    free(mesh->indices);
+    memset(mesh, 0, sizeof(TileMeshData));
+}
+
+// Appends one tile-sized quad sampling atlas cell (column, row)
+static void AddTileQuad(TileMeshData* mesh, int x, int y, int column, int row, TileAtlasLayout layout) {
+    int quad = mesh->quadCount++;
+    float size = (float)layout.tileSize;
+    float left = x * size;
+    float top = y * size;
+
+    float u0 = (float)(column * layout.tileSize) / (float)layout.textureWidth;
+    float v0 = (float)(row * layout.tileSize) / (float)layout.textureHeight;
+    float u1 = (float)((column + 1) * layout.tileSize) / (float)layout.textureWidth;
+    float v1 = (float)((row + 1) * layout.tileSize) / (float)layout.textureHeight;
+
+    // Top-left, bottom-left, bottom-right, top-right: counter-clockwise on
+    // screen, the same winding raylib uses for its own 2D quads
+    float* vertex = &mesh->vertices[quad * 12];
+    const float positions[12] = {
+        left, top, 0.0f,
+        left, top + size, 0.0f,
+        left + size, top + size, 0.0f,
+        left + size, top, 0.0f
+    };
+    memcpy(vertex, positions, sizeof(positions));
+
+    float* texcoord = &mesh->texcoords[quad * 8];
+    const float uvs[8] = { u0, v0, u0, v1, u1, v1, u1, v0 };
+    memcpy(texcoord, uvs, sizeof(uvs));
+    memset(&mesh->texcoords2[quad * 8], 0, 8 * sizeof(float));
+
+    unsigned short base = (unsigned short)(quad * 4);
+    unsigned short* index = &mesh->indices[quad * 6];
+    index[0] = base;
+    index[1] = (unsigned short)(base + 1);
+    index[2] = (unsigned short)(base + 2);
+    index[3] = base;
+    index[4] = (unsigned short)(base + 2);
+    index[5] = (unsigned short)(base + 3);
+}
+
+int BuildTileMesh(TileMeshData* mesh, const uint8_t* types, const uint8_t* objects, int stride,
+                  int width, int height, TileAtlasLayout layout) {
+    if (!mesh || !mesh->vertices) return 0;
+    mesh->quadCount = 0;
+    if (!types || !objects || layout.tileSize <= 0 || layout.textureWidth <= 0 || layout.textureHeight <= 0) return 0;
+
+    if (width > CACHE_CHUNK_SIZE) width = CACHE_CHUNK_SIZE;
+    if (height > CACHE_CHUNK_SIZE) height = CACHE_CHUNK_SIZE;
+
+    // Ground first so objects draw over it within the single draw call
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = &types[(size_t)y * stride];
+        for (int x = 0; x < width; x++) {
+            if (row[x] != TILE_NONE) AddTileQuad(mesh, x, y, row[x], 0, layout);
+        }
+    }
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = &objects[(size_t)y * stride];
+        for (int x = 0; x < width; x++) {
+            if (row[x] != OBJECT_NONE) AddTileQuad(mesh, x, y, row[x], 1, layout);
+        }
+    }
+    return mesh->quadCount;
+}
+
+void SetTileMeshResonance(TileMeshData* mesh, const uint8_t* levels, int stride, int tileSize) {
+    if (!mesh || !mesh->texcoords2 || !levels || tileSize <= 0) return;
+
+    // Every quad covers one tile; its top-left vertex says which
+    for (int quad = 0; quad < mesh->quadCount; quad++) {
+        int x = (int)(mesh->vertices[quad * 12] / (float)tileSize);
+        int y = (int)(mesh->vertices[quad * 12 + 1] / (float)tileSize);
+        float level = levels[(size_t)y * stride + x] / 255.0f;
+
+        float* texcoord = &mesh->texcoords2[quad * 8];
+        for (int vertex = 0; vertex < 4; vertex++) {
+            texcoord[vertex * 2] = level;
+            texcoord[vertex * 2 + 1] = 0.0f;
+        }
+    }
+}
@@ -14,6 +14,8 @@ END_EXTERNAL_WARNINGS
 #include <time.h>
 #include "../../include/world.h"
 #include "../../include/resource_manager.h"
+#include "../../include/random.h"
+#include "../../include/tile_grid.h"
 
 #define MAX_GENERATION_ATTEMPTS 100
 
@@ -43,26 +45,11 @@ static World* GenerateBaseWorld(int width, int height) {
     
     // Initialize with empty tiles
     size_t tileCount = (size_t)(width * height);  // Count in tiles, not pixels
-    world->tiles = (Tile*)calloc(tileCount, sizeof(Tile));
-    if (!world->tiles) {
+    if (!InitTileGrid(&world->tiles, tileCount, TILE_EMPTY) || !RebuildWorldCollision(world)) {
         DestroyWorld(world);
         return NULL;
     }
     
-    // Set all tiles to empty
-    for (size_t i = 0; i < tileCount; i++) {
-        world->tiles[i].type = TILE_EMPTY;
-        world->tiles[i].objectType = OBJECT_NONE;
-        world->tiles[i].properties = (TileProperties){
-            .isWalkable = true,
-            .isDestructible = false,
-            .isInteractive = false,
-            .friction = 1.0f,
-            .resonance = 0.0f,
-            .color = WHITE
-        };
-    }
-    
     return world;
 }
 
@@ -83,8 +70,7 @@ static bool PlaceRoom(World* world, const RoomTemplate* room, int startX, int st
     // Copy tiles
     for (int y = 0; y < room->height; y++) {
         for (int x = 0; x < room->width; x++) {
-            int index = (startY + y) * worldWidth + (startX + x);
-            world->tiles[index].type = room->tiles[y][x];
+            SetTile(world, startX + x, startY + y, room->tiles[y][x]);
             if (room->objects[y][x] != OBJECT_NONE) {
                 PlaceObject(world, startX + x, startY + y, room->objects[y][x]);
             }
@@ -133,9 +119,10 @@ World* GenerateFirstLevel(void) {
     };
     
     // Place connected rooms
+    RandomStream rng = CreateRandomStream(world->seed, RANDOM_PURPOSE_GEN_ROOMS, 0);
     for (int i = 0; i < startRoom->connectionCount; i++) {
         Rectangle conn = startRoom->connections[i];
-        int roomIndex = rand() % 3;
+        int roomIndex = NextRandomInt(&rng, 0, 2);
         
         // Calculate position based on connection
         int roomX = centerX;
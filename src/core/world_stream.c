@@ -0,0 +1,303 @@
+#include "../../include/world_stream.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+END_EXTERNAL_WARNINGS
+
+#define STREAM_SLOT_EMPTY -1
+
+static void GenerateGrass(void* context, StreamChunk* chunk) {
+    (void)context;
+    memset(chunk->types, TILE_GRASS, sizeof(chunk->types));
+    memset(chunk->objects, OBJECT_NONE, sizeof(chunk->objects));
+}
+
+// Chunk table
+static int FindSlot(const WorldStream* stream, int chunkX, int chunkY) {
+    int slot = (int)(HashChunkKey(chunkX, chunkY) & (uint32_t)stream->slotMask);
+    while (stream->slots[slot] != STREAM_SLOT_EMPTY) {
+        const StreamEntry* entry = &stream->entries[stream->slots[slot]];
+        if (entry->chunkX == chunkX && entry->chunkY == chunkY) return slot;
+        slot = (slot + 1) & stream->slotMask;
+    }
+    return -1;
+}
+
+static StreamEntry* FindEntry(const WorldStream* stream, int chunkX, int chunkY) {
+    int slot = FindSlot(stream, chunkX, chunkY);
+    return slot >= 0 ? &stream->entries[stream->slots[slot]] : NULL;
+}
+
+static StreamEntry* AddEntry(WorldStream* stream, int chunkX, int chunkY, uint32_t generation) {
+    int index = stream->entryCount++;
+    stream->entries[index] = (StreamEntry){ chunkX, chunkY, NULL, generation };
+
+    int slot = (int)(HashChunkKey(chunkX, chunkY) & (uint32_t)stream->slotMask);
+    while (stream->slots[slot] != STREAM_SLOT_EMPTY) {
+        slot = (slot + 1) & stream->slotMask;
+    }
+    stream->slots[slot] = index;
+    return &stream->entries[index];
+}
+
+// Backward-shift deletion, then the last entry fills the hole
+static void RemoveEntry(WorldStream* stream, int index) {
+    const StreamEntry* removed = &stream->entries[index];
+    int hole = FindSlot(stream, removed->chunkX, removed->chunkY);
+    int next = (hole + 1) & stream->slotMask;
+
+    while (stream->slots[next] != STREAM_SLOT_EMPTY) {
+        const StreamEntry* entry = &stream->entries[stream->slots[next]];
+        int home = (int)(HashChunkKey(entry->chunkX, entry->chunkY) & (uint32_t)stream->slotMask);
+
+        bool movable = (next > hole) ? (home <= hole || home > next)
+                                     : (home <= hole && home > next);
+        if (movable) {
+            stream->slots[hole] = stream->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & stream->slotMask;
+    }
+    stream->slots[hole] = STREAM_SLOT_EMPTY;
+
+    int last = --stream->entryCount;
+    if (index != last) {
+        const StreamEntry* moved = &stream->entries[last];
+        stream->slots[FindSlot(stream, moved->chunkX, moved->chunkY)] = index;
+        stream->entries[index] = *moved;
+    }
+}
+
+// Hands a chunk back: dirty chunks go to the I/O thread, clean ones are freed.
+// Returns false when the save queue is full and the chunk must stay.
+static bool ReleaseChunk(WorldStream* stream, StreamChunk* chunk) {
+    if (!chunk) return true;
+    if (!chunk->dirty) {
+        free(chunk);
+        return true;
+    }
+    return QueueChunkSave(stream->io, chunk);
+}
+
+static void InstallLoadedChunks(WorldStream* stream) {
+    StreamChunk* chunk = PollLoadedChunks(stream->io);
+    while (chunk) {
+        StreamChunk* next = chunk->next;
+        chunk->next = NULL;
+
+        // Only the load an entry waits for installs. One queued before the
+        // chunk was evicted may have read the file ahead of the eviction's
+        // save, so results for evicted or re-requested entries are dropped.
+        StreamEntry* entry = FindEntry(stream, chunk->chunkX, chunk->chunkY);
+        if (entry && !entry->chunk && entry->generation == chunk->generation) {
+            entry->chunk = chunk;
+        } else {
+            free(chunk);
+        }
+        chunk = next;
+    }
+}
+
+// Stream management
+WorldStream* CreateWorldStream(const char* directory, int radius, int maxChunks,
+                               ChunkGenerateFunc generate, void* context) {
+    if (radius < 0) radius = STREAM_DEFAULT_RADIUS;
+    if (maxChunks <= 0) maxChunks = STREAM_DEFAULT_MAX_CHUNKS;
+
+    WorldStream* stream = (WorldStream*)calloc(1, sizeof(WorldStream));
+    if (!stream) return NULL;
+
+    int slotCount = 1;
+    while (slotCount < maxChunks * 2) slotCount <<= 1;
+
+    stream->entries = (StreamEntry*)calloc((size_t)maxChunks, sizeof(StreamEntry));
+    stream->slots = (int*)malloc((size_t)slotCount * sizeof(int));
+    stream->io = CreateChunkIO(directory, generate ? generate : GenerateGrass, context);
+    if (!stream->entries || !stream->slots || !stream->io) {
+        DestroyChunkIO(stream->io);
+        free(stream->entries);
+        free(stream->slots);
+        free(stream);
+        return NULL;
+    }
+
+    for (int i = 0; i < slotCount; i++) stream->slots[i] = STREAM_SLOT_EMPTY;
+    stream->slotMask = slotCount - 1;
+    stream->maxChunks = maxChunks;
+    stream->radius = radius;
+    return stream;
+}
+
+void DestroyWorldStream(WorldStream* stream) {
+    if (!stream) return;
+
+    for (int i = 0; i < stream->entryCount; i++) {
+        StreamChunk* chunk = stream->entries[i].chunk;
+        while (!ReleaseChunk(stream, chunk)) {
+            FlushChunkIO(stream->io);
+        }
+    }
+
+    DestroyChunkIO(stream->io);
+    free(stream->entries);
+    free(stream->slots);
+    free(stream);
+}
+
+// Chebyshev distance in chunks to the closest focus
+static int FocusDistance(const StreamEntry* entry, const int* focusX, const int* focusY, int focusCount) {
+    int best = INT32_MAX;
+    for (int i = 0; i < focusCount; i++) {
+        int dx = abs(entry->chunkX - focusX[i]);
+        int dy = abs(entry->chunkY - focusY[i]);
+        int distance = dx > dy ? dx : dy;
+        if (distance < best) best = distance;
+    }
+    return best;
+}
+
+// Frees a table entry for a wanted chunk by dropping one that is only kept
+// for hysteresis. Fails when everything resident is inside the radius.
+static bool EvictMarginChunk(WorldStream* stream, const int* focusX, const int* focusY, int focusCount) {
+    for (int i = stream->entryCount - 1; i >= 0; i--) {
+        StreamEntry* entry = &stream->entries[i];
+        if (FocusDistance(entry, focusX, focusY, focusCount) <= stream->radius) continue;
+        if (!ReleaseChunk(stream, entry->chunk)) return false;
+        RemoveEntry(stream, i);
+        return true;
+    }
+    return false;
+}
+
+void UpdateWorldStream(WorldStream* stream, const Vector2* focus, int focusCount) {
+    if (!stream) return;
+
+    InstallLoadedChunks(stream);
+    if (!focus || focusCount <= 0) return;
+    if (focusCount > STREAM_MAX_FOCUS) focusCount = STREAM_MAX_FOCUS;
+
+    int focusX[STREAM_MAX_FOCUS];
+    int focusY[STREAM_MAX_FOCUS];
+    for (int i = 0; i < focusCount; i++) {
+        focusX[i] = FloorDiv((int)floorf(focus[i].x / TILE_SIZE), STREAM_CHUNK_SIZE);
+        focusY[i] = FloorDiv((int)floorf(focus[i].y / TILE_SIZE), STREAM_CHUNK_SIZE);
+    }
+
+    // Evict chunks past the margin, back to front so swap-removal is safe
+    int keepDistance = stream->radius + STREAM_UNLOAD_MARGIN;
+    for (int i = stream->entryCount - 1; i >= 0; i--) {
+        StreamEntry* entry = &stream->entries[i];
+        if (FocusDistance(entry, focusX, focusY, focusCount) <= keepDistance) continue;
+        if (ReleaseChunk(stream, entry->chunk)) RemoveEntry(stream, i);
+    }
+
+    // Request missing chunks ring by ring so the nearest load first
+    for (int ring = 0; ring <= stream->radius; ring++) {
+        for (int f = 0; f < focusCount; f++) {
+            for (int dy = -ring; dy <= ring; dy++) {
+                for (int dx = -ring; dx <= ring; dx++) {
+                    if (abs(dx) != ring && abs(dy) != ring) continue;
+
+                    int chunkX = focusX[f] + dx;
+                    int chunkY = focusY[f] + dy;
+                    if (FindEntry(stream, chunkX, chunkY)) continue;
+
+                    if (stream->entryCount >= stream->maxChunks &&
+                        !EvictMarginChunk(stream, focusX, focusY, focusCount)) {
+                        return;
+                    }
+                    uint32_t generation = stream->nextGeneration++;
+                    if (!QueueChunkLoad(stream->io, chunkX, chunkY, generation)) return;
+                    AddEntry(stream, chunkX, chunkY, generation);
+                }
+            }
+        }
+    }
+}
+
+void FlushWorldStream(WorldStream* stream) {
+    if (!stream) return;
+
+    FlushChunkIO(stream->io);
+    InstallLoadedChunks(stream);
+}
+
+void SaveWorldStream(WorldStream* stream) {
+    if (!stream) return;
+
+    for (int i = 0; i < stream->entryCount; i++) {
+        StreamChunk* chunk = stream->entries[i].chunk;
+        if (!chunk || !chunk->dirty) continue;
+
+        // The I/O thread owns what it saves, so it gets a snapshot
+        StreamChunk* copy = (StreamChunk*)malloc(sizeof(StreamChunk));
+        if (!copy) return;
+        *copy = *chunk;
+        copy->next = NULL;
+
+        while (!QueueChunkSave(stream->io, copy)) {
+            FlushChunkIO(stream->io);
+        }
+        chunk->dirty = false;
+    }
+}
+
+// Chunk access
+StreamChunk* GetStreamChunk(const WorldStream* stream, int chunkX, int chunkY) {
+    if (!stream) return NULL;
+
+    const StreamEntry* entry = FindEntry(stream, chunkX, chunkY);
+    return entry ? entry->chunk : NULL;
+}
+
+int GetResidentChunkCount(const WorldStream* stream) {
+    if (!stream) return 0;
+
+    int count = 0;
+    for (int i = 0; i < stream->entryCount; i++) {
+        if (stream->entries[i].chunk) count++;
+    }
+    return count;
+}
+
+// Resident chunk holding a tile and the tile's index inside it
+static StreamChunk* LocateTile(const WorldStream* stream, int x, int y, int* index) {
+    if (!stream) return NULL;
+
+    int chunkX = FloorDiv(x, STREAM_CHUNK_SIZE);
+    int chunkY = FloorDiv(y, STREAM_CHUNK_SIZE);
+    StreamChunk* chunk = GetStreamChunk(stream, chunkX, chunkY);
+    if (chunk) {
+        *index = (y - chunkY * STREAM_CHUNK_SIZE) * STREAM_CHUNK_SIZE + (x - chunkX * STREAM_CHUNK_SIZE);
+    }
+    return chunk;
+}
+
+bool IsStreamTileResident(const WorldStream* stream, int x, int y) {
+    int index;
+    return LocateTile(stream, x, y, &index) != NULL;
+}
+
+Tile GetStreamTile(const WorldStream* stream, int x, int y) {
+    int index;
+    const StreamChunk* chunk = LocateTile(stream, x, y, &index);
+    if (!chunk) return CreateTile(TILE_NONE, OBJECT_NONE);
+    return CreateTile((TileType)chunk->types[index], (ObjectType)chunk->objects[index]);
+}
+
+bool SetStreamTile(WorldStream* stream, int x, int y, Tile tile) {
+    int index;
+    StreamChunk* chunk = LocateTile(stream, x, y, &index);
+    if (!chunk) return false;
+
+    chunk->types[index] = (uint8_t)tile.type;
+    chunk->objects[index] = (uint8_t)tile.objectType;
+    chunk->dirty = true;
+    return true;
+}
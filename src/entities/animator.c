@@ -0,0 +1,101 @@
+#include "../../include/entities/animator.h"
+#include "../../include/entity.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <stdlib.h>
+#include <math.h>
+
+END_EXTERNAL_WARNINGS
+
+AnimationSystem* CreateAnimationSystem(const AnimationLibrary* library) {
+    if (!library) return NULL;
+
+    AnimationSystem* system = (AnimationSystem*)calloc(1, sizeof(AnimationSystem));
+    if (!system) return NULL;
+
+    system->library = library;
+    return system;
+}
+
+void DestroyAnimationSystem(AnimationSystem* system) {
+    free(system);
+}
+
+void PlayAnimation(Entity* entity, int clip) {
+    AnimatorComponent* animator = GetAnimatorComponent(entity);
+    if (!animator) return;
+
+    if (animator->clip != clip) {
+        animator->clip = clip;
+        animator->frame = 0;
+        animator->frameTime = 0.0f;
+    }
+    animator->playing = clip != ANIMATION_NO_CLIP;
+}
+
+void StopAnimation(Entity* entity) {
+    AnimatorComponent* animator = GetAnimatorComponent(entity);
+    if (animator) animator->playing = false;
+}
+
+static void AdvanceAnimator(AnimatorComponent* animator, const AnimationClip* clip,
+                            const AnimationFrame* frames, float elapsed) {
+    animator->frameTime += elapsed * animator->speed;
+
+    // Skip whole cycles so a long stall costs one pass, not one per frame
+    if (clip->loop && animator->frameTime >= clip->totalDuration) {
+        animator->frameTime = fmodf(animator->frameTime, clip->totalDuration);
+    }
+
+    while (animator->frameTime >= frames[animator->frame].duration) {
+        animator->frameTime -= frames[animator->frame].duration;
+        if (animator->frame + 1 < clip->frameCount) {
+            animator->frame++;
+        } else if (clip->loop) {
+            animator->frame = 0;
+        } else {
+            animator->frameTime = 0.0f;
+            animator->playing = false;
+            break;
+        }
+    }
+}
+
+int UpdateAnimationSystem(AnimationSystem* system, EntityPool* pool, float deltaTime) {
+    if (!system || !pool || deltaTime <= 0.0f) return 0;
+
+    system->accumulator += deltaTime;
+    int steps = (int)(system->accumulator / ANIMATION_FIXED_STEP);
+    if (steps == 0) return 0;
+
+    if (steps > ANIMATION_MAX_STEPS) {
+        steps = ANIMATION_MAX_STEPS;
+        system->accumulator = 0.0f;
+    } else {
+        system->accumulator -= (float)steps * ANIMATION_FIXED_STEP;
+    }
+
+    const AnimationLibrary* library = system->library;
+    const float elapsed = (float)steps * ANIMATION_FIXED_STEP;
+    const ComponentFlags required = COMPONENT_ANIMATOR | COMPONENT_RENDER;
+
+    for (size_t i = 0; i < pool->count; i++) {
+        Entity* entity = &pool->entities[i];
+        if (!entity->active || (entity->components & required) != required) continue;
+
+        AnimatorComponent* animator = GetAnimatorComponent(entity);
+        const AnimationClip* clip = GetAnimationClip(library, animator->clip);
+        if (!clip) continue;
+
+        const AnimationFrame* frames = &library->frames[clip->firstFrame];
+        if (animator->frame >= clip->frameCount) animator->frame = 0;
+        if (animator->playing) AdvanceAnimator(animator, clip, frames, elapsed);
+
+        GetRenderComponent(entity)->sourceRect = frames[animator->frame].source;
+    }
+
+    return steps;
+}
@@ -0,0 +1,246 @@
+#include "../../include/entities/crowd.h"
+#include "../../include/entity.h"
+#include "../../include/world.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <raymath.h>
+#include <stdlib.h>
+#include <math.h>
+
+END_EXTERNAL_WARNINGS
+
+static bool GrowCrowdStorage(CrowdSystem* crowd, int required) {
+    if (required <= crowd->agentCapacity) return true;
+
+    int newCapacity = crowd->agentCapacity > 0 ? crowd->agentCapacity : INITIAL_POOL_SIZE;
+    while (newCapacity < required) newCapacity *= POOL_GROWTH_FACTOR;
+
+    Entity** agents = (Entity**)realloc(crowd->agents, (size_t)newCapacity * sizeof(Entity*));
+    if (!agents) return false;
+    crowd->agents = agents;
+
+    Vector2* positions = (Vector2*)realloc(crowd->positions, (size_t)newCapacity * sizeof(Vector2));
+    if (!positions) return false;
+    crowd->positions = positions;
+
+    Vector2* velocities = (Vector2*)realloc(crowd->velocities, (size_t)newCapacity * sizeof(Vector2));
+    if (!velocities) return false;
+    crowd->velocities = velocities;
+
+    Vector2* desired = (Vector2*)realloc(crowd->desired, (size_t)newCapacity * sizeof(Vector2));
+    if (!desired) return false;
+    crowd->desired = desired;
+
+    Vector2* probes = (Vector2*)realloc(crowd->probes, (size_t)newCapacity * sizeof(Vector2));
+    if (!probes) return false;
+    crowd->probes = probes;
+
+    bool* probeOpen = (bool*)realloc(crowd->probeOpen, (size_t)newCapacity * sizeof(bool));
+    if (!probeOpen) return false;
+    crowd->probeOpen = probeOpen;
+
+    crowd->agentCapacity = newCapacity;
+    return true;
+}
+
+CrowdSettings GetDefaultCrowdSettings(void) {
+    CrowdSettings settings = {
+        .neighborRadius = CROWD_NEIGHBOR_RADIUS,
+        .separationRadius = CROWD_SEPARATION_RADIUS,
+        .separationWeight = CROWD_SEPARATION_WEIGHT,
+        .alignmentWeight = CROWD_ALIGNMENT_WEIGHT,
+        .obstacleWeight = CROWD_OBSTACLE_WEIGHT,
+        .obstacleLookahead = CROWD_OBSTACLE_LOOKAHEAD,
+        .maxSpeed = CROWD_MAX_SPEED
+    };
+    return settings;
+}
+
+CrowdSystem* CreateCrowdSystem(Rectangle worldBounds, const CrowdSettings* settings) {
+    CrowdSystem* crowd = (CrowdSystem*)calloc(1, sizeof(CrowdSystem));
+    if (!crowd) return NULL;
+
+    crowd->settings = settings ? *settings : GetDefaultCrowdSettings();
+
+    // Neighbor radius as cell size keeps every neighbor within the 3x3 block
+    crowd->grid = CreateSpatialGrid(worldBounds, crowd->settings.neighborRadius);
+    if (!crowd->grid || !GrowCrowdStorage(crowd, INITIAL_POOL_SIZE)) {
+        DestroyCrowdSystem(crowd);
+        return NULL;
+    }
+
+    return crowd;
+}
+
+void DestroyCrowdSystem(CrowdSystem* crowd) {
+    if (!crowd) return;
+
+    DestroySpatialGrid(crowd->grid);
+    free(crowd->agents);
+    free(crowd->positions);
+    free(crowd->velocities);
+    free(crowd->desired);
+    free(crowd->probes);
+    free(crowd->probeOpen);
+    free(crowd);
+}
+
+// Places each agent's probe along its preferred direction and tests them
+// all in one batched walkability query
+static void ProbeObstacles(CrowdSystem* crowd, const World* world) {
+    for (int agent = 0; agent < crowd->agentCount; agent++) {
+        Vector2 position = crowd->positions[agent];
+        Vector2 velocity = crowd->velocities[agent];
+        float speedSq = velocity.x * velocity.x + velocity.y * velocity.y;
+        if (speedSq < 0.0001f) {
+            crowd->probes[agent] = position;
+            continue;
+        }
+
+        float invSpeed = 1.0f / sqrtf(speedSq);
+        crowd->probes[agent] = (Vector2){
+            position.x + velocity.x * invSpeed * crowd->settings.obstacleLookahead,
+            position.y + velocity.y * invSpeed * crowd->settings.obstacleLookahead
+        };
+    }
+
+    if (world) {
+        AreWalkable(world, crowd->probes, crowd->agentCount, crowd->probeOpen);
+    } else {
+        for (int agent = 0; agent < crowd->agentCount; agent++) crowd->probeOpen[agent] = true;
+    }
+}
+
+// Pushes away from a blocked tile ahead of the agent
+static Vector2 ComputeObstacleAvoidance(const CrowdSystem* crowd, int agent, Vector2 position, Vector2 velocity) {
+    Vector2 avoidance = { 0.0f, 0.0f };
+    float speedSq = velocity.x * velocity.x + velocity.y * velocity.y;
+    if (speedSq < 0.0001f || crowd->probeOpen[agent]) return avoidance;
+
+    int tileX = (int)floorf(crowd->probes[agent].x / TILE_SIZE);
+    int tileY = (int)floorf(crowd->probes[agent].y / TILE_SIZE);
+    Vector2 away = {
+        position.x - ((float)tileX + 0.5f) * TILE_SIZE,
+        position.y - ((float)tileY + 0.5f) * TILE_SIZE
+    };
+    return Vector2Normalize(away);
+}
+
+static Vector2 SteerAgent(const CrowdSystem* crowd, int agent) {
+    const SpatialGrid* grid = crowd->grid;
+    const CrowdSettings* settings = &crowd->settings;
+    Vector2 position = crowd->positions[agent];
+    Vector2 velocity = crowd->velocities[agent];
+
+    float neighborRadiusSq = settings->neighborRadius * settings->neighborRadius;
+    float separationRadiusSq = settings->separationRadius * settings->separationRadius;
+
+    Vector2 separation = { 0.0f, 0.0f };
+    Vector2 alignment = { 0.0f, 0.0f };
+    int alignmentCount = 0;
+
+    int cellX = GetSpatialGridCellX(grid, position.x);
+    int cellY = GetSpatialGridCellY(grid, position.y);
+
+    for (int y = cellY - 1; y <= cellY + 1; y++) {
+        if (y < 0 || y >= grid->rows) continue;
+        for (int x = cellX - 1; x <= cellX + 1; x++) {
+            if (x < 0 || x >= grid->columns) continue;
+
+            int cell = y * grid->columns + x;
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+                int other = grid->cellItems[k];
+                if (other == agent) continue;
+
+                float dx = position.x - crowd->positions[other].x;
+                float dy = position.y - crowd->positions[other].y;
+                float distSq = dx * dx + dy * dy;
+                if (distSq > neighborRadiusSq) continue;
+
+                alignment.x += crowd->velocities[other].x;
+                alignment.y += crowd->velocities[other].y;
+                alignmentCount++;
+
+                if (distSq >= separationRadiusSq) continue;
+
+                if (distSq < 0.0001f) {
+                    // Exact overlap: split by index so both agents agree
+                    separation.x += agent < other ? -1.0f : 1.0f;
+                    continue;
+                }
+
+                float dist = sqrtf(distSq);
+                float strength = 1.0f - dist / settings->separationRadius;
+                separation.x += dx / dist * strength;
+                separation.y += dy / dist * strength;
+            }
+        }
+    }
+
+    if (alignmentCount > 0) {
+        alignment.x = alignment.x / (float)alignmentCount - velocity.x;
+        alignment.y = alignment.y / (float)alignmentCount - velocity.y;
+    }
+
+    Vector2 avoidance = ComputeObstacleAvoidance(crowd, agent, position, velocity);
+
+    Vector2 desired = {
+        velocity.x + separation.x * settings->separationWeight * settings->maxSpeed
+                   + alignment.x * settings->alignmentWeight
+                   + avoidance.x * settings->obstacleWeight * settings->maxSpeed,
+        velocity.y + separation.y * settings->separationWeight * settings->maxSpeed
+                   + alignment.y * settings->alignmentWeight
+                   + avoidance.y * settings->obstacleWeight * settings->maxSpeed
+    };
+
+    return Vector2ClampValue(desired, 0.0f, settings->maxSpeed);
+}
+
+static void SteerCellRange(void* context, int begin, int end) {
+    const CrowdSystem* crowd = (const CrowdSystem*)context;
+    const SpatialGrid* grid = crowd->grid;
+
+    for (int cell = begin; cell < end; cell++) {
+        for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+            int agent = grid->cellItems[k];
+            crowd->desired[agent] = SteerAgent(crowd, agent);
+        }
+    }
+}
+
+void UpdateCrowdSteering(CrowdSystem* crowd, EntityPool* pool, const World* world, JobSystem* jobs) {
+    if (!crowd || !pool) return;
+
+    // Snapshot agents into SoA arrays
+    crowd->agentCount = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        Entity* entity = &pool->entities[i];
+        if (!entity->active) continue;
+
+        TransformComponent* transform = GetTransformComponent(entity);
+        PhysicsComponent* physics = GetPhysicsComponent(entity);
+        if (!transform || !physics || !GetAIComponent(entity)) continue;
+
+        if (!GrowCrowdStorage(crowd, crowd->agentCount + 1)) return;
+
+        int agent = crowd->agentCount++;
+        crowd->agents[agent] = entity;
+        crowd->positions[agent] = transform->position;
+        crowd->velocities[agent] = physics->velocity;
+    }
+
+    if (!BuildSpatialGrid(crowd->grid, crowd->positions, crowd->agentCount)) return;
+    ProbeObstacles(crowd, world);
+
+    // Each agent is written by exactly one cell job
+    ParallelFor(jobs, GetSpatialGridCellCount(crowd->grid), CROWD_CELLS_PER_JOB, SteerCellRange, crowd);
+
+    for (int agent = 0; agent < crowd->agentCount; agent++) {
+        PhysicsComponent* physics = GetPhysicsComponent(crowd->agents[agent]);
+        physics->desiredVelocity = crowd->desired[agent];
+        physics->isSteered = true;
+    }
+}
@@ -0,0 +1,118 @@
+#include "../../include/entities/movement.h"
+#include "../../include/collision_grid.h"
+#include "../../include/entity.h"
+#include "../../include/world.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <raymath.h>
+#include <stdlib.h>
+
+END_EXTERNAL_WARNINGS
+
+typedef struct MovementPass {
+    EntityPool* pool;
+    const World* world;
+    int steps;
+} MovementPass;
+
+MovementSystem* CreateMovementSystem(void) {
+    return (MovementSystem*)calloc(1, sizeof(MovementSystem));
+}
+
+void DestroyMovementSystem(MovementSystem* system) {
+    free(system);
+}
+
+Rectangle GetMovementBox(Entity* entity, Vector2 position) {
+    ColliderComponent* collider = GetColliderComponent(entity);
+    if (!collider || !collider->isEnabled) {
+        return (Rectangle){ position.x, position.y, (float)TILE_SIZE, (float)TILE_SIZE };
+    }
+
+    // Collider bounds are relative to the entity position
+    return (Rectangle){
+        position.x + collider->bounds.x,
+        position.y + collider->bounds.y,
+        collider->bounds.width,
+        collider->bounds.height
+    };
+}
+
+// One fixed step for one box. Without a bitmap (streamed worlds) only the
+// destination point is tested, as movement did before the sweep existed.
+static Vector2 StepBox(const World* world, Rectangle box, Vector2 motion, bool* hit) {
+    if (world->collision) return MoveCollisionBox(world->collision, box, motion, hit);
+
+    Vector2 destination = { box.x + motion.x, box.y + motion.y };
+    *hit = !IsWalkable(world, destination);
+    return *hit ? (Vector2){ box.x, box.y } : destination;
+}
+
+static void MoveEntity(Entity* entity, const World* world, int steps) {
+    TransformComponent* transform = GetTransformComponent(entity);
+    PhysicsComponent* physics = GetPhysicsComponent(entity);
+
+    Vector2 motion = Vector2Scale(physics->moveVelocity, MOVEMENT_FIXED_STEP);
+    float motionLengthSqr = Vector2LengthSqr(motion);
+    if (motionLengthSqr == 0.0f) {
+        physics->isBlocked = false;
+        return;
+    }
+
+    Rectangle box = GetMovementBox(entity, transform->position);
+    Vector2 offset = { box.x - transform->position.x, box.y - transform->position.y };
+    bool blocked = false;
+
+    for (int step = 0; step < steps; step++) {
+        bool hit = false;
+        Vector2 start = { box.x, box.y };
+        Vector2 end = StepBox(world, box, motion, &hit);
+
+        float progressSqr = Vector2LengthSqr(Vector2Subtract(end, start));
+        if (hit && progressSqr < MOVEMENT_BLOCKED_PROGRESS * MOVEMENT_BLOCKED_PROGRESS * motionLengthSqr) {
+            blocked = true;
+        }
+        box.x = end.x;
+        box.y = end.y;
+    }
+
+    transform->position = (Vector2){ box.x - offset.x, box.y - offset.y };
+    entity->position = transform->position;
+    physics->isBlocked = blocked;
+}
+
+static void MoveEntityRange(void* context, int begin, int end) {
+    const MovementPass* pass = (const MovementPass*)context;
+    const ComponentFlags required = COMPONENT_TRANSFORM | COMPONENT_PHYSICS;
+
+    for (int i = begin; i < end; i++) {
+        Entity* entity = &pass->pool->entities[i];
+        if (!entity->active || (entity->components & required) != required) continue;
+        if (GetPhysicsComponent(entity)->isKinematic) continue;
+
+        MoveEntity(entity, pass->world, pass->steps);
+    }
+}
+
+int UpdateMovementSystem(MovementSystem* system, EntityPool* pool, const World* world,
+                         JobSystem* jobs, float deltaTime) {
+    if (!system || !pool || !world || deltaTime <= 0.0f) return 0;
+
+    system->accumulator += deltaTime;
+    int steps = (int)(system->accumulator / MOVEMENT_FIXED_STEP);
+    if (steps == 0) return 0;
+
+    if (steps > MOVEMENT_MAX_STEPS) {
+        steps = MOVEMENT_MAX_STEPS;
+        system->accumulator = 0.0f;
+    } else {
+        system->accumulator -= (float)steps * MOVEMENT_FIXED_STEP;
+    }
+
+    MovementPass pass = { pool, world, steps };
+    ParallelFor(jobs, (int)pool->count, MOVEMENT_ENTITIES_PER_JOB, MoveEntityRange, &pass);
+    return steps;
+}
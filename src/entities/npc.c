@@ -4,6 +4,12 @@
 #include "../../include/logger.h"
 #include "../../include/warning_suppression.h"
 #include "../../include/entities/player.h"
+#include "../../include/random.h"
+#include "../../include/entities/perception.h"
+#include "../../include/pathfinding.h"
+#include "../../include/region_map.h"
+#include "../../include/animation.h"
+#include "../../include/entities/animator.h"
 
 BEGIN_EXTERNAL_WARNINGS
 
@@ -17,6 +23,11 @@ BEGIN_EXTERNAL_WARNINGS
 END_EXTERNAL_WARNINGS
 
 #define INTERACTION_DISTANCE 64.0f
+#define PATROL_POINT_ATTEMPTS 8
+
+// Shared clip indices, resolved when the first NPC is created
+static int s_idleClip = ANIMATION_NO_CLIP;
+static int s_walkClip = ANIMATION_NO_CLIP;
 
 // Forward declarations of internal functions
 static void UpdateNPCInternal(Entity* self, struct World* world, float deltaTime);
@@ -33,11 +44,12 @@ static void UpdateFleeState(Entity* npc, struct World* world, float deltaTime);
 static Vector2 GetRandomPatrolPoint(const Entity* npc, const struct World* world);
 static float GetDistanceToPlayer(const Entity* npc, const struct World* world);
 static bool IsPlayerVisible(const Entity* npc, const struct World* world);
-static void UpdateNPCAnimation(Entity* npc, float deltaTime);
 
 // Forward declarations of static functions
+static bool GetNPCWaypoint(Entity* npc, struct World* world, Vector2 goal, Vector2* waypoint);
+static bool MoveNPC(Entity* npc, struct World* world, Vector2 preferredVelocity, float deltaTime);
 static void HandleCollision(Entity* npc, Entity* other);
-static void UpdatePathfinding(Entity* npc, World* world);
+static void ResolveNPCClips(void);
 static void UpdateAnimation(Entity* npc);
 static void HandleStateTransition(Entity* npc, World* world);
 
@@ -52,6 +64,12 @@ BEGIN_EXTERNAL_WARNINGS
 void UpdateNPC(Entity* npc, struct World* world, float deltaTime) {
     if (!npc || !world) return;
 
+    // Stand still unless a state below asks to move this tick, so arriving,
+    // losing the path or switching state never leaves the last velocity
+    // for the movement pass to keep sweeping
+    PhysicsComponent* physics = GetPhysicsComponent(npc);
+    if (physics) physics->moveVelocity = Vector2Zero();
+
     // Update NPC state
     switch (npc->state) {
         case ENTITY_STATE_IDLE:
@@ -70,9 +88,7 @@ void UpdateNPC(Entity* npc, struct World* world, float deltaTime) {
             break;
     }
 
-    // Update position and handle collisions
-    HandleCollision(npc, world);
-    UpdatePathfinding(npc, world);
+    // Pick the clip for this state and handle transitions
     UpdateAnimation(npc);
     HandleStateTransition(npc, world);
 }
@@ -82,11 +98,10 @@ void DrawNPC(Entity* npc) {
     
     RenderComponent* render = &npc->components_data[COMPONENT_RENDER].render;
     TransformComponent* transform = &npc->components_data[COMPONENT_TRANSFORM].transform;
-    AIComponent* ai = &npc->components_data[COMPONENT_AI].ai;
     
-    // Draw NPC sprite
+    // Draw NPC sprite, the animation system keeps sourceRect on the current frame
     if (render->texture) {
-        Rectangle source = { ai->animationFrame * NPC_WIDTH, 0, NPC_WIDTH, NPC_HEIGHT };
+        Rectangle source = render->sourceRect;
         Rectangle dest = { transform->position.x, transform->position.y, NPC_WIDTH * transform->scale, NPC_HEIGHT * transform->scale };
         Vector2 origin = Vector2Zero();
         DrawTexturePro(*render->texture, source, dest, origin, transform->rotation, render->color);
@@ -128,6 +143,7 @@ Entity* CreateNPC(struct EntityPool* pool, Vector2 position) {
     AddComponent(npc, COMPONENT_RENDER);
     AddComponent(npc, COMPONENT_COLLIDER);
     AddComponent(npc, COMPONENT_AI);
+    AddComponent(npc, COMPONENT_ANIMATOR);
 
     // Set up transform component
     TransformComponent* transform = GetTransformComponent(npc);
@@ -174,6 +190,10 @@ Entity* CreateNPC(struct EntityPool* pool, Vector2 position) {
         ai->isAggressive = false;
     }
 
+    // Start on the idle clip
+    if (s_idleClip == ANIMATION_NO_CLIP) ResolveNPCClips();
+    PlayAnimation(npc, s_idleClip);
+
     // Set up callbacks
     npc->Update = UpdateNPCInternal;
     npc->Draw = DrawNPCInternal;
@@ -190,17 +210,20 @@ static void UpdateIdleState(Entity* npc, struct World* world, float deltaTime) {
     if (!ai) return;
     
     // Check for player proximity
-    float distanceToPlayer = GetDistanceToPlayer(npc, world);
-    if (distanceToPlayer < ai->detectionRadius && IsPlayerVisible(npc, world)) {
+    if ((ai->perception & PERCEPTION_PLAYER_DETECTED) && IsPlayerVisible(npc, world)) {
         ai->state = ai->isAggressive ? ENTITY_STATE_CHASE : ENTITY_STATE_FLEE;
         return;
     }
     
     // Randomly transition to patrol state
-    if (GetRandomValue(0, 100) < 10) {
+    RandomStream rng = CreateEntityRandomStream(world->seed, npc->id, RANDOM_PURPOSE_AI_IDLE, world->tick);
+    if (NextRandomInt(&rng, 0, 100) < 10) {
         ai->state = ENTITY_STATE_PATROL;
         ai->targetPosition = GetRandomPatrolPoint(npc, world);
     }
+
+    // Standing still, but let the crowd nudge us out of overlaps
+    MoveNPC(npc, world, Vector2Zero(), deltaTime);
 }
 
 static void UpdatePatrolState(Entity* npc, struct World* world, float deltaTime) {
@@ -211,23 +234,23 @@ static void UpdatePatrolState(Entity* npc, struct World* world, float deltaTime)
     if (!ai || !transform) return;
     
     // Check for player
-    float distanceToPlayer = GetDistanceToPlayer(npc, world);
-    if (distanceToPlayer < ai->detectionRadius && IsPlayerVisible(npc, world)) {
+    if ((ai->perception & PERCEPTION_PLAYER_DETECTED) && IsPlayerVisible(npc, world)) {
         ai->state = ai->isAggressive ? ENTITY_STATE_CHASE : ENTITY_STATE_FLEE;
         return;
     }
     
     // Move towards target position
-    Vector2 direction = Vector2Subtract(ai->targetPosition, transform->position);
-    float distance = Vector2Length(direction);
+    float distance = Vector2Distance(ai->targetPosition, transform->position);
     
     if (distance > 5.0f) {
-        direction = Vector2Scale(Vector2Normalize(direction), 100.0f * deltaTime);
-        Vector2 newPos = Vector2Add(transform->position, direction);
+        Vector2 waypoint;
+        if (!GetNPCWaypoint(npc, world, ai->targetPosition, &waypoint)) {
+            ai->targetPosition = GetRandomPatrolPoint(npc, world);
+            return;
+        }
         
-        if (IsWalkable(world, newPos)) {
-            transform->position = newPos;
-        } else {
+        Vector2 direction = Vector2Subtract(waypoint, transform->position);
+        if (!MoveNPC(npc, world, Vector2Scale(Vector2Normalize(direction), 100.0f), deltaTime)) {
             ai->targetPosition = GetRandomPatrolPoint(npc, world);
         }
     }
@@ -240,21 +263,13 @@ static void UpdateChaseState(Entity* npc, struct World* world, float deltaTime)
     TransformComponent* transform = GetTransformComponent(npc);
     if (!ai || !transform) return;
     
-    Vector2 playerPos = GetPlayerPosition(world);
-    float distanceToPlayer = Vector2Distance(transform->position, playerPos);
-    
-    if (distanceToPlayer > ai->detectionRadius || !IsPlayerVisible(npc, world)) {
+    if (!(ai->perception & PERCEPTION_PLAYER_DETECTED) || !IsPlayerVisible(npc, world)) {
         ai->state = ENTITY_STATE_IDLE;
         return;
     }
     
-    Vector2 direction = Vector2Subtract(playerPos, transform->position);
-    direction = Vector2Scale(Vector2Normalize(direction), 120.0f * deltaTime);
-    Vector2 newPos = Vector2Add(transform->position, direction);
-    
-    if (IsWalkable(world, newPos)) {
-        transform->position = newPos;
-    }
+    Vector2 direction = Vector2Subtract(GetPlayerPosition(world), transform->position);
+    MoveNPC(npc, world, Vector2Scale(Vector2Normalize(direction), 120.0f), deltaTime);
 }
 
 static void UpdateFleeState(Entity* npc, struct World* world, float deltaTime) {
@@ -264,20 +279,13 @@ static void UpdateFleeState(Entity* npc, struct World* world, float deltaTime) {
     TransformComponent* transform = GetTransformComponent(npc);
     if (!ai || !transform) return;
     
-    Vector2 playerPos = GetPlayerPosition(world);
-    Vector2 direction = Vector2Subtract(transform->position, playerPos);
-    
-    if (Vector2Length(direction) > ai->detectionRadius * 2.0f) {
+    if (!(ai->perception & PERCEPTION_PLAYER_IN_RANGE)) {
         ai->state = ENTITY_STATE_IDLE;
         return;
     }
     
-    direction = Vector2Scale(Vector2Normalize(direction), 150.0f * deltaTime);
-    Vector2 newPos = Vector2Add(transform->position, direction);
-    
-    if (IsWalkable(world, newPos)) {
-        transform->position = newPos;
-    } else {
+    Vector2 direction = Vector2Subtract(transform->position, GetPlayerPosition(world));
+    if (!MoveNPC(npc, world, Vector2Scale(Vector2Normalize(direction), 150.0f), deltaTime)) {
         ai->targetPosition = GetRandomPatrolPoint(npc, world);
     }
 }
@@ -303,25 +311,28 @@ Vector2 GetRandomPatrolPoint(const Entity* npc, const struct World* world) {
     const AIComponent* ai = &npc->components_data[COMPONENT_AI].ai;
     float radius = ai->patrolRadius;
     
-    float angle = (float)(rand() % 360) * DEG2RAD;
-    float distance = (float)(rand() % (int)radius);
-    
-    return (Vector2){
-        ai->homePosition.x + cosf(angle) * distance,
-        ai->homePosition.y + sinf(angle) * distance
-    };
-}
-
-void UpdateNPCAnimation(Entity* npc, float deltaTime) {
-    if (!npc || !HasComponent(npc, COMPONENT_AI)) return;
-    
-    AIComponent* ai = &npc->components_data[COMPONENT_AI].ai;
-    ai->animationTimer += deltaTime;
-    
-    if (ai->animationTimer >= 0.2f) {
-        ai->animationFrame = (ai->animationFrame + 1) % 4;
-        ai->animationTimer = 0;
+    RandomStream rng = CreateEntityRandomStream(world->seed, npc->id, RANDOM_PURPOSE_AI_PATROL, world->tick);
+    int fromX = (int)floorf(npc->position.x / TILE_SIZE);
+    int fromY = (int)floorf(npc->position.y / TILE_SIZE);
+
+    // Resample points the NPC cannot walk to, so it never plans a path that
+    // searches its whole region only to fail
+    for (int attempt = 0; attempt < PATROL_POINT_ATTEMPTS; attempt++) {
+        float angle = NextRandomFloat(&rng) * 2.0f * PI;
+        float distance = NextRandomFloat(&rng) * radius;
+        Vector2 point = {
+            ai->homePosition.x + cosf(angle) * distance,
+            ai->homePosition.y + sinf(angle) * distance
+        };
+
+        if (!world->regions || GetTileRegion(world->regions, fromX, fromY) == REGION_NONE ||
+            AreTilesConnected(world->regions, fromX, fromY,
+                              (int)floorf(point.x / TILE_SIZE), (int)floorf(point.y / TILE_SIZE))) {
+            return point;
+        }
     }
+
+    return ai->homePosition;
 }
 
 void DestroyNPC(Entity* npc) {
@@ -341,9 +352,63 @@ static void DrawNPCInternal(const Entity* self) {
 
 static void OnNPCCollisionInternal(Entity* self, Entity* other) {
     if (!self || !other) return;
+    HandleCollision(self, other);
     OnNPCCollision(self, other);
 }
 
+// Next point on the hierarchical route to goal, replanning when the goal
+// changes. Worlds without a tile grid fall back to the straight line.
+static bool GetNPCWaypoint(Entity* npc, struct World* world, Vector2 goal, Vector2* waypoint) {
+    AIComponent* ai = GetAIComponent(npc);
+    TransformComponent* transform = GetTransformComponent(npc);
+    HPAGraph* graph = GetWorldPathGraph(world);
+    PathFollower* path = ai ? GetPathFollower(GetWorldPathFollowers(world), &ai->pathHandle, npc->id, world->tick) : NULL;
+    if (!ai || !transform || !graph || !path) {
+        *waypoint = goal;
+        return true;
+    }
+
+    HPAPoint goalTile = { (int)floorf(goal.x / TILE_SIZE), (int)floorf(goal.y / TILE_SIZE) };
+    bool onGoalTile = (int)floorf(transform->position.x / TILE_SIZE) == goalTile.x &&
+                      (int)floorf(transform->position.y / TILE_SIZE) == goalTile.y;
+
+    if (!path->active || path->goal.x != goalTile.x || path->goal.y != goalTile.y) {
+        SetPathGoal(path, graph, world, transform->position, goal);
+    }
+
+    if (!GetPathTarget(path, graph, world, transform->position, waypoint)) {
+        // Finish the last few pixels directly, or give up if unreachable
+        *waypoint = goal;
+        return onGoalTile;
+    }
+
+    return true;
+}
+
+// Records the preferred velocity for the next crowd pass and hands the
+// crowd-adjusted velocity, when one is available, to the movement pass.
+// Returns false when the last movement pass found the NPC blocked.
+static bool MoveNPC(Entity* npc, struct World* world, Vector2 preferredVelocity, float deltaTime) {
+    TransformComponent* transform = GetTransformComponent(npc);
+    PhysicsComponent* physics = GetPhysicsComponent(npc);
+    if (!transform) return false;
+
+    if (physics) {
+        physics->velocity = preferredVelocity;
+        physics->moveVelocity = physics->isSteered ? physics->desiredVelocity : preferredVelocity;
+        physics->isSteered = false;
+        return !physics->isBlocked;
+    }
+
+    // Without physics there is no sweep; test the destination point only
+    Vector2 newPos = Vector2Add(transform->position, Vector2Scale(preferredVelocity, deltaTime));
+    if (!IsWalkable(world, newPos)) return false;
+
+    transform->position = newPos;
+    npc->position = newPos;
+    return true;
+}
+
 static void HandleCollision(Entity* npc, Entity* other) {
     if (!npc || !other) return;
     
@@ -371,46 +436,23 @@ static void HandleCollision(Entity* npc, Entity* other) {
     }
 }
 
-static void UpdatePathfinding(Entity* npc, World* world) {
-    if (!npc || !world) return;
-    
-    AIComponent* ai = GetAIComponent(npc);
-    TransformComponent* transform = GetTransformComponent(npc);
-    
-    if (!ai || !transform) return;
-    
-    // Simple pathfinding: move directly towards target
-    Vector2 direction = Vector2Subtract(ai->targetPosition, transform->position);
-    float distance = Vector2Length(direction);
-    
-    if (distance > 0) {
-        direction = Vector2Normalize(direction);
-        direction.x *= ai->moveSpeed;
-        direction.y *= ai->moveSpeed;
-        PhysicsComponent* physics = GetPhysicsComponent(npc);
-        if (physics) {
-            physics->velocity = direction;
-        }
-    }
+static void ResolveNPCClips(void) {
+    const AnimationLibrary* library = GetAnimationLibrary();
+    s_idleClip = FindAnimationClip(library, "npc_idle");
+    s_walkClip = FindAnimationClip(library, "npc_walk");
 }
 
+// Frames are advanced by the batched animation system; NPCs only choose the clip
 static void UpdateAnimation(Entity* npc) {
     if (!npc) return;
     
     AIComponent* ai = GetAIComponent(npc);
-    RenderComponent* render = GetRenderComponent(npc);
-    
-    if (!ai || !render) return;
+    if (!ai) return;
     
-    // Update animation frame based on state
-    ai->animationTimer += GetFrameTime();
-    if (ai->animationTimer >= ANIMATION_FRAME_TIME) {
-        ai->animationTimer = 0;
-        ai->animationFrame = (ai->animationFrame + 1) % ANIMATION_FRAME_COUNT;
-        
-        // Update source rectangle for sprite animation
-        render->sourceRect.x = ai->animationFrame * TILE_SIZE;
-    }
+    bool moving = ai->state == ENTITY_STATE_PATROL ||
+                  ai->state == ENTITY_STATE_CHASE ||
+                  ai->state == ENTITY_STATE_FLEE;
+    PlayAnimation(npc, moving ? s_walkClip : s_idleClip);
 }
 
 static void HandleStateTransition(Entity* npc, World* world) {
@@ -429,9 +471,10 @@ static void HandleStateTransition(Entity* npc, World* world) {
                 ai->state = ENTITY_STATE_PATROL;
                 ai->stateTimer = 0;
                 // Set new patrol target
+                RandomStream rng = CreateEntityRandomStream(world->seed, npc->id, RANDOM_PURPOSE_AI_TRANSITION, world->tick);
                 ai->targetPosition = (Vector2){
-                    ai->homePosition.x + GetRandomValue(-100, 100),
-                    ai->homePosition.y + GetRandomValue(-100, 100)
+                    ai->homePosition.x + NextRandomInt(&rng, -100, 100),
+                    ai->homePosition.y + NextRandomInt(&rng, -100, 100)
                 };
             }
             break;
@@ -0,0 +1,177 @@
+#include "../../include/entities/perception.h"
+#include "../../include/entity.h"
+#include "../../include/warning_suppression.h"
+
+BEGIN_EXTERNAL_WARNINGS
+
+// External includes
+#include <stdlib.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PERCEPTION_USE_SSE 1
+#endif
+
+END_EXTERNAL_WARNINGS
+
+static bool GrowPerceptionStorage(PerceptionSystem* perception, int required) {
+    if (required <= perception->agentCapacity) return true;
+
+    int newCapacity = perception->agentCapacity > 0 ? perception->agentCapacity : INITIAL_POOL_SIZE;
+    while (newCapacity < required) newCapacity *= POOL_GROWTH_FACTOR;
+    newCapacity = (newCapacity + PERCEPTION_LANES - 1) / PERCEPTION_LANES * PERCEPTION_LANES;
+
+    Entity** agents = (Entity**)realloc(perception->agents, (size_t)newCapacity * sizeof(Entity*));
+    if (!agents) return false;
+    perception->agents = agents;
+
+    float* positionsX = (float*)realloc(perception->positionsX, (size_t)newCapacity * sizeof(float));
+    if (!positionsX) return false;
+    perception->positionsX = positionsX;
+
+    float* positionsY = (float*)realloc(perception->positionsY, (size_t)newCapacity * sizeof(float));
+    if (!positionsY) return false;
+    perception->positionsY = positionsY;
+
+    float* radiiSq = (float*)realloc(perception->detectionRadiiSq, (size_t)newCapacity * sizeof(float));
+    if (!radiiSq) return false;
+    perception->detectionRadiiSq = radiiSq;
+
+    uint32_t* masks = (uint32_t*)realloc(perception->masks, (size_t)newCapacity * sizeof(uint32_t));
+    if (!masks) return false;
+    perception->masks = masks;
+
+    perception->agentCapacity = newCapacity;
+    return true;
+}
+
+PerceptionSystem* CreatePerceptionSystem(void) {
+    PerceptionSystem* perception = (PerceptionSystem*)calloc(1, sizeof(PerceptionSystem));
+    if (!perception) return NULL;
+
+    if (!GrowPerceptionStorage(perception, INITIAL_POOL_SIZE)) {
+        DestroyPerceptionSystem(perception);
+        return NULL;
+    }
+
+    return perception;
+}
+
+void DestroyPerceptionSystem(PerceptionSystem* perception) {
+    if (!perception) return;
+
+    free(perception->agents);
+    free(perception->positionsX);
+    free(perception->positionsY);
+    free(perception->detectionRadiiSq);
+    free(perception->masks);
+    free(perception);
+}
+
+int AddPerceptionStimulus(PerceptionSystem* perception, Vector2 position, float radius) {
+    if (!perception || perception->stimulusCount >= PERCEPTION_MAX_STIMULI) return -1;
+
+    int index = perception->stimulusCount++;
+    perception->stimuli[index] = (PerceptionStimulus){ position, radius };
+    return index;
+}
+
+void ClearPerceptionStimuli(PerceptionSystem* perception) {
+    if (perception) perception->stimulusCount = 0;
+}
+
+#ifdef PERCEPTION_USE_SSE
+static void ComputePerceptionMasks(PerceptionSystem* perception, Vector2 playerPosition) {
+    const __m128 playerX = _mm_set1_ps(playerPosition.x);
+    const __m128 playerY = _mm_set1_ps(playerPosition.y);
+    const __m128 four = _mm_set1_ps(4.0f);
+
+    for (int i = 0; i < perception->agentCount; i += PERCEPTION_LANES) {
+        __m128 x = _mm_loadu_ps(&perception->positionsX[i]);
+        __m128 y = _mm_loadu_ps(&perception->positionsY[i]);
+        __m128 radiusSq = _mm_loadu_ps(&perception->detectionRadiiSq[i]);
+
+        __m128 dx = _mm_sub_ps(x, playerX);
+        __m128 dy = _mm_sub_ps(y, playerY);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        __m128i mask = _mm_and_si128(_mm_castps_si128(_mm_cmplt_ps(distSq, radiusSq)),
+                                     _mm_set1_epi32((int)PERCEPTION_PLAYER_DETECTED));
+        mask = _mm_or_si128(mask, _mm_and_si128(_mm_castps_si128(_mm_cmple_ps(distSq, _mm_mul_ps(radiusSq, four))),
+                                                _mm_set1_epi32((int)PERCEPTION_PLAYER_IN_RANGE)));
+
+        for (int s = 0; s < perception->stimulusCount; s++) {
+            const PerceptionStimulus* stimulus = &perception->stimuli[s];
+            __m128 sx = _mm_sub_ps(x, _mm_set1_ps(stimulus->position.x));
+            __m128 sy = _mm_sub_ps(y, _mm_set1_ps(stimulus->position.y));
+            __m128 stimulusDistSq = _mm_add_ps(_mm_mul_ps(sx, sx), _mm_mul_ps(sy, sy));
+            __m128 heard = _mm_cmplt_ps(stimulusDistSq, _mm_set1_ps(stimulus->radius * stimulus->radius));
+            mask = _mm_or_si128(mask, _mm_and_si128(_mm_castps_si128(heard),
+                                                    _mm_set1_epi32((int)PERCEPTION_STIMULUS_BIT(s))));
+        }
+
+        _mm_storeu_si128((__m128i*)&perception->masks[i], mask);
+    }
+}
+#else
+static void ComputePerceptionMasks(PerceptionSystem* perception, Vector2 playerPosition) {
+    for (int i = 0; i < perception->agentCount; i++) {
+        float dx = perception->positionsX[i] - playerPosition.x;
+        float dy = perception->positionsY[i] - playerPosition.y;
+        float distSq = dx * dx + dy * dy;
+        float radiusSq = perception->detectionRadiiSq[i];
+
+        uint32_t mask = PERCEPTION_NONE;
+        if (distSq < radiusSq) mask |= PERCEPTION_PLAYER_DETECTED;
+        if (distSq <= radiusSq * 4.0f) mask |= PERCEPTION_PLAYER_IN_RANGE;
+
+        for (int s = 0; s < perception->stimulusCount; s++) {
+            const PerceptionStimulus* stimulus = &perception->stimuli[s];
+            float sx = perception->positionsX[i] - stimulus->position.x;
+            float sy = perception->positionsY[i] - stimulus->position.y;
+            if (sx * sx + sy * sy < stimulus->radius * stimulus->radius) {
+                mask |= PERCEPTION_STIMULUS_BIT(s);
+            }
+        }
+
+        perception->masks[i] = mask;
+    }
+}
+#endif
+
+void UpdatePerception(PerceptionSystem* perception, EntityPool* pool, Vector2 playerPosition) {
+    if (!perception || !pool) return;
+
+    // Snapshot agents into SoA arrays
+    perception->agentCount = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        Entity* entity = &pool->entities[i];
+        if (!entity->active) continue;
+
+        AIComponent* ai = GetAIComponent(entity);
+        if (!ai) continue;
+
+        if (!GrowPerceptionStorage(perception, perception->agentCount + PERCEPTION_LANES)) return;
+
+        int agent = perception->agentCount++;
+        perception->agents[agent] = entity;
+        perception->positionsX[agent] = entity->position.x;
+        perception->positionsY[agent] = entity->position.y;
+        perception->detectionRadiiSq[agent] = ai->detectionRadius * ai->detectionRadius;
+    }
+
+    // Pad the last vector with lanes that can never detect anything
+    for (int i = perception->agentCount; i % PERCEPTION_LANES != 0; i++) {
+        perception->positionsX[i] = 0.0f;
+        perception->positionsY[i] = 0.0f;
+        perception->detectionRadiiSq[i] = 0.0f;
+    }
+
+    ComputePerceptionMasks(perception, playerPosition);
+
+    for (int agent = 0; agent < perception->agentCount; agent++) {
+        GetAIComponent(perception->agents[agent])->perception = perception->masks[agent];
+    }
+
+    ClearPerceptionStimuli(perception);
+}
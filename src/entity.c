@@ -1,6 +1,8 @@
 #include "../include/entity.h"
 #include "../include/world.h"
 #include "../include/logger.h"
+#include "../include/animation.h"
+#include "../include/pathfinding.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -103,9 +105,13 @@ void AddComponent(Entity* entity, ComponentFlags component) {
             PhysicsComponent* physics = &entity->components_data[componentIndex].physics;
             physics->velocity = (Vector2){0.0f, 0.0f};
             physics->acceleration = (Vector2){0.0f, 0.0f};
+            physics->desiredVelocity = (Vector2){0.0f, 0.0f};
             physics->friction = 0.5f;
             physics->mass = 1.0f;
             physics->isKinematic = false;
+            physics->isSteered = false;
+            physics->moveVelocity = (Vector2){0.0f, 0.0f};
+            physics->isBlocked = false;
             break;
         }
         case COMPONENT_RENDER: {
@@ -135,8 +141,8 @@ void AddComponent(Entity* entity, ComponentFlags component) {
             ai->isAggressive = false;
             ai->state = ENTITY_STATE_IDLE;
             ai->stateTimer = 0.0f;
-            ai->animationFrame = 0;
-            ai->animationTimer = 0.0f;
+            ai->perception = 0;
+            ai->pathHandle = PATH_FOLLOWER_NONE;
             break;
         }
         case COMPONENT_PLAYER_CONTROL: {
@@ -146,6 +152,15 @@ void AddComponent(Entity* entity, ComponentFlags component) {
             control->isInteracting = false;
             break;
         }
+        case COMPONENT_ANIMATOR: {
+            AnimatorComponent* animator = &entity->components_data[componentIndex].animator;
+            animator->clip = ANIMATION_NO_CLIP;
+            animator->frame = 0;
+            animator->frameTime = 0.0f;
+            animator->speed = 1.0f;
+            animator->playing = false;
+            break;
+        }
         default:
             break;
     }
@@ -210,6 +225,11 @@ PlayerControlComponent* GetPlayerControlComponent(Entity* entity) {
     return &entity->components_data[5].playerControl;
 }
 
+AnimatorComponent* GetAnimatorComponent(Entity* entity) {
+    if (!entity || !HasComponent(entity, COMPONENT_ANIMATOR)) return NULL;
+    return &entity->components_data[6].animator;
+}
+
 void UpdateEntityPosition(Entity* entity, Vector2 newPosition) {
     if (!entity) return;
 
@@ -293,9 +313,11 @@ static void InitializePhysicsComponent(PhysicsComponent* component) {
     if (!component) return;
     component->velocity = (Vector2){0.0f, 0.0f};
     component->acceleration = (Vector2){0.0f, 0.0f};
+    component->desiredVelocity = (Vector2){0.0f, 0.0f};
     component->friction = 0.5f;
     component->mass = 1.0f;
     component->isKinematic = false;
+    component->isSteered = false;
 }
 
 static void InitializeRenderComponent(RenderComponent* component) {
@@ -325,8 +347,8 @@ static void InitializeAIComponent(AIComponent* component) {
     component->isAggressive = false;
     component->state = ENTITY_STATE_IDLE;
     component->stateTimer = 0.0f;
-    component->animationFrame = 0;
-    component->animationTimer = 0.0f;
+    component->perception = 0;
+    component->pathHandle = PATH_FOLLOWER_NONE;
 }
 
 static void InitializePlayerControlComponent(PlayerControlComponent* component) {
@@ -7,6 +7,7 @@
 #include "../include/world.h"
 #include "../include/constants.h"
 #include "../include/entity_types.h"
+#include "../include/spatial_grid.h"
 
 BEGIN_EXTERNAL_WARNINGS
 
@@ -77,6 +78,8 @@ void DestroyEntityPool(EntityPool* pool) {
         free(pool->entities);
     }
     
+    DestroySpatialGrid(pool->drawGrid);
+    free(pool->drawPositions);
     free(pool);
 }
 
@@ -86,6 +89,7 @@ Entity* CreateEntity(EntityPool* pool, EntityType type, Vector2 position) {
     Entity* entity = &pool->entities[pool->count++];
     memset(entity, 0, sizeof(Entity));
     
+    entity->id = ++pool->nextEntityId;
     entity->type = type;
     entity->position = position;
     entity->active = true;
@@ -147,6 +151,7 @@ void RemoveEntity(EntityPool* pool, Entity* entity) {
     }
     
     pool->count--;
+    pool->indexedCount = 0;
 }
 
 void UpdateEntityPool(EntityPool* pool, World* world, float deltaTime) {
@@ -171,6 +176,81 @@ void DrawEntityPool(EntityPool* pool) {
     }
 }
 
+static void DrawPoolEntity(Entity* entity) {
+    if (entity->active && entity->visible && entity->Draw) entity->Draw(entity);
+}
+
+bool IndexEntityPool(EntityPool* pool, Rectangle worldBounds) {
+    if (!pool) return false;
+    pool->indexedCount = 0;
+
+    // Cells line up with map chunks, so a viewport's chunk range is a cell range
+    float cellSize = (float)(CACHE_CHUNK_SIZE * TILE_SIZE);
+    SpatialGrid* grid = pool->drawGrid;
+    if (grid && (grid->bounds.x != worldBounds.x || grid->bounds.y != worldBounds.y ||
+                 grid->bounds.width != worldBounds.width || grid->bounds.height != worldBounds.height)) {
+        DestroySpatialGrid(grid);
+        pool->drawGrid = NULL;
+    }
+    if (!pool->drawGrid) {
+        pool->drawGrid = CreateSpatialGrid(worldBounds, cellSize);
+        if (!pool->drawGrid) return false;
+    }
+
+    if (pool->count > pool->drawCapacity) {
+        Vector2* positions = (Vector2*)realloc(pool->drawPositions, pool->capacity * sizeof(Vector2));
+        if (!positions) return false;
+        pool->drawPositions = positions;
+        pool->drawCapacity = pool->capacity;
+    }
+
+    for (size_t i = 0; i < pool->count; i++) {
+        pool->drawPositions[i] = pool->entities[i].position;
+    }
+    if (!BuildSpatialGrid(pool->drawGrid, pool->drawPositions, (int)pool->count)) return false;
+
+    pool->indexedCount = pool->count;
+    return true;
+}
+
+void DrawEntityPoolInView(EntityPool* pool, const Viewport* viewport) {
+    if (!pool) return;
+    if (!viewport || !pool->drawGrid || pool->indexedCount == 0) {
+        DrawEntityPool(pool);
+        return;
+    }
+
+    // One extra ring of chunks covers sprites overhanging their chunk and
+    // movement since the index was built. Entities outside the world were
+    // clamped into the border chunks, and so are views past it, so nothing
+    // in view is ever skipped.
+    const SpatialGrid* grid = pool->drawGrid;
+    Rectangle view = viewport->bounds;
+    int minX = GetSpatialGridCellX(grid, view.x) - 1;
+    int minY = GetSpatialGridCellY(grid, view.y) - 1;
+    int maxX = GetSpatialGridCellX(grid, view.x + view.width) + 1;
+    int maxY = GetSpatialGridCellY(grid, view.y + view.height) + 1;
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX >= grid->columns) maxX = grid->columns - 1;
+    if (maxY >= grid->rows) maxY = grid->rows - 1;
+
+    for (int y = minY; y <= maxY; y++) {
+        for (int x = minX; x <= maxX; x++) {
+            int cell = y * grid->columns + x;
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+                size_t index = (size_t)grid->cellItems[k];
+                if (index < pool->count) DrawPoolEntity(&pool->entities[index]);
+            }
+        }
+    }
+
+    // Entities created since the index was built
+    for (size_t i = pool->indexedCount; i < pool->count; i++) {
+        DrawPoolEntity(&pool->entities[i]);
+    }
+}
+
 Entity* GetEntityAt(EntityPool* pool, Vector2 position, float radius) {
     if (!pool) return NULL;
     
@@ -381,6 +461,7 @@ PoolStatus GrowPool(EntityPool* pool) {
 
 void CompactPool(EntityPool* pool) {
     if (!pool) return;
+    pool->indexedCount = 0;
 
     size_t write = 0;
     for (size_t read = 0; read < pool->capacity; read++) {
@@ -406,6 +487,7 @@ void ClearPool(EntityPool* pool) {
     }
 
     pool->count = 0;
+    pool->indexedCount = 0;
     pool->status = POOL_OK;
 }
 
@@ -16,6 +16,8 @@ END_EXTERNAL_WARNINGS
 #include "../include/entities/player.h"
 #include "../include/entities/npc.h"
 #include "../include/sound_manager.h"
+#include "../include/job_system.h"
+#include "../include/animation.h"
 #include "../include/constants.h"
 #include <stdlib.h>
 
@@ -206,6 +208,8 @@ void Game_Unload(void) {
     // Unload systems
     UnloadSoundManager();
     UnloadResourceManager();
+    UnloadJobSystem();
+    UnloadAnimationLibrary();
     
     // Free game structure
     free(g_game);
@@ -3,6 +3,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include "../include/world.h"
+#include "../include/tile_grid.h"
+#include "../include/chunk_cache.h"
+#include "../include/collision_grid.h"
+#include "../include/map_file.h"
 
 // Add size type safety
 #define SAFE_SIZE_T(x) ((x) > SIZE_MAX ? SIZE_MAX : (x))
@@ -17,42 +21,36 @@ MapSystem* CreateMapSystem(void) {
 
     mapSystem->currentMap = NULL;
     mapSystem->collisionGrid = NULL;
-    mapSystem->layers = NULL;
-    mapSystem->layerCount = 0;
+    mapSystem->world = NULL;
+    mapSystem->chunkCacheSize = DEFAULT_CHUNK_CACHE_SIZE;
+    mapSystem->savePath[0] = '\0';
+    memset(&mapSystem->save, 0, sizeof(mapSystem->save));
+    if (!InitAnimatedTileIndex(&mapSystem->animatedTiles)) {
+        free(mapSystem);
+        return NULL;
+    }
     return mapSystem;
 }
 
 void DestroyMapSystem(MapSystem* mapSystem) {
     if (!mapSystem) return;
 
+    // Let a save running on a worker land before its map goes
+    FinishMapSave(mapSystem);
+
     // Unload current map with boundary check
     if (mapSystem->currentMap) {
-        if (mapSystem->currentMap->tiles) {
-            free(mapSystem->currentMap->tiles);
-        }
-        if (mapSystem->currentMap->properties) {
-            free(mapSystem->currentMap->properties);
-        }
+        CloseMapFile(mapSystem->currentMap->source);
+        free(mapSystem->currentMap->decodedChunks);
+        free(mapSystem->currentMap->unsavedChunks);
+        FreeTileGrid(&mapSystem->currentMap->tiles);
+        FreeMapLayers(mapSystem->currentMap);
         free(mapSystem->currentMap);
     }
 
-    // Free collision grid
-    if (mapSystem->collisionGrid) {
-        if (mapSystem->collisionGrid->cells) {
-            free(mapSystem->collisionGrid->cells);
-        }
-        free(mapSystem->collisionGrid);
-    }
-
-    // Free render layers
-    if (mapSystem->layers) {
-        for (int i = 0; i < mapSystem->layerCount; i++) {
-            UnloadTexture(mapSystem->layers[i].background);
-            UnloadTexture(mapSystem->layers[i].foreground);
-            UnloadTexture(mapSystem->layers[i].objects);
-        }
-        free(mapSystem->layers);
-    }
+    // Free collision grid and animated object index
+    DestroyCollisionGrid(mapSystem->collisionGrid);
+    FreeAnimatedTileIndex(&mapSystem->animatedTiles);
 
     free(mapSystem);
 }
@@ -61,44 +59,27 @@ bool LoadMap(MapSystem* mapSystem, const char* fileName) {
     if (!mapSystem || !fileName) return false;
 
     // Create new map
-    mapSystem->currentMap = (TileMap*)malloc(sizeof(TileMap));
+    mapSystem->currentMap = (TileMap*)calloc(1, sizeof(TileMap));
     if (!mapSystem->currentMap) return false;
 
     // Initialize map properties
     mapSystem->currentMap->width = ESTATE_WIDTH;
     mapSystem->currentMap->height = ESTATE_HEIGHT;
-    mapSystem->currentMap->tiles = (Tile*)calloc(ESTATE_WIDTH * ESTATE_HEIGHT, sizeof(Tile));
-    mapSystem->currentMap->properties = (TileProperties*)calloc(TILE_COUNT, sizeof(TileProperties));
-
-    if (!mapSystem->currentMap->tiles || !mapSystem->currentMap->properties) {
+    if (!InitTileGrid(&mapSystem->currentMap->tiles, ESTATE_WIDTH * ESTATE_HEIGHT, TILE_NONE) ||
+        !InitMapLayers(mapSystem->currentMap, mapSystem->chunkCacheSize)) {
         DestroyMapSystem(mapSystem);
         return false;
     }
 
-    // Initialize collision grid
-    mapSystem->collisionGrid = (CollisionGrid*)malloc(sizeof(CollisionGrid));
+    // Initialize collision grid, one bit per tile
+    mapSystem->collisionGrid = CreateCollisionGrid(ESTATE_WIDTH, ESTATE_HEIGHT, TILE_SIZE);
     if (!mapSystem->collisionGrid) {
         DestroyMapSystem(mapSystem);
         return false;
     }
-
-    mapSystem->collisionGrid->width = ESTATE_WIDTH;
-    mapSystem->collisionGrid->height = ESTATE_HEIGHT;
-    mapSystem->collisionGrid->cellSize = TILE_SIZE;
-    mapSystem->collisionGrid->cells = (bool*)calloc(ESTATE_WIDTH * ESTATE_HEIGHT, sizeof(bool));
-
-    if (!mapSystem->collisionGrid->cells) {
-        DestroyMapSystem(mapSystem);
-        return false;
-    }
-
-    // Initialize render layers
-    mapSystem->layers = (RenderLayer*)calloc(MAX_LAYERS, sizeof(RenderLayer));
-    if (!mapSystem->layers) {
-        DestroyMapSystem(mapSystem);
-        return false;
-    }
-    mapSystem->layerCount = MAX_LAYERS;
+    RebuildCollisionGrid(mapSystem->collisionGrid, &mapSystem->currentMap->tiles);
+    RebuildAnimatedTileIndex(&mapSystem->animatedTiles, &mapSystem->currentMap->tiles,
+                             ESTATE_WIDTH, ESTATE_HEIGHT);
 
     return true;
 }
@@ -109,20 +90,3 @@ void UpdateMapSystem(World* world, float deltaTime) {
     
     // Update map state if needed
 }
-
-void RenderMapLayers(MapSystem* mapSystem) {
-    if (!mapSystem || !mapSystem->currentMap || !mapSystem->layers) return;
-
-    for (int i = 0; i < mapSystem->layerCount; i++) {
-        RenderLayer* layer = &mapSystem->layers[i];
-        if (layer->background.id > 0) {
-            DrawTexture(layer->background, 0, 0, WHITE);
-        }
-        if (layer->foreground.id > 0) {
-            DrawTexture(layer->foreground, 0, 0, WHITE);
-        }
-        if (layer->objects.id > 0) {
-            DrawTexture(layer->objects, 0, 0, WHITE);
-        }
-    }
-} 
\ No newline at end of file
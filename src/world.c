@@ -24,6 +24,20 @@ END_EXTERNAL_WARNINGS
 
 #include "../../include/texture_atlas.h"
 #include "../../include/resource_manager.h"
+#include "../../include/job_system.h"
+#include "../../include/entities/crowd.h"
+#include "../../include/entities/perception.h"
+#include "../../include/entities/animator.h"
+#include "../../include/entities/movement.h"
+#include "../../include/entities/player.h"
+#include "../../include/pathfinding.h"
+#include "../../include/tile_grid.h"
+#include "../../include/random.h"
+#include "../../include/world_stream.h"
+#include "../../include/chunk_renderer.h"
+#include "../../include/collision_grid.h"
+#include "../../include/region_map.h"
+#include "../../include/resonance_field.h"
 
 #define MAX_TILES_PER_ATLAS 256
 #define ATLAS_PADDING 1
@@ -68,6 +82,8 @@ BEGIN_EXTERNAL_WARNINGS
 
 // Function declarations with proper parameter lists
 static void UpdateWorldState(World* world, float deltaTime);
+static void CreateWorldSystems(World* world);
+static void DestroyWorldSystems(World* world);
 static void RenderWorld(const World* world);
 EntityPool* CreateEntityPool(size_t initialCapacity);
 
@@ -79,6 +95,11 @@ World* CreateWorld(int width, int height, float gravity, ResourceManager* resour
     world->height = height;
     world->gravity = gravity;
     world->resourceManager = resourceManager;
+    world->tiles = (TileGrid){ 0 };
+    world->collision = NULL;
+    CreateWorldSystems(world);
+    world->seed = WORLD_DEFAULT_SEED;
+    world->tick = 0;
     
     world->camera = (Camera2D){
         .target = (Vector2){ 0, 0 },
@@ -100,47 +121,103 @@ void DestroyWorld(World* world) {
     
     // Free memory
     if (world->entityPool) DestroyEntityPool(world->entityPool);
+    DestroyWorldSystems(world);
     if (world->tileProperties) free(world->tileProperties);
-    if (world->tiles) free(world->tiles);
     
     // Note: Don't destroy the resource manager here as it's managed externally
     
     free(world);
 }
 
+// The per-frame systems UpdateWorld drives. Lazily built state (path graph,
+// regions, resonance, stream) starts empty and is created on first use.
+static void CreateWorldSystems(World* world) {
+    world->crowd = CreateCrowdSystem((Rectangle){ 0, 0, (float)(world->width * TILE_SIZE), (float)(world->height * TILE_SIZE) }, NULL);
+    world->perception = CreatePerceptionSystem();
+    world->pathGraph = NULL;
+    world->paths = NULL;
+    world->regions = NULL;
+    world->resonance = NULL;
+    world->animation = CreateAnimationSystem(GetAnimationLibrary());
+    world->movement = CreateMovementSystem();
+    world->stream = NULL;
+    world->renderer = CreateChunkRenderer(DEFAULT_CHUNK_CACHE_SIZE);
+}
+
+// Frees the systems along with the tiles and collision bitmap they read
+static void DestroyWorldSystems(World* world) {
+    if (world->crowd) DestroyCrowdSystem(world->crowd);
+    if (world->perception) DestroyPerceptionSystem(world->perception);
+    if (world->pathGraph) DestroyHPAGraph(world->pathGraph);
+    if (world->paths) DestroyPathFollowerTable(world->paths);
+    if (world->regions) DestroyRegionMap(world->regions);
+    if (world->resonance) DestroyResonanceField(world->resonance);
+    if (world->animation) DestroyAnimationSystem(world->animation);
+    if (world->movement) DestroyMovementSystem(world->movement);
+    if (world->stream) DestroyWorldStream(world->stream);
+    if (world->renderer) DestroyChunkRenderer(world->renderer);
+    FreeTileGrid(&world->tiles);
+    DestroyCollisionGrid(world->collision);
+}
+
+bool EnableWorldStreaming(World* world, const char* directory) {
+    if (!world) return false;
+    if (world->stream) return true;
+
+    world->stream = CreateWorldStream(directory, STREAM_DEFAULT_RADIUS, STREAM_DEFAULT_MAX_CHUNKS, NULL, NULL);
+    if (!world->stream) return false;
+
+    // The fixed grid is no longer authoritative
+    FreeTileGrid(&world->tiles);
+    DestroyCollisionGrid(world->collision);
+    world->collision = NULL;
+    InvalidateChunkRenderer(world->renderer);
+    return true;
+}
+
 void SetTileAt(World* world, int x, int y, Tile tile) {
-    if (!world || !world->tiles || x < 0 || x >= world->width || y < 0 || y >= world->height) return;
-    world->tiles[y * world->width + x] = tile;
+    if (world && world->stream) {
+        if (SetStreamTile(world->stream, x, y, tile)) OnTileChanged(world, x, y);
+        return;
+    }
+    if (!world || !world->tiles.types || x < 0 || x >= world->width || y < 0 || y >= world->height) return;
+    SetGridTile(&world->tiles, (size_t)(y * world->width + x), tile);
+    OnTileChanged(world, x, y);
 }
 
 Tile GetTileAt(World* world, int x, int y) {
-    if (!world || !world->tiles || x < 0 || x >= world->width || y < 0 || y >= world->height) {
+    if (world && world->stream) return GetStreamTile(world->stream, x, y);
+    if (!world || !world->tiles.types || x < 0 || x >= world->width || y < 0 || y >= world->height) {
         Tile emptyTile = {TILE_NONE, OBJECT_NONE};
         return emptyTile;
     }
-    return world->tiles[y * world->width + x];
+    return GetGridTile(&world->tiles, (size_t)(y * world->width + x));
 }
 
 void SetTile(World* world, int x, int y, TileType tileType) {
-    if (!world || !world->tiles || x < 0 || x >= world->width || y < 0 || y >= world->height) return;
-    Tile* tile = &world->tiles[y * world->width + x];
-    tile->type = tileType;
+    if (world && world->stream) {
+        SetTileAt(world, x, y, CreateTile(tileType, GetStreamTile(world->stream, x, y).objectType));
+        return;
+    }
+    if (!world || !world->tiles.types || x < 0 || x >= world->width || y < 0 || y >= world->height) return;
+    world->tiles.types[y * world->width + x] = (uint8_t)tileType;
+    OnTileChanged(world, x, y);
 }
 
 TileType GetTile(World* world, int x, int y) {
-    if (!world || !world->tiles || x < 0 || x >= world->width || y < 0 || y >= world->height) {
+    if (world && world->stream) return GetStreamTile(world->stream, x, y).type;
+    if (!world || !world->tiles.types || x < 0 || x >= world->width || y < 0 || y >= world->height) {
         return TILE_NONE;
     }
-    return world->tiles[y * world->width + x].type;
+    return GetGridTileType(&world->tiles, (size_t)(y * world->width + x));
 }
 
 bool IsWalkable(World* world, int x, int y) {
-    if (!world || !world->tiles || x < 0 || x >= world->width || y < 0 || y >= world->height) {
+    if (!world || !world->tiles.types || x < 0 || x >= world->width || y < 0 || y >= world->height) {
         return false;
     }
     
-    TileType type = world->tiles[y * world->width + x].type;
-    return type != TILE_WALL && type != TILE_WATER;
+    return IsWalkableGrid(world, x, y);
 }
 
 void AddSpawnPoint(World* world, Vector2 position) {
@@ -148,11 +225,14 @@ void AddSpawnPoint(World* world, Vector2 position) {
     world->spawnPoints[world->spawnPointCount++] = position;
 }
 
-Vector2 GetRandomSpawnPoint(World* world) {
+Vector2 GetRandomSpawnPoint(World* world, uint32_t spawnIndex) {
     if (!world || world->spawnPointCount == 0) {
         return (Vector2){ 0, 0 };
     }
-    return world->spawnPoints[rand() % world->spawnPointCount];
+
+    // Keyed by spawn index so batched spawns within a tick differ
+    RandomStream rng = CreateEntityRandomStream(world->seed, spawnIndex, RANDOM_PURPOSE_SPAWN, world->tick);
+    return world->spawnPoints[NextRandomInt(&rng, 0, world->spawnPointCount - 1)];
 }
 
 void DrawWorldDebug(World* world) {
@@ -201,10 +281,23 @@ WorldState* CreateWorldState(void) {
     }
     
     // Initialize world properties
+    state->world->width = WORLD_WIDTH;
+    state->world->height = WORLD_HEIGHT;
     state->world->dimensions = (Vector2){WORLD_WIDTH * TILE_SIZE, WORLD_HEIGHT * TILE_SIZE};
     state->world->gravity = GRAVITY;
     state->world->friction = 0.8f;
     state->world->spawnPointCount = 0;
+    state->world->seed = WORLD_DEFAULT_SEED;
+    
+    // Initialize the systems UpdateWorld drives
+    CreateWorldSystems(state->world);
+    if (!state->world->crowd || !state->world->perception || !state->world->animation ||
+        !state->world->movement || !state->world->renderer) {
+        DestroyWorldSystems(state->world);
+        free(state->world);
+        free(state);
+        return NULL;
+    }
     
     // Initialize camera
     state->camera = (Camera2D){
@@ -217,6 +310,7 @@ WorldState* CreateWorldState(void) {
     // Initialize resource manager
     state->textureManager = CreateResourceManager();
     if (!state->textureManager) {
+        DestroyWorldSystems(state->world);
         free(state->world);
         free(state);
         return NULL;
@@ -226,6 +320,7 @@ WorldState* CreateWorldState(void) {
     state->entityPool = CreateEntityPool((size_t)MAX_ENTITIES);
     if (!state->entityPool) {
         DestroyResourceManager(state->textureManager);
+        DestroyWorldSystems(state->world);
         free(state->world);
         free(state);
         return NULL;
@@ -236,6 +331,7 @@ WorldState* CreateWorldState(void) {
     if (!state->registry) {
         DestroyEntityPool(state->entityPool);
         DestroyResourceManager(state->textureManager);
+        DestroyWorldSystems(state->world);
         free(state->world);
         free(state);
         return NULL;
@@ -247,10 +343,13 @@ WorldState* CreateWorldState(void) {
         DestroyComponentRegistry(state->registry);
         DestroyEntityPool(state->entityPool);
         DestroyResourceManager(state->textureManager);
+        DestroyWorldSystems(state->world);
         free(state->world);
         free(state);
         return NULL;
     }
+    state->mapSystem->world = state->world;
+    state->world->mapSystem = state->mapSystem;
     
     return state;
 }
@@ -275,6 +374,7 @@ void DestroyWorldState(WorldState* state) {
     }
     
     if (state->world) {
+        DestroyWorldSystems(state->world);
         free(state->world);
     }
     
@@ -305,6 +405,7 @@ void UnloadWorldState(WorldState* state) {
     }
     
     if (state->world) {
+        DestroyWorldSystems(state->world);
         free(state->world);
         state->world = NULL;
     }
@@ -331,6 +432,7 @@ void DestroyWorldStateAndResources(WorldState* state) {
     }
     
     if (state->world) {
+        DestroyWorldSystems(state->world);
         free(state->world);
     }
     
@@ -340,11 +442,44 @@ void DestroyWorldStateAndResources(WorldState* state) {
 void UpdateWorld(WorldState* state, float deltaTime) {
     if (!state || !state->world) return;
 
+    // Keep the chunks around the camera and player resident, and start
+    // loading where the camera is heading
+    if (state->world->stream) {
+        Vector2 focus[3] = { state->camera.target, GetPlayerPosition(state->world) };
+        int focusCount = 2;
+        if (state->world->renderer && state->world->renderer->prefetch.hasView) {
+            focus[focusCount++] = GetChunkPrefetchFocus(&state->world->renderer->prefetch);
+        }
+        UpdateWorldStream(state->world->stream, focus, focusCount);
+    }
+
+    // Spread resonance into the chunks that emitter and wall edits touched
+    UpdateResonanceField(GetWorldResonance(state->world));
+
+    // Perceive before any AI decisions are made
+    UpdatePerception(state->world->perception, state->entityPool, GetPlayerPosition(state->world));
+
+    // Steer the crowd before entities move
+    UpdateCrowdSteering(state->world->crowd, state->entityPool, state->world, GetJobSystem());
+
     // Update entity pool
     UpdateEntityPool(state->entityPool, state->world, deltaTime);
 
+    // Sweep every mover through the tiles on the fixed step
+    UpdateMovementSystem(state->world->movement, state->entityPool, state->world, GetJobSystem(), deltaTime);
+
+    // Advance every animator once entities have picked their clips
+    UpdateAnimationSystem(state->world->animation, state->entityPool, deltaTime);
+
+    // Positions are final for the frame, so bin entities for drawing
+    IndexEntityPool(state->entityPool, (Rectangle){ 0.0f, 0.0f,
+                    (float)(state->world->width * TILE_SIZE), (float)(state->world->height * TILE_SIZE) });
+
     // Update map system
     UpdateMapSystem(state->mapSystem, deltaTime);
+
+    // Advance the clock that keys per-entity random streams
+    state->world->tick++;
 }
 
 void DrawWorld(WorldState* state) {
@@ -356,8 +491,12 @@ void DrawWorld(WorldState* state) {
     // Draw map
     DrawMapSystem(state->mapSystem);
     
-    // Draw entities
-    DrawEntityPool(state->entityPool);
+    // Draw entities on screen, found through the chunk index
+    Viewport viewport = GetCameraViewport(state->camera);
+    DrawEntityPoolInView(state->entityPool, &viewport);
+    
+    // Canopies and overlays go over entities
+    DrawMapOverhead(state->mapSystem);
     
     EndMode2D();
 }
@@ -409,6 +548,9 @@ void UnloadWorld(World* world) {
         world->entityPool = NULL;
     }
     
+    // Unload the per-frame systems, tiles and collision bitmap
+    DestroyWorldSystems(world);
+    
     // Unload resource manager
     if (world->resourceManager) {
         DestroyResourceManager(world->resourceManager);
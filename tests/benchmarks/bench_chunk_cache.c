@@ -0,0 +1,153 @@
+// Chunk cache benchmark: sweeps a camera across a large map and times the
+// per-frame visible chunk lookups against the previous linear-scan cache.
+//
+// Usage: bench_chunk_cache [cacheSize]
+
+#include "../../include/chunk_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_MAP_CHUNKS 256           // 4096x4096 tiles
+#define BENCH_VIEW_CHUNKS_X 6          // 1600x900 view at 1x zoom, plus the partial edge
+#define BENCH_VIEW_CHUNKS_Y 4
+#define BENCH_SWEEP_STEP 8.0f          // Camera pixels per frame
+#define BENCH_SWEEP_ROWS 16
+
+// The cache as it was: fixed array, float keys, scans for lookup and eviction
+typedef struct LinearCache {
+    CachedChunk* chunks;
+    int capacity;
+    int chunkCount;
+    int frameCounter;
+} LinearCache;
+
+static CachedChunk* LinearFind(LinearCache* cache, float x, float y) {
+    for (int i = 0; i < cache->chunkCount; i++) {
+        if (cache->chunks[i].gridPosition.x == x && cache->chunks[i].gridPosition.y == y) {
+            cache->chunks[i].lastAccessTime = cache->frameCounter;
+            return &cache->chunks[i];
+        }
+    }
+    return NULL;
+}
+
+static void LinearInsert(LinearCache* cache, float x, float y) {
+    if (cache->chunkCount >= cache->capacity) {
+        int oldest = 0;
+        for (int i = 1; i < cache->chunkCount; i++) {
+            if (cache->chunks[i].lastAccessTime < cache->chunks[oldest].lastAccessTime) oldest = i;
+        }
+        cache->chunks[oldest] = cache->chunks[--cache->chunkCount];
+    }
+
+    CachedChunk chunk = { 0 };
+    chunk.gridPosition = (Vector2){ x, y };
+    chunk.lastAccessTime = cache->frameCounter;
+    cache->chunks[cache->chunkCount++] = chunk;
+}
+
+static double Seconds(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+typedef struct SweepResult {
+    double seconds;
+    long lookups;
+    long misses;
+} SweepResult;
+
+#define BENCH_CHUNK_PIXELS (CACHE_CHUNK_SIZE * TILE_SIZE)
+#define BENCH_FRAMES_PER_ROW ((int)(BENCH_MAP_CHUNKS * BENCH_CHUNK_PIXELS / BENCH_SWEEP_STEP))
+#define BENCH_FRAME_COUNT (BENCH_FRAMES_PER_ROW * BENCH_SWEEP_ROWS)
+
+// Serpentine sweeps over the whole map, returns the top-left visible chunk
+static void GetSweepWindow(int frame, int* startX, int* startY) {
+    int row = frame / BENCH_FRAMES_PER_ROW;
+    float camera = (float)(frame % BENCH_FRAMES_PER_ROW) * BENCH_SWEEP_STEP;
+    if (row % 2) camera = BENCH_MAP_CHUNKS * BENCH_CHUNK_PIXELS - camera;
+
+    *startX = (int)(camera / BENCH_CHUNK_PIXELS);
+    *startY = row * (BENCH_MAP_CHUNKS / BENCH_SWEEP_ROWS);
+}
+
+static SweepResult RunHashedSweep(int capacity) {
+    SweepResult result = { 0 };
+    ChunkCache cache;
+    if (!InitChunkCache(&cache, capacity)) return result;
+
+    double start = Seconds();
+    for (int frame = 0; frame < BENCH_FRAME_COUNT; frame++) {
+        int startX, startY;
+        GetSweepWindow(frame, &startX, &startY);
+        for (int y = startY; y < startY + BENCH_VIEW_CHUNKS_Y; y++) {
+            for (int x = startX; x < startX + BENCH_VIEW_CHUNKS_X; x++) {
+                CachedChunk* chunk = FindCachedChunk(&cache, x, y);
+                if (chunk) {
+                    TouchCachedChunk(&cache, chunk);
+                } else {
+                    InsertCachedChunk(&cache, x, y);
+                    result.misses++;
+                }
+                result.lookups++;
+            }
+        }
+        cache.frameCounter++;
+    }
+    result.seconds = Seconds() - start;
+
+    FreeChunkCache(&cache);
+    return result;
+}
+
+static SweepResult RunLinearSweep(int capacity) {
+    SweepResult result = { 0 };
+    LinearCache cache = { 0 };
+    cache.capacity = capacity;
+    cache.chunks = (CachedChunk*)calloc((size_t)capacity, sizeof(CachedChunk));
+    if (!cache.chunks) return result;
+
+    double start = Seconds();
+    for (int frame = 0; frame < BENCH_FRAME_COUNT; frame++) {
+        int startX, startY;
+        GetSweepWindow(frame, &startX, &startY);
+        for (int y = startY; y < startY + BENCH_VIEW_CHUNKS_Y; y++) {
+            for (int x = startX; x < startX + BENCH_VIEW_CHUNKS_X; x++) {
+                if (!LinearFind(&cache, (float)x, (float)y)) {
+                    LinearInsert(&cache, (float)x, (float)y);
+                    result.misses++;
+                }
+                result.lookups++;
+            }
+        }
+        cache.frameCounter++;
+    }
+    result.seconds = Seconds() - start;
+
+    free(cache.chunks);
+    return result;
+}
+
+static void PrintResult(const char* name, int capacity, SweepResult result) {
+    double nsPerLookup = result.lookups > 0 ? result.seconds * 1e9 / (double)result.lookups : 0.0;
+    printf("%-8s cache=%-5d lookups=%-9ld misses=%-7ld time=%7.3f ms  %6.1f ns/lookup\n",
+           name, capacity, result.lookups, result.misses, result.seconds * 1e3, nsPerLookup);
+}
+
+int main(int argc, char** argv) {
+    int sizes[] = { DEFAULT_CHUNK_CACHE_SIZE, 256, 1024 };
+    int sizeCount = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    if (argc > 1) {
+        sizes[0] = atoi(argv[1]);
+        sizeCount = 1;
+    }
+
+    printf("Camera sweeps over a %dx%d chunk map, %dx%d visible chunks\n",
+           BENCH_MAP_CHUNKS, BENCH_MAP_CHUNKS, BENCH_VIEW_CHUNKS_X, BENCH_VIEW_CHUNKS_Y);
+    for (int i = 0; i < sizeCount; i++) {
+        PrintResult("hashed", sizes[i], RunHashedSweep(sizes[i]));
+        PrintResult("linear", sizes[i], RunLinearSweep(sizes[i]));
+    }
+
+    return 0;
+}
@@ -17,6 +17,25 @@ int run_map_tests(void);
 int run_memory_tests(void);
 int run_integration_tests(void);
 int run_texture_manager_tests(void);
+int run_crowd_tests(void);
+int run_random_tests(void);
+int run_perception_tests(void);
+int run_pathfinding_tests(void);
+int run_animation_tests(void);
+int run_tile_grid_tests(void);
+int run_chunk_cache_tests(void);
+int run_world_stream_tests(void);
+int run_collision_grid_tests(void);
+int run_movement_tests(void);
+int run_animated_tiles_tests(void);
+int run_tile_mesh_tests(void);
+int run_map_file_tests(void);
+int run_region_map_tests(void);
+int run_entity_culling_tests(void);
+int run_chunk_prefetch_tests(void);
+int run_tile_lod_tests(void);
+int run_resonance_field_tests(void);
+int run_property_store_tests(void);
 
 // Test utilities
 void setup_test_environment(void);
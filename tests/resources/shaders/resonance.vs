@@ -4,6 +4,7 @@
 in vec3 vertexPosition;
 in vec2 vertexTexCoord;
 in vec4 vertexColor;
+in vec2 vertexTexCoord2;    // x: baked resonance field level, 0 when the mesh has none
 
 // Input uniform values
 uniform mat4 mvp;
@@ -33,7 +34,8 @@ void main() {
     vec3 resonatedPosition = vec3(pos + offset, vertexPosition.z);
     
     // Calculate resonance intensity for fragment shader
-    resonanceIntensity = amplitude * (wave * 0.5 + 0.5);
+    // Tiles near fountains and torches glow at least as much as the field says
+    resonanceIntensity = max(amplitude * (wave * 0.5 + 0.5), vertexTexCoord2.x);
     
     // Calculate final vertex position
     gl_Position = mvp * vec4(resonatedPosition, 1.0);
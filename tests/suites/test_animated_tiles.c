@@ -0,0 +1,99 @@
+#include "../include/test_suites.h"
+#include "../../include/animated_tiles.h"
+#include "../../include/tile_grid.h"
+#include <stdio.h>
+
+#define ANIMATED_TEST_WIDTH 40
+#define ANIMATED_TEST_HEIGHT 24
+
+static int test_animated_index_edits(void) {
+    printf("Testing animated tile index edits...\n");
+
+    AnimatedTileIndex index;
+    TEST_TRUE(InitAnimatedTileIndex(&index));
+
+    // Only animated objects are recorded, each in its own chunk bucket
+    TEST_TRUE(SetAnimatedTile(&index, 3, 4, OBJECT_TORCH));
+    TEST_TRUE(SetAnimatedTile(&index, 20, 4, OBJECT_FOUNTAIN));
+    TEST_TRUE(SetAnimatedTile(&index, 5, 5, OBJECT_TREE));
+    TEST_TRUE(SetAnimatedTile(&index, -1, -1, OBJECT_TORCH));
+    TEST_EQUAL(index.count, 3);
+    TEST_EQUAL(index.chunkCount, 3);
+    TEST_NOT_NULL(FindAnimatedChunk(&index, -1, -1));
+    TEST_NULL(FindAnimatedChunk(&index, 5, 5));
+
+    // Setting the same tile again replaces its entry
+    TEST_TRUE(SetAnimatedTile(&index, 3, 4, OBJECT_FOUNTAIN));
+    TEST_EQUAL(index.count, 3);
+    AnimatedChunk* chunk = FindAnimatedChunk(&index, 0, 0);
+    TEST_NOT_NULL(chunk);
+    TEST_EQUAL(chunk->count, 1);
+    TEST_EQUAL(chunk->types[0], OBJECT_FOUNTAIN);
+
+    // Removal empties the bucket but keeps it
+    TEST_TRUE(SetAnimatedTile(&index, 3, 4, OBJECT_NONE));
+    TEST_TRUE(SetAnimatedTile(&index, 3, 4, OBJECT_NONE));
+    TEST_EQUAL(index.count, 2);
+    TEST_EQUAL(chunk->count, 0);
+
+    // Enough buckets to force the hash table to grow
+    for (int i = 0; i < 100; i++) {
+        TEST_TRUE(SetAnimatedTile(&index, i * CACHE_CHUNK_SIZE, 100 * CACHE_CHUNK_SIZE, OBJECT_TORCH));
+    }
+    TEST_EQUAL(index.count, 102);
+    for (int i = 0; i < 100; i++) {
+        TEST_NOT_NULL(FindAnimatedChunk(&index, i, 100));
+    }
+    TEST_NOT_NULL(FindAnimatedChunk(&index, 1, 0));
+
+    FreeAnimatedTileIndex(&index);
+    return TEST_PASSED;
+}
+
+static int test_animated_index_tick(void) {
+    printf("Testing animated tile ticks...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, ANIMATED_TEST_WIDTH * ANIMATED_TEST_HEIGHT, TILE_GRASS));
+    tiles.objects[2 * ANIMATED_TEST_WIDTH + 2] = OBJECT_FOUNTAIN;
+    tiles.objects[2 * ANIMATED_TEST_WIDTH + 9] = OBJECT_FOUNTAIN;
+    tiles.objects[20 * ANIMATED_TEST_WIDTH + 35] = OBJECT_TORCH;
+    tiles.objects[20 * ANIMATED_TEST_WIDTH + 36] = OBJECT_ROCK;
+
+    AnimatedTileIndex index;
+    TEST_TRUE(InitAnimatedTileIndex(&index));
+    TEST_TRUE(RebuildAnimatedTileIndex(&index, &tiles, ANIMATED_TEST_WIDTH, ANIMATED_TEST_HEIGHT));
+    TEST_EQUAL(index.count, 3);
+
+    // Untouched chunks keep their old values
+    TickAnimatedChunk(FindAnimatedChunk(&index, 0, 0), 1.25);
+    float first = GetAnimatedTileResonance(&index, 2, 2);
+    float second = GetAnimatedTileResonance(&index, 9, 2);
+    TEST_TRUE(first >= 0.0f && first <= 1.0f);
+    TEST_TRUE(first != second);
+    TEST_FLOAT_EQUAL(GetAnimatedTileResonance(&index, 35, 20), 0.0f);
+    TEST_FLOAT_EQUAL(GetAnimatedTileResonance(&index, 36, 20), 0.0f);
+
+    // Values depend only on tile and time
+    TickAnimatedChunk(FindAnimatedChunk(&index, 2, 1), 3.0);
+    float torch = GetAnimatedTileResonance(&index, 35, 20);
+    TEST_TRUE(torch >= 0.8f && torch <= 1.0f);
+    TickAnimatedChunk(FindAnimatedChunk(&index, 2, 1), 3.0);
+    TEST_FLOAT_EQUAL(GetAnimatedTileResonance(&index, 35, 20), torch);
+    TickAnimatedChunk(FindAnimatedChunk(&index, 0, 0), 1.25);
+    TEST_FLOAT_EQUAL(GetAnimatedTileResonance(&index, 2, 2), first);
+
+    FreeAnimatedTileIndex(&index);
+    FreeTileGrid(&tiles);
+    return TEST_PASSED;
+}
+
+int run_animated_tiles_tests(void) {
+    printf("\nRunning Animated Tiles Tests...\n");
+    int failures = 0;
+
+    failures += test_animated_index_edits();
+    failures += test_animated_index_tick();
+
+    return failures;
+}
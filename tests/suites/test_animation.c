@@ -0,0 +1,141 @@
+#include "../include/test_suites.h"
+#include "../../include/entity.h"
+#include "../../include/entity_pool.h"
+#include "../../include/animation.h"
+#include "../../include/entities/animator.h"
+#include <stdio.h>
+
+#define ANIMATION_TEST_METADATA "test_animations.txt"
+
+static Entity* CreateAnimatedEntity(EntityPool* pool, int clip) {
+    Entity* entity = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 0.0f, 0.0f });
+    if (!entity) return NULL;
+
+    AddComponent(entity, COMPONENT_RENDER);
+    AddComponent(entity, COMPONENT_ANIMATOR);
+    PlayAnimation(entity, clip);
+    return entity;
+}
+
+static int test_animation_library(void) {
+    printf("Testing animation clip library...\n");
+
+    AnimationLibrary* library = CreateAnimationLibrary();
+    TEST_NOT_NULL(library);
+
+    int walk = AddAnimationStrip(library, "walk", (Rectangle){ 0, 32, 16, 16 }, 4, 0.1f, true);
+    TEST_EQUAL(walk, 0);
+    TEST_EQUAL(FindAnimationClip(library, "walk"), walk);
+    TEST_EQUAL(FindAnimationClip(library, "run"), ANIMATION_NO_CLIP);
+
+    const AnimationClip* clip = GetAnimationClip(library, walk);
+    TEST_NOT_NULL(clip);
+    TEST_EQUAL(clip->frameCount, 4);
+    TEST_FLOAT_EQUAL(clip->totalDuration, 0.4f);
+    TEST_FLOAT_EQUAL(library->frames[clip->firstFrame + 3].source.x, 48.0f);
+
+    // Duplicate names and zero-length frames are rejected
+    TEST_EQUAL(AddAnimationStrip(library, "walk", (Rectangle){ 0, 0, 16, 16 }, 2, 0.1f, true), ANIMATION_NO_CLIP);
+    TEST_EQUAL(AddAnimationStrip(library, "still", (Rectangle){ 0, 0, 16, 16 }, 2, 0.0f, true), ANIMATION_NO_CLIP);
+
+    DestroyAnimationLibrary(library);
+    return TEST_PASSED;
+}
+
+static int test_animation_metadata(void) {
+    printf("Testing animation metadata loading...\n");
+
+    FILE* file = fopen(ANIMATION_TEST_METADATA, "w");
+    TEST_NOT_NULL(file);
+    fprintf(file, "# Test clips\n");
+    fprintf(file, "clip attack once\n");
+    fprintf(file, "frame 0 0 32 32 0.05\n");
+    fprintf(file, "frame 32 0 32 32 0.15\n");
+    fprintf(file, "\n");
+    fprintf(file, "clip walk loop\n");
+    fprintf(file, "strip 0 64 32 32 3 0.1\n");
+    fclose(file);
+
+    AnimationLibrary* library = CreateAnimationLibrary();
+    TEST_NOT_NULL(library);
+    TEST_TRUE(LoadAnimationClips(library, ANIMATION_TEST_METADATA));
+    remove(ANIMATION_TEST_METADATA);
+
+    TEST_EQUAL(library->clipCount, 2);
+    const AnimationClip* attack = GetAnimationClip(library, FindAnimationClip(library, "attack"));
+    const AnimationClip* walk = GetAnimationClip(library, FindAnimationClip(library, "walk"));
+    TEST_NOT_NULL(attack);
+    TEST_NOT_NULL(walk);
+    TEST_FALSE(attack->loop);
+    TEST_TRUE(walk->loop);
+    TEST_FLOAT_EQUAL(attack->totalDuration, 0.2f);
+    TEST_EQUAL(walk->frameCount, 3);
+    TEST_FLOAT_EQUAL(library->frames[walk->firstFrame + 2].source.x, 64.0f);
+    TEST_FALSE(LoadAnimationClips(library, "missing_animations.txt"));
+
+    DestroyAnimationLibrary(library);
+    return TEST_PASSED;
+}
+
+static int test_animation_fixed_step(void) {
+    printf("Testing batched fixed-step animation...\n");
+
+    AnimationLibrary* library = CreateAnimationLibrary();
+    TEST_NOT_NULL(library);
+    int walk = AddAnimationStrip(library, "walk", (Rectangle){ 0, 0, 32, 32 }, 4, 0.1f, true);
+    AnimationFrame attackFrames[] = {
+        { { 0, 32, 32, 32 }, 0.05f },
+        { { 32, 32, 32, 32 }, 0.05f }
+    };
+    int attack = AddAnimationClip(library, "attack", attackFrames, 2, false);
+
+    AnimationSystem* system = CreateAnimationSystem(library);
+    TEST_NOT_NULL(system);
+    EntityPool* pool = CreateEntityPool(8);
+    TEST_NOT_NULL(pool);
+
+    Entity* walker = CreateAnimatedEntity(pool, walk);
+    Entity* attacker = CreateAnimatedEntity(pool, attack);
+    TEST_NOT_NULL(walker);
+    TEST_NOT_NULL(attacker);
+
+    // Partial steps are banked until a whole step has elapsed
+    TEST_EQUAL(UpdateAnimationSystem(system, pool, ANIMATION_FIXED_STEP * 0.5f), 0);
+    TEST_EQUAL(UpdateAnimationSystem(system, pool, ANIMATION_FIXED_STEP * 0.6f), 1);
+
+    // Same total time in uneven slices lands every animator on the same frame
+    for (int i = 0; i < 9; i++) {
+        UpdateAnimationSystem(system, pool, ANIMATION_FIXED_STEP * (i % 2 ? 1.5f : 0.5f));
+    }
+    TEST_EQUAL(GetAnimatorComponent(walker)->frame, 1);
+    TEST_FLOAT_EQUAL(GetRenderComponent(walker)->sourceRect.x, 32.0f);
+
+    // One-shot clips hold their last frame and stop
+    TEST_FALSE(GetAnimatorComponent(attacker)->playing);
+    TEST_EQUAL(GetAnimatorComponent(attacker)->frame, 1);
+    TEST_FLOAT_EQUAL(GetRenderComponent(attacker)->sourceRect.x, 32.0f);
+    TEST_FLOAT_EQUAL(GetRenderComponent(attacker)->sourceRect.y, 32.0f);
+
+    // Looping clips wrap back to the start
+    for (int i = 0; i < 18; i++) {
+        UpdateAnimationSystem(system, pool, ANIMATION_FIXED_STEP);
+    }
+    TEST_EQUAL(GetAnimatorComponent(walker)->frame, 0);
+    TEST_FLOAT_EQUAL(GetRenderComponent(walker)->sourceRect.x, 0.0f);
+
+    DestroyEntityPool(pool);
+    DestroyAnimationSystem(system);
+    DestroyAnimationLibrary(library);
+    return TEST_PASSED;
+}
+
+int run_animation_tests(void) {
+    printf("\nRunning Animation Tests...\n");
+    int failures = 0;
+
+    failures += test_animation_library();
+    failures += test_animation_metadata();
+    failures += test_animation_fixed_step();
+
+    return failures;
+}
@@ -0,0 +1,163 @@
+#include "../include/test_suites.h"
+#include "../../include/chunk_cache.h"
+#include "../../include/random.h"
+#include <stdio.h>
+
+#define CHUNK_TEST_CAPACITY 8
+
+static int test_chunk_cache_lookup(void) {
+    printf("Testing chunk cache lookup...\n");
+
+    ChunkCache cache;
+    TEST_TRUE(InitChunkCache(&cache, CHUNK_TEST_CAPACITY));
+    TEST_NULL(FindCachedChunk(&cache, 0, 0));
+
+    CachedChunk* chunk = InsertCachedChunk(&cache, -3, 5);
+    TEST_NOT_NULL(chunk);
+    TEST_TRUE(chunk->isDirty);
+    TEST_FLOAT_EQUAL(chunk->bounds.x, -3.0f * CACHE_CHUNK_SIZE * TILE_SIZE);
+    TEST_TRUE(FindCachedChunk(&cache, -3, 5) == chunk);
+    TEST_NULL(FindCachedChunk(&cache, 5, -3));
+
+    // Inserting a cached key returns the existing chunk
+    TEST_TRUE(InsertCachedChunk(&cache, -3, 5) == chunk);
+    TEST_EQUAL(cache.chunkCount, 1);
+
+    FreeChunkCache(&cache);
+    return TEST_PASSED;
+}
+
+static int test_chunk_cache_lru(void) {
+    printf("Testing chunk cache LRU eviction...\n");
+
+    ChunkCache cache;
+    TEST_TRUE(InitChunkCache(&cache, CHUNK_TEST_CAPACITY));
+
+    for (int i = 0; i < CHUNK_TEST_CAPACITY; i++) {
+        CachedChunk* chunk = InsertCachedChunk(&cache, i, 0);
+        TEST_NOT_NULL(chunk);
+        chunk->texture.id = (unsigned int)(100 + i);
+    }
+
+    // Touching the oldest chunk protects it, so (1, 0) goes next
+    TouchCachedChunk(&cache, FindCachedChunk(&cache, 0, 0));
+    CachedChunk* reused = InsertCachedChunk(&cache, 50, 50);
+    TEST_NOT_NULL(reused);
+    TEST_EQUAL(cache.chunkCount, CHUNK_TEST_CAPACITY);
+    TEST_NULL(FindCachedChunk(&cache, 1, 0));
+    TEST_NOT_NULL(FindCachedChunk(&cache, 0, 0));
+
+    // The evicted slot keeps its texture for reuse
+    TEST_EQUAL(reused->texture.id, 101);
+    TEST_TRUE(reused->isDirty);
+
+    FreeChunkCache(&cache);
+    return TEST_PASSED;
+}
+
+static int test_chunk_cache_churn(void) {
+    printf("Testing chunk cache under churn...\n");
+
+    // Every key seen in the last CHUNK_TEST_CAPACITY distinct inserts must be
+    // findable, which exercises deletion from the middle of probe runs
+    ChunkCache cache;
+    TEST_TRUE(InitChunkCache(&cache, CHUNK_TEST_CAPACITY));
+
+    RandomStream rng = CreateRandomStream(7, 0, 0);
+    int recentX[CHUNK_TEST_CAPACITY];
+    int recentY[CHUNK_TEST_CAPACITY];
+    int recentCount = 0;
+
+    for (int i = 0; i < 2000; i++) {
+        int x = NextRandomInt(&rng, -6, 6);
+        int y = NextRandomInt(&rng, -6, 6);
+        if (FindCachedChunk(&cache, x, y)) continue;
+
+        TEST_NOT_NULL(InsertCachedChunk(&cache, x, y));
+        recentX[recentCount % CHUNK_TEST_CAPACITY] = x;
+        recentY[recentCount % CHUNK_TEST_CAPACITY] = y;
+        recentCount++;
+
+        int live = recentCount < CHUNK_TEST_CAPACITY ? recentCount : CHUNK_TEST_CAPACITY;
+        for (int k = 0; k < live; k++) {
+            TEST_NOT_NULL(FindCachedChunk(&cache, recentX[k], recentY[k]));
+        }
+    }
+
+    FreeChunkCache(&cache);
+    return TEST_PASSED;
+}
+
+static int test_chunk_cache_dirty_regions(void) {
+    printf("Testing chunk cache dirty regions...\n");
+
+    ChunkCache cache;
+    TEST_TRUE(InitChunkCache(&cache, CHUNK_TEST_CAPACITY));
+
+    // A fresh chunk is drawn in full
+    CachedChunk* chunk = InsertCachedChunk(&cache, 1, -1);
+    TEST_NOT_NULL(chunk);
+    TEST_EQUAL(chunk->dirtyRectCount, 1);
+    TEST_EQUAL(chunk->dirtyRects[0].maxX, CACHE_CHUNK_SIZE - 1);
+    ClearChunkDirty(chunk);
+    TEST_FALSE(chunk->isDirty);
+
+    // Edits in adjacent tiles coalesce into one region
+    MarkCachedTileDirty(&cache, CACHE_CHUNK_SIZE + 3, -CACHE_CHUNK_SIZE + 4);
+    MarkCachedTileDirty(&cache, CACHE_CHUNK_SIZE + 4, -CACHE_CHUNK_SIZE + 4);
+    MarkCachedTileDirty(&cache, CACHE_CHUNK_SIZE + 4, -CACHE_CHUNK_SIZE + 5);
+    TEST_TRUE(chunk->isDirty);
+    TEST_EQUAL(chunk->dirtyRectCount, 1);
+    TEST_EQUAL(chunk->dirtyRects[0].minX, 3);
+    TEST_EQUAL(chunk->dirtyRects[0].maxX, 4);
+    TEST_EQUAL(chunk->dirtyRects[0].minY, 4);
+    TEST_EQUAL(chunk->dirtyRects[0].maxY, 5);
+
+    // Distant edits stay separate until the region budget runs out
+    MarkChunkRegionDirty(chunk, 12, 12, 12, 12);
+    MarkChunkRegionDirty(chunk, 0, 14, 0, 14);
+    MarkChunkRegionDirty(chunk, 14, 0, 14, 0);
+    TEST_EQUAL(chunk->dirtyRectCount, CHUNK_MAX_DIRTY_RECTS);
+    MarkChunkRegionDirty(chunk, 11, 13, 11, 13);
+    TEST_EQUAL(chunk->dirtyRectCount, CHUNK_MAX_DIRTY_RECTS);
+    MarkChunkRegionDirty(chunk, 8, 0, 8, 0);
+    TEST_EQUAL(chunk->dirtyRectCount, CHUNK_MAX_DIRTY_RECTS);
+
+    int area = 0;
+    for (int i = 0; i < chunk->dirtyRectCount; i++) {
+        ChunkDirtyRect rect = chunk->dirtyRects[i];
+        area += (rect.maxX - rect.minX + 1) * (rect.maxY - rect.minY + 1);
+        for (int j = i + 1; j < chunk->dirtyRectCount; j++) {
+            ChunkDirtyRect other = chunk->dirtyRects[j];
+            bool apart = rect.maxX + 1 < other.minX || other.maxX + 1 < rect.minX ||
+                         rect.maxY + 1 < other.minY || other.maxY + 1 < rect.minY;
+            TEST_TRUE(apart);
+        }
+    }
+    TEST_EQUAL(area, 4 + 4 + 1 + 7);
+
+    // Covering half the chunk falls back to one full redraw
+    MarkChunkRegionDirty(chunk, 0, 0, CACHE_CHUNK_SIZE - 1, CACHE_CHUNK_SIZE / 2);
+    TEST_EQUAL(chunk->dirtyRectCount, 1);
+    TEST_EQUAL(chunk->dirtyRects[0].minY, 0);
+    TEST_EQUAL(chunk->dirtyRects[0].maxY, CACHE_CHUNK_SIZE - 1);
+
+    // Tiles in uncached chunks are ignored
+    MarkCachedTileDirty(&cache, -1, -1);
+    TEST_NULL(FindCachedChunk(&cache, -1, -1));
+
+    FreeChunkCache(&cache);
+    return TEST_PASSED;
+}
+
+int run_chunk_cache_tests(void) {
+    printf("\nRunning Chunk Cache Tests...\n");
+    int failures = 0;
+
+    failures += test_chunk_cache_lookup();
+    failures += test_chunk_cache_lru();
+    failures += test_chunk_cache_churn();
+    failures += test_chunk_cache_dirty_regions();
+
+    return failures;
+}
@@ -0,0 +1,158 @@
+#include "../include/test_suites.h"
+#include "../../include/chunk_prefetch.h"
+#include "../../include/chunk_cache.h"
+#include <stdio.h>
+
+#define PREFETCH_TEST_FRAME 0.1f
+
+static bool IsQueued(const ChunkPrefetcher* prefetcher, int chunkX, int chunkY) {
+    for (int i = 0; i < prefetcher->queueCount; i++) {
+        if (prefetcher->queue[i].x == chunkX && prefetcher->queue[i].y == chunkY) return true;
+    }
+    return false;
+}
+
+static int test_chunk_prefetch_prediction(void) {
+    printf("Testing chunk prefetch prediction...\n");
+
+    ChunkPrefetcher prefetcher;
+    InitChunkPrefetcher(&prefetcher, 0.0f);
+    TEST_FLOAT_EQUAL(prefetcher.lookahead, CHUNK_PREFETCH_LOOKAHEAD);
+
+    // A still camera predicts nothing
+    Rectangle view = { 0.0f, 0.0f, 800.0f, 600.0f };
+    UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    TEST_EQUAL(prefetcher.queueCount, 0);
+    Vector2 focus = GetChunkPrefetchFocus(&prefetcher);
+    TEST_FLOAT_EQUAL(focus.x, 400.0f);
+    TEST_FLOAT_EQUAL(focus.y, 300.0f);
+
+    // Panning east at 1000 pixels a second settles on that velocity
+    for (int i = 0; i < 42; i++) {
+        view.x += 100.0f;
+        UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    }
+    TEST_TRUE(prefetcher.velocity.x > 990.0f);
+    TEST_FLOAT_EQUAL(prefetcher.velocity.y, 0.0f);
+    TEST_TRUE(prefetcher.predictedView.x > view.x + 290.0f);
+    TEST_TRUE(prefetcher.predictedView.x < view.x + 310.0f);
+
+    // View 4200-5000 covers chunks 8-9; the prediction reaches chunk 10
+    TEST_FLOAT_EQUAL(view.x, 4200.0f);
+    TEST_TRUE(prefetcher.queueCount > 0);
+    TEST_TRUE(IsQueued(&prefetcher, 10, 0));
+    TEST_TRUE(IsQueued(&prefetcher, 10, 1));
+    TEST_FALSE(IsQueued(&prefetcher, 9, 0));
+    TEST_FALSE(IsQueued(&prefetcher, 7, 0));
+
+    // Chunks level with the view come before those below its edge
+    TEST_EQUAL(prefetcher.queue[0].x, 10);
+    TEST_EQUAL(prefetcher.queue[0].y, 0);
+
+    return TEST_PASSED;
+}
+
+static int test_chunk_prefetch_limits(void) {
+    printf("Testing chunk prefetch cuts and limits...\n");
+
+    ChunkPrefetcher prefetcher;
+    InitChunkPrefetcher(&prefetcher, 1.0f);
+
+    // Fast but continuous motion is capped at a few views ahead
+    Rectangle view = { 0.0f, 0.0f, 800.0f, 600.0f };
+    UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    for (int i = 0; i < 10; i++) {
+        view.y += 2000.0f;
+        UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    }
+    TEST_TRUE(prefetcher.velocity.y > 0.0f);
+    TEST_FLOAT_EQUAL(prefetcher.predictedView.y - view.y, 600.0f * CHUNK_PREFETCH_MAX_AHEAD);
+    TEST_TRUE(prefetcher.queueCount <= CHUNK_PREFETCH_QUEUE_SIZE);
+
+    // A teleport is not motion
+    view.x += 100000.0f;
+    UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    TEST_FLOAT_EQUAL(prefetcher.velocity.x, 0.0f);
+    TEST_FLOAT_EQUAL(prefetcher.velocity.y, 0.0f);
+    TEST_EQUAL(prefetcher.queueCount, 0);
+
+    // Paused frames keep the last velocity
+    view.x += 50.0f;
+    UpdateChunkPrefetcher(&prefetcher, view, PREFETCH_TEST_FRAME);
+    float velocity = prefetcher.velocity.x;
+    UpdateChunkPrefetcher(&prefetcher, view, 0.0f);
+    TEST_FLOAT_EQUAL(prefetcher.velocity.x, velocity);
+
+    return TEST_PASSED;
+}
+
+static int test_chunk_prefetch_hit_rate(void) {
+    printf("Testing chunk prefetch hit rate...\n");
+
+    ChunkPrefetcher prefetcher;
+    InitChunkPrefetcher(&prefetcher, 0.0f);
+    TEST_FLOAT_EQUAL(GetChunkPrefetchHitRate(&prefetcher), 1.0f);
+
+    RecordChunkEntered(&prefetcher, true);
+    RecordChunkEntered(&prefetcher, true);
+    RecordChunkEntered(&prefetcher, true);
+    RecordChunkEntered(&prefetcher, false);
+    TEST_EQUAL(prefetcher.enteredChunks, 4);
+    TEST_FLOAT_EQUAL(GetChunkPrefetchHitRate(&prefetcher), 0.75f);
+
+    ResetChunkPrefetchStats(&prefetcher);
+    TEST_EQUAL(prefetcher.enteredChunks, 0);
+    TEST_FLOAT_EQUAL(GetChunkPrefetchHitRate(&prefetcher), 1.0f);
+
+    return TEST_PASSED;
+}
+
+static int test_chunk_prefetch_eviction(void) {
+    printf("Testing prefetch eviction by distance...\n");
+
+    ChunkCache cache;
+    TEST_TRUE(InitChunkCache(&cache, 4));
+    for (int x = 0; x < 4; x++) TEST_NOT_NULL(InsertCachedChunk(&cache, x, 0));
+
+    // Next frame only (0, 0) and (1, 0) are drawn
+    cache.frameCounter++;
+    InsertCachedChunk(&cache, 0, 0);
+    InsertCachedChunk(&cache, 1, 0);
+
+    // Cached chunks are returned without being touched
+    TEST_TRUE(PrefetchCachedChunk(&cache, 3, 0, 10.5f, 0.5f) == FindCachedChunk(&cache, 3, 0));
+    TEST_EQUAL(FindCachedChunk(&cache, 3, 0)->lastAccessTime, 0);
+
+    // Heading east, the stale chunk farthest west makes room
+    CachedChunk* ahead = PrefetchCachedChunk(&cache, 10, 0, 10.5f, 0.5f);
+    TEST_NOT_NULL(ahead);
+    TEST_TRUE(ahead->isDirty);
+    TEST_NULL(FindCachedChunk(&cache, 2, 0));
+    TEST_NOT_NULL(FindCachedChunk(&cache, 3, 0));
+    TEST_NOT_NULL(FindCachedChunk(&cache, 0, 0));
+    TEST_NOT_NULL(FindCachedChunk(&cache, 1, 0));
+
+    // A chunk farther away than everything evictable is not worth it, and
+    // chunks drawn this frame are never given up
+    TEST_NULL(PrefetchCachedChunk(&cache, -20, 0, 10.5f, 0.5f));
+    TEST_NOT_NULL(PrefetchCachedChunk(&cache, 9, 0, 10.5f, 0.5f));
+    TEST_NULL(FindCachedChunk(&cache, 3, 0));
+    TEST_NULL(PrefetchCachedChunk(&cache, 11, 0, 10.5f, 0.5f));
+    TEST_EQUAL(cache.chunkCount, 4);
+
+    FreeChunkCache(&cache);
+    return TEST_PASSED;
+}
+
+int run_chunk_prefetch_tests(void) {
+    printf("\nRunning Chunk Prefetch Tests...\n");
+    int failures = 0;
+
+    failures += test_chunk_prefetch_prediction();
+    failures += test_chunk_prefetch_limits();
+    failures += test_chunk_prefetch_hit_rate();
+    failures += test_chunk_prefetch_eviction();
+
+    return failures;
+}
@@ -0,0 +1,283 @@
+#include "../include/test_suites.h"
+#include "../../include/collision_grid.h"
+#include "../../include/estate_map.h"
+#include "../../include/pathfinding.h"
+#include "../../include/region_map.h"
+#include "../../include/tile_grid.h"
+#include "../../include/world.h"
+#include <stdio.h>
+#include <string.h>
+
+#define COLLISION_TEST_WIDTH 100     // Not a multiple of 64, so rows carry padding
+#define COLLISION_TEST_HEIGHT 20
+#define COLLISION_TEST_PATH_SIZE 48
+
+static int test_collision_cells(void) {
+    printf("Testing collision grid cells...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(COLLISION_TEST_WIDTH, COLLISION_TEST_HEIGHT, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+    TEST_EQUAL(grid->stride, 2);
+    TEST_FALSE(IsCellBlocked(grid, 0, 0));
+    TEST_FALSE(IsCellBlocked(grid, COLLISION_TEST_WIDTH - 1, COLLISION_TEST_HEIGHT - 1));
+
+    // Everything outside the grid, padding included, reads as blocked
+    TEST_TRUE(IsCellBlocked(grid, -1, 0));
+    TEST_TRUE(IsCellBlocked(grid, COLLISION_TEST_WIDTH, 0));
+    TEST_TRUE(IsCellBlocked(grid, 0, COLLISION_TEST_HEIGHT));
+    TEST_TRUE((GetCollisionRow(grid, COLLISION_TEST_WIDTH - 2, 3) & 0x3u) == 0);
+    TEST_TRUE((GetCollisionRow(grid, COLLISION_TEST_WIDTH - 2, 3) >> 2) == (~(uint64_t)0 >> 2));
+    TEST_TRUE(GetCollisionRow(grid, -64, 3) == ~(uint64_t)0);
+
+    SetCellBlocked(grid, 63, 5, true);
+    SetCellBlocked(grid, 64, 5, true);
+    TEST_TRUE(IsCellBlocked(grid, 63, 5));
+    TEST_TRUE(IsCellBlocked(grid, 64, 5));
+
+    // Unaligned row reads stitch the two words together
+    TEST_TRUE((GetCollisionRow(grid, 60, 5) & 0xFFFFu) == ((uint64_t)0x3 << 3));
+    TEST_TRUE(GetCollisionRow(grid, 2, 5) == ((uint64_t)0x3 << 61));
+    TEST_TRUE(GetCollisionRow(grid, -2, 5) == 0x3u);
+
+    SetCellBlocked(grid, 63, 5, false);
+    TEST_FALSE(IsCellBlocked(grid, 63, 5));
+
+    DestroyCollisionGrid(grid);
+    return TEST_PASSED;
+}
+
+static int test_collision_area(void) {
+    printf("Testing collision grid area queries...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(COLLISION_TEST_WIDTH, COLLISION_TEST_HEIGHT, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+    SetCellBlocked(grid, 70, 10, true);
+
+    TEST_TRUE(IsCollisionAreaBlocked(grid, 0, 10, 80, 10));
+    TEST_FALSE(IsCollisionAreaBlocked(grid, 0, 0, COLLISION_TEST_WIDTH - 1, 9));
+    TEST_FALSE(IsCollisionAreaBlocked(grid, 71, 0, 99, 19));
+    TEST_TRUE(IsCollisionAreaBlocked(grid, 95, 0, 100, 0));
+
+    // Boxes that only touch the blocked cell's edge do not collide
+    Rectangle touching = { 69.0f * TILE_SIZE, 10.0f * TILE_SIZE, (float)TILE_SIZE, (float)TILE_SIZE };
+    TEST_FALSE(CheckCollisionGridRec(grid, touching));
+    touching.x += 1.0f;
+    TEST_TRUE(CheckCollisionGridRec(grid, touching));
+    Rectangle outside = { -8.0f, 0.0f, 16.0f, 16.0f };
+    TEST_TRUE(CheckCollisionGridRec(grid, outside));
+
+    DestroyCollisionGrid(grid);
+    return TEST_PASSED;
+}
+
+static int test_collision_rebuild(void) {
+    printf("Testing collision grid rebuild...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, COLLISION_TEST_WIDTH * COLLISION_TEST_HEIGHT, TILE_GRASS));
+    tiles.types[2 * COLLISION_TEST_WIDTH + 3] = TILE_WALL;
+    tiles.types[2 * COLLISION_TEST_WIDTH + 90] = TILE_WATER;
+    tiles.objects[7 * COLLISION_TEST_WIDTH + 64] = OBJECT_ROCK;
+    tiles.objects[7 * COLLISION_TEST_WIDTH + 65] = OBJECT_FLOWER;
+
+    CollisionGrid* grid = CreateCollisionGrid(COLLISION_TEST_WIDTH, COLLISION_TEST_HEIGHT, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+    RebuildCollisionGrid(grid, &tiles);
+
+    // The bitmap must agree with the property table everywhere
+    for (int y = 0; y < COLLISION_TEST_HEIGHT; y++) {
+        for (int x = 0; x < COLLISION_TEST_WIDTH; x++) {
+            int index = y * COLLISION_TEST_WIDTH + x;
+            bool blocked = !GetTileProperties(GetGridTileType(&tiles, index))->isWalkable ||
+                           IsObjectBlocking(GetGridObjectType(&tiles, index));
+            TEST_EQUAL(IsCellBlocked(grid, x, y), blocked);
+        }
+    }
+    TEST_TRUE(IsCellBlocked(grid, 64, 7));
+    TEST_FALSE(IsCellBlocked(grid, 65, 7));
+
+    UpdateCollisionCell(grid, 3, 2, TILE_FLOOR, OBJECT_NONE);
+    TEST_FALSE(IsCellBlocked(grid, 3, 2));
+
+    DestroyCollisionGrid(grid);
+    FreeTileGrid(&tiles);
+    return TEST_PASSED;
+}
+
+static int test_collision_world_sync(void) {
+    printf("Testing collision grid world sync...\n");
+
+    World world;
+    memset(&world, 0, sizeof(World));
+    world.width = COLLISION_TEST_PATH_SIZE;
+    world.height = COLLISION_TEST_PATH_SIZE;
+    TEST_TRUE(InitTileGrid(&world.tiles, COLLISION_TEST_PATH_SIZE * COLLISION_TEST_PATH_SIZE, TILE_FLOOR));
+    TEST_TRUE(RebuildWorldCollision(&world));
+    TEST_NOT_NULL(world.collision);
+
+    HPAGraph* graph = GetWorldPathGraph(&world);
+    TEST_NOT_NULL(graph);
+
+    // Edits through the tile API reach the bitmap and the path search
+    const int wallX = 20;
+    for (int y = 0; y < COLLISION_TEST_PATH_SIZE; y++) {
+        SetTile(&world, wallX, y, TILE_WALL);
+    }
+    TEST_TRUE(IsCellBlocked(world.collision, wallX, 10));
+    TEST_FALSE(IsWalkableGrid(&world, wallX, 10));
+
+    HPAPoint start = { 5, 5 };
+    HPAPoint goal = { 35, 5 };
+    HPAPoint waypoints[64];
+    TEST_EQUAL(FindHPAPath(graph, &world, start, goal, waypoints, 64), -1);
+
+    SetTile(&world, wallX, 30, TILE_FLOOR);
+    TEST_FALSE(IsCellBlocked(world.collision, wallX, 30));
+    TEST_TRUE(FindHPAPath(graph, &world, start, goal, waypoints, 64) > 0);
+
+    SetMapObjectAt(&world, wallX, 30, OBJECT_STATUE);
+    TEST_TRUE(IsCellBlocked(world.collision, wallX, 30));
+    TEST_EQUAL(FindHPAPath(graph, &world, start, goal, waypoints, 64), -1);
+
+    DestroyHPAGraph(world.pathGraph);
+    DestroyRegionMap(world.regions);
+    DestroyCollisionGrid(world.collision);
+    FreeTileGrid(&world.tiles);
+    return TEST_PASSED;
+}
+
+static int test_collision_batched_queries(void) {
+    printf("Testing batched collision queries...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(COLLISION_TEST_WIDTH, COLLISION_TEST_HEIGHT, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+    SetCellBlocked(grid, 5, 5, true);
+    SetCellBlocked(grid, 63, 8, true);
+    SetCellBlocked(grid, 64, 8, true);
+    SetCellBlocked(grid, 70, 8, true);
+
+    // Odd count so both the four-wide and the leftover path run; includes
+    // negative and out-of-range coordinates
+    const float tile = (float)TILE_SIZE;
+    Vector2 points[] = {
+        { 5.5f * tile, 5.5f * tile }, { 4.99f * tile, 5.0f * tile }, { -0.5f, 3.0f }, { 0.0f, 0.0f },
+        { 63.0f * tile, 8.9f * tile }, { 1e12f, 4.0f }, { -1e12f, 4.0f }, { 6.0f * tile, 5.0f * tile },
+        { 99.5f * tile, 19.5f * tile }, { 100.0f * tile, 19.5f * tile }, { 70.2f * tile, 8.1f * tile }
+    };
+    int count = (int)(sizeof(points) / sizeof(points[0]));
+    bool open[sizeof(points) / sizeof(points[0])];
+    int openCount = TestCollisionPoints(grid, points, count, open);
+
+    int expectedOpen = 0;
+    for (int i = 0; i < count; i++) {
+        bool expected = points[i].x > -1e9f && points[i].x < 1e9f &&
+                        !IsCellBlocked(grid, (int)floorf(points[i].x / tile), (int)floorf(points[i].y / tile));
+        TEST_EQUAL(open[i], expected);
+        expectedOpen += expected;
+    }
+    TEST_EQUAL(openCount, expectedOpen);
+    TEST_FALSE(open[0]);
+    TEST_TRUE(open[1]);
+    TEST_FALSE(open[2]);
+    TEST_FALSE(open[10]);
+
+    // Blocked cells in a box, in row order; touching edges are outside
+    CollisionCell cells[8];
+    Rectangle box = { 4.0f * tile, 5.0f * tile, 67.0f * tile, 4.0f * tile };
+    TEST_EQUAL(FindBlockedCells(grid, box, cells, 8), 4);
+    TEST_TRUE(cells[0].x == 5 && cells[0].y == 5);
+    TEST_TRUE(cells[1].x == 63 && cells[1].y == 8);
+    TEST_TRUE(cells[2].x == 64 && cells[2].y == 8);
+    TEST_TRUE(cells[3].x == 70 && cells[3].y == 8);
+    TEST_EQUAL(FindBlockedCells(grid, box, cells, 2), 4);
+    Rectangle clear = { 6.0f * tile, 0.0f, 10.0f * tile, 5.0f * tile };
+    TEST_EQUAL(FindBlockedCells(grid, clear, cells, 8), 0);
+    Rectangle edge = { -1.0f, 0.0f, 2.0f, 2.0f * tile };
+    TEST_EQUAL(FindBlockedCells(grid, edge, cells, 8), 2);
+
+    // Rays stop at the first blocked cell they pass through
+    Vector2 origins[4] = {
+        { 0.5f * tile, 5.5f * tile }, { 0.5f * tile, 2.5f * tile }, { 5.5f * tile, 5.5f * tile }, { 75.5f * tile, 8.5f * tile }
+    };
+    Vector2 motions[4] = {
+        { 10.0f * tile, 0.0f }, { 10.0f * tile, 0.0f }, { tile, tile }, { -20.0f * tile, 0.0f }
+    };
+    CollisionRayHit hits[4];
+    CastCollisionRays(grid, origins, motions, 4, hits);
+    TEST_TRUE(hits[0].hit);
+    TEST_TRUE(hits[0].cell.x == 5 && hits[0].cell.y == 5);
+    TEST_FLOAT_EQUAL(hits[0].time, 0.45f);
+    TEST_FALSE(hits[1].hit);
+    TEST_FLOAT_EQUAL(hits[1].time, 1.0f);
+    TEST_TRUE(hits[2].hit);
+    TEST_FLOAT_EQUAL(hits[2].time, 0.0f);
+    TEST_TRUE(hits[3].hit);
+    TEST_TRUE(hits[3].cell.x == 70 && hits[3].cell.y == 8);
+
+    // A ray leaving the grid hits its edge
+    Vector2 outward = { 0.5f * tile, 0.5f * tile };
+    Vector2 up = { 0.0f, -2.0f * tile };
+    CastCollisionRays(grid, &outward, &up, 1, hits);
+    TEST_TRUE(hits[0].hit);
+    TEST_EQUAL(hits[0].cell.y, -1);
+
+    DestroyCollisionGrid(grid);
+    return TEST_PASSED;
+}
+
+static int test_collision_world_rays(void) {
+    printf("Testing world rays without a bitmap...\n");
+
+    World world;
+    memset(&world, 0, sizeof(World));
+    world.width = COLLISION_TEST_PATH_SIZE;
+    world.height = COLLISION_TEST_PATH_SIZE;
+    TEST_TRUE(InitTileGrid(&world.tiles, COLLISION_TEST_PATH_SIZE * COLLISION_TEST_PATH_SIZE, TILE_FLOOR));
+    for (int y = 0; y < COLLISION_TEST_PATH_SIZE; y++) {
+        world.tiles.types[y * COLLISION_TEST_PATH_SIZE + 10] = TILE_WALL;
+    }
+
+    // A wall between the ends stops the ray at its real time of impact,
+    // and an open end cell past it does not hide it
+    const float tile = (float)TILE_SIZE;
+    Vector2 origins[3] = { { 2.5f * tile, 4.5f * tile }, { 2.5f * tile, 4.5f * tile }, { 2.5f * tile, 4.5f * tile } };
+    Vector2 motions[3] = { { 15.0f * tile, 0.0f }, { 5.0f * tile, 0.0f }, { 8.0f * tile, 0.0f } };
+    CollisionRayHit tileHits[3];
+    CastWorldRays(&world, origins, motions, 3, tileHits);
+    TEST_TRUE(tileHits[0].hit);
+    TEST_TRUE(tileHits[0].cell.x == 10 && tileHits[0].cell.y == 4);
+    TEST_FLOAT_EQUAL(tileHits[0].time, 7.5f / 15.0f);
+    TEST_FALSE(tileHits[1].hit);
+    TEST_FLOAT_EQUAL(tileHits[1].time, 1.0f);
+    TEST_TRUE(tileHits[2].hit);
+    TEST_FLOAT_EQUAL(tileHits[2].time, 7.5f / 8.0f);
+
+    // The bitmap path gives the same answers
+    TEST_TRUE(RebuildWorldCollision(&world));
+    CollisionRayHit gridHits[3];
+    CastWorldRays(&world, origins, motions, 3, gridHits);
+    for (int i = 0; i < 3; i++) {
+        TEST_EQUAL(gridHits[i].hit, tileHits[i].hit);
+        TEST_FLOAT_EQUAL(gridHits[i].time, tileHits[i].time);
+        TEST_TRUE(gridHits[i].cell.x == tileHits[i].cell.x && gridHits[i].cell.y == tileHits[i].cell.y);
+    }
+
+    DestroyRegionMap(world.regions);
+    DestroyCollisionGrid(world.collision);
+    FreeTileGrid(&world.tiles);
+    return TEST_PASSED;
+}
+
+int run_collision_grid_tests(void) {
+    printf("\nRunning Collision Grid Tests...\n");
+    int failures = 0;
+
+    failures += test_collision_cells();
+    failures += test_collision_area();
+    failures += test_collision_rebuild();
+    failures += test_collision_world_sync();
+    failures += test_collision_batched_queries();
+    failures += test_collision_world_rays();
+
+    return failures;
+}
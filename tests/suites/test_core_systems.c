@@ -45,7 +45,7 @@ static int TestWorldStructure(void) {
     TEST_NOT_NULL(world);
     TEST_EQUAL((int)world->dimensions.x, ESTATE_WIDTH * TILE_SIZE);
     TEST_EQUAL((int)world->dimensions.y, ESTATE_HEIGHT * TILE_SIZE);
-    TEST_NOT_NULL(world->tiles);
+    TEST_NOT_NULL(world->tiles.types);
     
     // Test tile operations
     Tile wallTile = CreateTile(TILE_WALL, OBJECT_NONE);
@@ -0,0 +1,88 @@
+#include "../include/test_suites.h"
+#include "../../include/entity.h"
+#include "../../include/entity_pool.h"
+#include "../../include/job_system.h"
+#include "../../include/entities/crowd.h"
+#include <stdio.h>
+
+static Entity* SpawnAgent(EntityPool* pool, Vector2 position, Vector2 velocity) {
+    Entity* agent = CreateEntity(pool, ENTITY_TYPE_NPC, position);
+    if (!agent) return NULL;
+
+    GetTransformComponent(agent)->position = position;
+    GetPhysicsComponent(agent)->velocity = velocity;
+    return agent;
+}
+
+static int test_crowd_separation(void) {
+    printf("Testing crowd separation...\n");
+
+    EntityPool* pool = CreateEntityPool(16);
+    TEST_NOT_NULL(pool);
+    CrowdSystem* crowd = CreateCrowdSystem((Rectangle){ 0, 0, 1024, 1024 }, NULL);
+    TEST_NOT_NULL(crowd);
+
+    // Two idle agents standing almost on top of each other
+    Entity* left = SpawnAgent(pool, (Vector2){ 500, 500 }, (Vector2){ 0, 0 });
+    Entity* right = SpawnAgent(pool, (Vector2){ 510, 500 }, (Vector2){ 0, 0 });
+    TEST_NOT_NULL(left);
+    TEST_NOT_NULL(right);
+
+    UpdateCrowdSteering(crowd, pool, NULL, NULL);
+
+    PhysicsComponent* leftPhysics = GetPhysicsComponent(left);
+    PhysicsComponent* rightPhysics = GetPhysicsComponent(right);
+    TEST_TRUE(leftPhysics->isSteered);
+    TEST_TRUE(rightPhysics->isSteered);
+    TEST_TRUE(leftPhysics->desiredVelocity.x < 0.0f);
+    TEST_TRUE(rightPhysics->desiredVelocity.x > 0.0f);
+    TEST_FLOAT_EQUAL(leftPhysics->desiredVelocity.x, -rightPhysics->desiredVelocity.x);
+
+    DestroyCrowdSystem(crowd);
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+static int test_crowd_thread_independence(void) {
+    printf("Testing crowd determinism across worker counts...\n");
+
+    EntityPool* pool = CreateEntityPool(256);
+    TEST_NOT_NULL(pool);
+    CrowdSystem* crowd = CreateCrowdSystem((Rectangle){ 0, 0, 1024, 1024 }, NULL);
+    TEST_NOT_NULL(crowd);
+    JobSystem* jobs = CreateJobSystem(4);
+    TEST_NOT_NULL(jobs);
+
+    for (int i = 0; i < 200; i++) {
+        Vector2 position = { (float)(37 * i % 1000), (float)(53 * i % 1000) };
+        Vector2 velocity = { (float)(i % 7) * 10.0f - 30.0f, (float)(i % 5) * 10.0f - 20.0f };
+        TEST_NOT_NULL(SpawnAgent(pool, position, velocity));
+    }
+
+    Vector2 serial[200];
+    UpdateCrowdSteering(crowd, pool, NULL, NULL);
+    for (int i = 0; i < 200; i++) {
+        serial[i] = GetPhysicsComponent(&pool->entities[i])->desiredVelocity;
+    }
+
+    UpdateCrowdSteering(crowd, pool, NULL, jobs);
+    for (int i = 0; i < 200; i++) {
+        Vector2 parallel = GetPhysicsComponent(&pool->entities[i])->desiredVelocity;
+        TEST_TRUE(parallel.x == serial[i].x && parallel.y == serial[i].y);
+    }
+
+    DestroyJobSystem(jobs);
+    DestroyCrowdSystem(crowd);
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+int run_crowd_tests(void) {
+    printf("\nRunning Crowd Tests...\n");
+    int failures = 0;
+
+    failures += test_crowd_separation();
+    failures += test_crowd_thread_independence();
+
+    return failures;
+}
@@ -0,0 +1,132 @@
+#include "../include/test_suites.h"
+#include "../../include/entity.h"
+#include "../../include/entity_pool.h"
+#include <stdio.h>
+
+#define CULLING_TEST_ENTITIES 5000
+#define CULLING_TEST_WORLD_SIZE (256 * TILE_SIZE)
+
+static int s_drawCount;
+
+static void CountDraw(Entity* entity) {
+    (void)entity;
+    s_drawCount++;
+}
+
+static Entity* SpawnDrawable(EntityPool* pool, Vector2 position) {
+    Entity* entity = CreateEntity(pool, ENTITY_TYPE_NPC, position);
+    if (entity) entity->Draw = CountDraw;
+    return entity;
+}
+
+static Viewport MakeViewport(float x, float y, float width, float height) {
+    Viewport viewport = { { x, y, width, height }, { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+    return viewport;
+}
+
+static int test_entity_culling_skips_off_screen(void) {
+    printf("Testing entity drawing skips off-screen chunks...\n");
+
+    EntityPool* pool = CreateEntityPool(CULLING_TEST_ENTITIES + 16);
+    TEST_NOT_NULL(pool);
+    Rectangle world = { 0.0f, 0.0f, (float)CULLING_TEST_WORLD_SIZE, (float)CULLING_TEST_WORLD_SIZE };
+
+    // A crowd far from the view, in the opposite corner of the estate
+    for (int i = 0; i < CULLING_TEST_ENTITIES; i++) {
+        Vector2 position = {
+            (float)CULLING_TEST_WORLD_SIZE - 1.0f - (float)(i % 70) * 10.0f,
+            (float)CULLING_TEST_WORLD_SIZE - 1.0f - (float)(i / 70) * 10.0f
+        };
+        TEST_NOT_NULL(SpawnDrawable(pool, position));
+    }
+
+    // A handful on screen, and one just past its edge that the extra ring
+    // of chunks still draws
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ 100.0f, 100.0f }));
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ 600.0f, 400.0f }));
+    Entity* hidden = SpawnDrawable(pool, (Vector2){ 300.0f, 300.0f });
+    TEST_NOT_NULL(hidden);
+    hidden->visible = false;
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ 800.0f + 4.0f, 200.0f }));
+
+    TEST_TRUE(IndexEntityPool(pool, world));
+    Viewport viewport = MakeViewport(0.0f, 0.0f, 800.0f, 600.0f);
+
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 3);
+
+    // Without an index every entity is drawn
+    s_drawCount = 0;
+    DrawEntityPool(pool);
+    TEST_EQUAL(s_drawCount, CULLING_TEST_ENTITIES + 3);
+
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+static int test_entity_culling_stays_correct(void) {
+    printf("Testing entity drawing across pool changes...\n");
+
+    EntityPool* pool = CreateEntityPool(64);
+    TEST_NOT_NULL(pool);
+    Rectangle world = { 0.0f, 0.0f, (float)CULLING_TEST_WORLD_SIZE, (float)CULLING_TEST_WORLD_SIZE };
+    Viewport viewport = MakeViewport(0.0f, 0.0f, 800.0f, 600.0f);
+
+    // No index yet: falls back to drawing everything
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ 100.0f, 100.0f }));
+    Entity* far = SpawnDrawable(pool, (Vector2){ 6000.0f, 6000.0f });
+    TEST_NOT_NULL(far);
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 2);
+
+    TEST_TRUE(IndexEntityPool(pool, world));
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 1);
+
+    // Entities spawned after the index are drawn until the next one
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ 7000.0f, 7000.0f }));
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 2);
+
+    // Removal reorders slots, so the stale index is not used
+    RemoveEntity(pool, far);
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 2);
+    TEST_TRUE(IndexEntityPool(pool, world));
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &viewport);
+    TEST_EQUAL(s_drawCount, 1);
+
+    // Entities outside the world sit in the border chunks, so views past
+    // the edge still find them
+    TEST_NOT_NULL(SpawnDrawable(pool, (Vector2){ -500.0f, 50.0f }));
+    TEST_TRUE(IndexEntityPool(pool, world));
+    Viewport outside = MakeViewport(-900.0f, 0.0f, 800.0f, 600.0f);
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &outside);
+    TEST_EQUAL(s_drawCount, 2);
+
+    // A view moved across the estate picks up the far corner instead
+    Viewport corner = MakeViewport(6700.0f, 6700.0f, 800.0f, 600.0f);
+    s_drawCount = 0;
+    DrawEntityPoolInView(pool, &corner);
+    TEST_EQUAL(s_drawCount, 1);
+
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+int run_entity_culling_tests(void) {
+    printf("\nRunning Entity Culling Tests...\n");
+    int failures = 0;
+
+    failures += test_entity_culling_skips_off_screen();
+    failures += test_entity_culling_stays_correct();
+
+    return failures;
+}
@@ -1,8 +1,11 @@
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include "../src/core/map.h"
 #include "../include/resource_manager.h"
 #include "../include/world.h"
+#include "../include/map_system.h"
+#include "../include/tile_grid.h"
 #include "../include/test_suites.h"
 #include "../../include/map_types.h"
 
@@ -13,7 +16,7 @@ int test_map_creation(void) {
     ResourceManager* resources = GetResourceManager();
     World* world = CreateWorld(ESTATE_WIDTH, ESTATE_HEIGHT, 9.81f, resources);
     TEST_NOT_NULL(world);
-    TEST_NOT_NULL(world->tiles);
+    TEST_NOT_NULL(world->tiles.types);
     TEST_NOT_NULL(world->entityPool);
     
     DestroyWorld(world);
@@ -165,6 +168,7 @@ static int test_map_tile_access(void) {
 static int TestTileOperations(void);
 static int TestMapGeneration(void);
 static int TestObjectPlacement(void);
+static int TestTilePropertiesSave(void);
 
 int run_map_tests(void) {
     printf("\nRunning Map Tests...\n");
@@ -177,6 +181,7 @@ int run_map_tests(void) {
     failures += TestTileOperations();
     failures += TestMapGeneration();
     failures += TestObjectPlacement();
+    failures += TestTilePropertiesSave();
     
     return failures;
 }
@@ -244,4 +249,39 @@ static int TestObjectPlacement(void) {
     
     DestroyWorld(world);
     return TEST_PASSED;
-} 
\ No newline at end of file
+} 
+
+static int TestTilePropertiesSave(void) {
+    const char* path = "test_map_properties.map";
+    ResourceManager* resources = GetResourceManager();
+    TEST_NOT_NULL(resources);
+
+    MapSystem* mapSystem = CreateMapSystem();
+    TEST_NOT_NULL(mapSystem);
+    TEST_TRUE(LoadMap(mapSystem, path));
+    World* world = CreateWorld(ESTATE_WIDTH, ESTATE_HEIGHT, 9.81f, resources);
+    TEST_NOT_NULL(world);
+    world->mapSystem = mapSystem;
+
+    // A full save first, so the property goes out as an appended chunk
+    SaveMapSystem(mapSystem, path);
+    SetTileCustomProperties(world, 12, 7, "{\"lit\":true}");
+    SaveMapSystem(mapSystem, path);
+    FinishMapSave(mapSystem);
+
+    MapSystem* loaded = CreateMapSystem();
+    TEST_NOT_NULL(loaded);
+    LoadMapSystem(loaded, path);
+    TEST_NOT_NULL(loaded->currentMap);
+    LoadMapArea(loaded, (Rectangle){ 12 * TILE_SIZE, 7 * TILE_SIZE, 0, 0 });
+    const char* properties = GetTileOverride(&loaded->currentMap->tiles, 7 * ESTATE_WIDTH + 12);
+    TEST_NOT_NULL(properties);
+    TEST_TRUE(strcmp(properties, "{\"lit\":true}") == 0);
+
+    DestroyMapSystem(loaded);
+    world->mapSystem = NULL;
+    DestroyWorld(world);
+    DestroyMapSystem(mapSystem);
+    remove(path);
+    return TEST_PASSED;
+}
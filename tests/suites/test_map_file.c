@@ -0,0 +1,441 @@
+#include "../include/test_suites.h"
+#include "../../include/map_file.h"
+#include "../../include/tile_grid.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAP_FILE_TEST_PATH "test_map_file.swmp"
+#define MAP_FILE_TEST_PATCH_PATH MAP_FILE_TEST_PATH ".patch"
+#define MAP_FILE_TEST_WIDTH 70
+#define MAP_FILE_TEST_HEIGHT 45
+
+static long GetFileSize(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static int test_map_plane_coding(void) {
+    printf("Testing map plane run-length coding...\n");
+
+    uint8_t data[600];
+    uint8_t decoded[600];
+    uint8_t encoded[700];
+
+    // Long runs, short runs and literals mixed
+    memset(data, TILE_GRASS, 300);
+    for (int i = 300; i < 450; i++) data[i] = (uint8_t)(i * 7);
+    memset(&data[450], TILE_WATER, 2);
+    for (int i = 452; i < 600; i++) data[i] = (uint8_t)(i % 3 == 0 ? TILE_FLOWER : TILE_GRASS);
+
+    size_t size = EncodeMapPlane(data, sizeof(data), encoded);
+    TEST_TRUE(size <= GetMapPlaneBound(sizeof(data)));
+    TEST_EQUAL(DecodeMapPlane(encoded, size, decoded, sizeof(decoded)), size);
+    TEST_EQUAL(memcmp(data, decoded, sizeof(data)), 0);
+
+    // A uniform plane collapses to a few pairs
+    memset(data, TILE_GRASS, sizeof(data));
+    size = EncodeMapPlane(data, sizeof(data), encoded);
+    TEST_TRUE(size <= 10);
+    TEST_EQUAL(DecodeMapPlane(encoded, size, decoded, sizeof(decoded)), size);
+    TEST_EQUAL(decoded[599], TILE_GRASS);
+
+    // No repeats at all is the worst case
+    for (int i = 0; i < 600; i++) data[i] = (uint8_t)(i & 1);
+    size = EncodeMapPlane(data, sizeof(data), encoded);
+    TEST_EQUAL(size, GetMapPlaneBound(sizeof(data)));
+    TEST_EQUAL(DecodeMapPlane(encoded, size, decoded, sizeof(decoded)), size);
+    TEST_EQUAL(memcmp(data, decoded, sizeof(data)), 0);
+
+    // Truncated input and overlong output are rejected
+    TEST_EQUAL(DecodeMapPlane(encoded, size - 1, decoded, sizeof(decoded)), 0);
+    TEST_EQUAL(DecodeMapPlane(encoded, size, decoded, sizeof(decoded) - 1), 0);
+
+    return TEST_PASSED;
+}
+
+static int test_map_file_round_trip(void) {
+    printf("Testing map file round trip...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, MAP_FILE_TEST_WIDTH * MAP_FILE_TEST_HEIGHT, TILE_GRASS));
+    for (int x = 0; x < MAP_FILE_TEST_WIDTH; x++) {
+        tiles.types[20 * MAP_FILE_TEST_WIDTH + x] = TILE_PATH;
+    }
+    tiles.types[44 * MAP_FILE_TEST_WIDTH + 69] = TILE_WATER;
+    tiles.objects[3 * MAP_FILE_TEST_WIDTH + 40] = OBJECT_TREE;
+    tiles.objects[40 * MAP_FILE_TEST_WIDTH + 66] = OBJECT_TORCH;
+    TEST_TRUE(SetTileOverride(&tiles, 3 * MAP_FILE_TEST_WIDTH + 40, "{\"fruit\":\"apple\"}"));
+    TEST_TRUE(SetTileOverride(&tiles, 40 * MAP_FILE_TEST_WIDTH + 66, "{\"lit\":true}"));
+    TEST_TRUE(SetTileOverride(&tiles, 41 * MAP_FILE_TEST_WIDTH + 1, "{\"lit\":true}"));
+
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+
+    TileGrid loaded;
+    int width = 0;
+    int height = 0;
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, &width, &height));
+    TEST_EQUAL(width, MAP_FILE_TEST_WIDTH);
+    TEST_EQUAL(height, MAP_FILE_TEST_HEIGHT);
+    TEST_EQUAL(memcmp(tiles.types, loaded.types, tiles.count), 0);
+    TEST_EQUAL(memcmp(tiles.objects, loaded.objects, tiles.count), 0);
+    TEST_EQUAL(loaded.overrideCount, 3);
+    TEST_TRUE(strcmp(GetTileOverride(&loaded, 3 * MAP_FILE_TEST_WIDTH + 40), "{\"fruit\":\"apple\"}") == 0);
+    TEST_TRUE(strcmp(GetTileOverride(&loaded, 41 * MAP_FILE_TEST_WIDTH + 1), "{\"lit\":true}") == 0);
+    TEST_EQUAL(GetTilePropertySet(&loaded, 41 * MAP_FILE_TEST_WIDTH + 1),
+               GetTilePropertySet(&loaded, 40 * MAP_FILE_TEST_WIDTH + 66));
+    FreeTileGrid(&loaded);
+
+    // Single chunks decode on their own and drop stale properties
+    MapFile* file = OpenMapFile(MAP_FILE_TEST_PATH);
+    TEST_NOT_NULL(file);
+    TEST_EQUAL(GetMapFileChunkCount(file), 3 * 2);
+
+    TEST_TRUE(InitTileGrid(&loaded, tiles.count, TILE_NONE));
+    TEST_TRUE(SetTileOverride(&loaded, 40 * MAP_FILE_TEST_WIDTH + 65, "{\"stale\":1}"));
+    TEST_TRUE(ReadMapFileChunk(file, 2, 1, &loaded));
+    TEST_EQUAL(loaded.types[44 * MAP_FILE_TEST_WIDTH + 69], TILE_WATER);
+    TEST_EQUAL(loaded.objects[40 * MAP_FILE_TEST_WIDTH + 66], OBJECT_TORCH);
+    TEST_EQUAL(loaded.types[40 * MAP_FILE_TEST_WIDTH + 63], TILE_NONE);
+    TEST_NULL(GetTileOverride(&loaded, 40 * MAP_FILE_TEST_WIDTH + 65));
+    TEST_TRUE(strcmp(GetTileOverride(&loaded, 40 * MAP_FILE_TEST_WIDTH + 66), "{\"lit\":true}") == 0);
+    TEST_FALSE(ReadMapFileChunk(file, 3, 0, &loaded));
+
+    CloseMapFile(file);
+    FreeTileGrid(&loaded);
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_lazy_reads(void) {
+    printf("Testing lazy map file reads...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, MAP_FILE_TEST_WIDTH * MAP_FILE_TEST_HEIGHT, TILE_GRASS));
+    tiles.types[0] = TILE_WALL;
+    tiles.types[44 * MAP_FILE_TEST_WIDTH + 69] = TILE_WATER;
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+
+    MapFile* file = OpenMapFile(MAP_FILE_TEST_PATH);
+    TEST_NOT_NULL(file);
+    TEST_EQUAL(GetMapFileWidth(file), MAP_FILE_TEST_WIDTH);
+    TEST_EQUAL(GetMapFileHeight(file), MAP_FILE_TEST_HEIGHT);
+
+    // Replacing the file keeps the open mapping on the old contents
+    tiles.types[0] = TILE_FLOOR;
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+
+    // Chunks decode in any order; hints outside the map are ignored
+    TileGrid loaded;
+    TEST_TRUE(InitTileGrid(&loaded, tiles.count, TILE_NONE));
+    PrefetchMapFileChunk(file, 2, 1);
+    PrefetchMapFileChunk(file, 5, 5);
+    PrefetchMapFileChunk(file, -1, 0);
+    TEST_TRUE(ReadMapFileChunk(file, 2, 1, &loaded));
+    TEST_EQUAL(loaded.types[44 * MAP_FILE_TEST_WIDTH + 69], TILE_WATER);
+    TEST_EQUAL(loaded.types[0], TILE_NONE);
+    TEST_TRUE(ReadMapFileChunk(file, 0, 0, &loaded));
+    TEST_EQUAL(loaded.types[0], TILE_WALL);
+    CloseMapFile(file);
+
+    // A bad index entry only fails its own chunk
+    FILE* raw = fopen(MAP_FILE_TEST_PATH, "r+b");
+    TEST_NOT_NULL(raw);
+    uint8_t header[MAP_FILE_HEADER_SIZE];
+    TEST_EQUAL(fread(header, 1, sizeof(header), raw), sizeof(header));
+    long indexOffset = (long)(header[16] | header[17] << 8 | header[18] << 16 | (uint32_t)header[19] << 24);
+    uint8_t badOffset[4] = { 0xFF, 0xFF, 0xFF, 0x7F };
+    fseek(raw, indexOffset + 8, SEEK_SET);
+    fwrite(badOffset, 1, sizeof(badOffset), raw);
+    fclose(raw);
+
+    file = OpenMapFile(MAP_FILE_TEST_PATH);
+    TEST_NOT_NULL(file);
+    TEST_FALSE(ReadMapFileChunk(file, 1, 0, &loaded));
+    TEST_TRUE(ReadMapFileChunk(file, 0, 0, &loaded));
+    TEST_EQUAL(loaded.types[0], TILE_FLOOR);
+    CloseMapFile(file);
+
+    FreeTileGrid(&loaded);
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_size(void) {
+    printf("Testing map file size...\n");
+
+    // A mostly grass estate with paths and scattered trees
+    const int side = 256;
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, (size_t)side * side, TILE_GRASS));
+    for (int i = 0; i < side; i++) {
+        tiles.types[64 * side + i] = TILE_PATH;
+        tiles.types[i * side + 128] = TILE_PATH;
+    }
+    for (int i = 0; i < 400; i++) {
+        tiles.objects[(i * 7919) % (side * side)] = OBJECT_TREE;
+    }
+
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, side, side));
+    long size = GetFileSize(MAP_FILE_TEST_PATH);
+    long rawSize = 2 * side * side + 2 * (long)sizeof(int);
+    TEST_TRUE(size > 0);
+    TEST_TRUE(size * 10 <= rawSize);
+
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_rejects_bad_files(void) {
+    printf("Testing map file validation...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, 40 * 40, TILE_FLOOR));
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, 40, 40));
+    TEST_FALSE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, 41, 40));
+
+    long size = GetFileSize(MAP_FILE_TEST_PATH);
+    uint8_t* bytes = (uint8_t*)malloc((size_t)size);
+    TEST_NOT_NULL(bytes);
+    FILE* file = fopen(MAP_FILE_TEST_PATH, "rb");
+    TEST_NOT_NULL(file);
+    TEST_EQUAL(fread(bytes, 1, (size_t)size, file), (size_t)size);
+    fclose(file);
+
+    // A newer version is refused rather than misread
+    bytes[4] = MAP_FILE_VERSION + 1;
+    file = fopen(MAP_FILE_TEST_PATH, "wb");
+    fwrite(bytes, 1, (size_t)size, file);
+    fclose(file);
+    TEST_NULL(OpenMapFile(MAP_FILE_TEST_PATH));
+
+    // So is a file cut short before its index
+    bytes[4] = MAP_FILE_VERSION;
+    file = fopen(MAP_FILE_TEST_PATH, "wb");
+    fwrite(bytes, 1, (size_t)size - 4, file);
+    fclose(file);
+    TEST_NULL(OpenMapFile(MAP_FILE_TEST_PATH));
+
+    // Legacy raw maps do not carry the magic
+    TileGrid loaded;
+    int width = 40;
+    file = fopen(MAP_FILE_TEST_PATH, "wb");
+    fwrite(&width, sizeof(int), 1, file);
+    fwrite(&width, sizeof(int), 1, file);
+    fwrite(tiles.types, 1, tiles.count, file);
+    fwrite(tiles.objects, 1, tiles.count, file);
+    fclose(file);
+    TEST_FALSE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_NULL(OpenMapFile("missing_map_file.swmp"));
+
+    free(bytes);
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    return TEST_PASSED;
+}
+
+// Saves one chunk of a grid to the test file's patch log
+static bool AppendTestChunk(const TileGrid* tiles, int width, int height, int chunkX, int chunkY) {
+    MapPatch* patch = CreateMapPatch(width, height);
+    bool appended = AddMapPatchChunk(patch, tiles, chunkX, chunkY) && AppendMapFilePatch(MAP_FILE_TEST_PATH, patch);
+    DestroyMapPatch(patch);
+    return appended;
+}
+
+static int test_map_file_patches(void) {
+    printf("Testing map file patch logs...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, MAP_FILE_TEST_WIDTH * MAP_FILE_TEST_HEIGHT, TILE_GRASS));
+    TEST_TRUE(SetTileOverride(&tiles, 5 * MAP_FILE_TEST_WIDTH + 5, "{\"old\":1}"));
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+    TEST_EQUAL(GetFileSize(MAP_FILE_TEST_PATCH_PATH), -1);
+
+    // Edits in two chunks, the first saved twice so the later entry wins
+    tiles.types[0] = TILE_WALL;
+    TEST_TRUE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 0, 0));
+    tiles.types[0] = TILE_WATER;
+    tiles.objects[MAP_FILE_TEST_WIDTH + 1] = OBJECT_TORCH;
+    TEST_TRUE(SetTileOverride(&tiles, 5 * MAP_FILE_TEST_WIDTH + 5, NULL));
+    TEST_TRUE(SetTileOverride(&tiles, 2 * MAP_FILE_TEST_WIDTH + 3, "{\"lit\":true}"));
+    tiles.types[44 * MAP_FILE_TEST_WIDTH + 69] = TILE_PATH;
+
+    MapPatch* patch = CreateMapPatch(MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT);
+    TEST_NOT_NULL(patch);
+    TEST_TRUE(AddMapPatchChunk(patch, &tiles, 0, 0));
+    TEST_TRUE(AddMapPatchChunk(patch, &tiles, 2, 1));
+    TEST_FALSE(AddMapPatchChunk(patch, &tiles, 3, 0));
+    TEST_EQUAL(GetMapPatchChunkCount(patch), 2);
+    TEST_TRUE(AppendMapFilePatch(MAP_FILE_TEST_PATH, patch));
+    DestroyMapPatch(patch);
+
+    // Opening replays the log over the file
+    TileGrid loaded;
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(memcmp(tiles.types, loaded.types, tiles.count), 0);
+    TEST_EQUAL(memcmp(tiles.objects, loaded.objects, tiles.count), 0);
+    TEST_EQUAL(loaded.overrideCount, 1);
+    TEST_TRUE(strcmp(GetTileOverride(&loaded, 2 * MAP_FILE_TEST_WIDTH + 3), "{\"lit\":true}") == 0);
+    FreeTileGrid(&loaded);
+
+    // A log for another map size is refused
+    TileGrid small;
+    TEST_TRUE(InitTileGrid(&small, 40 * 40, TILE_GRASS));
+    TEST_FALSE(AppendTestChunk(&small, 40, 40, 0, 0));
+    FreeTileGrid(&small);
+
+    // Folding the log in gives the same map and removes the log
+    long patchedSize = GetFileSize(MAP_FILE_TEST_PATCH_PATH);
+    TEST_TRUE(patchedSize > MAP_PATCH_HEADER_SIZE);
+    TEST_TRUE(CompactMapFile(MAP_FILE_TEST_PATH));
+    TEST_EQUAL(GetFileSize(MAP_FILE_TEST_PATCH_PATH), -1);
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(memcmp(tiles.types, loaded.types, tiles.count), 0);
+    TEST_EQUAL(loaded.overrideCount, 1);
+    FreeTileGrid(&loaded);
+
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_torn_patch(void) {
+    printf("Testing torn map file patch logs...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, MAP_FILE_TEST_WIDTH * MAP_FILE_TEST_HEIGHT, TILE_GRASS));
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+    tiles.types[0] = TILE_WALL;
+    TEST_TRUE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 0, 0));
+
+    // A crash part way through an entry leaves only its header
+    FILE* file = fopen(MAP_FILE_TEST_PATCH_PATH, "ab");
+    TEST_NOT_NULL(file);
+    uint8_t entry[8] = { 1, 0, 0, 0, 200, 0, 0, 0 };
+    fwrite(entry, 1, sizeof(entry), file);
+    fclose(file);
+
+    // The entries before it still apply, but nothing is added after it
+    TileGrid loaded;
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(loaded.types[0], TILE_WALL);
+    TEST_EQUAL(loaded.types[MAP_FILE_CHUNK_SIZE], TILE_GRASS);
+    FreeTileGrid(&loaded);
+    TEST_FALSE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 1, 0));
+
+    // A full save starts over without the log
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+    TEST_EQUAL(GetFileSize(MAP_FILE_TEST_PATCH_PATH), -1);
+    TEST_TRUE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 1, 0));
+
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    remove(MAP_FILE_TEST_PATCH_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_stale_patch(void) {
+    printf("Testing stale map file patch logs...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, MAP_FILE_TEST_WIDTH * MAP_FILE_TEST_HEIGHT, TILE_GRASS));
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+    tiles.types[0] = TILE_WALL;
+    TEST_TRUE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 0, 0));
+
+    long size = GetFileSize(MAP_FILE_TEST_PATCH_PATH);
+    TEST_TRUE(size > MAP_PATCH_HEADER_SIZE);
+    uint8_t* log = (uint8_t*)malloc((size_t)size);
+    TEST_NOT_NULL(log);
+    FILE* file = fopen(MAP_FILE_TEST_PATCH_PATH, "rb");
+    TEST_NOT_NULL(file);
+    TEST_EQUAL(fread(log, 1, (size_t)size, file), (size_t)size);
+    fclose(file);
+
+    // A crash after the full save replaced the file but before its log
+    // was deleted leaves the old log beside the new file
+    tiles.types[0] = TILE_WATER;
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT));
+    file = fopen(MAP_FILE_TEST_PATCH_PATH, "wb");
+    TEST_NOT_NULL(file);
+    fwrite(log, 1, (size_t)size, file);
+    fclose(file);
+    free(log);
+
+    // The newer file wins, and the next append starts the log over
+    TileGrid loaded;
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(loaded.types[0], TILE_WATER);
+    FreeTileGrid(&loaded);
+
+    tiles.types[MAP_FILE_CHUNK_SIZE] = TILE_PATH;
+    TEST_TRUE(AppendTestChunk(&tiles, MAP_FILE_TEST_WIDTH, MAP_FILE_TEST_HEIGHT, 1, 0));
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(memcmp(tiles.types, loaded.types, tiles.count), 0);
+    FreeTileGrid(&loaded);
+
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    remove(MAP_FILE_TEST_PATCH_PATH);
+    return TEST_PASSED;
+}
+
+static int test_map_file_patch_size(void) {
+    printf("Testing map file patch size...\n");
+
+    // Saving a few edits on a large estate writes only their chunks
+    const int side = 512;
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, (size_t)side * side, TILE_GRASS));
+    for (int i = 0; i < side * side; i++) {
+        if ((i * 7919) % 13 == 0) tiles.objects[i] = OBJECT_TREE;
+    }
+    TEST_TRUE(SaveMapFile(MAP_FILE_TEST_PATH, &tiles, side, side));
+    long fullSize = GetFileSize(MAP_FILE_TEST_PATH);
+
+    tiles.objects[100 * side + 300] = OBJECT_FOUNTAIN;
+    tiles.objects[400 * side + 20] = OBJECT_TORCH;
+    MapPatch* patch = CreateMapPatch(side, side);
+    TEST_TRUE(AddMapPatchChunk(patch, &tiles, 300 / MAP_FILE_CHUNK_SIZE, 100 / MAP_FILE_CHUNK_SIZE));
+    TEST_TRUE(AddMapPatchChunk(patch, &tiles, 20 / MAP_FILE_CHUNK_SIZE, 400 / MAP_FILE_CHUNK_SIZE));
+    TEST_TRUE(AppendMapFilePatch(MAP_FILE_TEST_PATH, patch));
+    DestroyMapPatch(patch);
+
+    long patchSize = GetFileSize(MAP_FILE_TEST_PATCH_PATH);
+    TEST_TRUE(patchSize > 0);
+    TEST_TRUE(patchSize * 50 < fullSize);
+
+    TileGrid loaded;
+    TEST_TRUE(LoadMapFile(MAP_FILE_TEST_PATH, &loaded, NULL, NULL));
+    TEST_EQUAL(memcmp(tiles.objects, loaded.objects, tiles.count), 0);
+    FreeTileGrid(&loaded);
+
+    FreeTileGrid(&tiles);
+    remove(MAP_FILE_TEST_PATH);
+    remove(MAP_FILE_TEST_PATCH_PATH);
+    return TEST_PASSED;
+}
+
+int run_map_file_tests(void) {
+    printf("\nRunning Map File Tests...\n");
+    int failures = 0;
+
+    failures += test_map_plane_coding();
+    failures += test_map_file_round_trip();
+    failures += test_map_file_lazy_reads();
+    failures += test_map_file_size();
+    failures += test_map_file_rejects_bad_files();
+    failures += test_map_file_patches();
+    failures += test_map_file_torn_patch();
+    failures += test_map_file_stale_patch();
+    failures += test_map_file_patch_size();
+
+    return failures;
+}
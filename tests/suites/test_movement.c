@@ -0,0 +1,178 @@
+#include "../include/test_suites.h"
+#include "../../include/collision_grid.h"
+#include "../../include/entity.h"
+#include "../../include/entity_pool.h"
+#include "../../include/entities/movement.h"
+#include "../../include/world.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MOVEMENT_TEST_SIZE 16
+#define MOVEMENT_TEST_SPEED 480.0f
+
+static Rectangle TileBox(float tileX, float tileY) {
+    return (Rectangle){ tileX * TILE_SIZE, tileY * TILE_SIZE, (float)TILE_SIZE, (float)TILE_SIZE };
+}
+
+static int test_sweep_contact(void) {
+    printf("Testing swept box contact...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(MOVEMENT_TEST_SIZE, MOVEMENT_TEST_SIZE, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+    for (int y = 0; y < MOVEMENT_TEST_SIZE; y++) SetCellBlocked(grid, 10, y, true);
+
+    // Clear motion runs to completion
+    SweepResult clear = SweepCollisionBox(grid, TileBox(2, 2), (Vector2){ 64.0f, 0.0f });
+    TEST_FALSE(clear.hit);
+    TEST_FLOAT_EQUAL(clear.time, 1.0f);
+    TEST_FLOAT_EQUAL(clear.position.x, 4.0f * TILE_SIZE);
+
+    // A fast mover stops flush against the wall instead of tunnelling
+    SweepResult fast = SweepCollisionBox(grid, TileBox(2, 2), (Vector2){ 20.0f * TILE_SIZE, 0.0f });
+    TEST_TRUE(fast.hit);
+    TEST_FLOAT_EQUAL(fast.time, 7.0f / 20.0f);
+    TEST_FLOAT_EQUAL(fast.position.x, 9.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(fast.normal.x, -1.0f);
+    TEST_FLOAT_EQUAL(fast.normal.y, 0.0f);
+
+    // Diagonal motion keeps its tangential part as the slide
+    SweepResult angled = SweepCollisionBox(grid, TileBox(8, 2), (Vector2){ 64.0f, 64.0f });
+    TEST_TRUE(angled.hit);
+    TEST_FLOAT_EQUAL(angled.time, 0.5f);
+    TEST_FLOAT_EQUAL(angled.position.y, 3.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(angled.slide.x, 0.0f);
+    TEST_FLOAT_EQUAL(angled.slide.y, 32.0f);
+
+    // Resting against the wall, moving along it is free and moving into it is not
+    TEST_FALSE(SweepCollisionBox(grid, TileBox(9, 2), (Vector2){ 0.0f, 100.0f }).hit);
+    SweepResult pressed = SweepCollisionBox(grid, TileBox(9, 2), (Vector2){ 5.0f, 0.0f });
+    TEST_TRUE(pressed.hit);
+    TEST_FLOAT_EQUAL(pressed.time, 0.0f);
+
+    DestroyCollisionGrid(grid);
+    return TEST_PASSED;
+}
+
+static int test_sweep_corners(void) {
+    printf("Testing swept box corners and slides...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(MOVEMENT_TEST_SIZE, MOVEMENT_TEST_SIZE, TILE_SIZE);
+    TEST_NOT_NULL(grid);
+
+    // An exact diagonal into a lone corner cell must not slip past it
+    SetCellBlocked(grid, 5, 5, true);
+    SweepResult corner = SweepCollisionBox(grid, TileBox(4, 4), (Vector2){ 32.0f, 32.0f });
+    TEST_TRUE(corner.hit);
+    TEST_FLOAT_EQUAL(corner.time, 0.0f);
+
+    // Sliding carries the box along the wall for the rest of the motion
+    bool hit = false;
+    Vector2 end = MoveCollisionBox(grid, TileBox(3.5f, 5), (Vector2){ 32.0f, 24.0f }, &hit);
+    TEST_TRUE(hit);
+    TEST_FLOAT_EQUAL(end.x, 4.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(end.y, 5.0f * TILE_SIZE + 24.0f);
+
+    // A box that starts inside a blocked cell can still leave it
+    SetCellBlocked(grid, 8, 8, true);
+    TEST_FALSE(SweepCollisionBox(grid, TileBox(8, 8), (Vector2){ -40.0f, 0.0f }).hit);
+
+    // The grid edge is a wall
+    SweepResult edge = SweepCollisionBox(grid, TileBox(1, 1), (Vector2){ -100.0f, 0.0f });
+    TEST_TRUE(edge.hit);
+    TEST_FLOAT_EQUAL(edge.position.x, 0.0f);
+
+    DestroyCollisionGrid(grid);
+    return TEST_PASSED;
+}
+
+static bool InitMovementTestWorld(World* world) {
+    memset(world, 0, sizeof(World));
+    world->width = MOVEMENT_TEST_SIZE;
+    world->height = MOVEMENT_TEST_SIZE;
+    world->collision = CreateCollisionGrid(MOVEMENT_TEST_SIZE, MOVEMENT_TEST_SIZE, TILE_SIZE);
+    if (!world->collision) return false;
+
+    for (int y = 0; y < MOVEMENT_TEST_SIZE; y++) SetCellBlocked(world->collision, 12, y, true);
+    return true;
+}
+
+static Entity* CreateMover(EntityPool* pool, Vector2 position, Vector2 velocity) {
+    Entity* entity = CreateEntity(pool, ENTITY_TYPE_NPC, position);
+    if (!entity) return NULL;
+
+    AddComponent(entity, COMPONENT_TRANSFORM);
+    AddComponent(entity, COMPONENT_PHYSICS);
+    GetTransformComponent(entity)->position = position;
+    PhysicsComponent* physics = GetPhysicsComponent(entity);
+    physics->isKinematic = false;
+    physics->moveVelocity = velocity;
+    return entity;
+}
+
+// Runs the pass for one second split into frames of the given length and
+// returns the number of fixed steps taken
+static int RunMovementSecond(EntityPool* pool, const World* world, float frameTime) {
+    MovementSystem* system = CreateMovementSystem();
+    if (!system) return 0;
+
+    int steps = 0;
+    int frames = (int)lroundf(1.0f / frameTime);
+    for (int i = 0; i < frames; i++) {
+        steps += UpdateMovementSystem(system, pool, world, NULL, frameTime);
+    }
+    DestroyMovementSystem(system);
+    return steps;
+}
+
+static int test_movement_pass(void) {
+    printf("Testing batched movement pass...\n");
+
+    World world;
+    TEST_TRUE(InitMovementTestWorld(&world));
+
+    // The same second of movement at two frame rates lands identically
+    Vector2 results[2][2];
+    const float frameTimes[2] = { 1.0f / 60.0f, 1.0f / 30.0f };
+    for (int run = 0; run < 2; run++) {
+        EntityPool* pool = CreateEntityPool(8);
+        TEST_NOT_NULL(pool);
+        Entity* runner = CreateMover(pool, (Vector2){ 2.0f * TILE_SIZE, 3.0f * TILE_SIZE },
+                                     (Vector2){ MOVEMENT_TEST_SPEED, 10.0f });
+        Entity* diver = CreateMover(pool, (Vector2){ 9.0f * TILE_SIZE, 1.0f * TILE_SIZE },
+                                    (Vector2){ MOVEMENT_TEST_SPEED / 4.0f, MOVEMENT_TEST_SPEED / 1.6f });
+        TEST_NOT_NULL(runner);
+        TEST_NOT_NULL(diver);
+
+        TEST_EQUAL(RunMovementSecond(pool, &world, frameTimes[run]), 60);
+        results[run][0] = GetTransformComponent(runner)->position;
+        results[run][1] = GetTransformComponent(diver)->position;
+
+        // The runner stopped at the wall; the diver slid down it
+        TEST_FLOAT_EQUAL(results[run][0].x, 11.0f * TILE_SIZE);
+        TEST_TRUE(GetPhysicsComponent(runner)->isBlocked);
+        TEST_FLOAT_EQUAL(results[run][1].x, 11.0f * TILE_SIZE);
+        TEST_TRUE(results[run][1].y > 10.0f * TILE_SIZE);
+        TEST_FALSE(GetPhysicsComponent(diver)->isBlocked);
+        TEST_FALSE(CheckCollisionGridRec(world.collision, GetMovementBox(diver, results[run][1])));
+
+        DestroyEntityPool(pool);
+    }
+
+    TEST_TRUE(results[1][0].x == results[0][0].x && results[1][0].y == results[0][0].y);
+    TEST_TRUE(results[1][1].x == results[0][1].x && results[1][1].y == results[0][1].y);
+
+    DestroyCollisionGrid(world.collision);
+    return TEST_PASSED;
+}
+
+int run_movement_tests(void) {
+    printf("\nRunning Movement Tests...\n");
+    int failures = 0;
+
+    failures += test_sweep_contact();
+    failures += test_sweep_corners();
+    failures += test_movement_pass();
+
+    return failures;
+}
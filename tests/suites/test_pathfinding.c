@@ -0,0 +1,182 @@
+#include "../include/test_suites.h"
+#include "../../include/world.h"
+#include "../../include/pathfinding.h"
+#include "../../include/estate_map.h"
+#include "../../include/tile_grid.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PATH_TEST_SIZE 48
+#define PATH_TEST_MAX_WAYPOINTS 256
+
+static bool InitPathTestWorld(World* world) {
+    memset(world, 0, sizeof(World));
+    world->width = PATH_TEST_SIZE;
+    world->height = PATH_TEST_SIZE;
+    return InitTileGrid(&world->tiles, PATH_TEST_SIZE * PATH_TEST_SIZE, TILE_FLOOR);
+}
+
+static void FreePathTestWorld(World* world) {
+    DestroyHPAGraph(world->pathGraph);
+    FreeTileGrid(&world->tiles);
+}
+
+// Walks the abstract path tile by tile, returning the step count or -1
+static int WalkPath(HPAGraph* graph, World* world, HPAPoint start, HPAPoint goal, bool* visited) {
+    HPAPoint waypoints[PATH_TEST_MAX_WAYPOINTS];
+    int count = FindHPAPath(graph, world, start, goal, waypoints, PATH_TEST_MAX_WAYPOINTS);
+    if (count < 0) return -1;
+
+    int steps = 0;
+    HPAPoint current = start;
+    for (int i = 0; i < count; i++) {
+        while (current.x != waypoints[i].x || current.y != waypoints[i].y) {
+            HPAPoint next;
+            if (!RefineHPAStep(graph, world, current, waypoints[i], &next)) return -1;
+            if (!IsWalkableGrid(world, next.x, next.y)) return -1;
+            if (abs(next.x - current.x) + abs(next.y - current.y) != 1) return -1;
+
+            current = next;
+            if (visited) visited[current.y * PATH_TEST_SIZE + current.x] = true;
+            steps++;
+        }
+    }
+
+    return (current.x == goal.x && current.y == goal.y) ? steps : -1;
+}
+
+static int test_hpa_open_map(void) {
+    printf("Testing HPA* on an open map...\n");
+
+    World world;
+    TEST_TRUE(InitPathTestWorld(&world));
+    HPAGraph* graph = GetWorldPathGraph(&world);
+    TEST_NOT_NULL(graph);
+    TEST_EQUAL(graph->chunksX, PATH_TEST_SIZE / HPA_CHUNK_SIZE);
+
+    HPAPoint start = { 1, 1 };
+    HPAPoint goal = { 46, 44 };
+    int steps = WalkPath(graph, &world, start, goal, NULL);
+    int manhattan = (goal.x - start.x) + (goal.y - start.y);
+    TEST_TRUE(steps >= manhattan);
+    TEST_TRUE(steps <= manhattan + manhattan / 4);
+
+    FreePathTestWorld(&world);
+    return TEST_PASSED;
+}
+
+static int test_hpa_repair(void) {
+    printf("Testing HPA* chunk repair...\n");
+
+    World world;
+    TEST_TRUE(InitPathTestWorld(&world));
+    HPAGraph* graph = GetWorldPathGraph(&world);
+    TEST_NOT_NULL(graph);
+
+    // Wall across the map with a single gap, placed after the graph exists
+    const int wallX = 20;
+    const int gapY = 40;
+    for (int y = 0; y < PATH_TEST_SIZE; y++) {
+        if (y != gapY) SetTile(&world, wallX, y, TILE_WALL);
+    }
+
+    HPAPoint start = { 5, 5 };
+    HPAPoint goal = { 35, 5 };
+    bool visited[PATH_TEST_SIZE * PATH_TEST_SIZE] = { false };
+    TEST_TRUE(WalkPath(graph, &world, start, goal, visited) > 0);
+    TEST_TRUE(visited[gapY * PATH_TEST_SIZE + wallX]);
+
+    // Closing the gap disconnects the halves
+    SetTile(&world, wallX, gapY, TILE_WALL);
+    HPAPoint waypoints[PATH_TEST_MAX_WAYPOINTS];
+    TEST_EQUAL(FindHPAPath(graph, &world, start, goal, waypoints, PATH_TEST_MAX_WAYPOINTS), -1);
+
+    // Blocking objects count as obstacles too
+    SetTile(&world, wallX, gapY, TILE_FLOOR);
+    TEST_TRUE(FindHPAPath(graph, &world, start, goal, waypoints, PATH_TEST_MAX_WAYPOINTS) > 0);
+    SetMapObjectAt(&world, wallX, gapY, OBJECT_ROCK);
+    TEST_EQUAL(FindHPAPath(graph, &world, start, goal, waypoints, PATH_TEST_MAX_WAYPOINTS), -1);
+
+    FreePathTestWorld(&world);
+    return TEST_PASSED;
+}
+
+static int test_path_follower(void) {
+    printf("Testing lazy path following...\n");
+
+    World world;
+    TEST_TRUE(InitPathTestWorld(&world));
+    for (int y = 0; y < PATH_TEST_SIZE - 4; y++) {
+        world.tiles.types[y * PATH_TEST_SIZE + 24] = TILE_WATER;
+    }
+    HPAGraph* graph = GetWorldPathGraph(&world);
+    TEST_NOT_NULL(graph);
+
+    PathFollower path;
+    Vector2 position = { 2 * TILE_SIZE, 2 * TILE_SIZE };
+    Vector2 goal = { 40 * TILE_SIZE, 2 * TILE_SIZE };
+    TEST_TRUE(SetPathGoal(&path, graph, &world, position, goal));
+
+    // Snap to each target the follower hands out
+    Vector2 target;
+    int moves = 0;
+    while (GetPathTarget(&path, graph, &world, position, &target) && moves < 1000) {
+        TEST_TRUE(IsWalkable(&world, target));
+        position = target;
+        moves++;
+    }
+
+    TEST_FLOAT_EQUAL(position.x, goal.x);
+    TEST_FLOAT_EQUAL(position.y, goal.y);
+    TEST_TRUE(moves < 1000);
+
+    FreePathTestWorld(&world);
+    return TEST_PASSED;
+}
+
+static int test_path_follower_table(void) {
+    printf("Testing path follower table...\n");
+
+    PathFollowerTable* table = CreatePathFollowerTable();
+    TEST_NOT_NULL(table);
+
+    // A handle keeps finding its owner's follower
+    int first = PATH_FOLLOWER_NONE;
+    int second = PATH_FOLLOWER_NONE;
+    PathFollower* path = GetPathFollower(table, &first, 7, 0);
+    TEST_NOT_NULL(path);
+    TEST_TRUE(first != PATH_FOLLOWER_NONE);
+    path->active = true;
+    TEST_TRUE(GetPathFollower(table, &second, 8, 0) != path);
+    TEST_TRUE(second != first);
+    TEST_TRUE(GetPathFollower(table, &first, 7, 10) == path);
+    TEST_TRUE(path->active);
+
+    // An idle slot goes to a new owner, and the old one starts over elsewhere
+    int third = PATH_FOLLOWER_NONE;
+    uint64_t later = 10 + PATH_FOLLOWER_IDLE_TICKS;
+    GetPathFollower(table, &second, 8, later);
+    TEST_TRUE(GetPathFollower(table, &third, 9, later) == path);
+    TEST_EQUAL(third, first);
+    TEST_FALSE(path->active);
+    PathFollower* moved = GetPathFollower(table, &first, 7, later);
+    TEST_TRUE(moved != path);
+    TEST_TRUE(first != third);
+    TEST_EQUAL(table->count, 3);
+
+    DestroyPathFollowerTable(table);
+    return TEST_PASSED;
+}
+
+int run_pathfinding_tests(void) {
+    printf("\nRunning Pathfinding Tests...\n");
+    int failures = 0;
+
+    failures += test_hpa_open_map();
+    failures += test_hpa_repair();
+    failures += test_path_follower();
+    failures += test_path_follower_table();
+
+    return failures;
+}
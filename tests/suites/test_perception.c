@@ -0,0 +1,78 @@
+#include "../include/test_suites.h"
+#include "../../include/entity.h"
+#include "../../include/entity_pool.h"
+#include "../../include/entities/perception.h"
+#include <stdio.h>
+
+static int test_perception_player_masks(void) {
+    printf("Testing perception player masks...\n");
+
+    EntityPool* pool = CreateEntityPool(16);
+    TEST_NOT_NULL(pool);
+    PerceptionSystem* perception = CreatePerceptionSystem();
+    TEST_NOT_NULL(perception);
+
+    // Odd count so the last vector is partially padded
+    const float offsets[] = { 0.0f, 50.0f, 199.0f, 201.0f, 399.0f, 401.0f, 1000.0f };
+    const int agentCount = (int)(sizeof(offsets) / sizeof(offsets[0]));
+    Entity* agents[7];
+    for (int i = 0; i < agentCount; i++) {
+        agents[i] = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 100.0f + offsets[i], 100.0f });
+        TEST_NOT_NULL(agents[i]);
+        GetAIComponent(agents[i])->detectionRadius = 200.0f;
+    }
+
+    UpdatePerception(perception, pool, (Vector2){ 100.0f, 100.0f });
+
+    for (int i = 0; i < agentCount; i++) {
+        uint32_t mask = GetAIComponent(agents[i])->perception;
+        bool detected = offsets[i] < 200.0f;
+        bool inRange = offsets[i] <= 400.0f;
+        TEST_TRUE(((mask & PERCEPTION_PLAYER_DETECTED) != 0) == detected);
+        TEST_TRUE(((mask & PERCEPTION_PLAYER_IN_RANGE) != 0) == inRange);
+    }
+
+    DestroyPerceptionSystem(perception);
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+static int test_perception_stimuli(void) {
+    printf("Testing perception stimuli...\n");
+
+    EntityPool* pool = CreateEntityPool(8);
+    TEST_NOT_NULL(pool);
+    PerceptionSystem* perception = CreatePerceptionSystem();
+    TEST_NOT_NULL(perception);
+
+    Entity* nearNoise = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 0.0f, 0.0f });
+    Entity* farNoise = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 500.0f, 0.0f });
+    TEST_NOT_NULL(nearNoise);
+    TEST_NOT_NULL(farNoise);
+
+    int stimulus = AddPerceptionStimulus(perception, (Vector2){ 10.0f, 0.0f }, 50.0f);
+    TEST_EQUAL(stimulus, 0);
+
+    UpdatePerception(perception, pool, (Vector2){ 5000.0f, 5000.0f });
+    TEST_TRUE(GetAIComponent(nearNoise)->perception & PERCEPTION_STIMULUS_BIT(stimulus));
+    TEST_FALSE(GetAIComponent(farNoise)->perception & PERCEPTION_STIMULUS_BIT(stimulus));
+
+    // Stimuli only last one update
+    TEST_EQUAL(perception->stimulusCount, 0);
+    UpdatePerception(perception, pool, (Vector2){ 5000.0f, 5000.0f });
+    TEST_FALSE(GetAIComponent(nearNoise)->perception & PERCEPTION_STIMULUS_BIT(stimulus));
+
+    DestroyPerceptionSystem(perception);
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+int run_perception_tests(void) {
+    printf("\nRunning Perception Tests...\n");
+    int failures = 0;
+
+    failures += test_perception_player_masks();
+    failures += test_perception_stimuli();
+
+    return failures;
+}
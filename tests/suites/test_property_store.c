@@ -0,0 +1,106 @@
+#include "../include/test_suites.h"
+#include "../../include/property_store.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PROPERTY_TEST_SETS 300
+
+static int test_property_store_parsing(void) {
+    printf("Testing property set parsing...\n");
+
+    PropertyStore* store = CreatePropertyStore();
+    TEST_NOT_NULL(store);
+
+    uint16_t id = InternPropertySet(store, " { \"name\" : \"Old \\\"Oak\\\"\", \"age\": 120.5,"
+                                           " \"lit\": false, \"owner\": null, \"note\": \"caf\\u00e9\" } ");
+    TEST_TRUE(id != PROPERTY_SET_NONE);
+
+    // Keys sorted, spaces gone, escapes kept only where needed
+    const PropertySet* set = GetPropertySet(store, id);
+    TEST_NOT_NULL(set);
+    TEST_EQUAL(set->count, 5);
+    TEST_TRUE(strcmp(set->json, "{\"age\":120.5,\"lit\":false,\"name\":\"Old \\\"Oak\\\"\","
+                                "\"note\":\"caf\xc3\xa9\",\"owner\":null}") == 0);
+
+    // Values come back typed
+    const PropertyValue* age = GetPropertyValue(store, id, FindPropertyKey(store, "age"));
+    TEST_NOT_NULL(age);
+    TEST_EQUAL(age->type, PROPERTY_NUMBER);
+    TEST_FLOAT_EQUAL((float)age->number, 120.5f);
+    const PropertyValue* name = GetPropertyValue(store, id, FindPropertyKey(store, "name"));
+    TEST_EQUAL(name->type, PROPERTY_STRING);
+    TEST_TRUE(strcmp(name->string, "Old \"Oak\"") == 0);
+    TEST_EQUAL(GetPropertyValue(store, id, FindPropertyKey(store, "lit"))->type, PROPERTY_BOOL);
+    TEST_FALSE(GetPropertyValue(store, id, FindPropertyKey(store, "lit"))->boolean);
+    TEST_EQUAL(GetPropertyValue(store, id, FindPropertyKey(store, "owner"))->type, PROPERTY_NULL);
+
+    // Unknown keys and ids find nothing
+    TEST_EQUAL(FindPropertyKey(store, "height"), PROPERTY_KEY_NONE);
+    TEST_NULL(GetPropertyValue(store, id, PROPERTY_KEY_NONE));
+    TEST_NULL(GetPropertySet(store, PROPERTY_SET_NONE));
+    TEST_NULL(GetPropertySet(store, (uint16_t)(id + 1)));
+
+    // Only flat, well-formed objects are taken
+    TEST_EQUAL(InternPropertySet(store, "[1, 2]"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": {\"b\": 1}}"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": 01}"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": 1,}"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": \"\\u0000\"}"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": 1} x"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, "{\"a\": 1e999}"), PROPERTY_SET_NONE);
+    TEST_EQUAL(InternPropertySet(store, NULL), PROPERTY_SET_NONE);
+
+    DestroyPropertyStore(store);
+    return TEST_PASSED;
+}
+
+static int test_property_store_dedup(void) {
+    printf("Testing property set deduplication...\n");
+
+    PropertyStore* store = CreatePropertyStore();
+    TEST_NOT_NULL(store);
+
+    // The same properties however written are one set
+    uint16_t first = InternPropertySet(store, "{\"sign\":\"east\",\"lit\":true}");
+    TEST_EQUAL(InternPropertySet(store, "{ \"lit\" : true , \"sign\" : \"east\" }"), first);
+    TEST_EQUAL(InternPropertySet(store, "{\"lit\":true,\"sign\":\"e\\u0061st\"}"), first);
+    TEST_EQUAL(InternPropertySet(store, "{\"sign\":\"west\",\"lit\":true,\"sign\":\"east\"}"), first);
+    TEST_TRUE(InternPropertySet(store, "{\"lit\":1.0,\"sign\":\"east\"}") != first);
+    TEST_EQUAL(store->setCount, 3);
+
+    // An empty object is a set of its own
+    uint16_t empty = InternPropertySet(store, "{}");
+    TEST_TRUE(empty != PROPERTY_SET_NONE);
+    TEST_EQUAL(GetPropertySet(store, empty)->count, 0);
+    TEST_EQUAL(InternPropertySet(store, " { } "), empty);
+
+    // Many sets keep distinct ids and shared keys
+    uint16_t ids[PROPERTY_TEST_SETS];
+    for (int i = 0; i < PROPERTY_TEST_SETS; i++) {
+        char json[64];
+        snprintf(json, sizeof(json), "{\"lit\":true,\"sign\":%d}", i);
+        ids[i] = InternPropertySet(store, json);
+        TEST_TRUE(ids[i] != PROPERTY_SET_NONE);
+    }
+    int sign = FindPropertyKey(store, "sign");
+    for (int i = 0; i < PROPERTY_TEST_SETS; i++) {
+        char json[64];
+        snprintf(json, sizeof(json), "{\"sign\":%d,\"lit\":true}", i);
+        TEST_EQUAL(InternPropertySet(store, json), ids[i]);
+        TEST_FLOAT_EQUAL((float)GetPropertyValue(store, ids[i], sign)->number, (float)i);
+    }
+    TEST_EQUAL(store->setCount, 4 + PROPERTY_TEST_SETS);
+
+    DestroyPropertyStore(store);
+    return TEST_PASSED;
+}
+
+int run_property_store_tests(void) {
+    printf("\nRunning Property Store Tests...\n");
+    int failures = 0;
+
+    failures += test_property_store_parsing();
+    failures += test_property_store_dedup();
+
+    return failures;
+}
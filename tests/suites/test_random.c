@@ -0,0 +1,83 @@
+#include "../include/test_suites.h"
+#include "../../include/random.h"
+#include "../../include/entity_pool.h"
+#include <stdio.h>
+
+static int test_random_determinism(void) {
+    printf("Testing counter-based random determinism...\n");
+
+    RandomStream a = CreateEntityRandomStream(1234, 7, RANDOM_PURPOSE_AI_PATROL, 42);
+    RandomStream b = CreateEntityRandomStream(1234, 7, RANDOM_PURPOSE_AI_PATROL, 42);
+    for (int i = 0; i < 64; i++) {
+        uint32_t valueA = NextRandom(&a);
+        uint32_t valueB = NextRandom(&b);
+        TEST_TRUE(valueA == valueB);
+    }
+
+    // Any change in the key gives a different stream
+    RandomStream base = CreateEntityRandomStream(1234, 7, RANDOM_PURPOSE_AI_PATROL, 42);
+    RandomStream otherEntity = CreateEntityRandomStream(1234, 8, RANDOM_PURPOSE_AI_PATROL, 42);
+    RandomStream otherTick = CreateEntityRandomStream(1234, 7, RANDOM_PURPOSE_AI_PATROL, 43);
+    RandomStream otherSeed = CreateEntityRandomStream(1235, 7, RANDOM_PURPOSE_AI_PATROL, 42);
+    RandomStream otherPurpose = CreateEntityRandomStream(1234, 7, RANDOM_PURPOSE_AI_IDLE, 42);
+    uint32_t first = NextRandom(&base);
+    TEST_TRUE(first != NextRandom(&otherEntity));
+    TEST_TRUE(first != NextRandom(&otherTick));
+    TEST_TRUE(first != NextRandom(&otherSeed));
+    TEST_TRUE(first != NextRandom(&otherPurpose));
+
+    return TEST_PASSED;
+}
+
+static int test_random_ranges(void) {
+    printf("Testing random ranges...\n");
+
+    RandomStream rng = CreateRandomStream(99, RANDOM_PURPOSE_GEN_ROOMS, 0);
+    int counts[3] = { 0, 0, 0 };
+    for (int i = 0; i < 3000; i++) {
+        int value = NextRandomInt(&rng, 0, 2);
+        TEST_TRUE(value >= 0 && value <= 2);
+        counts[value]++;
+
+        float f = NextRandomFloat(&rng);
+        TEST_TRUE(f >= 0.0f && f < 1.0f);
+
+        int signedValue = NextRandomInt(&rng, -100, 100);
+        TEST_TRUE(signedValue >= -100 && signedValue <= 100);
+    }
+
+    // Every bucket gets a reasonable share
+    for (int i = 0; i < 3; i++) {
+        TEST_TRUE(counts[i] > 800);
+    }
+
+    return TEST_PASSED;
+}
+
+static int test_entity_ids_unique(void) {
+    printf("Testing entity ids...\n");
+
+    EntityPool* pool = CreateEntityPool(8);
+    TEST_NOT_NULL(pool);
+
+    Entity* first = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 0, 0 });
+    Entity* second = CreateEntity(pool, ENTITY_TYPE_NPC, (Vector2){ 0, 0 });
+    TEST_NOT_NULL(first);
+    TEST_NOT_NULL(second);
+    TEST_TRUE(first->id != 0);
+    TEST_TRUE(first->id != second->id);
+
+    DestroyEntityPool(pool);
+    return TEST_PASSED;
+}
+
+int run_random_tests(void) {
+    printf("\nRunning Random Tests...\n");
+    int failures = 0;
+
+    failures += test_random_determinism();
+    failures += test_random_ranges();
+    failures += test_entity_ids_unique();
+
+    return failures;
+}
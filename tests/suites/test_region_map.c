@@ -0,0 +1,208 @@
+#include "../include/test_suites.h"
+#include "../../include/region_map.h"
+#include "../../include/collision_grid.h"
+#include "../../include/random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REGION_TEST_WIDTH 24
+#define REGION_TEST_HEIGHT 18
+#define REGION_TEST_EDITS 2000
+
+// Reference labelling by flood fill, -1 for blocked tiles
+static void FloodLabels(const bool* open, int width, int height, int* labels, int* queue) {
+    for (int i = 0; i < width * height; i++) labels[i] = -1;
+
+    int next = 0;
+    for (int i = 0; i < width * height; i++) {
+        if (!open[i] || labels[i] >= 0) continue;
+
+        int head = 0;
+        int tail = 0;
+        labels[i] = next;
+        queue[tail++] = i;
+        while (head < tail) {
+            int tile = queue[head++];
+            int x = tile % width;
+            int y = tile / width;
+            int neighbors[4] = {
+                x + 1 < width ? tile + 1 : -1,
+                y + 1 < height ? tile + width : -1,
+                x > 0 ? tile - 1 : -1,
+                y > 0 ? tile - width : -1
+            };
+            for (int n = 0; n < 4; n++) {
+                if (neighbors[n] < 0 || !open[neighbors[n]] || labels[neighbors[n]] >= 0) continue;
+                labels[neighbors[n]] = next;
+                queue[tail++] = neighbors[n];
+            }
+        }
+        next++;
+    }
+}
+
+// True when region ids partition the open tiles exactly like the flood fill
+static bool MatchesFloodLabels(RegionMap* regions, const bool* open, int width, int height) {
+    int count = width * height;
+    int* labels = (int*)malloc((size_t)count * sizeof(int));
+    int* queue = (int*)malloc((size_t)count * sizeof(int));
+    uint32_t* regionOf = (uint32_t*)malloc((size_t)count * sizeof(uint32_t));
+    FloodLabels(open, width, height, labels, queue);
+
+    bool matches = true;
+    for (int i = 0; i < count; i++) regionOf[i] = REGION_NONE;
+    for (int i = 0; i < count && matches; i++) {
+        uint32_t region = GetTileRegion(regions, i % width, i / width);
+        if (labels[i] < 0) {
+            matches = region == REGION_NONE;
+            continue;
+        }
+        if (region == REGION_NONE) {
+            matches = false;
+        } else if (regionOf[labels[i]] == REGION_NONE) {
+            regionOf[labels[i]] = region;
+        } else {
+            matches = regionOf[labels[i]] == region;
+        }
+    }
+
+    // Distinct components must not share a region
+    for (int a = 0; a < count && matches; a++) {
+        if (regionOf[a] == REGION_NONE) continue;
+        for (int b = a + 1; b < count && matches; b++) {
+            matches = regionOf[a] != regionOf[b];
+        }
+    }
+
+    free(labels);
+    free(queue);
+    free(regionOf);
+    return matches;
+}
+
+static int test_region_map_rebuild(void) {
+    printf("Testing region labelling from collision...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(12, 10, 32);
+    RegionMap* regions = CreateRegionMap(12, 10);
+    TEST_NOT_NULL(grid);
+    TEST_NOT_NULL(regions);
+    TEST_EQUAL(GetTileRegion(regions, 0, 0), REGION_NONE);
+
+    // A walled courtyard from (3,3) to (8,7)
+    for (int x = 3; x <= 8; x++) {
+        SetCellBlocked(grid, x, 3, true);
+        SetCellBlocked(grid, x, 7, true);
+    }
+    for (int y = 3; y <= 7; y++) {
+        SetCellBlocked(grid, 3, y, true);
+        SetCellBlocked(grid, 8, y, true);
+    }
+    RebuildRegionMap(regions, grid);
+
+    TEST_TRUE(AreTilesConnected(regions, 0, 0, 11, 9));
+    TEST_TRUE(AreTilesConnected(regions, 4, 4, 7, 6));
+    TEST_FALSE(AreTilesConnected(regions, 0, 0, 5, 5));
+    TEST_FALSE(AreTilesConnected(regions, 3, 3, 3, 3));
+    TEST_EQUAL(GetTileRegion(regions, -1, 0), REGION_NONE);
+    TEST_EQUAL(GetTileRegion(regions, 12, 0), REGION_NONE);
+
+    // Mismatched sizes are ignored
+    CollisionGrid* small = CreateCollisionGrid(4, 4, 32);
+    RebuildRegionMap(regions, small);
+    TEST_FALSE(AreTilesConnected(regions, 0, 0, 5, 5));
+
+    DestroyCollisionGrid(small);
+    DestroyCollisionGrid(grid);
+    DestroyRegionMap(regions);
+    return TEST_PASSED;
+}
+
+static int test_region_map_edits(void) {
+    printf("Testing region splits and merges...\n");
+
+    CollisionGrid* grid = CreateCollisionGrid(10, 5, 32);
+    RegionMap* regions = CreateRegionMap(10, 5);
+    RebuildRegionMap(regions, grid);
+    uint32_t open = GetTileRegion(regions, 0, 0);
+    TEST_TRUE(open != REGION_NONE);
+
+    // A wall down column 7 cuts the map in two, one tile at a time
+    for (int y = 0; y < 5; y++) {
+        TEST_TRUE(AreTilesConnected(regions, 0, 0, 9, 4));
+        UpdateRegionTile(regions, 7, y, false);
+    }
+    TEST_FALSE(AreTilesConnected(regions, 0, 0, 9, 4));
+    TEST_TRUE(AreTilesConnected(regions, 8, 0, 9, 4));
+
+    // The larger side keeps its label, only the cut-off side is relabelled
+    TEST_EQUAL(GetTileRegion(regions, 0, 0), open);
+    TEST_TRUE(GetTileRegion(regions, 9, 4) != open);
+
+    // Blocking an already blocked tile changes nothing
+    UpdateRegionTile(regions, 7, 2, false);
+    TEST_FALSE(AreTilesConnected(regions, 0, 0, 9, 4));
+
+    // A door through the wall joins the sides again
+    UpdateRegionTile(regions, 7, 2, true);
+    TEST_TRUE(AreTilesConnected(regions, 0, 0, 9, 4));
+    TEST_TRUE(AreTilesConnected(regions, 7, 2, 8, 2));
+
+    // Edits out of bounds are ignored
+    UpdateRegionTile(regions, -1, 0, false);
+    UpdateRegionTile(regions, 10, 0, true);
+    TEST_TRUE(AreTilesConnected(regions, 0, 0, 9, 4));
+
+    DestroyCollisionGrid(grid);
+    DestroyRegionMap(regions);
+    return TEST_PASSED;
+}
+
+static int test_region_map_matches_flood_fill(void) {
+    printf("Testing region edits against a flood fill...\n");
+
+    int width = REGION_TEST_WIDTH;
+    int height = REGION_TEST_HEIGHT;
+    bool open[REGION_TEST_WIDTH * REGION_TEST_HEIGHT];
+    CollisionGrid* grid = CreateCollisionGrid(width, height, 32);
+    RegionMap* regions = CreateRegionMap(width, height);
+
+    // Start from a maze-like mix so edits cut and join many regions
+    RandomStream rng = CreateRandomStream(42, 0, 0);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool blocked = NextRandomInt(&rng, 0, 99) < 35;
+            open[y * width + x] = !blocked;
+            SetCellBlocked(grid, x, y, blocked);
+        }
+    }
+    RebuildRegionMap(regions, grid);
+    TEST_TRUE(MatchesFloodLabels(regions, open, width, height));
+
+    bool matches = true;
+    for (int edit = 0; edit < REGION_TEST_EDITS && matches; edit++) {
+        int x = NextRandomInt(&rng, 0, width - 1);
+        int y = NextRandomInt(&rng, 0, height - 1);
+        open[y * width + x] = !open[y * width + x];
+        UpdateRegionTile(regions, x, y, open[y * width + x]);
+        if (edit % 25 == 0) matches = MatchesFloodLabels(regions, open, width, height);
+    }
+    TEST_TRUE(matches);
+    TEST_TRUE(MatchesFloodLabels(regions, open, width, height));
+
+    DestroyCollisionGrid(grid);
+    DestroyRegionMap(regions);
+    return TEST_PASSED;
+}
+
+int run_region_map_tests(void) {
+    printf("\nRunning Region Map Tests...\n");
+    int failures = 0;
+
+    failures += test_region_map_rebuild();
+    failures += test_region_map_edits();
+    failures += test_region_map_matches_flood_fill();
+
+    return failures;
+}
@@ -0,0 +1,170 @@
+#include "../include/test_suites.h"
+#include "../../include/resonance_field.h"
+#include "../../include/collision_grid.h"
+#include "../../include/tile_grid.h"
+#include "../../include/random.h"
+#include <stdio.h>
+
+#define RESONANCE_TEST_SIZE 48
+#define RESONANCE_TEST_EDITS 500
+
+// Level as the stored byte, so expectations are exact
+static int GetLevelByte(const ResonanceField* field, int x, int y) {
+    return (int)(GetResonanceLevel(field, x, y) * 255.0f + 0.5f);
+}
+
+static uint32_t GetChunkVersion(const ResonanceField* field, int chunkX, int chunkY) {
+    return GetResonanceChunk(field, chunkX, chunkY)->version;
+}
+
+static int test_resonance_field_falloff(void) {
+    printf("Testing resonance falloff and walls...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, 40 * 20, TILE_FLOOR));
+    tiles.objects[10 * 40 + 10] = OBJECT_TORCH;
+    CollisionGrid* grid = CreateCollisionGrid(40, 20, TILE_SIZE);
+    ResonanceField* field = CreateResonanceField(40, 20);
+    TEST_NOT_NULL(grid);
+    TEST_NOT_NULL(field);
+
+    // Every chunk is computed after a rebuild
+    RebuildResonanceField(field, &tiles, grid);
+    TEST_EQUAL(UpdateResonanceField(field), 3 * 2);
+    TEST_EQUAL(UpdateResonanceField(field), 0);
+
+    // A torch is 0.8 at its tile and fades to nothing five steps out
+    TEST_EQUAL(GetLevelByte(field, 10, 10), 204);
+    TEST_EQUAL(GetLevelByte(field, 12, 10), 122);
+    TEST_EQUAL(GetLevelByte(field, 11, 11), 122);
+    TEST_EQUAL(GetLevelByte(field, 14, 10), 41);
+    TEST_EQUAL(GetLevelByte(field, 15, 10), 0);
+    TEST_EQUAL(GetLevelByte(field, 10, 15), 0);
+    TEST_EQUAL(GetLevelByte(field, -1, 10), 0);
+    TEST_NULL(GetResonanceChunk(field, 3, 0));
+
+    // A wall is lit but hides what is behind it
+    for (int y = 0; y < 20; y++) {
+        SetCellBlocked(grid, 12, y, true);
+    }
+    RebuildResonanceField(field, &tiles, grid);
+    UpdateResonanceField(field);
+    TEST_EQUAL(GetLevelByte(field, 12, 10), 122);
+    TEST_EQUAL(GetLevelByte(field, 13, 10), 0);
+    TEST_EQUAL(GetLevelByte(field, 13, 11), 0);
+
+    // A gap lets it through the long way round
+    UpdateResonanceTile(field, 12, 11, OBJECT_NONE, true);
+    TEST_EQUAL(UpdateResonanceField(field), 1);
+    TEST_EQUAL(GetLevelByte(field, 13, 11), 41);
+    TEST_EQUAL(GetLevelByte(field, 13, 10), 0);
+
+    DestroyResonanceField(field);
+    DestroyCollisionGrid(grid);
+    FreeTileGrid(&tiles);
+    return TEST_PASSED;
+}
+
+static int test_resonance_field_incremental(void) {
+    printf("Testing resonance recompute stays local...\n");
+
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, 64 * 64, TILE_FLOOR));
+    tiles.objects[8 * 64 + 8] = OBJECT_FOUNTAIN;
+    ResonanceField* field = CreateResonanceField(64, 64);
+    RebuildResonanceField(field, &tiles, NULL);
+    TEST_EQUAL(UpdateResonanceField(field), 16);
+    TEST_EQUAL(GetLevelByte(field, 8, 8), 255);
+    uint32_t far = GetChunkVersion(field, 3, 3);
+
+    // A new torch recomputes only the chunk it reaches
+    UpdateResonanceTile(field, 40, 40, OBJECT_TORCH, true);
+    TEST_EQUAL(UpdateResonanceField(field), 1);
+    TEST_EQUAL(GetLevelByte(field, 40, 40), 204);
+    TEST_EQUAL(GetLevelByte(field, 8, 8), 255);
+    TEST_EQUAL(GetChunkVersion(field, 3, 3), far);
+
+    // Re-applying the same object changes nothing; removing it clears it
+    UpdateResonanceTile(field, 40, 40, OBJECT_TORCH, true);
+    TEST_EQUAL(UpdateResonanceField(field), 0);
+    UpdateResonanceTile(field, 40, 40, OBJECT_NONE, true);
+    TEST_EQUAL(UpdateResonanceField(field), 1);
+    TEST_EQUAL(GetLevelByte(field, 40, 40), 0);
+
+    // Walls out of every emitter's reach cost nothing
+    UpdateResonanceTile(field, 60, 60, OBJECT_NONE, false);
+    TEST_EQUAL(UpdateResonanceField(field), 0);
+    UpdateResonanceTile(field, 9, 8, OBJECT_NONE, false);
+    TEST_EQUAL(UpdateResonanceField(field), 1);
+
+    // An emitter on a chunk corner spreads into all four chunks
+    UpdateResonanceTile(field, 15, 47, OBJECT_TORCH, true);
+    TEST_EQUAL(UpdateResonanceField(field), 4);
+    TEST_EQUAL(GetLevelByte(field, 16, 48), 122);
+
+    DestroyResonanceField(field);
+    FreeTileGrid(&tiles);
+    return TEST_PASSED;
+}
+
+static int test_resonance_field_matches_rebuild(void) {
+    printf("Testing resonance edits against a full rebuild...\n");
+
+    int size = RESONANCE_TEST_SIZE;
+    TileGrid tiles;
+    TEST_TRUE(InitTileGrid(&tiles, (size_t)(size * size), TILE_FLOOR));
+    CollisionGrid* grid = CreateCollisionGrid(size, size, TILE_SIZE);
+    ResonanceField* field = CreateResonanceField(size, size);
+    ResonanceField* reference = CreateResonanceField(size, size);
+
+    RandomStream rng = CreateRandomStream(7, 0, 0);
+    for (int i = 0; i < size * size; i++) {
+        if (NextRandomInt(&rng, 0, 99) < 20) SetCellBlocked(grid, i % size, i / size, true);
+        if (NextRandomInt(&rng, 0, 99) < 2) tiles.objects[i] = NextRandomInt(&rng, 0, 1) ? OBJECT_TORCH : OBJECT_FOUNTAIN;
+    }
+    RebuildResonanceField(field, &tiles, grid);
+    UpdateResonanceField(field);
+
+    for (int edit = 0; edit < RESONANCE_TEST_EDITS; edit++) {
+        int x = NextRandomInt(&rng, 0, size - 1);
+        int y = NextRandomInt(&rng, 0, size - 1);
+        int roll = NextRandomInt(&rng, 0, 3);
+        if (roll == 0) {
+            tiles.objects[y * size + x] = OBJECT_TORCH;
+        } else if (roll == 1) {
+            tiles.objects[y * size + x] = OBJECT_NONE;
+        } else {
+            SetCellBlocked(grid, x, y, !IsCellBlocked(grid, x, y));
+        }
+        UpdateResonanceTile(field, x, y, (ObjectType)tiles.objects[y * size + x], !IsCellBlocked(grid, x, y));
+        if (edit % 10 == 0) UpdateResonanceField(field);
+    }
+    UpdateResonanceField(field);
+
+    RebuildResonanceField(reference, &tiles, grid);
+    UpdateResonanceField(reference);
+    int mismatches = 0;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            if (GetLevelByte(field, x, y) != GetLevelByte(reference, x, y)) mismatches++;
+        }
+    }
+    TEST_EQUAL(mismatches, 0);
+
+    DestroyResonanceField(field);
+    DestroyResonanceField(reference);
+    DestroyCollisionGrid(grid);
+    FreeTileGrid(&tiles);
+    return TEST_PASSED;
+}
+
+int run_resonance_field_tests(void) {
+    printf("\nRunning Resonance Field Tests...\n");
+    int failures = 0;
+
+    failures += test_resonance_field_falloff();
+    failures += test_resonance_field_incremental();
+    failures += test_resonance_field_matches_rebuild();
+
+    return failures;
+}
@@ -0,0 +1,143 @@
+#include "../include/test_suites.h"
+#include "../../include/tile_grid.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TILE_GRID_TEST_SIZE 1024
+
+static int test_tile_grid_planes(void) {
+    printf("Testing packed tile planes...\n");
+
+    TileGrid grid;
+    size_t count = (size_t)TILE_GRID_TEST_SIZE * TILE_GRID_TEST_SIZE;
+    TEST_TRUE(InitTileGrid(&grid, count, TILE_GRASS));
+    TEST_EQUAL(grid.count, count);
+
+    // One byte per tile in each plane
+    TEST_EQUAL(sizeof(grid.types[0]) + sizeof(grid.objects[0]), 2);
+
+    Tile tile = GetGridTile(&grid, count - 1);
+    TEST_EQUAL_ENUM(tile.type, TILE_GRASS);
+    TEST_EQUAL_ENUM(tile.objectType, OBJECT_NONE);
+
+    SetGridTile(&grid, 42, CreateTile(TILE_WALL, OBJECT_TORCH));
+    TEST_EQUAL_ENUM(GetGridTileType(&grid, 42), TILE_WALL);
+    TEST_EQUAL_ENUM(GetGridObjectType(&grid, 42), OBJECT_TORCH);
+    TEST_EQUAL_ENUM(GetGridTileType(&grid, 43), TILE_GRASS);
+
+    FillTileGrid(&grid, TILE_FLOOR);
+    TEST_EQUAL_ENUM(GetGridTileType(&grid, 42), TILE_FLOOR);
+    TEST_EQUAL_ENUM(GetGridObjectType(&grid, 42), OBJECT_NONE);
+
+    FreeTileGrid(&grid);
+    TEST_NULL(grid.types);
+    TEST_NULL(grid.objects);
+    return TEST_PASSED;
+}
+
+static int test_tile_properties_table(void) {
+    printf("Testing shared tile properties...\n");
+
+    TEST_TRUE(GetTileProperties(TILE_GRASS)->isWalkable);
+    TEST_TRUE(GetTileProperties(TILE_FLOOR)->isWalkable);
+    TEST_FALSE(GetTileProperties(TILE_WALL)->isWalkable);
+    TEST_FALSE(GetTileProperties(TILE_WATER)->isWalkable);
+    TEST_TRUE(GetTileProperties(TILE_DOOR)->isInteractive);
+
+    // Every tile of a type shares one entry
+    TEST_TRUE(GetTileProperties(TILE_GRASS) == GetTileProperties(TILE_GRASS));
+
+    // Out of range types fall back to TILE_NONE
+    TEST_TRUE(GetTileProperties(TILE_COUNT) == GetTileProperties(TILE_NONE));
+    return TEST_PASSED;
+}
+
+static int test_tile_overrides(void) {
+    printf("Testing sparse tile overrides...\n");
+
+    TileGrid grid;
+    TEST_TRUE(InitTileGrid(&grid, 256, TILE_GRASS));
+    TEST_NULL(GetTileOverride(&grid, 10));
+
+    // Inserted out of order, kept sorted for lookup
+    TEST_TRUE(SetTileOverride(&grid, 200, "{\"sign\":\"east\"}"));
+    TEST_TRUE(SetTileOverride(&grid, 10, "{\"sign\":\"north\"}"));
+    TEST_TRUE(SetTileOverride(&grid, 100, "{\"sign\":\"west\"}"));
+    TEST_EQUAL(grid.overrideCount, 3);
+    TEST_EQUAL(grid.overrides[0].index, 10);
+    TEST_EQUAL(grid.overrides[2].index, 200);
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 100), "{\"sign\":\"west\"}") == 0);
+    TEST_NULL(GetTileOverride(&grid, 101));
+    TEST_EQUAL(FindTileOverrideSlot(&grid, 0), 0);
+    TEST_EQUAL(FindTileOverrideSlot(&grid, 100), 1);
+    TEST_EQUAL(FindTileOverrideSlot(&grid, 101), 2);
+    TEST_EQUAL(FindTileOverrideSlot(&grid, 201), 3);
+
+    // Replacing keeps one entry, NULL removes it
+    TEST_TRUE(SetTileOverride(&grid, 100, "{\"sign\":\"south\"}"));
+    TEST_EQUAL(grid.overrideCount, 3);
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 100), "{\"sign\":\"south\"}") == 0);
+    TEST_TRUE(SetTileOverride(&grid, 100, NULL));
+    TEST_EQUAL(grid.overrideCount, 2);
+    TEST_NULL(GetTileOverride(&grid, 100));
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 200), "{\"sign\":\"east\"}") == 0);
+
+    // Out of range tiles are rejected
+    TEST_FALSE(SetTileOverride(&grid, 256, "{}"));
+    TEST_FALSE(SetTileOverride(&grid, -1, "{}"));
+
+    FreeTileGrid(&grid);
+    TEST_EQUAL(grid.overrideCount, 0);
+    return TEST_PASSED;
+}
+
+static int test_tile_property_sets(void) {
+    printf("Testing shared tile property sets...\n");
+
+    TileGrid grid;
+    TEST_TRUE(InitTileGrid(&grid, 256, TILE_GRASS));
+    TEST_NULL(grid.propertyStore);
+
+    // Tiles with the same properties share one set
+    TEST_TRUE(SetTileOverride(&grid, 1, "{\"lit\":true,\"sign\":\"east\"}"));
+    TEST_TRUE(SetTileOverride(&grid, 2, "{ \"sign\": \"east\", \"lit\": true }"));
+    TEST_TRUE(SetTileOverride(&grid, 3, "{\"sign\":\"west\"}"));
+    TEST_NOT_NULL(grid.propertyStore);
+    TEST_EQUAL(GetTilePropertySet(&grid, 1), GetTilePropertySet(&grid, 2));
+    TEST_TRUE(GetTilePropertySet(&grid, 1) != GetTilePropertySet(&grid, 3));
+    TEST_EQUAL(GetTilePropertySet(&grid, 4), PROPERTY_SET_NONE);
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 2), "{\"lit\":true,\"sign\":\"east\"}") == 0);
+
+    // Typed lookups by key id
+    int sign = FindPropertyKey(grid.propertyStore, "sign");
+    TEST_TRUE(strcmp(GetTileProperty(&grid, 3, sign)->string, "west") == 0);
+    TEST_TRUE(GetTileProperty(&grid, 2, FindPropertyKey(grid.propertyStore, "lit"))->boolean);
+    TEST_NULL(GetTileProperty(&grid, 4, sign));
+
+    // Ids can be handed straight to other tiles, but only known ones
+    TEST_TRUE(SetTilePropertySet(&grid, 50, GetTilePropertySet(&grid, 3)));
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 50), "{\"sign\":\"west\"}") == 0);
+    TEST_FALSE(SetTilePropertySet(&grid, 51, 999));
+    TEST_TRUE(SetTilePropertySet(&grid, 50, PROPERTY_SET_NONE));
+    TEST_NULL(GetTileOverride(&grid, 50));
+
+    // Text that is not a flat object leaves the tile as it was
+    TEST_FALSE(SetTileOverride(&grid, 3, "sign=north"));
+    TEST_TRUE(strcmp(GetTileOverride(&grid, 3), "{\"sign\":\"west\"}") == 0);
+
+    FreeTileGrid(&grid);
+    TEST_NULL(grid.propertyStore);
+    return TEST_PASSED;
+}
+
+int run_tile_grid_tests(void) {
+    printf("\nRunning Tile Grid Tests...\n");
+    int failures = 0;
+
+    failures += test_tile_grid_planes();
+    failures += test_tile_properties_table();
+    failures += test_tile_overrides();
+    failures += test_tile_property_sets();
+
+    return failures;
+}
@@ -0,0 +1,156 @@
+#include "../include/test_suites.h"
+#include "../../include/tile_lod.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOD_TEST_COLUMNS 8
+#define LOD_TEST_WIDTH (LOD_TEST_COLUMNS * TILE_SIZE)
+#define LOD_TEST_HEIGHT (2 * TILE_SIZE)
+#define LOD_TEST_IMAGE (CACHE_CHUNK_SIZE * TILE_SIZE)
+
+static const Color kWater = { 20, 60, 200, 255 };
+static const Color kRed = { 255, 0, 0, 255 };
+
+static void FillCell(Color* pixels, int column, int row, Color even, Color odd) {
+    for (int y = 0; y < TILE_SIZE; y++) {
+        for (int x = 0; x < TILE_SIZE; x++) {
+            pixels[(row * TILE_SIZE + y) * LOD_TEST_WIDTH + column * TILE_SIZE + x] = ((x + y) % 2 == 0) ? even : odd;
+        }
+    }
+}
+
+// Grass is a black and white checkerboard, water is flat. The torch is
+// transparent on its left half and red on its right; the rock alternates
+// transparent black with opaque white.
+static Color* CreateTestTileset(void) {
+    Color* pixels = (Color*)calloc(LOD_TEST_WIDTH * LOD_TEST_HEIGHT, sizeof(Color));
+    if (!pixels) return NULL;
+
+    FillCell(pixels, TILE_GRASS, 0, WHITE, BLACK);
+    FillCell(pixels, TILE_WATER, 0, kWater, kWater);
+    FillCell(pixels, OBJECT_ROCK, 1, BLANK, WHITE);
+    for (int y = 0; y < TILE_SIZE; y++) {
+        for (int x = TILE_SIZE / 2; x < TILE_SIZE; x++) {
+            pixels[(TILE_SIZE + y) * LOD_TEST_WIDTH + OBJECT_TORCH * TILE_SIZE + x] = kRed;
+        }
+    }
+    return pixels;
+}
+
+static bool ColorsEqual(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+static int test_tile_lod_atlas(void) {
+    printf("Testing tile LOD atlas reduction...\n");
+
+    Color* pixels = CreateTestTileset();
+    TEST_NOT_NULL(pixels);
+    TileAtlasLayout layout = { TILE_SIZE, LOD_TEST_WIDTH, LOD_TEST_HEIGHT };
+
+    TileLodAtlas atlas;
+    TEST_FALSE(BuildTileLodAtlas(&atlas, NULL, layout));
+    TEST_FALSE(BuildTileLodAtlas(&atlas, pixels, (TileAtlasLayout){ 6, 48, 12 }));
+    TEST_TRUE(BuildTileLodAtlas(&atlas, pixels, layout));
+    TEST_EQUAL(atlas.columns, LOD_TEST_COLUMNS);
+    TEST_NULL(atlas.cells[0]);
+
+    // Each level halves the cell; the checkerboard averages to grey
+    int half = TILE_SIZE / 2;
+    const Color* grass = &atlas.cells[1][TILE_GRASS * half * half];
+    TEST_EQUAL(grass[0].r, 127);
+    TEST_EQUAL(grass[half * half - 1].g, 127);
+    TEST_EQUAL(grass[0].a, 255);
+    int quarter = TILE_SIZE / 4;
+    TEST_EQUAL(atlas.cells[2][TILE_GRASS * quarter * quarter + 5].b, 127);
+
+    // Transparent pixels add no colour, only lower the alpha
+    const Color* rock = &atlas.cells[1][(LOD_TEST_COLUMNS + OBJECT_ROCK) * half * half];
+    TEST_EQUAL(rock[0].r, 255);
+    TEST_EQUAL(rock[0].a, 127);
+    const Color* torch = &atlas.cells[1][(LOD_TEST_COLUMNS + OBJECT_TORCH) * half * half];
+    TEST_TRUE(ColorsEqual(torch[0], BLANK));
+    TEST_TRUE(ColorsEqual(torch[half - 1], kRed));
+
+    FreeTileLodAtlas(&atlas);
+    TEST_NULL(atlas.cells[1]);
+    free(pixels);
+    return TEST_PASSED;
+}
+
+static int test_tile_lod_compose(void) {
+    printf("Testing tile LOD group images...\n");
+
+    Color* tileset = CreateTestTileset();
+    Color* image = (Color*)malloc(LOD_TEST_IMAGE * LOD_TEST_IMAGE * sizeof(Color));
+    TEST_NOT_NULL(tileset);
+    TEST_NOT_NULL(image);
+    TileLodAtlas atlas;
+    TEST_TRUE(BuildTileLodAtlas(&atlas, tileset, (TileAtlasLayout){ TILE_SIZE, LOD_TEST_WIDTH, LOD_TEST_HEIGHT }));
+
+    // A 2x2 chunk group, of which the map covers 20 columns
+    int stride = CACHE_CHUNK_SIZE * 2;
+    uint8_t types[CACHE_CHUNK_SIZE * 2 * CACHE_CHUNK_SIZE * 2];
+    uint8_t objects[CACHE_CHUNK_SIZE * 2 * CACHE_CHUNK_SIZE * 2];
+    memset(types, TILE_GRASS, sizeof(types));
+    memset(objects, OBJECT_NONE, sizeof(objects));
+    types[2 * stride + 3] = TILE_WATER;
+    objects[2 * stride + 3] = OBJECT_TORCH;
+    types[4 * stride + 4] = TILE_WATER;
+    objects[4 * stride + 4] = OBJECT_ROCK;
+    types[6 * stride + 6] = TILE_NONE;
+    ComposeTileLod(image, &atlas, 1, types, objects, stride, 20, stride);
+
+    // Tiles are 16 pixels at level 1, so the group fills one chunk's image
+    int cell = TILE_SIZE / 2;
+    TEST_EQUAL(image[0].r, 127);
+    TEST_EQUAL(image[(LOD_TEST_IMAGE - 1) * LOD_TEST_IMAGE + 19 * cell].a, 255);
+
+    // The torch covers only the right half of its water tile
+    const Color* torchTile = &image[(2 * cell) * LOD_TEST_IMAGE + 3 * cell];
+    TEST_TRUE(ColorsEqual(torchTile[0], kWater));
+    TEST_TRUE(ColorsEqual(torchTile[cell - 1], kRed));
+
+    // The half-transparent rock lightens the water under it
+    Color rock = image[(4 * cell) * LOD_TEST_IMAGE + 4 * cell];
+    TEST_EQUAL(rock.a, 255);
+    TEST_TRUE(rock.r > kWater.r && rock.r < 255);
+    TEST_TRUE(rock.b > kWater.b);
+
+    // Empty tiles and columns past the map edge stay transparent
+    TEST_EQUAL(image[(6 * cell) * LOD_TEST_IMAGE + 6 * cell].a, 0);
+    TEST_EQUAL(image[20 * cell].a, 0);
+    TEST_EQUAL(image[LOD_TEST_IMAGE - 1].a, 0);
+
+    FreeTileLodAtlas(&atlas);
+    free(tileset);
+    free(image);
+    return TEST_PASSED;
+}
+
+static int test_tile_lod_level_selection(void) {
+    printf("Testing tile LOD level selection...\n");
+
+    TEST_EQUAL(SelectTileLodLevel(2.0f), 0);
+    TEST_EQUAL(SelectTileLodLevel(1.0f), 0);
+    TEST_EQUAL(SelectTileLodLevel(0.6f), 0);
+    TEST_EQUAL(SelectTileLodLevel(0.5f), 1);
+    TEST_EQUAL(SelectTileLodLevel(0.3f), 1);
+    TEST_EQUAL(SelectTileLodLevel(0.25f), 2);
+    TEST_EQUAL(SelectTileLodLevel(0.05f), TILE_LOD_LEVELS - 1);
+    TEST_EQUAL(SelectTileLodLevel(0.0f), 0);
+
+    return TEST_PASSED;
+}
+
+int run_tile_lod_tests(void) {
+    printf("\nRunning Tile LOD Tests...\n");
+    int failures = 0;
+
+    failures += test_tile_lod_atlas();
+    failures += test_tile_lod_compose();
+    failures += test_tile_lod_level_selection();
+
+    return failures;
+}
@@ -0,0 +1,138 @@
+#include "../include/test_suites.h"
+#include "../../include/tile_mesh.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MESH_TEST_STRIDE 40
+#define MESH_TEST_ROWS 20
+
+static int test_tile_mesh_quads(void) {
+    printf("Testing tile mesh quads...\n");
+
+    uint8_t types[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    uint8_t objects[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    memset(types, TILE_GRASS, sizeof(types));
+    memset(objects, OBJECT_NONE, sizeof(objects));
+    types[1 * MESH_TEST_STRIDE + 2] = TILE_NONE;
+    types[3 * MESH_TEST_STRIDE + 4] = TILE_WATER;
+    objects[3 * MESH_TEST_STRIDE + 4] = OBJECT_TORCH;
+
+    TileMeshData mesh;
+    TEST_TRUE(InitTileMeshData(&mesh));
+
+    // A 256x64 atlas of 32 pixel cells: 8 columns, 2 rows
+    TileAtlasLayout layout = { TILE_SIZE, 8 * TILE_SIZE, 2 * TILE_SIZE };
+    int quads = BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, CACHE_CHUNK_SIZE, CACHE_CHUNK_SIZE, layout);
+
+    // Every ground tile but the empty one, plus the single object
+    TEST_EQUAL(quads, CACHE_CHUNK_SIZE * CACHE_CHUNK_SIZE - 1 + 1);
+    TEST_EQUAL(mesh.quadCount, quads);
+
+    // Ground quads come first in row order; (3, 0) is the fourth
+    const float* vertex = &mesh.vertices[3 * 12];
+    TEST_FLOAT_EQUAL(vertex[0], 3.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(vertex[1], 0.0f);
+    TEST_FLOAT_EQUAL(vertex[4], (float)TILE_SIZE);
+    TEST_FLOAT_EQUAL(vertex[6], 4.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(vertex[2], 0.0f);
+
+    const float* uv = &mesh.texcoords[3 * 8];
+    TEST_FLOAT_EQUAL(uv[0], (float)TILE_GRASS / 8.0f);
+    TEST_FLOAT_EQUAL(uv[1], 0.0f);
+    TEST_FLOAT_EQUAL(uv[3], 0.5f);
+    TEST_FLOAT_EQUAL(uv[4], (float)(TILE_GRASS + 1) / 8.0f);
+
+    // The object quad is last and samples the second atlas row
+    int last = quads - 1;
+    TEST_FLOAT_EQUAL(mesh.vertices[last * 12], 4.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(mesh.vertices[last * 12 + 1], 3.0f * TILE_SIZE);
+    TEST_FLOAT_EQUAL(mesh.texcoords[last * 8], (float)OBJECT_TORCH / 8.0f);
+    TEST_FLOAT_EQUAL(mesh.texcoords[last * 8 + 1], 0.5f);
+    TEST_FLOAT_EQUAL(mesh.texcoords[last * 8 + 3], 1.0f);
+
+    // Two triangles per quad over its own four vertices
+    TEST_EQUAL(mesh.indices[last * 6], last * 4);
+    TEST_EQUAL(mesh.indices[last * 6 + 2], last * 4 + 2);
+    TEST_EQUAL(mesh.indices[last * 6 + 5], last * 4 + 3);
+
+    FreeTileMeshData(&mesh);
+    return TEST_PASSED;
+}
+
+static int test_tile_mesh_edges(void) {
+    printf("Testing tile mesh edge windows...\n");
+
+    uint8_t types[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    uint8_t objects[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    memset(types, TILE_FLOOR, sizeof(types));
+    memset(objects, OBJECT_ROCK, sizeof(objects));
+
+    TileMeshData mesh;
+    TEST_TRUE(InitTileMeshData(&mesh));
+    TileAtlasLayout layout = { TILE_SIZE, 16 * TILE_SIZE, 2 * TILE_SIZE };
+
+    // A full chunk of objects fills the buffer exactly
+    TEST_EQUAL(BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, CACHE_CHUNK_SIZE, CACHE_CHUNK_SIZE, layout),
+               TILE_MESH_MAX_QUADS);
+
+    // Partial chunks at the map edge and oversized windows are clipped
+    TEST_EQUAL(BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, 8, 4, layout), 8 * 4 * 2);
+    TEST_EQUAL(BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, MESH_TEST_STRIDE, MESH_TEST_ROWS, layout),
+               TILE_MESH_MAX_QUADS);
+    TEST_EQUAL(BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, 0, 0, layout), 0);
+
+    // Rebuilding into the same buffer starts over
+    memset(objects, OBJECT_NONE, sizeof(objects));
+    TEST_EQUAL(BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, 2, 2, layout), 4);
+    TEST_EQUAL(mesh.quadCount, 4);
+
+    FreeTileMeshData(&mesh);
+    return TEST_PASSED;
+}
+
+static int test_tile_mesh_resonance(void) {
+    printf("Testing tile mesh resonance levels...\n");
+
+    uint8_t types[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    uint8_t objects[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    uint8_t levels[MESH_TEST_STRIDE * MESH_TEST_ROWS];
+    memset(types, TILE_GRASS, sizeof(types));
+    memset(objects, OBJECT_NONE, sizeof(objects));
+    memset(levels, 0, sizeof(levels));
+    objects[1 * MESH_TEST_STRIDE + 2] = OBJECT_TORCH;
+    levels[1 * MESH_TEST_STRIDE + 2] = 255;
+    levels[1 * MESH_TEST_STRIDE + 3] = 51;
+
+    TileMeshData mesh;
+    TEST_TRUE(InitTileMeshData(&mesh));
+    TileAtlasLayout layout = { TILE_SIZE, 8 * TILE_SIZE, 2 * TILE_SIZE };
+    int quads = BuildTileMesh(&mesh, types, objects, MESH_TEST_STRIDE, 4, 2, layout);
+    TEST_EQUAL(quads, 4 * 2 + 1);
+
+    // Fresh meshes carry no resonance
+    TEST_FLOAT_EQUAL(mesh.texcoords2[(quads - 1) * 8], 0.0f);
+
+    // Each quad takes its tile's level on all four vertices, objects too
+    SetTileMeshResonance(&mesh, levels, MESH_TEST_STRIDE, TILE_SIZE);
+    int ground = 1 * 4 + 2;
+    TEST_FLOAT_EQUAL(mesh.texcoords2[ground * 8], 1.0f);
+    TEST_FLOAT_EQUAL(mesh.texcoords2[ground * 8 + 6], 1.0f);
+    TEST_FLOAT_EQUAL(mesh.texcoords2[ground * 8 + 7], 0.0f);
+    TEST_FLOAT_EQUAL(mesh.texcoords2[(ground + 1) * 8 + 2], 0.2f);
+    TEST_FLOAT_EQUAL(mesh.texcoords2[(quads - 1) * 8 + 4], 1.0f);
+    TEST_FLOAT_EQUAL(mesh.texcoords2[0], 0.0f);
+
+    FreeTileMeshData(&mesh);
+    return TEST_PASSED;
+}
+
+int run_tile_mesh_tests(void) {
+    printf("\nRunning Tile Mesh Tests...\n");
+    int failures = 0;
+
+    failures += test_tile_mesh_quads();
+    failures += test_tile_mesh_edges();
+    failures += test_tile_mesh_resonance();
+
+    return failures;
+}
@@ -4,6 +4,9 @@
 #include "../include/resource_manager.h"
 #include "../include/entity_pool.h"
 #include "../include/logger.h"
+#include "../../include/entity.h"
+#include "../../include/entities/npc.h"
+#include "../../include/tile_grid.h"
 #include <assert.h>
 #include <stdio.h>
 
@@ -31,6 +34,7 @@ static bool verify_resources(void) {
 static int TestWorldCreation(void);
 static int TestEntityManagement(void);
 static int TestWorldInteractions(void);
+static int TestWorldStateUpdate(void);
 
 int run_world_tests(void) {
     printf("\nRunning World Tests...\n");
@@ -39,6 +43,7 @@ int run_world_tests(void) {
     failures += TestWorldCreation();
     failures += TestEntityManagement();
     failures += TestWorldInteractions();
+    failures += TestWorldStateUpdate();
     
     return failures;
 }
@@ -111,6 +116,48 @@ static int TestWorldInteractions(void) {
     return TEST_PASSED;
 }
 
+static int TestWorldStateUpdate(void) {
+    printf("\nTesting World State Update...\n");
+
+    WorldState* state = CreateWorldState();
+    TEST_NOT_NULL(state);
+    World* world = state->world;
+
+    // UpdateWorld drives these; a missing one silently skips its pass
+    TEST_NOT_NULL(world->crowd);
+    TEST_NOT_NULL(world->perception);
+    TEST_NOT_NULL(world->animation);
+    TEST_NOT_NULL(world->movement);
+    TEST_NOT_NULL(world->renderer);
+
+    TEST_TRUE(InitTileGrid(&world->tiles, (size_t)(world->width * world->height), TILE_FLOOR));
+    TEST_TRUE(RebuildWorldCollision(world));
+
+    // A patrolling NPC far from the player walks to its target and stops there
+    Vector2 start = { 60.0f * TILE_SIZE, 60.0f * TILE_SIZE };
+    Vector2 target = { start.x + 4.0f * TILE_SIZE, start.y };
+    Entity* npc = CreateNPC(state->entityPool, start);
+    TEST_NOT_NULL(npc);
+    AIComponent* ai = GetAIComponent(npc);
+    ai->detectionRadius = 0.0f;
+    ai->homePosition = start;
+    ai->targetPosition = target;
+    ai->state = ENTITY_STATE_PATROL;
+    npc->state = ENTITY_STATE_PATROL;
+
+    for (int frame = 0; frame < 180; frame++) {
+        UpdateWorld(state, 1.0f / 60.0f);
+    }
+
+    Vector2 position = GetTransformComponent(npc)->position;
+    TEST_TRUE(position.x > start.x + 3.0f * TILE_SIZE);
+    TEST_TRUE(position.x <= target.x + ARRIVAL_THRESHOLD);
+    TEST_FLOAT_EQUAL(GetPhysicsComponent(npc)->moveVelocity.x, 0.0f);
+
+    DestroyWorldState(state);
+    return TEST_PASSED;
+}
+
 void test_world_tile_operations(void) {
     LOG_INFO(LOG_CORE, "Starting tile operations test");
     
@@ -0,0 +1,152 @@
+#include "../include/test_suites.h"
+#include "../../include/world_stream.h"
+#include <stdio.h>
+
+#define STREAM_TEST_DIRECTORY "test_world_stream_chunks"
+#define STREAM_TEST_CHUNK_PIXELS ((float)(STREAM_CHUNK_SIZE * TILE_SIZE))
+
+// Centre of a chunk in world pixels
+static Vector2 ChunkCentre(int chunkX, int chunkY) {
+    return (Vector2){ (chunkX + 0.5f) * STREAM_TEST_CHUNK_PIXELS, (chunkY + 0.5f) * STREAM_TEST_CHUNK_PIXELS };
+}
+
+static void GenerateWater(void* context, StreamChunk* chunk) {
+    (void)context;
+    for (int i = 0; i < STREAM_CHUNK_TILES; i++) {
+        chunk->types[i] = TILE_WATER;
+    }
+}
+
+// Grass for the first chunk generated, water after that
+static void GenerateGrassThenWater(void* context, StreamChunk* chunk) {
+    int* calls = (int*)context;
+    for (int i = 0; i < STREAM_CHUNK_TILES; i++) {
+        chunk->types[i] = *calls == 0 ? TILE_GRASS : TILE_WATER;
+    }
+    (*calls)++;
+}
+
+static int test_world_stream_residency(void) {
+    printf("Testing world stream residency...\n");
+
+    WorldStream* stream = CreateWorldStream(NULL, 1, 0, NULL, NULL);
+    TEST_NOT_NULL(stream);
+    TEST_FALSE(IsStreamTileResident(stream, 0, 0));
+    TEST_EQUAL_ENUM(GetStreamTile(stream, 0, 0).type, TILE_NONE);
+
+    Vector2 focus = ChunkCentre(0, 0);
+    UpdateWorldStream(stream, &focus, 1);
+    FlushWorldStream(stream);
+    TEST_EQUAL(GetResidentChunkCount(stream), 9);
+
+    // Negative coordinates resolve to the chunks left of and above the origin
+    TEST_TRUE(IsStreamTileResident(stream, -1, -1));
+    TEST_NOT_NULL(GetStreamChunk(stream, -1, -1));
+    TEST_EQUAL_ENUM(GetStreamTile(stream, -STREAM_CHUNK_SIZE, 0).type, TILE_GRASS);
+    TEST_FALSE(IsStreamTileResident(stream, -STREAM_CHUNK_SIZE - 1, 0));
+
+    DestroyWorldStream(stream);
+    return TEST_PASSED;
+}
+
+static int test_world_stream_bounded(void) {
+    printf("Testing world stream memory bound...\n");
+
+    const int maxChunks = 12;
+    WorldStream* stream = CreateWorldStream(NULL, 1, maxChunks, GenerateWater, NULL);
+    TEST_NOT_NULL(stream);
+
+    // Two foci walking apart across a long stretch never exceed the cap
+    for (int step = 0; step < 64; step++) {
+        Vector2 focus[2] = { ChunkCentre(step, 0), ChunkCentre(-step, step / 2) };
+        UpdateWorldStream(stream, focus, 2);
+        TEST_TRUE(stream->entryCount <= maxChunks);
+        if (step % 8 == 0) FlushWorldStream(stream);
+    }
+
+    FlushWorldStream(stream);
+    TEST_TRUE(GetResidentChunkCount(stream) <= maxChunks);
+    TEST_EQUAL_ENUM(GetStreamTile(stream, 63 * STREAM_CHUNK_SIZE, 0).type, TILE_WATER);
+
+    DestroyWorldStream(stream);
+    return TEST_PASSED;
+}
+
+static int test_world_stream_persistence(void) {
+    printf("Testing world stream persistence...\n");
+
+    WorldStream* stream = CreateWorldStream(STREAM_TEST_DIRECTORY, 1, 0, NULL, NULL);
+    TEST_NOT_NULL(stream);
+
+    Vector2 home = ChunkCentre(0, 0);
+    UpdateWorldStream(stream, &home, 1);
+    FlushWorldStream(stream);
+
+    TEST_TRUE(SetStreamTile(stream, -5, 7, CreateTile(TILE_WALL, OBJECT_TORCH)));
+    TEST_TRUE(GetStreamChunk(stream, -1, 0)->dirty);
+    TEST_FALSE(SetStreamTile(stream, 40 * STREAM_CHUNK_SIZE, 0, CreateTile(TILE_WALL, OBJECT_NONE)));
+
+    // Travel far enough to evict the edit, then come back for it
+    Vector2 away = ChunkCentre(20, 20);
+    UpdateWorldStream(stream, &away, 1);
+    TEST_NULL(GetStreamChunk(stream, -1, 0));
+    FlushWorldStream(stream);
+
+    UpdateWorldStream(stream, &home, 1);
+    FlushWorldStream(stream);
+    Tile tile = GetStreamTile(stream, -5, 7);
+    TEST_EQUAL_ENUM(tile.type, TILE_WALL);
+    TEST_EQUAL_ENUM(tile.objectType, OBJECT_TORCH);
+    TEST_FALSE(GetStreamChunk(stream, -1, 0)->dirty);
+
+    DestroyWorldStream(stream);
+
+    // The file round-trips on its own and rejects a mismatched chunk
+    StreamChunk chunk = { .chunkX = -1, .chunkY = 0 };
+    TEST_TRUE(ReadChunkFile(STREAM_TEST_DIRECTORY, &chunk));
+    TEST_EQUAL(chunk.types[7 * STREAM_CHUNK_SIZE + (STREAM_CHUNK_SIZE - 5)], TILE_WALL);
+    chunk.chunkX = 3;
+    TEST_FALSE(ReadChunkFile(STREAM_TEST_DIRECTORY, &chunk));
+
+    char path[256];
+    GetChunkFilePath(STREAM_TEST_DIRECTORY, -1, 0, path, sizeof(path));
+    remove(path);
+    remove(STREAM_TEST_DIRECTORY);
+    return TEST_PASSED;
+}
+
+static int test_world_stream_stale_loads(void) {
+    printf("Testing world stream stale loads...\n");
+
+    int calls = 0;
+    WorldStream* stream = CreateWorldStream(NULL, 0, 0, GenerateGrassThenWater, &calls);
+    TEST_NOT_NULL(stream);
+
+    // A result tagged for another request of the same chunk, as a load
+    // from before an eviction would be, finishes after the entry's own
+    Vector2 focus = ChunkCentre(0, 0);
+    UpdateWorldStream(stream, &focus, 1);
+    FlushChunkIO(stream->io);
+    TEST_TRUE(QueueChunkLoad(stream->io, 0, 0, stream->entries[0].generation + 1));
+    FlushWorldStream(stream);
+    TEST_EQUAL(calls, 2);
+
+    // Only the current request's result is installed
+    TEST_EQUAL_ENUM(GetStreamTile(stream, 0, 0).type, TILE_GRASS);
+    TEST_EQUAL(GetStreamChunk(stream, 0, 0)->generation, stream->entries[0].generation);
+
+    DestroyWorldStream(stream);
+    return TEST_PASSED;
+}
+
+int run_world_stream_tests(void) {
+    printf("\nRunning World Stream Tests...\n");
+    int failures = 0;
+
+    failures += test_world_stream_residency();
+    failures += test_world_stream_bounded();
+    failures += test_world_stream_persistence();
+    failures += test_world_stream_stale_loads();
+
+    return failures;
+}
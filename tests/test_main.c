@@ -22,6 +22,25 @@ int main(void) {
     RUN_TEST_SUITE(run_memory_tests);
     RUN_TEST_SUITE(run_integration_tests);
     RUN_TEST_SUITE(run_texture_manager_tests);
+    RUN_TEST_SUITE(run_crowd_tests);
+    RUN_TEST_SUITE(run_random_tests);
+    RUN_TEST_SUITE(run_perception_tests);
+    RUN_TEST_SUITE(run_pathfinding_tests);
+    RUN_TEST_SUITE(run_animation_tests);
+    RUN_TEST_SUITE(run_tile_grid_tests);
+    RUN_TEST_SUITE(run_chunk_cache_tests);
+    RUN_TEST_SUITE(run_world_stream_tests);
+    RUN_TEST_SUITE(run_collision_grid_tests);
+    RUN_TEST_SUITE(run_movement_tests);
+    RUN_TEST_SUITE(run_animated_tiles_tests);
+    RUN_TEST_SUITE(run_tile_mesh_tests);
+    RUN_TEST_SUITE(run_map_file_tests);
+    RUN_TEST_SUITE(run_region_map_tests);
+    RUN_TEST_SUITE(run_entity_culling_tests);
+    RUN_TEST_SUITE(run_chunk_prefetch_tests);
+    RUN_TEST_SUITE(run_tile_lod_tests);
+    RUN_TEST_SUITE(run_resonance_field_tests);
+    RUN_TEST_SUITE(run_property_store_tests);
     
     teardown_test_environment();
     